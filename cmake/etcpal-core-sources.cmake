@@ -5,20 +5,27 @@ set(ETCPAL_CORE_HEADERS
   ${ETCPAL_ROOT}/include/etcpal/common.h
   ${ETCPAL_ROOT}/include/etcpal/error.h
   ${ETCPAL_ROOT}/include/etcpal/handle_manager.h
+  ${ETCPAL_ROOT}/include/etcpal/hashmap.h
   ${ETCPAL_ROOT}/include/etcpal/log.h
   ${ETCPAL_ROOT}/include/etcpal/mempool.h
   ${ETCPAL_ROOT}/include/etcpal/pack.h
   ${ETCPAL_ROOT}/include/etcpal/pack64.h
   ${ETCPAL_ROOT}/include/etcpal/rbtree.h
+  ${ETCPAL_ROOT}/include/etcpal/spsc_queue.h
   ${ETCPAL_ROOT}/include/etcpal/timer.h
+  ${ETCPAL_ROOT}/include/etcpal/timer_wheel.h
   ${ETCPAL_ROOT}/include/etcpal/uuid.h
   ${ETCPAL_ROOT}/include/etcpal/version.h
+  ${ETCPAL_ROOT}/include/etcpal/cpp/acn_pdu.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/common.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/error.h
+  ${ETCPAL_ROOT}/include/etcpal/cpp/handle_table.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/hash.h
+  ${ETCPAL_ROOT}/include/etcpal/cpp/hashmap.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/log.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/opaque_id.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/timer.h
+  ${ETCPAL_ROOT}/include/etcpal/cpp/timer_wheel.h
   ${ETCPAL_ROOT}/include/etcpal/cpp/uuid.h
 )
 
@@ -28,11 +35,14 @@ set(ETCPAL_CORE_SOURCES
   ${ETCPAL_ROOT}/src/etcpal/common.c
   ${ETCPAL_ROOT}/src/etcpal/error.c
   ${ETCPAL_ROOT}/src/etcpal/handle_manager.c
+  ${ETCPAL_ROOT}/src/etcpal/hashmap.c
   ${ETCPAL_ROOT}/src/etcpal/log.c
   ${ETCPAL_ROOT}/src/etcpal/mempool.c
   ${ETCPAL_ROOT}/src/etcpal/pack.c
   ${ETCPAL_ROOT}/src/etcpal/rbtree.c
+  ${ETCPAL_ROOT}/src/etcpal/spsc_queue.c
   ${ETCPAL_ROOT}/src/etcpal/timer.c
+  ${ETCPAL_ROOT}/src/etcpal/timer_wheel.c
   ${ETCPAL_ROOT}/src/etcpal/uuid.c
 )
 
@@ -45,6 +55,7 @@ if(ETCPAL_HAVE_OS_SUPPORT)
     ${ETCPAL_ROOT}/include/etcpal/sem.h
     ${ETCPAL_ROOT}/include/etcpal/signal.h
     ${ETCPAL_ROOT}/include/etcpal/thread.h
+    ${ETCPAL_ROOT}/include/etcpal/threadpool.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/event_group.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/mutex.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/queue.h
@@ -52,7 +63,12 @@ if(ETCPAL_HAVE_OS_SUPPORT)
     ${ETCPAL_ROOT}/include/etcpal/cpp/rwlock.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/sem.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/signal.h
+    ${ETCPAL_ROOT}/include/etcpal/cpp/spsc_queue.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/thread.h
+    ${ETCPAL_ROOT}/include/etcpal/cpp/threadpool.h
+  )
+  set(ETCPAL_CORE_SOURCES ${ETCPAL_CORE_SOURCES}
+    ${ETCPAL_ROOT}/src/etcpal/threadpool.c
   )
 endif()
 
@@ -63,10 +79,12 @@ if(ETCPAL_HAVE_NETWORKING_SUPPORT)
     ${ETCPAL_ROOT}/include/etcpal/socket.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/inet.h
     ${ETCPAL_ROOT}/include/etcpal/cpp/netint.h
+    ${ETCPAL_ROOT}/include/etcpal/cpp/socket.h
   )
 
   set(ETCPAL_CORE_SOURCES ${ETCPAL_CORE_SOURCES}
     ${ETCPAL_ROOT}/src/etcpal/inet.c
     ${ETCPAL_ROOT}/src/etcpal/netint.c
+    ${ETCPAL_ROOT}/src/etcpal/route_index.c
   )
 endif()
@@ -21,6 +21,7 @@ set(ETCPAL_OS_ADDITIONAL_SOURCES
   ${ETCPAL_ROOT}/src/os/linux/etcpal/os_sem.c
   ${ETCPAL_ROOT}/src/os/linux/etcpal/os_signal.c
   ${ETCPAL_ROOT}/src/os/linux/etcpal/os_thread.c
+  ${ETCPAL_ROOT}/src/os/linux/etcpal/os_timed_wait.h
   ${ETCPAL_ROOT}/src/os/linux/etcpal/os_timer.c
   ${ETCPAL_ROOT}/src/os/linux/etcpal/os_uuid.c
 
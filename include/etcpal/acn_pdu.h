@@ -201,7 +201,13 @@ typedef struct AcnPduConstraints
 extern "C" {
 #endif
 
-bool acn_parse_pdu(const uint8_t* buf, size_t buflen, const AcnPduConstraints* constraints, AcnPdu* pdu);
+bool   acn_parse_pdu(const uint8_t* buf, size_t buflen, const AcnPduConstraints* constraints, AcnPdu* pdu);
+size_t acn_parse_pdu_block(const uint8_t*           buf,
+                           size_t                   buflen,
+                           const AcnPduConstraints* constraints,
+                           AcnPdu*                  last_pdu,
+                           AcnPdu*                  pdus,
+                           size_t                   max_pdus);
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include "etcpal/acn_pdu.h"
 #include "etcpal/acn_prot.h"
+#include "etcpal/common.h"
 #include "etcpal/uuid.h"
 
 /**
@@ -55,6 +56,11 @@
 /** Size of the Root Layer PDU header when the length is 4096 or greater. */
 #define ACN_RLP_HEADER_SIZE_EXT_LEN 23
 
+/** Size of the header buffer to provide to acn_pack_root_layer_block_iov() for a block of num_pdus PDUs. */
+#define ACN_RLP_IOV_HEADER_BUF_SIZE(num_pdus) ((num_pdus)*ACN_RLP_HEADER_SIZE_EXT_LEN)
+/** Maximum number of buffers filled in by acn_pack_root_layer_block_iov() for a block of num_pdus PDUs. */
+#define ACN_RLP_IOV_MAX_COUNT(num_pdus) ((num_pdus)*2)
+
 /**
  * @name Protocol Vectors
  * Each ACN family protocol is defined by a protocol vector in a Root Layer PDU. These values
@@ -118,6 +124,12 @@ size_t acn_pack_udp_preamble(uint8_t* buf, size_t buflen);
 size_t acn_root_layer_buf_size(const AcnRootLayerPdu* pdu_block, size_t num_pdus);
 size_t acn_pack_root_layer_header(uint8_t* buf, size_t buflen, const AcnRootLayerPdu* pdu);
 size_t acn_pack_root_layer_block(uint8_t* buf, size_t buflen, const AcnRootLayerPdu* pdu_block, size_t num_pdus);
+size_t acn_pack_root_layer_block_iov(uint8_t*               header_buf,
+                                     size_t                 header_buflen,
+                                     const AcnRootLayerPdu* pdu_block,
+                                     size_t                 num_pdus,
+                                     EtcPalIoVec*           iov,
+                                     size_t                 max_iov);
 
 #ifdef __cplusplus
 }
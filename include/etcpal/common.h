@@ -22,6 +22,7 @@
 #ifndef ETCPAL_COMMON_H_
 #define ETCPAL_COMMON_H_
 
+#include <stddef.h>
 #include <stdint.h>
 #include "etcpal/error.h"
 
@@ -120,6 +121,13 @@ extern "C" {
 /** For etcpal_ functions that take a millisecond timeout, this means do not wait at all */
 #define ETCPAL_NO_WAIT 0
 
+/** One buffer in a scatter-gather list, e.g. for etcpal_sendmsg(). */
+typedef struct EtcPalIoVec
+{
+  const void* base; /**< Start of the buffer. */
+  size_t      len;  /**< Size in bytes of the buffer. */
+} EtcPalIoVec;
+
 /** A mask of desired EtcPal features. See "EtcPal feature masks". */
 typedef uint32_t etcpal_features_t;
 
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/acn_pdu.h
+/// @brief C++ utilities for etcpal/acn_pdu.h
+
+#ifndef ETCPAL_CPP_ACN_PDU_H_
+#define ETCPAL_CPP_ACN_PDU_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "etcpal/acn_pdu.h"
+
+namespace etcpal
+{
+namespace acn
+{
+/// @defgroup etcpal_cpp_acn_pdu acn_pdu (ACN Protocol Family PDUs)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_acn_pdu module.
+
+/// @ingroup etcpal_cpp_acn_pdu
+/// @brief An iterable view of the PDUs in an ACN PDU block.
+///
+/// Iterating a PduRange yields the same sequence of AcnPdu as calling acn_parse_pdu() repeatedly
+/// on the block, but the flags and length decoding is done inline. Nothing is copied; each AcnPdu
+/// points into the original buffer, which must outlive the range.
+///
+/// Example usage:
+/// @code
+/// const AcnPduConstraints constraints = {4, 0};
+/// for (const AcnPdu& pdu : etcpal::acn::PduRange(buf, buflen, constraints))
+/// {
+///   // Handle pdu.pvector, pdu.pheader, pdu.pdata and pdu.data_len
+/// }
+/// @endcode
+///
+/// Iteration stops at the first PDU that fails to parse. To find out whether the entire block was
+/// well-formed, check whether the last PDU's pnextpdu is the end of the buffer, or use
+/// acn_parse_pdu_block().
+class PduRange
+{
+public:
+  /// @brief A forward iterator over the PDUs in a block.
+  class Iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = AcnPdu;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const AcnPdu*;
+    using reference         = const AcnPdu&;
+
+    Iterator() = default;
+    Iterator(const uint8_t* buf, const uint8_t* buf_end, const AcnPduConstraints& constraints) noexcept;
+
+    reference operator*() const noexcept { return pdu_; }
+    pointer   operator->() const noexcept { return &pdu_; }
+    Iterator& operator++() noexcept;
+    Iterator  operator++(int) noexcept;
+
+    /// @brief Whether two iterators refer to the same PDU.
+    friend bool operator==(const Iterator& a, const Iterator& b) noexcept { return a.this_pdu_ == b.this_pdu_; }
+    /// @brief Whether two iterators refer to different PDUs.
+    friend bool operator!=(const Iterator& a, const Iterator& b) noexcept { return a.this_pdu_ != b.this_pdu_; }
+
+  private:
+    bool Parse(bool first_in_block) noexcept;
+
+    const uint8_t*    this_pdu_{nullptr};
+    const uint8_t*    buf_end_{nullptr};
+    AcnPduConstraints constraints_{};
+    AcnPdu            pdu_{};
+  };
+
+  PduRange(const uint8_t* buf, size_t buflen, const AcnPduConstraints& constraints) noexcept;
+
+  Iterator begin() const noexcept;
+  Iterator end() const noexcept;
+
+private:
+  const uint8_t*    buf_{nullptr};
+  size_t            buflen_{0};
+  AcnPduConstraints constraints_{};
+};
+
+/// @brief Create a view of the PDUs in a block.
+/// @param buf Byte buffer containing a PDU block.
+/// @param buflen Size in bytes of buf.
+/// @param constraints Specific information about the PDUs in the block.
+inline PduRange::PduRange(const uint8_t* buf, size_t buflen, const AcnPduConstraints& constraints) noexcept
+    : buf_(buf), buflen_(buflen), constraints_(constraints)
+{
+}
+
+/// @brief Get an iterator to the first PDU in the block.
+inline PduRange::Iterator PduRange::begin() const noexcept
+{
+  return (buf_ && buflen_) ? Iterator(buf_, buf_ + buflen_, constraints_) : Iterator();
+}
+
+/// @brief Get an iterator past the last PDU in the block.
+inline PduRange::Iterator PduRange::end() const noexcept
+{
+  return Iterator();
+}
+
+/// @brief Create an iterator pointing to the first PDU in a block.
+/// @param buf Start of the PDU block.
+/// @param buf_end End of the PDU block.
+/// @param constraints Specific information about the PDUs in the block.
+inline PduRange::Iterator::Iterator(const uint8_t*           buf,
+                                    const uint8_t*           buf_end,
+                                    const AcnPduConstraints& constraints) noexcept
+    : this_pdu_(buf), buf_end_(buf_end), constraints_(constraints)
+{
+  if (!Parse(true))
+    this_pdu_ = nullptr;
+}
+
+/// @brief Advance to the next PDU in the block.
+inline PduRange::Iterator& PduRange::Iterator::operator++() noexcept
+{
+  this_pdu_ = pdu_.pnextpdu;
+  if (this_pdu_ >= buf_end_ || !Parse(false))
+    this_pdu_ = nullptr;
+  return *this;
+}
+
+/// @brief Advance to the next PDU in the block.
+inline PduRange::Iterator PduRange::Iterator::operator++(int) noexcept
+{
+  Iterator prev = *this;
+  ++(*this);
+  return prev;
+}
+
+// Mirrors acn_parse_pdu(), with the per-call argument checks hoisted out.
+inline bool PduRange::Iterator::Parse(bool first_in_block) noexcept
+{
+  const uint8_t flags_byte  = *this_pdu_;
+  const size_t  len_size    = ACN_PDU_L_FLAG_SET(flags_byte) ? 3 : 2;
+  const bool    inheritvect = !ACN_PDU_V_FLAG_SET(flags_byte);
+  const bool    inherithead = !ACN_PDU_H_FLAG_SET(flags_byte);
+  const bool    inheritdata = !ACN_PDU_D_FLAG_SET(flags_byte);
+
+  if (static_cast<size_t>(buf_end_ - this_pdu_) <= len_size)
+    return false;
+  if (first_in_block && (inheritvect || inherithead || inheritdata))
+    return false;
+
+  const size_t pdu_len     = ACN_PDU_LENGTH(this_pdu_);
+  const size_t min_pdu_len = len_size + (inheritvect ? 0 : constraints_.vector_size) +
+                             (inherithead ? 0 : constraints_.header_size);
+  if (pdu_len < min_pdu_len || pdu_len > static_cast<size_t>(buf_end_ - this_pdu_))
+    return false;
+
+  const uint8_t* cur_ptr = this_pdu_ + len_size;
+  if (!inheritvect)
+  {
+    pdu_.pvector = cur_ptr;
+    cur_ptr += constraints_.vector_size;
+  }
+  if (!inherithead)
+  {
+    pdu_.pheader = cur_ptr;
+    cur_ptr += constraints_.header_size;
+  }
+  if (!inheritdata)
+  {
+    pdu_.pdata    = cur_ptr;
+    pdu_.data_len = pdu_len - static_cast<size_t>(cur_ptr - this_pdu_);
+    cur_ptr += pdu_.data_len;
+  }
+  pdu_.pnextpdu = cur_ptr;
+  return true;
+}
+
+};  // namespace acn
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_ACN_PDU_H_
@@ -0,0 +1,305 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/handle_table.h
+/// @brief C++ wrapper and utilities for the handle table in etcpal/handle_manager.h
+
+#ifndef ETCPAL_CPP_HANDLE_TABLE_H_
+#define ETCPAL_CPP_HANDLE_TABLE_H_
+
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "etcpal/handle_manager.h"
+#include "etcpal/cpp/common.h"
+#include "etcpal/cpp/error.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_handle_table handle_table (Handle Tables)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_handle_manager module.
+
+/// @ingroup etcpal_cpp_handle_table
+/// @brief A table of resources addressed by strongly-typed handles.
+///
+/// Handles are allocated from an #EtcPalHandleTable, so inserting, finding and erasing a resource
+/// all take constant time, and a handle which has been erased is recognized as stale even after its
+/// slot has been reused. Resources are stored by value and are never moved, so pointers returned by
+/// Find() remain valid until the resource is erased.
+///
+/// Id must be an etcpal::OpaqueId with an underlying type of int, e.g.:
+///
+/// @code
+/// struct SourceHandleType {};
+/// using SourceHandle = etcpal::OpaqueId<SourceHandleType, int, -1>;
+///
+/// etcpal::HandleTable<SourceHandle, Source> sources;
+///
+/// auto handle = sources.Emplace(cid, name);
+/// if (handle)
+/// {
+///   Source* source = sources.Find(*handle);
+///   // ...
+///   sources.Erase(*handle);
+///   // sources.Find(*handle) now returns nullptr
+/// }
+/// @endcode
+template <class Id, class T>
+class HandleTable
+{
+public:
+  static_assert(std::is_same<typename std::decay<decltype(std::declval<Id>().value())>::type, int>::value,
+                "HandleTable IDs must have an underlying type of int.");
+
+  explicit HandleTable(size_t max_size = ETCPAL_HANDLE_TABLE_MAX_SIZE) noexcept;
+  ~HandleTable();
+
+  HandleTable(const HandleTable& other) = delete;
+  HandleTable& operator=(const HandleTable& other) = delete;
+  HandleTable(HandleTable&& other)                 = delete;
+  HandleTable& operator=(HandleTable&& other) = delete;
+
+  template <class... Args>
+  Expected<Id> Emplace(Args&&... args);
+  Expected<Id> Insert(const T& value);
+  Expected<Id> Insert(T&& value);
+
+  T*       Find(Id id) noexcept;
+  const T* Find(Id id) const noexcept;
+  bool     Contains(Id id) const noexcept;
+  bool     Erase(Id id) noexcept;
+  void     Clear() noexcept;
+
+  template <class Function>
+  void ForEach(Function&& func);
+
+  size_t size() const noexcept;
+  bool   empty() const noexcept;
+
+  EtcPalHandleTable& get() noexcept;
+
+private:
+  using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  T*       At(size_t index) noexcept;
+  const T* At(size_t index) const noexcept;
+
+  EtcPalHandleTable table_{};
+  // A deque does not move its elements when it grows at the end.
+  std::deque<Storage> storage_;
+};
+
+/// @brief Create an empty handle table which allocates and grows its own storage.
+///
+/// If max_size is 0 or greater than #ETCPAL_HANDLE_TABLE_MAX_SIZE, the table is created empty with
+/// no room for resources, and Emplace() and Insert() return #kEtcPalErrNoMem.
+///
+/// @param max_size The maximum number of resources in the table at once; see
+///                 etcpal_handle_table_init().
+template <class Id, class T>
+HandleTable<Id, T>::HandleTable(size_t max_size) noexcept
+{
+  if (etcpal_handle_table_init(&table_, max_size) != kEtcPalErrOk)
+  {
+    // A zero-initialized table looks like it has a free slot at index 0. Mark it as having no free
+    // slots and no storage to grow, so that allocation fails cleanly.
+    table_.free_head = -1;
+    table_.free_tail = -1;
+  }
+}
+
+/// @brief Destroy the handle table and all the resources it contains.
+template <class Id, class T>
+HandleTable<Id, T>::~HandleTable()
+{
+  Clear();
+  etcpal_handle_table_deinit(&table_);
+}
+
+/// @brief Construct a new resource in place and allocate a handle for it.
+///
+/// If growing the storage or the constructor of T throws, no handle is allocated and the exception
+/// propagates to the caller.
+///
+/// @param args Arguments to pass to the constructor of T.
+/// @return The handle for the new resource (success) or #kEtcPalErrNoMem (failure).
+template <class Id, class T>
+template <class... Args>
+Expected<Id> HandleTable<Id, T>::Emplace(Args&&... args)
+{
+  // Grow the storage before allocating, so that running out of memory here cannot leave a handle
+  // allocated with no resource behind it. A full table grows when allocating, and hands out the
+  // first of its new slots.
+  size_t capacity = etcpal_handle_table_capacity(&table_);
+  size_t needed   = (etcpal_handle_table_size(&table_) == capacity) ? capacity + 1 : capacity;
+  if (storage_.size() < needed)
+    storage_.resize(needed);
+
+  size_t index  = 0;
+  int    handle = etcpal_handle_table_alloc(&table_, &index);
+  if (handle < 0)
+    return kEtcPalErrNoMem;
+
+#if ETCPAL_BUILDING_WITH_EXCEPTIONS
+  try
+  {
+#endif
+    if (index >= storage_.size())
+      storage_.resize(index + 1);
+    new (&storage_[index]) T(std::forward<Args>(args)...);
+#if ETCPAL_BUILDING_WITH_EXCEPTIONS
+  }
+  catch (...)
+  {
+    // Clear() and the destructor would otherwise destroy a T that was never constructed.
+    (void)etcpal_handle_table_free(&table_, handle);
+    throw;
+  }
+#endif
+  return Id(handle);
+}
+
+/// @brief Copy a resource into the table and allocate a handle for it.
+/// @return The handle for the new resource (success) or #kEtcPalErrNoMem (failure).
+template <class Id, class T>
+Expected<Id> HandleTable<Id, T>::Insert(const T& value)
+{
+  return Emplace(value);
+}
+
+/// @brief Move a resource into the table and allocate a handle for it.
+/// @return The handle for the new resource (success) or #kEtcPalErrNoMem (failure).
+template <class Id, class T>
+Expected<Id> HandleTable<Id, T>::Insert(T&& value)
+{
+  return Emplace(std::move(value));
+}
+
+/// @brief Find the resource associated with a handle.
+/// @return Pointer to the resource, or nullptr if the handle is invalid or stale.
+template <class Id, class T>
+T* HandleTable<Id, T>::Find(Id id) noexcept
+{
+  int index = etcpal_handle_table_lookup(&table_, id.value());
+  return (index >= 0) ? At(static_cast<size_t>(index)) : nullptr;
+}
+
+/// @brief Find the resource associated with a handle.
+/// @return Pointer to the resource, or nullptr if the handle is invalid or stale.
+template <class Id, class T>
+const T* HandleTable<Id, T>::Find(Id id) const noexcept
+{
+  int index = etcpal_handle_table_lookup(&table_, id.value());
+  return (index >= 0) ? At(static_cast<size_t>(index)) : nullptr;
+}
+
+/// @brief Determine whether a handle is currently allocated from this table.
+template <class Id, class T>
+bool HandleTable<Id, T>::Contains(Id id) const noexcept
+{
+  return etcpal_handle_table_lookup(&table_, id.value()) >= 0;
+}
+
+/// @brief Destroy the resource associated with a handle and free the handle.
+/// @return true if the resource was erased, false if the handle is invalid or stale.
+template <class Id, class T>
+bool HandleTable<Id, T>::Erase(Id id) noexcept
+{
+  int index = etcpal_handle_table_lookup(&table_, id.value());
+  if (index < 0)
+    return false;
+
+  At(static_cast<size_t>(index))->~T();
+  (void)etcpal_handle_table_free(&table_, id.value());
+  return true;
+}
+
+/// @brief Destroy all resources in the table and free their handles.
+template <class Id, class T>
+void HandleTable<Id, T>::Clear() noexcept
+{
+  for (size_t i = 0; i < etcpal_handle_table_capacity(&table_); ++i)
+  {
+    if (etcpal_handle_table_handle_at(&table_, i) >= 0)
+      At(i)->~T();
+  }
+  etcpal_handle_table_clear(&table_);
+}
+
+/// @brief Call a function for each resource in the table.
+///
+/// The table must not be modified while it is being iterated over.
+///
+/// @param func Function to call with each handle and resource, with the signature
+///             void(Id id, T& resource).
+template <class Id, class T>
+template <class Function>
+void HandleTable<Id, T>::ForEach(Function&& func)
+{
+  for (size_t i = 0; i < etcpal_handle_table_capacity(&table_); ++i)
+  {
+    int handle = etcpal_handle_table_handle_at(&table_, i);
+    if (handle >= 0)
+      func(Id(handle), *At(i));
+  }
+}
+
+/// @brief Get the number of resources in the table.
+template <class Id, class T>
+size_t HandleTable<Id, T>::size() const noexcept
+{
+  return etcpal_handle_table_size(&table_);
+}
+
+/// @brief Determine whether the table is empty.
+template <class Id, class T>
+bool HandleTable<Id, T>::empty() const noexcept
+{
+  return size() == 0;
+}
+
+/// @brief Get a reference to the underlying EtcPalHandleTable type.
+template <class Id, class T>
+EtcPalHandleTable& HandleTable<Id, T>::get() noexcept
+{
+  return table_;
+}
+
+/// @cond Internal helpers
+
+template <class Id, class T>
+T* HandleTable<Id, T>::At(size_t index) noexcept
+{
+  return reinterpret_cast<T*>(&storage_[index]);
+}
+
+template <class Id, class T>
+const T* HandleTable<Id, T>::At(size_t index) const noexcept
+{
+  return reinterpret_cast<const T*>(&storage_[index]);
+}
+
+/// @endcond
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_HANDLE_TABLE_H_
@@ -25,6 +25,7 @@
 
 #include <cstddef>
 #include <functional>
+#include "etcpal/hashmap.h"
 
 namespace etcpal
 {
@@ -55,6 +56,20 @@ inline void HashCombine(size_t& seed, const T& val)
   seed ^= hasher(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+/// @ingroup etcpal_cpp_hash
+/// @brief Hash an arbitrary sequence of bytes.
+///
+/// Uses etcpal_hash_bytes(), which is also used for keys in @ref etcpal_hashmap. Useful for
+/// hashing plain structures without padding bytes.
+///
+/// @param data The bytes to hash.
+/// @param size The number of bytes to hash.
+/// @return The hash of the data.
+inline size_t HashBytes(const void* data, size_t size) noexcept
+{
+  return static_cast<size_t>(etcpal_hash_bytes(data, size));
+}
+
 };  // namespace etcpal
 
 #endif /* ETCPAL_CPP_HASH_H_ */
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/hashmap.h
+/// @brief C++ wrapper and utilities for etcpal/hashmap.h
+
+#ifndef ETCPAL_CPP_HASHMAP_H_
+#define ETCPAL_CPP_HASHMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "etcpal/hashmap.h"
+#include "etcpal/cpp/common.h"
+#include "etcpal/cpp/error.h"
+#include "etcpal/cpp/hash.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_hashmap hashmap (Hash Maps)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_hashmap module.
+
+/// @ingroup etcpal_cpp_hashmap
+/// @brief A cache-friendly open-addressing hash map for trivially copyable keys and values.
+///
+/// Keys and values are stored by value in one contiguous array of slots; see @ref etcpal_hashmap
+/// for details. Unlike std::unordered_map, entries are not individually allocated, but inserting
+/// or erasing may move other entries, so pointers returned by Find() are only valid until the next
+/// modification.
+///
+/// Hash and KeyEqual must be stateless (default-constructible) function objects. std::hash
+/// specializations for EtcPalUuid, EtcPalIpAddr and EtcPalSockAddr are provided by
+/// etcpal/cpp/uuid.h and etcpal/cpp/inet.h.
+///
+/// The default constructor creates a map which allocates and grows its own storage. On targets
+/// without a heap, provide fixed storage instead:
+///
+/// @code
+/// using SourceMap = etcpal::FlatHashMap<EtcPalUuid, SourceState>;
+///
+/// alignas(8) static uint8_t source_storage[SourceMap::StorageSize(64)];
+/// SourceMap                 sources(source_storage, 64);
+///
+/// if (sources.Insert(cid, SourceState{}))
+/// {
+///   SourceState* state = sources.Find(cid);
+///   // ...
+/// }
+/// @endcode
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+{
+public:
+  static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                "FlatHashMap keys and values are copied with memcpy() and must be trivially copyable.");
+  static_assert(alignof(Key) <= 8 && alignof(Value) <= 8, "FlatHashMap slots are only aligned to 8 bytes.");
+
+  FlatHashMap() noexcept;
+  FlatHashMap(void* storage, size_t capacity) noexcept;
+  ~FlatHashMap();
+
+  FlatHashMap(const FlatHashMap& other) = delete;
+  FlatHashMap& operator=(const FlatHashMap& other) = delete;
+  FlatHashMap(FlatHashMap&& other)                 = delete;
+  FlatHashMap& operator=(FlatHashMap&& other) = delete;
+
+  static constexpr size_t StorageSize(size_t capacity) noexcept;
+
+  Error        Insert(const Key& key, const Value& value) noexcept;
+  Error        InsertOrAssign(const Key& key, const Value& value) noexcept;
+  Value*       Find(const Key& key) noexcept;
+  const Value* Find(const Key& key) const noexcept;
+  bool         Contains(const Key& key) const noexcept;
+  bool         Erase(const Key& key) noexcept;
+  void         Clear() noexcept;
+  Error        Reserve(size_t size) noexcept;
+
+  template <class Function>
+  void ForEach(Function&& func);
+
+  size_t size() const noexcept;
+  size_t capacity() const noexcept;
+  bool   empty() const noexcept;
+
+  EtcPalHashMap& get() noexcept;
+
+private:
+  static uint32_t HashKey(const void* key);
+  static bool     KeysEqual(const void* key_a, const void* key_b);
+
+  EtcPalHashMap map_{};
+};
+
+/// @brief Create an empty hash map which allocates and grows its own storage.
+///
+/// No memory is allocated until the first insertion or call to Reserve().
+template <class Key, class Value, class Hash, class KeyEqual>
+FlatHashMap<Key, Value, Hash, KeyEqual>::FlatHashMap() noexcept
+{
+  (void)etcpal_hashmap_init(&map_, sizeof(Key), sizeof(Value), HashKey, KeysEqual);
+}
+
+/// @brief Create an empty hash map which uses fixed storage and never allocates.
+/// @param storage Storage for the map, at least StorageSize(capacity) bytes and aligned to 8 bytes.
+///                Must remain valid for the lifetime of the map.
+/// @param capacity The number of slots in storage; the maximum number of entries.
+template <class Key, class Value, class Hash, class KeyEqual>
+FlatHashMap<Key, Value, Hash, KeyEqual>::FlatHashMap(void* storage, size_t capacity) noexcept
+{
+  (void)etcpal_hashmap_init_static(&map_, sizeof(Key), sizeof(Value), HashKey, KeysEqual, storage, capacity);
+}
+
+/// @brief Destroy the hash map, freeing its storage if it was allocated by the map.
+template <class Key, class Value, class Hash, class KeyEqual>
+FlatHashMap<Key, Value, Hash, KeyEqual>::~FlatHashMap()
+{
+  etcpal_hashmap_deinit(&map_);
+}
+
+/// @brief Get the size in bytes of the fixed storage required for a given number of slots.
+template <class Key, class Value, class Hash, class KeyEqual>
+constexpr size_t FlatHashMap<Key, Value, Hash, KeyEqual>::StorageSize(size_t capacity) noexcept
+{
+  return ETCPAL_HASHMAP_STORAGE_SIZE(capacity, sizeof(Key), sizeof(Value));
+}
+
+/// @brief Insert a new entry.
+/// @param key The key to insert.
+/// @param value The value to associate with the key.
+/// @return #kEtcPalErrOk: The entry was inserted.
+/// @return #kEtcPalErrExists: The key is already present; the existing value was not changed.
+/// @return #kEtcPalErrNoMem: The map is full (fixed storage) or could not grow.
+template <class Key, class Value, class Hash, class KeyEqual>
+Error FlatHashMap<Key, Value, Hash, KeyEqual>::Insert(const Key& key, const Value& value) noexcept
+{
+  return etcpal_hashmap_insert(&map_, &key, &value);
+}
+
+/// @brief Insert a new entry, or replace the value of an existing one.
+/// @param key The key to insert or update.
+/// @param value The value to associate with the key.
+/// @return #kEtcPalErrOk: The entry was inserted or updated.
+/// @return #kEtcPalErrNoMem: The map is full (fixed storage) or could not grow.
+template <class Key, class Value, class Hash, class KeyEqual>
+Error FlatHashMap<Key, Value, Hash, KeyEqual>::InsertOrAssign(const Key& key, const Value& value) noexcept
+{
+  Value* existing = Find(key);
+  if (existing)
+  {
+    *existing = value;
+    return kEtcPalErrOk;
+  }
+  return etcpal_hashmap_insert(&map_, &key, &value);
+}
+
+/// @brief Find the value associated with a key.
+/// @return Pointer to the value, or nullptr if the key is not present. Invalidated by the next
+///         insertion or removal.
+template <class Key, class Value, class Hash, class KeyEqual>
+Value* FlatHashMap<Key, Value, Hash, KeyEqual>::Find(const Key& key) noexcept
+{
+  return static_cast<Value*>(etcpal_hashmap_find(&map_, &key));
+}
+
+/// @brief Find the value associated with a key.
+/// @return Pointer to the value, or nullptr if the key is not present. Invalidated by the next
+///         insertion or removal.
+template <class Key, class Value, class Hash, class KeyEqual>
+const Value* FlatHashMap<Key, Value, Hash, KeyEqual>::Find(const Key& key) const noexcept
+{
+  return static_cast<const Value*>(etcpal_hashmap_find(&map_, &key));
+}
+
+/// @brief Whether the map contains an entry with the given key.
+template <class Key, class Value, class Hash, class KeyEqual>
+bool FlatHashMap<Key, Value, Hash, KeyEqual>::Contains(const Key& key) const noexcept
+{
+  return (Find(key) != nullptr);
+}
+
+/// @brief Remove the entry with the given key.
+/// @return Whether an entry was removed.
+template <class Key, class Value, class Hash, class KeyEqual>
+bool FlatHashMap<Key, Value, Hash, KeyEqual>::Erase(const Key& key) noexcept
+{
+  return (etcpal_hashmap_remove(&map_, &key) == kEtcPalErrOk);
+}
+
+/// @brief Remove all entries, keeping the storage.
+template <class Key, class Value, class Hash, class KeyEqual>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::Clear() noexcept
+{
+  etcpal_hashmap_clear(&map_);
+}
+
+/// @brief Make sure the map can hold a number of entries without growing.
+/// @return #kEtcPalErrOk: The map can hold size entries without allocating.
+/// @return #kEtcPalErrNoMem: Allocation failed, or the fixed storage is too small.
+template <class Key, class Value, class Hash, class KeyEqual>
+Error FlatHashMap<Key, Value, Hash, KeyEqual>::Reserve(size_t size) noexcept
+{
+  return etcpal_hashmap_reserve(&map_, size);
+}
+
+/// @brief Call a function for each entry in the map, in an unspecified order.
+///
+/// The function is called as `func(const Key& key, Value& value)`. It may modify the value, but
+/// must not insert into or erase from the map.
+template <class Key, class Value, class Hash, class KeyEqual>
+template <class Function>
+void FlatHashMap<Key, Value, Hash, KeyEqual>::ForEach(Function&& func)
+{
+  EtcPalHashMapIter iter;
+  etcpal_hashmap_iter_init(&iter, &map_);
+
+  const void* key   = nullptr;
+  void*       value = nullptr;
+  while (etcpal_hashmap_iter_next(&iter, &key, &value))
+    func(*static_cast<const Key*>(key), *static_cast<Value*>(value));
+}
+
+/// @brief Get the number of entries in the map.
+template <class Key, class Value, class Hash, class KeyEqual>
+size_t FlatHashMap<Key, Value, Hash, KeyEqual>::size() const noexcept
+{
+  return etcpal_hashmap_size(&map_);
+}
+
+/// @brief Get the number of slots in the map.
+template <class Key, class Value, class Hash, class KeyEqual>
+size_t FlatHashMap<Key, Value, Hash, KeyEqual>::capacity() const noexcept
+{
+  return etcpal_hashmap_capacity(&map_);
+}
+
+/// @brief Whether the map has no entries.
+template <class Key, class Value, class Hash, class KeyEqual>
+bool FlatHashMap<Key, Value, Hash, KeyEqual>::empty() const noexcept
+{
+  return (size() == 0);
+}
+
+/// @brief Get a reference to the underlying EtcPalHashMap type.
+template <class Key, class Value, class Hash, class KeyEqual>
+EtcPalHashMap& FlatHashMap<Key, Value, Hash, KeyEqual>::get() noexcept
+{
+  return map_;
+}
+
+/// @cond Internal hash map callbacks
+
+template <class Key, class Value, class Hash, class KeyEqual>
+uint32_t FlatHashMap<Key, Value, Hash, KeyEqual>::HashKey(const void* key)
+{
+  // Fold 64-bit hashes so that no bits are lost; the C module mixes the result further.
+  uint64_t hash = static_cast<uint64_t>(Hash{}(*static_cast<const Key*>(key)));
+  return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+template <class Key, class Value, class Hash, class KeyEqual>
+bool FlatHashMap<Key, Value, Hash, KeyEqual>::KeysEqual(const void* key_a, const void* key_b)
+{
+  return KeyEqual{}(*static_cast<const Key*>(key_a), *static_cast<const Key*>(key_b));
+}
+
+/// @endcond
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_HASHMAP_H_
@@ -1185,6 +1185,21 @@ struct hash<::etcpal::SockAddr>
   }
 };
 
+// std::hash specializations for the C EtcPalIpAddr and EtcPalSockAddr types, so that they can be
+// used directly as keys in hash-based containers, including etcpal::FlatHashMap. These are
+// consistent with the C comparison operators, which ignore the IPv6 scope ID.
+template <>
+struct hash<EtcPalIpAddr>
+{
+  std::size_t operator()(const EtcPalIpAddr& addr) const noexcept { return etcpal_ip_hash_key(&addr); }
+};
+
+template <>
+struct hash<EtcPalSockAddr>
+{
+  std::size_t operator()(const EtcPalSockAddr& addr) const noexcept { return etcpal_sockaddr_hash_key(&addr); }
+};
+
 template <>
 struct hash<::etcpal::MacAddr>
 {
@@ -23,18 +23,23 @@
 #ifndef ETCPAL_CPP_LOG_H_
 #define ETCPAL_CPP_LOG_H_
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <memory>
-#include <queue>
 #include <string>
 #include "etcpal/common.h"
 #include "etcpal/log.h"
 #include "etcpal/cpp/common.h"
-#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/signal.h"
+#include "etcpal/cpp/spsc_queue.h"
 #include "etcpal/cpp/thread.h"
 
 namespace etcpal
@@ -58,9 +63,10 @@ namespace etcpal
 /// {
 ///   etcpal::LogTimestamp GetLogTimestamp() override
 ///   {
-///     // Grab a timestamp from the local system and return it
+///     // Grab a timestamp from the local system and return it, e.g. with LogTimestamp::Now().
 ///     // This function can also be omitted if you can't easily obtain system time. No timestamps
 ///     // will be prepended to log messages in that case.
+///     return etcpal::LogTimestamp::Now();
 ///   }
 ///
 ///   void HandleLogMessage(const EtcPalLogStrings& strings) override
@@ -93,7 +99,9 @@ namespace etcpal
 ///         .SetSyslogProcId(0)
 ///         .Startup(log_handler);
 ///
-///   // By default, a background thread is started to dispatch the log messages.
+///   // By default, a background thread is started to dispatch the log messages. Messages are
+///   // formatted into a preallocated ring of slots; SetLogQueueCapacity() and SetOverflowPolicy()
+///   // control its size and what happens when it fills up.
 ///
 ///   logger.Log(ETCPAL_LOG_INFO, "Starting up!");
 ///
@@ -139,6 +147,7 @@ public:
   ETCPAL_CONSTEXPR_14 EtcPalLogTimestamp& get() noexcept;
 
   static LogTimestamp Invalid();
+  static LogTimestamp Now();
 
 private:
   EtcPalLogTimestamp timestamp_{};
@@ -189,6 +198,57 @@ inline LogTimestamp LogTimestamp::Invalid()
   return LogTimestamp{};
 }
 
+/// @brief Construct a timestamp representing the current local time.
+///
+/// Suitable for returning from LogMessageHandler::GetLogTimestamp(). Converting the system time to
+/// local calendar time is relatively expensive, so each thread caches the conversion and only
+/// redoes it when the time moves on to another second; within the same second, only the
+/// milliseconds are updated.
+inline LogTimestamp LogTimestamp::Now()
+{
+  struct LocalTimeCache
+  {
+    std::time_t  time{-1};
+    LogTimestamp timestamp;
+  };
+  static thread_local LocalTimeCache cache;
+
+  const auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  const auto time = static_cast<std::time_t>(since_epoch.count() / 1000);
+  const auto msec = static_cast<unsigned int>(since_epoch.count() % 1000);
+
+  if (time != cache.time)
+  {
+    std::tm local_tm{};
+    std::tm utc_tm{};
+#ifdef _WIN32
+    if (localtime_s(&local_tm, &time) != 0 || gmtime_s(&utc_tm, &time) != 0)
+      return LogTimestamp::Invalid();
+#else
+    if (!localtime_r(&time, &local_tm) || !gmtime_r(&time, &utc_tm))
+      return LogTimestamp::Invalid();
+#endif
+
+    // The local and UTC dates can differ by at most one day.
+    int day_diff = local_tm.tm_yday - utc_tm.tm_yday;
+    if (local_tm.tm_year != utc_tm.tm_year)
+      day_diff = (local_tm.tm_year > utc_tm.tm_year) ? 1 : -1;
+    const int utc_offset =
+        (day_diff * 24 * 60) + ((local_tm.tm_hour - utc_tm.tm_hour) * 60) + (local_tm.tm_min - utc_tm.tm_min);
+
+    cache.timestamp = LogTimestamp(
+        static_cast<unsigned int>(local_tm.tm_year + 1900), static_cast<unsigned int>(local_tm.tm_mon + 1),
+        static_cast<unsigned int>(local_tm.tm_mday), static_cast<unsigned int>(local_tm.tm_hour),
+        static_cast<unsigned int>(local_tm.tm_min), static_cast<unsigned int>(local_tm.tm_sec), 0, utc_offset);
+    cache.time = time;
+  }
+
+  LogTimestamp result = cache.timestamp;
+  result.get().msec   = msec;
+  return result;
+}
+
 /// @ingroup etcpal_cpp_log
 /// @brief An interface which handles log messages.
 ///
@@ -228,6 +288,659 @@ enum class LogDispatchPolicy
   kQueued   ///< Log messages are queued and dispatched from another thread (recommended)
 };
 
+/// @ingroup etcpal_cpp_log
+/// @brief Options for what the Logger does when its message queue is full.
+///
+/// Only relevant when the dispatch policy is LogDispatchPolicy::kQueued. Messages discarded due to
+/// either of the drop policies are counted; see Logger::dropped_message_count().
+enum class LogOverflowPolicy
+{
+  kDropNewest,  ///< The message being logged is discarded. Logging never blocks.
+  kDropOldest,  ///< The oldest queued message is discarded to make room. Logging never blocks.
+  kBlock        ///< The logging thread waits for the dispatch thread to make room (default)
+};
+
+/// @ingroup etcpal_cpp_log
+/// @brief Options for when the Logger formats queued log messages.
+///
+/// Only relevant when the dispatch policy is LogDispatchPolicy::kQueued.
+enum class LogFormatPolicy
+{
+  kImmediate,  ///< Messages are formatted by the thread that logs them (default)
+  kDeferred    ///< Only the arguments are captured by the logging thread; messages are formatted by the dispatch thread
+};
+
+/// @cond detail
+
+namespace detail
+{
+// Deferred log formatting: the arguments for a printf-style format string are captured into a
+// compact binary record, and formatted later on the log dispatch thread. Both sides walk the format
+// string the same way to agree on the type of each argument. Strings are copied into the record,
+// since the caller's buffer may not outlive the call.
+
+enum class LogArgType
+{
+  kNone,  // "%%"
+  kInt,
+  kLong,
+  kLongLong,
+  kIntMax,
+  kSize,
+  kPtrDiff,
+  kDouble,
+  kLongDouble,
+  kString,
+  kPointer,
+  kUnsupported
+};
+
+struct LogConversionSpec
+{
+  const char* end{nullptr};  // One past the conversion specifier character
+  LogArgType  type{LogArgType::kUnsupported};
+  bool        width_star{false};
+  bool        precision_star{false};
+  int         precision{-1};
+};
+
+// The longest conversion specification that will be formatted, including the null terminator and
+// room for each '*' to be replaced by a number.
+constexpr size_t kMaxLogConversionSpecLen = 48;
+constexpr size_t kMaxLogStarArgLen        = 11;
+
+// Parse the conversion specification starting at the '%' pointed to by spec.
+inline LogConversionSpec ParseLogConversionSpec(const char* spec) noexcept
+{
+  LogConversionSpec result;
+  const char*       p = spec + 1;
+  if (*p == '%')
+  {
+    result.end  = p + 1;
+    result.type = LogArgType::kNone;
+    return result;
+  }
+
+  while (*p != '\0' && std::strchr("-+ #0'", *p))
+    ++p;
+
+  if (*p == '*')
+  {
+    result.width_star = true;
+    ++p;
+  }
+  while (*p >= '0' && *p <= '9')
+    ++p;
+
+  if (*p == '.')
+  {
+    ++p;
+    if (*p == '*')
+    {
+      result.precision_star = true;
+      ++p;
+    }
+    else
+    {
+      result.precision = 0;
+      while (*p >= '0' && *p <= '9')
+        result.precision = result.precision * 10 + (*p++ - '0');
+    }
+  }
+
+  char length = '\0';
+  if (*p == 'h' || *p == 'l')
+  {
+    length = *p++;
+    if (*p == length)
+    {
+      // "hh" and "ll"
+      length = (length == 'h' ? 'H' : 'q');
+      ++p;
+    }
+  }
+  else if (*p != '\0' && std::strchr("jztL", *p))
+  {
+    length = *p++;
+  }
+
+  switch (*p)
+  {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+      switch (length)
+      {
+        case 'l':
+          result.type = LogArgType::kLong;
+          break;
+        case 'q':
+          result.type = LogArgType::kLongLong;
+          break;
+        case 'j':
+          result.type = LogArgType::kIntMax;
+          break;
+        case 'z':
+          result.type = LogArgType::kSize;
+          break;
+        case 't':
+          result.type = LogArgType::kPtrDiff;
+          break;
+        case 'L':
+          break;
+        default:
+          result.type = LogArgType::kInt;
+          break;
+      }
+      break;
+    case 'c':
+      if (length == '\0')
+        result.type = LogArgType::kInt;
+      break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      if (length == 'L')
+        result.type = LogArgType::kLongDouble;
+      else if (length == '\0' || length == 'l')
+        result.type = LogArgType::kDouble;
+      break;
+    case 's':
+      if (length == '\0')
+        result.type = LogArgType::kString;
+      break;
+    case 'p':
+      if (length == '\0')
+        result.type = LogArgType::kPointer;
+      break;
+    default:
+      // Includes %n, wide characters and strings, and the end of the format string.
+      break;
+  }
+
+  if (*p != '\0')
+    result.end = p + 1;
+  if (static_cast<size_t>(p - spec) + 2 + (2 * kMaxLogStarArgLen) > kMaxLogConversionSpecLen)
+    result.type = LogArgType::kUnsupported;
+  return result;
+}
+
+template <class T>
+bool PutLogArg(char* record, size_t record_size, size_t& pos, T value) noexcept
+{
+  if (record_size - pos < sizeof(T))
+    return false;
+  std::memcpy(&record[pos], &value, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+template <class T>
+T GetLogArg(const char* record, size_t& pos) noexcept
+{
+  T value;
+  std::memcpy(&value, &record[pos], sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+// Capture the arguments for format into record. Returns false if any argument can't be captured
+// (unsupported conversion, null string or insufficient space), in which case the message must be
+// formatted immediately instead.
+inline bool CaptureLogArgs(const char* format, std::va_list args, char* record, size_t record_size) noexcept
+{
+  size_t pos = 0;
+  for (const char* p = std::strchr(format, '%'); p; p = std::strchr(p, '%'))
+  {
+    LogConversionSpec spec = ParseLogConversionSpec(p);
+    if (spec.type == LogArgType::kUnsupported)
+      return false;
+    p = spec.end;
+
+    if (spec.width_star && !PutLogArg(record, record_size, pos, va_arg(args, int)))
+      return false;
+    if (spec.precision_star)
+    {
+      spec.precision = va_arg(args, int);
+      if (!PutLogArg(record, record_size, pos, spec.precision))
+        return false;
+    }
+
+    bool fits = true;
+    switch (spec.type)
+    {
+      case LogArgType::kInt:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, int));
+        break;
+      case LogArgType::kLong:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, long));
+        break;
+      case LogArgType::kLongLong:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, long long));
+        break;
+      case LogArgType::kIntMax:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, intmax_t));
+        break;
+      case LogArgType::kSize:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, size_t));
+        break;
+      case LogArgType::kPtrDiff:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, ptrdiff_t));
+        break;
+      case LogArgType::kDouble:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, double));
+        break;
+      case LogArgType::kLongDouble:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, long double));
+        break;
+      case LogArgType::kPointer:
+        fits = PutLogArg(record, record_size, pos, va_arg(args, void*));
+        break;
+      case LogArgType::kString: {
+        // A precision limits how much of the string may be read; it need not be null-terminated.
+        const char* str = va_arg(args, const char*);
+        if (!str)
+          return false;
+        size_t max_len = (spec.precision >= 0 ? static_cast<size_t>(spec.precision) : record_size);
+        size_t len     = 0;
+        while (len < max_len && str[len] != '\0' && pos + len < record_size)
+          ++len;
+        if (pos + len >= record_size)
+          return false;
+        std::memcpy(&record[pos], str, len);
+        record[pos + len] = '\0';
+        pos += len + 1;
+        break;
+      }
+      default:
+        break;
+    }
+    if (!fits)
+      return false;
+  }
+  return true;
+}
+
+// Format a message from a format string and the record previously captured by CaptureLogArgs().
+// The result is truncated to buf_size as if by snprintf().
+inline void FormatLogRecord(const char* format, const char* record, char* buf, size_t buf_size) noexcept
+{
+  size_t pos     = 0;
+  size_t written = 0;
+
+  auto append = [&](int res) {
+    if (res > 0)
+      written += std::min(static_cast<size_t>(res), buf_size - 1 - written);
+  };
+
+  const char* p = format;
+  while (*p != '\0' && written < buf_size - 1)
+  {
+    if (*p != '%')
+    {
+      buf[written++] = *p++;
+      continue;
+    }
+
+    LogConversionSpec spec = ParseLogConversionSpec(p);
+    if (spec.type == LogArgType::kNone)
+    {
+      buf[written++] = '%';
+      p              = spec.end;
+      continue;
+    }
+
+    // Rebuild the conversion specification with any '*' replaced by its captured value.
+    char   spec_str[kMaxLogConversionSpecLen];
+    size_t spec_len = 0;
+    for (const char* c = p; c < spec.end; ++c)
+    {
+      if (*c == '*')
+        spec_len += static_cast<size_t>(snprintf(&spec_str[spec_len], sizeof(spec_str) - spec_len, "%d",
+                                                 GetLogArg<int>(record, pos)));
+      else
+        spec_str[spec_len++] = *c;
+    }
+    spec_str[spec_len] = '\0';
+    p                  = spec.end;
+
+    char*  out       = &buf[written];
+    size_t remaining = buf_size - written;
+    switch (spec.type)
+    {
+      case LogArgType::kInt:
+        append(snprintf(out, remaining, spec_str, GetLogArg<int>(record, pos)));
+        break;
+      case LogArgType::kLong:
+        append(snprintf(out, remaining, spec_str, GetLogArg<long>(record, pos)));
+        break;
+      case LogArgType::kLongLong:
+        append(snprintf(out, remaining, spec_str, GetLogArg<long long>(record, pos)));
+        break;
+      case LogArgType::kIntMax:
+        append(snprintf(out, remaining, spec_str, GetLogArg<intmax_t>(record, pos)));
+        break;
+      case LogArgType::kSize:
+        append(snprintf(out, remaining, spec_str, GetLogArg<size_t>(record, pos)));
+        break;
+      case LogArgType::kPtrDiff:
+        append(snprintf(out, remaining, spec_str, GetLogArg<ptrdiff_t>(record, pos)));
+        break;
+      case LogArgType::kDouble:
+        append(snprintf(out, remaining, spec_str, GetLogArg<double>(record, pos)));
+        break;
+      case LogArgType::kLongDouble:
+        append(snprintf(out, remaining, spec_str, GetLogArg<long double>(record, pos)));
+        break;
+      case LogArgType::kPointer:
+        append(snprintf(out, remaining, spec_str, GetLogArg<void*>(record, pos)));
+        break;
+      case LogArgType::kString: {
+        const char* str = &record[pos];
+        pos += std::strlen(str) + 1;
+        append(snprintf(out, remaining, spec_str, str));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  buf[written] = '\0';
+}
+
+// The message queue used by the Logger when the dispatch policy is LogDispatchPolicy::kQueued.
+//
+// This is a fixed-capacity ring of preallocated message slots based on Dmitry Vyukov's bounded
+// MPMC queue. Each slot's sequence number tracks whether it is free, being written, ready to read
+// or being read, so that logging threads can format directly into a slot without allocating or
+// locking. Multiple consumers are supported so that logging threads can discard the oldest message
+// under LogOverflowPolicy::kDropOldest.
+class LogMessageQueue
+{
+public:
+  // If format is non-null, buf holds the arguments captured by CaptureLogArgs() rather than a
+  // formatted message.
+  struct Message
+  {
+    int                                          pri;
+    const char*                                  format;
+    std::array<char, ETCPAL_RAW_LOG_MSG_MAX_LEN> buf;
+  };
+
+  LogMessageQueue(size_t capacity, LogOverflowPolicy overflow_policy, LogFormatPolicy format_policy);
+
+  LogMessageQueue(const LogMessageQueue& other) = delete;
+  LogMessageQueue& operator=(const LogMessageQueue& other) = delete;
+  LogMessageQueue(LogMessageQueue&& other)                 = delete;
+  LogMessageQueue& operator=(LogMessageQueue&& other) = delete;
+
+  void Push(int pri, const char* format, std::va_list args) noexcept;
+  bool Pop(Message& msg) noexcept;
+  bool TryPop(Message& msg) noexcept;
+  void Close() noexcept;
+
+  size_t capacity() const noexcept;
+  size_t dropped_count() const noexcept;
+
+private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    Message             msg;
+  };
+
+  Message* ClaimWrite(size_t& pos) noexcept;
+  Message* ClaimWriteOnOverflow(size_t& pos) noexcept;
+  void     Publish(size_t pos) noexcept;
+  Message* ClaimRead(size_t& pos) noexcept;
+  void     Release(size_t pos) noexcept;
+  bool     DrainPop(Message& msg) noexcept;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t                  mask_{0};
+  LogOverflowPolicy       overflow_policy_;
+  LogFormatPolicy         format_policy_;
+  std::atomic<size_t>     num_dropped_{0};
+  std::atomic<size_t>     num_blocked_{0};
+  std::atomic<bool>       closed_{false};
+  ConsumerWaiter          consumer_waiter_;
+  Signal                  space_available_;
+
+  // head_ is advanced by the dispatch thread and tail_ by logging threads; keep them on separate
+  // cache lines.
+  char                pad1_[kCacheLineSize];
+  std::atomic<size_t> head_{0};
+  char                pad2_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail_{0};
+  std::atomic<size_t> num_published_{0};  // Compared with tail_ to find claimed, unpublished slots
+  char                pad3_[kCacheLineSize - 2 * sizeof(std::atomic<size_t>)];
+};
+
+// Capacity is rounded up to a power of 2 of at least 2, which the sequence numbering requires.
+inline LogMessageQueue::LogMessageQueue(size_t            capacity,
+                                        LogOverflowPolicy overflow_policy,
+                                        LogFormatPolicy   format_policy)
+    : overflow_policy_(overflow_policy), format_policy_(format_policy)
+{
+  size_t actual_capacity = 2;
+  while (actual_capacity < capacity)
+    actual_capacity <<= 1;
+
+  slots_ = std::make_unique<Slot[]>(actual_capacity);
+  mask_  = actual_capacity - 1;
+  for (size_t i = 0; i < actual_capacity; ++i)
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// Format a message (or capture its arguments) into the queue, applying the overflow policy if it
+// is full. Called from any number of logging threads.
+inline void LogMessageQueue::Push(int pri, const char* format, std::va_list args) noexcept
+{
+  size_t   pos = 0;
+  Message* msg = ClaimWrite(pos);
+  if (!msg)
+    msg = ClaimWriteOnOverflow(pos);
+  if (!msg)
+  {
+    num_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  msg->pri    = pri;
+  msg->format = nullptr;
+  if (format_policy_ == LogFormatPolicy::kDeferred)
+  {
+    std::va_list args_copy;
+    va_copy(args_copy, args);
+    if (CaptureLogArgs(format, args_copy, msg->buf.data(), ETCPAL_RAW_LOG_MSG_MAX_LEN))
+      msg->format = format;
+    va_end(args_copy);
+  }
+  if (!msg->format)
+    vsnprintf(msg->buf.data(), ETCPAL_RAW_LOG_MSG_MAX_LEN, format, args);
+  Publish(pos);
+  consumer_waiter_.NotifyIfWaiting();
+}
+
+// Wait for the next message. Returns false once the queue has been closed and no messages remain.
+// Called only from the dispatch thread.
+inline bool LogMessageQueue::Pop(Message& msg) noexcept
+{
+  bool got_msg = false;
+  consumer_waiter_.Wait(
+      [&]() {
+        got_msg = TryPop(msg);
+        return got_msg || closed_.load(std::memory_order_relaxed);
+      },
+      ETCPAL_WAIT_FOREVER);
+  return got_msg || DrainPop(msg);
+}
+
+// Copy out the oldest message without blocking.
+inline bool LogMessageQueue::TryPop(Message& msg) noexcept
+{
+  size_t   pos    = 0;
+  Message* queued = ClaimRead(pos);
+  if (!queued)
+    return false;
+
+  msg = *queued;
+  Release(pos);
+  return true;
+}
+
+// Wake the dispatch thread so it can drain the queue and exit, and release any logging threads
+// blocked under LogOverflowPolicy::kBlock.
+inline void LogMessageQueue::Close() noexcept
+{
+  closed_.store(true, std::memory_order_relaxed);
+  consumer_waiter_.NotifyIfWaiting();
+  space_available_.Notify();
+}
+
+inline size_t LogMessageQueue::capacity() const noexcept
+{
+  return mask_ + 1;
+}
+
+inline size_t LogMessageQueue::dropped_count() const noexcept
+{
+  return num_dropped_.load(std::memory_order_relaxed);
+}
+
+inline LogMessageQueue::Message* LogMessageQueue::ClaimWrite(size_t& pos) noexcept
+{
+  pos = tail_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot&    slot = slots_[pos & mask_];
+    intptr_t diff =
+        static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+    if (diff == 0)
+    {
+      if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return &slot.msg;
+    }
+    else if (diff < 0)
+    {
+      return nullptr;
+    }
+    else
+    {
+      pos = tail_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+inline LogMessageQueue::Message* LogMessageQueue::ClaimWriteOnOverflow(size_t& pos) noexcept
+{
+  switch (overflow_policy_)
+  {
+    case LogOverflowPolicy::kDropOldest: {
+      // If the oldest message is still being written or the dispatch thread wins the race for it,
+      // fall back to dropping this one rather than spinning.
+      size_t read_pos = 0;
+      if (ClaimRead(read_pos))
+      {
+        Release(read_pos);
+        num_dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return ClaimWrite(pos);
+    }
+    case LogOverflowPolicy::kBlock: {
+      Message* msg = nullptr;
+      num_blocked_.fetch_add(1);
+      while (!msg && !closed_.load(std::memory_order_relaxed))
+      {
+        msg = ClaimWrite(pos);
+        if (!msg)
+          space_available_.Wait();
+      }
+      // The signal coalesces notifications, so pass the wakeup on, in case more than one slot was
+      // freed or the queue was closed.
+      if (num_blocked_.fetch_sub(1) > 1)
+        space_available_.Notify();
+      return msg;
+    }
+    case LogOverflowPolicy::kDropNewest:
+    default:
+      return nullptr;
+  }
+}
+
+inline void LogMessageQueue::Publish(size_t pos) noexcept
+{
+  slots_[pos & mask_].sequence.store(pos + 1, std::memory_order_release);
+  num_published_.fetch_add(1, std::memory_order_release);
+}
+
+inline LogMessageQueue::Message* LogMessageQueue::ClaimRead(size_t& pos) noexcept
+{
+  pos = head_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot&    slot = slots_[pos & mask_];
+    intptr_t diff =
+        static_cast<intptr_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0)
+    {
+      if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return &slot.msg;
+    }
+    else if (diff < 0)
+    {
+      return nullptr;
+    }
+    else
+    {
+      pos = head_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+// Pop a message once the queue has been closed. A logging thread may have claimed a slot but not
+// yet published its message, so keep going until every claimed slot has been published and popped.
+inline bool LogMessageQueue::DrainPop(Message& msg) noexcept
+{
+  for (;;)
+  {
+    if (TryPop(msg))
+      return true;
+
+    // The published count is read first; if it still equals the claimed count afterward, every
+    // slot claimed up to that point has been published.
+    size_t published = num_published_.load(std::memory_order_acquire);
+    if (published == tail_.load(std::memory_order_acquire))
+      return TryPop(msg);
+
+    Thread::Sleep(1);
+  }
+}
+
+inline void LogMessageQueue::Release(size_t pos) noexcept
+{
+  slots_[pos & mask_].sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+  // Pairs with the increment of num_blocked_ in ClaimWriteOnOverflow(), so that either a blocked
+  // logging thread sees the free slot or we see that it is waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_blocked_.load(std::memory_order_relaxed) > 0)
+    space_available_.Notify();
+}
+}  // namespace detail
+
+/// @endcond
+
 /// @ingroup etcpal_cpp_log
 /// @brief A class for dispatching log messages.
 ///
@@ -259,6 +972,10 @@ public:
   /// @name Getters
   /// @{
   LogDispatchPolicy      dispatch_policy() const noexcept;
+  LogOverflowPolicy      overflow_policy() const noexcept;
+  LogFormatPolicy        format_policy() const noexcept;
+  size_t                 log_queue_capacity() const noexcept;
+  size_t                 dropped_message_count() const noexcept;
   int                    log_mask() const noexcept;
   int                    log_action() const noexcept;
   int                    syslog_facility() const noexcept;
@@ -271,6 +988,9 @@ public:
   /// @name Setters
   /// @{
   Logger& SetDispatchPolicy(LogDispatchPolicy new_policy) noexcept;
+  Logger& SetOverflowPolicy(LogOverflowPolicy new_policy) noexcept;
+  Logger& SetFormatPolicy(LogFormatPolicy new_policy) noexcept;
+  Logger& SetLogQueueCapacity(size_t capacity) noexcept;
   Logger& SetLogMask(int log_mask) noexcept;
   Logger& SetLogAction(int log_action) noexcept;
   Logger& SetSyslogFacility(int facility) noexcept;
@@ -292,26 +1012,17 @@ public:
 private:
   void LogInternal(int pri, const char* format, std::va_list args);
   void LogThreadRun();
-  void EmptyLogQueue();
 
   LogDispatchPolicy dispatch_policy_{LogDispatchPolicy::kQueued};
+  LogOverflowPolicy overflow_policy_{LogOverflowPolicy::kBlock};
+  LogFormatPolicy   format_policy_{LogFormatPolicy::kImmediate};
+  size_t            queue_capacity_{128};
   EtcPalLogParams   log_params_{};
 
-  struct LogMessage
-  {
-    int                                          pri;
-    std::array<char, ETCPAL_RAW_LOG_MSG_MAX_LEN> buf;
-  };
-
   // Used when dispatch_policy_ == Queued
-  // This implementation will become more elegant with the addition of new queue APIs. This is
-  // being tracked with ETCPAL-43 and ETCPAL-46.
-  std::queue<LogMessage>          msg_q_;
-  std::unique_ptr<etcpal::Signal> signal_;
-  std::unique_ptr<etcpal::Signal> stop_signal_;
-  std::unique_ptr<etcpal::Mutex>  mutex_;
-  etcpal::Thread                  thread_;
-  bool                            initialized_{false};
+  std::unique_ptr<detail::LogMessageQueue> msg_q_;
+  etcpal::Thread                           thread_;
+  bool                                     initialized_{false};
 };
 
 /// @cond Internal log callback functions
@@ -361,23 +1072,25 @@ inline bool Logger::Startup(LogMessageHandler& message_handler)
     return false;
   }
 
-  signal_      = std::make_unique<etcpal::Signal>();
-  stop_signal_ = std::make_unique<etcpal::Signal>();
-  mutex_       = std::make_unique<etcpal::Mutex>();
-
-  if (!signal_ || !stop_signal_ || !mutex_)
-  {
-    etcpal_deinit(ETCPAL_FEATURE_LOGGING);
-    return false;
-  }
-
   log_params_.context = &message_handler;
-  initialized_        = true;
 
   if (dispatch_policy_ == LogDispatchPolicy::kDirect)
+  {
+    msg_q_.reset();
+    initialized_ = true;
     return true;
+  }
 
   // kQueued
+  // All message storage is allocated up front, so that logging never allocates.
+  msg_q_ = std::make_unique<detail::LogMessageQueue>(queue_capacity_, overflow_policy_, format_policy_);
+  if (!msg_q_)
+  {
+    etcpal_deinit(ETCPAL_FEATURE_LOGGING);
+    return false;
+  }
+  initialized_ = true;
+
   // Start the log dispatch thread
   if (!thread_.SetName("EtcPalLoggerThread").Start(&Logger::LogThreadRun, this))
   {
@@ -397,10 +1110,9 @@ inline void Logger::Shutdown()
   if (initialized_)
   {
     initialized_ = false;
-    stop_signal_->Notify();
     if (dispatch_policy_ == LogDispatchPolicy::kQueued)
     {
-      signal_->Notify();
+      msg_q_->Close();
       thread_.Join();
     }
     etcpal_deinit(ETCPAL_FEATURE_LOGGING);
@@ -509,6 +1221,37 @@ inline LogDispatchPolicy Logger::dispatch_policy() const noexcept
   return dispatch_policy_;
 }
 
+/// @brief Get the current log queue overflow policy.
+inline LogOverflowPolicy Logger::overflow_policy() const noexcept
+{
+  return overflow_policy_;
+}
+
+/// @brief Get the current log message format policy.
+inline LogFormatPolicy Logger::format_policy() const noexcept
+{
+  return format_policy_;
+}
+
+/// @brief Get the number of message slots in the log queue.
+///
+/// If the logger has been started with LogDispatchPolicy::kQueued, this is the actual capacity
+/// allocated, which may have been rounded up from the value passed to SetLogQueueCapacity().
+inline size_t Logger::log_queue_capacity() const noexcept
+{
+  return msg_q_ ? msg_q_->capacity() : queue_capacity_;
+}
+
+/// @brief Get the number of log messages discarded because the log queue was full.
+///
+/// Counts messages discarded since the last call to Startup() under LogOverflowPolicy::kDropNewest
+/// or LogOverflowPolicy::kDropOldest, or under LogOverflowPolicy::kBlock by threads which were
+/// still waiting for room when the logger was shut down.
+inline size_t Logger::dropped_message_count() const noexcept
+{
+  return msg_q_ ? msg_q_->dropped_count() : 0;
+}
+
 /// @brief Get the current log mask.
 inline int Logger::log_mask() const noexcept
 {
@@ -566,6 +1309,52 @@ inline Logger& Logger::SetDispatchPolicy(LogDispatchPolicy new_policy) noexcept
   return *this;
 }
 
+/// @brief Change what happens when a message is logged while the log queue is full.
+///
+/// Only has any effect if the logger has not been started yet, and the dispatch policy is
+/// LogDispatchPolicy::kQueued. Threads which must never block or contend on a lock while logging,
+/// such as real-time output threads, should use LogOverflowPolicy::kDropNewest or
+/// LogOverflowPolicy::kDropOldest.
+///
+/// @param new_policy The new overflow policy.
+inline Logger& Logger::SetOverflowPolicy(LogOverflowPolicy new_policy) noexcept
+{
+  overflow_policy_ = new_policy;
+  return *this;
+}
+
+/// @brief Change when queued log messages are formatted.
+///
+/// Only has any effect if the logger has not been started yet, and the dispatch policy is
+/// LogDispatchPolicy::kQueued.
+///
+/// With LogFormatPolicy::kDeferred, logging a message only captures a pointer to the format string
+/// and a copy of its arguments; formatting happens on the dispatch thread, along with
+/// timestamping and header construction. String arguments are copied, but **the format string
+/// itself must remain valid until the message is dispatched** - in practice, it should be a string
+/// literal. Messages with arguments that can't be captured (e.g. %%n, wide strings, null string
+/// pointers, or too much argument data to fit in a log message) are formatted immediately instead.
+///
+/// @param new_policy The new format policy.
+inline Logger& Logger::SetFormatPolicy(LogFormatPolicy new_policy) noexcept
+{
+  format_policy_ = new_policy;
+  return *this;
+}
+
+/// @brief Change the number of messages the log queue can hold.
+///
+/// Only has any effect if the logger has not been started yet, and the dispatch policy is
+/// LogDispatchPolicy::kQueued. Storage for all messages is allocated by Startup(). The capacity is
+/// rounded up to a power of 2; the default is 128.
+///
+/// @param capacity The new log queue capacity.
+inline Logger& Logger::SetLogQueueCapacity(size_t capacity) noexcept
+{
+  queue_capacity_ = capacity;
+  return *this;
+}
+
 /// @brief Set a new log mask.
 ///
 /// Use the ETCPAL_LOG_UPTO() macro to create a mask up to and including a priority level. For
@@ -702,40 +1491,27 @@ inline void Logger::LogInternal(int pri, const char* format, std::va_list args)
     }
     else
     {
-      {
-        etcpal::MutexGuard lock(*mutex_);
-        msg_q_.emplace();
-        msg_q_.back().pri = pri;
-        vsnprintf(msg_q_.back().buf.data(), ETCPAL_RAW_LOG_MSG_MAX_LEN, format, args);
-      }
-      signal_->Notify();
+      msg_q_->Push(pri, format, args);
     }
   }
 }
 
 inline void Logger::LogThreadRun()
 {
-  while (!stop_signal_->TryWait())
-  {
-    EmptyLogQueue();
-    signal_->Wait();
-  }
-  // Bail the queue one last time on exit
-  EmptyLogQueue();
-}
-
-inline void Logger::EmptyLogQueue()
-{
-  std::queue<LogMessage> to_log;
+  // Pop() drains the rest of the queue after Shutdown() before returning false.
+  detail::LogMessageQueue::Message              msg;
+  std::array<char, ETCPAL_RAW_LOG_MSG_MAX_LEN> formatted;
+  while (msg_q_->Pop(msg))
   {
-    etcpal::MutexGuard lock(*mutex_);
-    to_log.swap(msg_q_);
-  }
-
-  while (!to_log.empty())
-  {
-    etcpal_log(&log_params_, to_log.front().pri, "%s", to_log.front().buf.data());
-    to_log.pop();
+    if (msg.format)
+    {
+      detail::FormatLogRecord(msg.format, msg.buf.data(), formatted.data(), formatted.size());
+      etcpal_log(&log_params_, msg.pri, "%s", formatted.data());
+    }
+    else
+    {
+      etcpal_log(&log_params_, msg.pri, "%s", msg.buf.data());
+    }
   }
 }
 
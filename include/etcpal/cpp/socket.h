@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/socket.h
+/// @brief C++ wrapper and utilities for etcpal/socket.h
+
+#ifndef ETCPAL_CPP_SOCKET_H_
+#define ETCPAL_CPP_SOCKET_H_
+
+#include <array>
+#include <cstddef>
+#include "etcpal/socket.h"
+#include "etcpal/cpp/common.h"
+#include "etcpal/cpp/error.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_socket socket (Network Socket Interface)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_socket module.
+///
+/// **WARNING:** This module must be explicitly initialized before use. Initialize the module by
+/// calling etcpal_init() with the relevant feature mask:
+/// @code
+/// etcpal_init(ETCPAL_FEATURE_SOCKETS);
+/// @endcode
+///
+/// Currently provides a wrapper for the etcpal_poll API.
+
+/// @ingroup etcpal_cpp_socket
+/// @brief A wrapper class for the EtcPal poll context type.
+///
+/// Example usage:
+/// @code
+/// etcpal::PollContext context;
+/// context.AddSocket(sock_1, ETCPAL_POLL_IN);
+/// context.AddSocket(sock_2, ETCPAL_POLL_IN);
+///
+/// std::array<EtcPalPollEvent, 16> events;
+/// auto num_events = context.WaitMany(events, 100);
+/// if (num_events)
+/// {
+///   for (size_t i = 0; i < *num_events; ++i)
+///   {
+///     // Handle activity on events[i].socket
+///   }
+/// }
+/// @endcode
+///
+/// See @ref etcpal_socket for more information.
+class PollContext
+{
+public:
+  PollContext();
+  explicit PollContext(bool multithreaded);
+  ~PollContext();
+
+  PollContext(const PollContext& other) = delete;
+  PollContext& operator=(const PollContext& other) = delete;
+  PollContext(PollContext&& other)                 = delete;
+  PollContext& operator=(PollContext&& other) = delete;
+
+  Error AddSocket(etcpal_socket_t socket, etcpal_poll_events_t events, void* user_data = nullptr) noexcept;
+  Error ModifySocket(etcpal_socket_t socket, etcpal_poll_events_t new_events, void* new_user_data = nullptr) noexcept;
+  Error RearmSocket(etcpal_socket_t socket) noexcept;
+  void  RemoveSocket(etcpal_socket_t socket) noexcept;
+
+  Expected<etcpal_poll_timer_t> AddTimer(uint32_t timeout_ms,
+                                         uint32_t interval_ms = 0,
+                                         void*    user_data   = nullptr) noexcept;
+  Error ResetTimer(etcpal_poll_timer_t timer, uint32_t timeout_ms, uint32_t interval_ms = 0) noexcept;
+  void  RemoveTimer(etcpal_poll_timer_t timer) noexcept;
+
+  Error AddWakeup(void* user_data = nullptr) noexcept;
+  Error Wakeup() noexcept;
+  void  RemoveWakeup() noexcept;
+
+  Expected<EtcPalPollEvent> Wait(int timeout_ms = ETCPAL_WAIT_FOREVER) noexcept;
+  Expected<size_t>          WaitMany(EtcPalPollEvent* events,
+                                     size_t           max_events,
+                                     int              timeout_ms = ETCPAL_WAIT_FOREVER) noexcept;
+  template <size_t N>
+  Expected<size_t> WaitMany(std::array<EtcPalPollEvent, N>& events, int timeout_ms = ETCPAL_WAIT_FOREVER) noexcept;
+
+  EtcPalPollContext& get();
+
+private:
+  EtcPalPollContext context_{};
+};
+
+/// @brief Create a new poll context.
+inline PollContext::PollContext()
+{
+  (void)etcpal_poll_context_init(&context_);
+}
+
+/// @brief Create a new poll context, optionally one that multiple threads can wait on at once.
+///
+/// See etcpal_poll_context_init_multithreaded(). On platforms which do not support multithreaded
+/// contexts, creating one leaves the context invalid, and all operations on it fail with
+/// #kEtcPalErrInvalid.
+///
+/// @param multithreaded Whether to create the context with etcpal_poll_context_init_multithreaded().
+inline PollContext::PollContext(bool multithreaded)
+{
+  if (multithreaded)
+    (void)etcpal_poll_context_init_multithreaded(&context_);
+  else
+    (void)etcpal_poll_context_init(&context_);
+}
+
+/// @brief Destroy the poll context.
+inline PollContext::~PollContext()
+{
+  etcpal_poll_context_deinit(&context_);
+}
+
+/// @brief Add a new socket to the poll context.
+///
+/// See etcpal_poll_add_socket().
+///
+/// @param socket Socket to start monitoring.
+/// @param events Events to monitor for on this socket.
+/// @param user_data Opaque data pointer that is passed back with events on this socket.
+/// @return The result of etcpal_poll_add_socket() on the underlying context.
+inline Error PollContext::AddSocket(etcpal_socket_t socket, etcpal_poll_events_t events, void* user_data) noexcept
+{
+  return etcpal_poll_add_socket(&context_, socket, events, user_data);
+}
+
+/// @brief Change the set of events or user data associated with a monitored socket.
+///
+/// See etcpal_poll_modify_socket().
+///
+/// @param socket Socket to modify.
+/// @param new_events New set of events to monitor for on this socket.
+/// @param new_user_data New opaque data pointer that is passed back with events on this socket.
+/// @return The result of etcpal_poll_modify_socket() on the underlying context.
+inline Error PollContext::ModifySocket(etcpal_socket_t      socket,
+                                       etcpal_poll_events_t new_events,
+                                       void*                new_user_data) noexcept
+{
+  return etcpal_poll_modify_socket(&context_, socket, new_events, new_user_data);
+}
+
+/// @brief Re-enable event reporting on a socket after an event on it has been handled.
+///
+/// See etcpal_poll_rearm_socket().
+///
+/// @param socket Socket to rearm.
+/// @return The result of etcpal_poll_rearm_socket() on the underlying context.
+inline Error PollContext::RearmSocket(etcpal_socket_t socket) noexcept
+{
+  return etcpal_poll_rearm_socket(&context_, socket);
+}
+
+/// @brief Remove a monitored socket from the poll context.
+/// @param socket Socket to remove.
+inline void PollContext::RemoveSocket(etcpal_socket_t socket) noexcept
+{
+  etcpal_poll_remove_socket(&context_, socket);
+}
+
+/// @brief Add a timer to the poll context.
+///
+/// See etcpal_poll_add_timer().
+///
+/// @param timeout_ms Time until the timer first expires, in milliseconds.
+/// @param interval_ms Time between subsequent expirations, in milliseconds; 0 for a one-shot timer.
+/// @param user_data Opaque data pointer that is passed back with events on this timer.
+/// @return The new timer (success) or the error returned by etcpal_poll_add_timer() (failure).
+inline Expected<etcpal_poll_timer_t> PollContext::AddTimer(uint32_t timeout_ms,
+                                                           uint32_t interval_ms,
+                                                           void*    user_data) noexcept
+{
+  etcpal_poll_timer_t timer = ETCPAL_POLL_TIMER_INVALID;
+  auto                res   = etcpal_poll_add_timer(&context_, timeout_ms, interval_ms, user_data, &timer);
+  if (res == kEtcPalErrOk)
+    return timer;
+  return res;
+}
+
+/// @brief Restart a timer in the poll context with a new timeout and interval.
+///
+/// See etcpal_poll_reset_timer().
+///
+/// @param timer Timer to restart.
+/// @param timeout_ms Time until the timer next expires, in milliseconds.
+/// @param interval_ms Time between subsequent expirations, in milliseconds; 0 for a one-shot timer.
+/// @return The result of etcpal_poll_reset_timer() on the underlying context.
+inline Error PollContext::ResetTimer(etcpal_poll_timer_t timer, uint32_t timeout_ms, uint32_t interval_ms) noexcept
+{
+  return etcpal_poll_reset_timer(&context_, timer, timeout_ms, interval_ms);
+}
+
+/// @brief Remove a timer from the poll context.
+/// @param timer Timer to remove.
+inline void PollContext::RemoveTimer(etcpal_poll_timer_t timer) noexcept
+{
+  etcpal_poll_remove_timer(&context_, timer);
+}
+
+/// @brief Enable waking up threads waiting on the poll context with Wakeup().
+///
+/// See etcpal_poll_add_wakeup().
+///
+/// @param user_data Opaque data pointer that is passed back with wakeup events.
+/// @return The result of etcpal_poll_add_wakeup() on the underlying context.
+inline Error PollContext::AddWakeup(void* user_data) noexcept
+{
+  return etcpal_poll_add_wakeup(&context_, user_data);
+}
+
+/// @brief Wake up a thread waiting on the poll context. Safe to call from any thread.
+///
+/// See etcpal_poll_wakeup().
+///
+/// @return The result of etcpal_poll_wakeup() on the underlying context.
+inline Error PollContext::Wakeup() noexcept
+{
+  return etcpal_poll_wakeup(&context_);
+}
+
+/// @brief Stop monitoring for wakeups on the poll context.
+inline void PollContext::RemoveWakeup() noexcept
+{
+  etcpal_poll_remove_wakeup(&context_);
+}
+
+/// @brief Wait for an event on the set of monitored sockets.
+///
+/// See etcpal_poll_wait().
+///
+/// @param timeout_ms How long to wait for an event, in milliseconds.
+/// @return The event that occurred (success) or the error returned by etcpal_poll_wait() (failure).
+inline Expected<EtcPalPollEvent> PollContext::Wait(int timeout_ms) noexcept
+{
+  EtcPalPollEvent event{};
+  auto            res = etcpal_poll_wait(&context_, &event, timeout_ms);
+  if (res == kEtcPalErrOk)
+    return event;
+  return res;
+}
+
+/// @brief Wait for events on the set of monitored sockets, retrieving multiple events at once.
+///
+/// See etcpal_poll_wait_many().
+///
+/// @param events Array of events to fill in.
+/// @param max_events Size of the events array.
+/// @param timeout_ms How long to wait for an event, in milliseconds.
+/// @return The number of events filled in (success) or the error returned by
+///         etcpal_poll_wait_many() (failure).
+inline Expected<size_t> PollContext::WaitMany(EtcPalPollEvent* events, size_t max_events, int timeout_ms) noexcept
+{
+  int res = etcpal_poll_wait_many(&context_, events, max_events, timeout_ms);
+  if (res > 0)
+    return static_cast<size_t>(res);
+  return static_cast<etcpal_error_t>(res);
+}
+
+/// @brief Wait for events on the set of monitored sockets, filling in a std::array of events.
+/// @param events Array of events to fill in.
+/// @param timeout_ms How long to wait for an event, in milliseconds.
+/// @return The number of events filled in (success) or the error returned by
+///         etcpal_poll_wait_many() (failure).
+template <size_t N>
+Expected<size_t> PollContext::WaitMany(std::array<EtcPalPollEvent, N>& events, int timeout_ms) noexcept
+{
+  return WaitMany(events.data(), N, timeout_ms);
+}
+
+/// @brief Get a reference to the underlying EtcPalPollContext type.
+inline EtcPalPollContext& PollContext::get()
+{
+  return context_;
+}
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_SOCKET_H_
@@ -0,0 +1,404 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/spsc_queue.h
+/// @brief C++ wrapper and utilities for etcpal/spsc_queue.h
+
+#ifndef ETCPAL_CPP_SPSC_QUEUE_H_
+#define ETCPAL_CPP_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "etcpal/common.h"
+#include "etcpal/spsc_queue.h"
+#include "etcpal/timer.h"
+#include "etcpal/cpp/common.h"
+#include "etcpal/cpp/signal.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_spsc_queue spsc_queue (Lock-Free Queues)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_spsc_queue module.
+///
+/// Provides the template classes SpscQueue (single producer, single consumer) and MpscQueue
+/// (multiple producers, single consumer). These are fixed-capacity lock-free queues with storage
+/// for N items of type T contained in the object itself; N must be a power of 2.
+///
+/// @code
+/// #include "etcpal/cpp/spsc_queue.h"
+///
+/// struct Packet
+/// {
+///   size_t  len;
+///   uint8_t data[1500];
+/// };
+///
+/// etcpal::SpscQueue<Packet, 64> queue;
+///
+/// // On the network receive thread
+/// Packet packet;
+/// if (!queue.TryPush(packet))
+/// {
+///   // Queue is full, packet dropped
+/// }
+///
+/// // On the worker thread
+/// Packet received;
+/// if (queue.Pop(received)) // Blocks until a packet is available
+/// {
+///   // Handle packet
+/// }
+/// @endcode
+///
+/// TryPush() and TryPop() never block. Pop() can optionally block the consumer until an item is
+/// available; producers only touch the underlying etcpal::Signal when the consumer is actually
+/// waiting.
+///
+/// **NOTE**: Timeouts other than 0 or ETCPAL_WAIT_FOREVER passed to Pop() are only honored on
+/// platforms where #ETCPAL_SIGNAL_HAS_TIMED_WAIT is 1. See @ref etcpal_signal for details.
+
+namespace detail
+{
+/// Implements the optional blocking wait for the consumer of a lock-free queue.
+class ConsumerWaiter
+{
+public:
+  void NotifyIfWaiting() noexcept;
+  template <class TryPopFunc>
+  bool Wait(TryPopFunc try_pop, int timeout_ms) noexcept;
+
+private:
+  std::atomic<bool> waiting_{false};
+  Signal            signal_;
+};
+
+// Called by producers after an item has been pushed.
+inline void ConsumerWaiter::NotifyIfWaiting() noexcept
+{
+  // Pairs with the fence in Wait(), so that either the consumer sees our item or we see its flag.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed) && waiting_.exchange(false))
+    signal_.Notify();
+}
+
+// Called by the consumer. try_pop is called repeatedly until it succeeds or the timeout expires.
+template <class TryPopFunc>
+bool ConsumerWaiter::Wait(TryPopFunc try_pop, int timeout_ms) noexcept
+{
+  if (try_pop())
+    return true;
+  if (timeout_ms == 0)
+    return false;
+
+  uint32_t start_time   = etcpal_getms();
+  int      remaining_ms = timeout_ms;
+  for (;;)
+  {
+    waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (try_pop())
+    {
+      waiting_.store(false, std::memory_order_relaxed);
+      return true;
+    }
+
+    bool notified = signal_.TryWait(remaining_ms);
+    waiting_.store(false, std::memory_order_relaxed);
+    if (try_pop())
+      return true;
+    if (!notified)
+      return false;
+
+    if (timeout_ms != ETCPAL_WAIT_FOREVER)
+    {
+      uint32_t elapsed = etcpal_getms() - start_time;
+      if (elapsed >= static_cast<uint32_t>(timeout_ms))
+        return false;
+      remaining_ms = timeout_ms - static_cast<int>(elapsed);
+    }
+  }
+}
+
+inline int ClampTimeoutMs(std::chrono::milliseconds timeout) noexcept
+{
+  return static_cast<int>(
+      std::min(timeout.count(), static_cast<std::chrono::milliseconds::rep>(std::numeric_limits<int>::max())));
+}
+}  // namespace detail
+
+/// @ingroup etcpal_cpp_spsc_queue
+/// @brief A lock-free queue with a single producer thread and a single consumer thread.
+///
+/// See the module description for @ref etcpal_cpp_spsc_queue for usage information.
+template <class T, size_t N>
+class SpscQueue
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Type T in etcpal::SpscQueue<T, N> must be trivially copyable.");
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity N in etcpal::SpscQueue<T, N> must be a power of 2.");
+
+public:
+  SpscQueue() noexcept;
+
+  SpscQueue(const SpscQueue& other) = delete;
+  SpscQueue& operator=(const SpscQueue& other) = delete;
+  SpscQueue(SpscQueue&& other)                 = delete;
+  SpscQueue& operator=(SpscQueue&& other) = delete;
+
+  bool TryPush(const T& item) noexcept;
+  bool TryPop(T& item) noexcept;
+  bool Pop(T& item, int timeout_ms = ETCPAL_WAIT_FOREVER) noexcept;
+  template <class Rep, class Period>
+  bool Pop(T& item, const std::chrono::duration<Rep, Period>& timeout) noexcept;
+
+  size_t                  Size() const noexcept;
+  bool                    IsEmpty() const noexcept;
+  static constexpr size_t Capacity() noexcept;
+
+  EtcPalSpscQueue& get() noexcept;
+
+private:
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+  EtcPalSpscQueue                                                 queue_{};
+  detail::ConsumerWaiter                                          waiter_;
+};
+
+/// @brief Create a new, empty queue.
+template <class T, size_t N>
+inline SpscQueue<T, N>::SpscQueue() noexcept
+{
+  (void)etcpal_spsc_queue_init(&queue_, &buffer_, sizeof(T), N);
+}
+
+/// @brief Add an item to the queue without blocking.
+///
+/// Must only be called from the producer thread. Wakes the consumer if it is blocked in Pop().
+///
+/// @param item The item to add.
+/// @return true if the item was added, false if the queue was full.
+template <class T, size_t N>
+inline bool SpscQueue<T, N>::TryPush(const T& item) noexcept
+{
+  if (!etcpal_spsc_queue_try_push(&queue_, &item))
+    return false;
+  waiter_.NotifyIfWaiting();
+  return true;
+}
+
+/// @brief Remove the oldest item from the queue without blocking.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @return true if an item was removed, false if the queue was empty.
+template <class T, size_t N>
+inline bool SpscQueue<T, N>::TryPop(T& item) noexcept
+{
+  return etcpal_spsc_queue_try_pop(&queue_, &item);
+}
+
+/// @brief Remove the oldest item from the queue, waiting for one to become available.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @param timeout_ms How long to wait for an item, in milliseconds.
+/// @return true if an item was removed, false if the timeout expired.
+template <class T, size_t N>
+inline bool SpscQueue<T, N>::Pop(T& item, int timeout_ms) noexcept
+{
+  return waiter_.Wait([&]() { return TryPop(item); }, timeout_ms);
+}
+
+/// @brief Remove the oldest item from the queue, waiting for one to become available.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @param timeout How long to wait for an item.
+/// @return true if an item was removed, false if the timeout expired.
+template <class T, size_t N>
+template <class Rep, class Period>
+inline bool SpscQueue<T, N>::Pop(T& item, const std::chrono::duration<Rep, Period>& timeout) noexcept
+{
+  return Pop(item, detail::ClampTimeoutMs(std::chrono::duration_cast<std::chrono::milliseconds>(timeout)));
+}
+
+/// @brief Get the number of items currently in the queue.
+template <class T, size_t N>
+inline size_t SpscQueue<T, N>::Size() const noexcept
+{
+  return etcpal_spsc_queue_size(&queue_);
+}
+
+/// @brief Whether the queue is currently empty.
+template <class T, size_t N>
+inline bool SpscQueue<T, N>::IsEmpty() const noexcept
+{
+  return Size() == 0;
+}
+
+/// @brief Get the maximum number of items the queue can hold.
+template <class T, size_t N>
+constexpr size_t SpscQueue<T, N>::Capacity() noexcept
+{
+  return N;
+}
+
+/// @brief Get a reference to the underlying EtcPalSpscQueue type.
+template <class T, size_t N>
+inline EtcPalSpscQueue& SpscQueue<T, N>::get() noexcept
+{
+  return queue_;
+}
+
+/// @ingroup etcpal_cpp_spsc_queue
+/// @brief A lock-free queue with any number of producer threads and a single consumer thread.
+///
+/// See the module description for @ref etcpal_cpp_spsc_queue for usage information.
+template <class T, size_t N>
+class MpscQueue
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Type T in etcpal::MpscQueue<T, N> must be trivially copyable.");
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity N in etcpal::MpscQueue<T, N> must be a power of 2.");
+
+public:
+  MpscQueue() noexcept;
+
+  MpscQueue(const MpscQueue& other) = delete;
+  MpscQueue& operator=(const MpscQueue& other) = delete;
+  MpscQueue(MpscQueue&& other)                 = delete;
+  MpscQueue& operator=(MpscQueue&& other) = delete;
+
+  bool TryPush(const T& item) noexcept;
+  bool TryPop(T& item) noexcept;
+  bool Pop(T& item, int timeout_ms = ETCPAL_WAIT_FOREVER) noexcept;
+  template <class Rep, class Period>
+  bool Pop(T& item, const std::chrono::duration<Rep, Period>& timeout) noexcept;
+
+  size_t                  Size() const noexcept;
+  bool                    IsEmpty() const noexcept;
+  static constexpr size_t Capacity() noexcept;
+
+  EtcPalMpscQueue& get() noexcept;
+
+private:
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buffer_;
+  size_t                                                          sequences_[N];
+  EtcPalMpscQueue                                                 queue_{};
+  detail::ConsumerWaiter                                          waiter_;
+};
+
+/// @brief Create a new, empty queue.
+template <class T, size_t N>
+inline MpscQueue<T, N>::MpscQueue() noexcept
+{
+  (void)etcpal_mpsc_queue_init(&queue_, &buffer_, sequences_, sizeof(T), N);
+}
+
+/// @brief Add an item to the queue without blocking.
+///
+/// Can be called from any number of threads concurrently. Wakes the consumer if it is blocked in
+/// Pop().
+///
+/// @param item The item to add.
+/// @return true if the item was added, false if the queue was full.
+template <class T, size_t N>
+inline bool MpscQueue<T, N>::TryPush(const T& item) noexcept
+{
+  if (!etcpal_mpsc_queue_try_push(&queue_, &item))
+    return false;
+  waiter_.NotifyIfWaiting();
+  return true;
+}
+
+/// @brief Remove the oldest item from the queue without blocking.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @return true if an item was removed, false if the queue was empty.
+template <class T, size_t N>
+inline bool MpscQueue<T, N>::TryPop(T& item) noexcept
+{
+  return etcpal_mpsc_queue_try_pop(&queue_, &item);
+}
+
+/// @brief Remove the oldest item from the queue, waiting for one to become available.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @param timeout_ms How long to wait for an item, in milliseconds.
+/// @return true if an item was removed, false if the timeout expired.
+template <class T, size_t N>
+inline bool MpscQueue<T, N>::Pop(T& item, int timeout_ms) noexcept
+{
+  return waiter_.Wait([&]() { return TryPop(item); }, timeout_ms);
+}
+
+/// @brief Remove the oldest item from the queue, waiting for one to become available.
+///
+/// Must only be called from the consumer thread.
+///
+/// @param item Filled in with the item removed from the queue.
+/// @param timeout How long to wait for an item.
+/// @return true if an item was removed, false if the timeout expired.
+template <class T, size_t N>
+template <class Rep, class Period>
+inline bool MpscQueue<T, N>::Pop(T& item, const std::chrono::duration<Rep, Period>& timeout) noexcept
+{
+  return Pop(item, detail::ClampTimeoutMs(std::chrono::duration_cast<std::chrono::milliseconds>(timeout)));
+}
+
+/// @brief Get the number of items currently in the queue.
+template <class T, size_t N>
+inline size_t MpscQueue<T, N>::Size() const noexcept
+{
+  return etcpal_mpsc_queue_size(&queue_);
+}
+
+/// @brief Whether the queue is currently empty.
+template <class T, size_t N>
+inline bool MpscQueue<T, N>::IsEmpty() const noexcept
+{
+  return Size() == 0;
+}
+
+/// @brief Get the maximum number of items the queue can hold.
+template <class T, size_t N>
+constexpr size_t MpscQueue<T, N>::Capacity() noexcept
+{
+  return N;
+}
+
+/// @brief Get a reference to the underlying EtcPalMpscQueue type.
+template <class T, size_t N>
+inline EtcPalMpscQueue& MpscQueue<T, N>::get() noexcept
+{
+  return queue_;
+}
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_SPSC_QUEUE_H_
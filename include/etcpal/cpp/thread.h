@@ -88,6 +88,18 @@ namespace etcpal
 ///                                     .Start(MyThreadFunction);
 /// @endcode
 ///
+/// On Linux (#ETCPAL_THREAD_HAS_SCHED_PARAMS), a real-time scheduling policy and a CPU affinity
+/// mask can also be set. If the process lacks the privileges for real-time scheduling, the thread
+/// is started with default scheduling instead:
+/// @code
+/// etcpal::Thread thread;
+/// etcpal::Error start_result = thread.SetName("DMX Output")
+///                                     .SetSchedPolicy(SCHED_FIFO)
+///                                     .SetPriority(80)
+///                                     .SetCpuAffinity(1ull << 2)  // Run only on CPU 2
+///                                     .Start(MyThreadFunction);
+/// @endcode
+///
 /// Pass arguments to your thread function, which will be stored on the heap:
 /// @code
 /// void MyThreadFunction(int value)
@@ -172,6 +184,10 @@ public:
   void*                     platform_data() const noexcept;
   const EtcPalThreadParams& params() const noexcept;
   etcpal_thread_os_handle_t os_handle() const noexcept;
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  int                sched_policy() const noexcept;
+  unsigned long long cpu_affinity() const noexcept;
+#endif
   /// @}
 
   /// @name Setters
@@ -182,6 +198,10 @@ public:
   Thread& SetName(const std::string& name) noexcept;
   Thread& SetPlatformData(void* platform_data) noexcept;
   Thread& SetParams(const EtcPalThreadParams& params) noexcept;
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  Thread& SetSchedPolicy(int sched_policy) noexcept;
+  Thread& SetCpuAffinity(unsigned long long cpu_affinity) noexcept;
+#endif
   /// @}
 
   template <class Function, class... Args>
@@ -200,6 +220,9 @@ public:
 private:
   std::unique_ptr<etcpal_thread_t> thread_;
   EtcPalThreadParams               params_{ETCPAL_THREAD_PARAMS_INIT_VALUES};
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  EtcPalThreadParamsLinux sched_params_ ETCPAL_THREAD_LINUX_PARAMS_INIT;
+#endif
 };
 
 /// @cond Internal thread function
@@ -274,6 +297,10 @@ inline Thread& Thread::operator=(Thread&& other) noexcept
   thread_ = std::move(other.thread_);
   params_ = other.params_;
   ETCPAL_THREAD_SET_DEFAULT_PARAMS(&other.params_);
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  sched_params_       = other.sched_params_;
+  other.sched_params_ = EtcPalThreadParamsLinux ETCPAL_THREAD_LINUX_PARAMS_INIT;
+#endif
   return *this;
 }
 
@@ -321,6 +348,20 @@ inline etcpal_thread_os_handle_t Thread::os_handle() const noexcept
   return thread_ ? etcpal_thread_get_os_handle(thread_.get()) : ETCPAL_THREAD_OS_HANDLE_INVALID;
 }
 
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+/// @brief Get the scheduling policy of this thread (SCHED_OTHER, SCHED_FIFO or SCHED_RR).
+inline int Thread::sched_policy() const noexcept
+{
+  return sched_params_.sched_policy;
+}
+
+/// @brief Get the CPU affinity mask of this thread (bit n represents CPU n; 0 means any CPU).
+inline unsigned long long Thread::cpu_affinity() const noexcept
+{
+  return sched_params_.cpu_affinity;
+}
+#endif
+
 /// @brief Set the priority of this thread.
 ///
 /// Priority is not valid on all platforms. This function does not have any effect on the
@@ -381,6 +422,9 @@ inline Thread& Thread::SetName(const std::string& name) noexcept
 /// default-constructed thread before Start() is called. The pointer passed to this function must
 /// remain valid until after Start() is called.
 ///
+/// If a non-null pointer is set, it takes precedence over the values set by SetSchedPolicy() and
+/// SetCpuAffinity().
+///
 /// @param platform_data Pointer to platform-specific data structure.
 /// @return A reference to this thread, for method chaining.
 inline Thread& Thread::SetPlatformData(void* platform_data) noexcept
@@ -402,6 +446,38 @@ inline Thread& Thread::SetParams(const EtcPalThreadParams& params) noexcept
   return *this;
 }
 
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+/// @brief Set the scheduling policy of this thread.
+///
+/// With SCHED_FIFO or SCHED_RR, the priority set with SetPriority() is honored, clamped to the
+/// range supported by the policy. If the process does not have the privileges to use a real-time
+/// policy, the thread is started with default scheduling instead. This function does not have any
+/// effect on the associated thread unless it is called on a default-constructed thread before
+/// Start() is called.
+///
+/// @param sched_policy SCHED_OTHER, SCHED_FIFO or SCHED_RR.
+/// @return A reference to this thread, for method chaining.
+inline Thread& Thread::SetSchedPolicy(int sched_policy) noexcept
+{
+  sched_params_.sched_policy = sched_policy;
+  return *this;
+}
+
+/// @brief Set the CPUs this thread is allowed to run on.
+///
+/// If none of the CPUs in the mask are available to this process, the thread is started without
+/// an affinity restriction instead. This function does not have any effect on the associated
+/// thread unless it is called on a default-constructed thread before Start() is called.
+///
+/// @param cpu_affinity Mask of allowed CPUs, where bit n represents CPU n. 0 means any CPU.
+/// @return A reference to this thread, for method chaining.
+inline Thread& Thread::SetCpuAffinity(unsigned long long cpu_affinity) noexcept
+{
+  sched_params_.cpu_affinity = cpu_affinity;
+  return *this;
+}
+#endif
+
 /// @brief Associate this thread object with a new thread of execution.
 ///
 /// The new thread of execution starts executing
@@ -440,7 +516,13 @@ Error Thread::Start(Function&& func, Args&&... args)
   if (!new_f)
     return kEtcPalErrNoMem;
 
-  Error create_res = etcpal_thread_create(thread_.get(), &params_, CppThreadFn, new_f.get());
+  EtcPalThreadParams params = params_;
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  if (!params.platform_data)
+    params.platform_data = &sched_params_;
+#endif
+
+  Error create_res = etcpal_thread_create(thread_.get(), &params, CppThreadFn, new_f.get());
   if (create_res)
     new_f.release();
   else
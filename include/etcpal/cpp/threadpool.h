@@ -0,0 +1,305 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/threadpool.h
+/// @brief C++ wrapper and utilities for etcpal/threadpool.h
+
+#ifndef ETCPAL_CPP_THREADPOOL_H_
+#define ETCPAL_CPP_THREADPOOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "etcpal/threadpool.h"
+#include "etcpal/cpp/common.h"
+#include "etcpal/cpp/error.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_threadpool threadpool (Thread Pools)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_threadpool module.
+
+/// @ingroup etcpal_cpp_threadpool
+/// @brief A wrapper class for the EtcPal thread pool type.
+///
+/// Example usage:
+/// @code
+/// etcpal::ThreadPool pool(4);  // 4 worker threads
+///
+/// pool.Submit([&universe]() { universe.Process(); });
+///
+/// // Process every universe, using the workers and the calling thread.
+/// pool.ParallelFor(universes.size(), [&](size_t i) { universes[i].Process(); });
+///
+/// pool.WaitIdle();
+/// @endcode
+///
+/// Callables which are trivially copyable and no larger than #ETCPAL_THREADPOOL_TASK_DATA_SIZE
+/// bytes (for example, lambdas which capture a few references or pointers) are copied directly
+/// into the pool's queues, so submitting them does not allocate. Other callables are moved to the
+/// heap. Tasks must not throw exceptions.
+///
+/// See @ref etcpal_threadpool for more information.
+class ThreadPool
+{
+public:
+  /// @brief Create a thread pool object which does not yet have any worker threads.
+  ThreadPool() = default;
+  explicit ThreadPool(unsigned int num_threads,
+                      size_t       max_queued_tasks = ETCPAL_THREADPOOL_DEFAULT_MAX_QUEUED_TASKS);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool& other) = delete;
+  ThreadPool& operator=(const ThreadPool& other) = delete;
+  ThreadPool(ThreadPool&& other)                 = delete;
+  ThreadPool& operator=(ThreadPool&& other) = delete;
+
+  Error Startup(unsigned int num_threads,
+                size_t       max_queued_tasks = ETCPAL_THREADPOOL_DEFAULT_MAX_QUEUED_TASKS) noexcept;
+  Error Startup(const EtcPalThreadPoolConfig& config) noexcept;
+  void  Shutdown() noexcept;
+
+  template <class Function>
+  Error Submit(Function&& func, int timeout_ms = ETCPAL_WAIT_FOREVER);
+  template <class Function>
+  void ParallelFor(size_t count, Function&& func, size_t grain_size = 0);
+  template <class Function>
+  void ParallelForChunks(size_t count, Function&& func, size_t grain_size = 0);
+  void WaitIdle() noexcept;
+
+  bool         IsRunning() const noexcept;
+  unsigned int num_threads() const noexcept;
+
+  EtcPalThreadPool& get() noexcept;
+
+private:
+  template <class Function>
+  struct CanSubmitInline
+      : std::integral_constant<bool,
+                               std::is_trivially_copyable<Function>::value &&
+                                   sizeof(Function) <= ETCPAL_THREADPOOL_TASK_DATA_SIZE &&
+                                   (alignof(Function) <= alignof(void*) || alignof(Function) <= alignof(double))>
+  {
+  };
+
+  template <class Function>
+  Error SubmitImpl(Function&& func, int timeout_ms, std::true_type /*inline*/);
+  template <class Function>
+  Error SubmitImpl(Function&& func, int timeout_ms, std::false_type /*inline*/);
+
+  EtcPalThreadPool pool_{};
+  bool             running_{false};
+};
+
+/// @cond Internal thread pool trampolines
+
+namespace detail
+{
+template <class Function>
+void RunInlineTask(void* data)
+{
+  (*static_cast<Function*>(data))();
+}
+
+template <class Function>
+void RunHeapTask(void* context)
+{
+  std::unique_ptr<Function> func(static_cast<Function*>(context));
+  (*func)();
+}
+
+template <class Function>
+void RunParallelForIndices(void* context, size_t begin, size_t end)
+{
+  auto& func = *static_cast<Function*>(context);
+  for (size_t i = begin; i < end; ++i)
+    func(i);
+}
+
+template <class Function>
+void RunParallelForChunk(void* context, size_t begin, size_t end)
+{
+  (*static_cast<Function*>(context))(begin, end);
+}
+}  // namespace detail
+
+/// @endcond
+
+/// @brief Create a thread pool and start its worker threads.
+/// @param num_threads The number of worker threads.
+/// @param max_queued_tasks The maximum number of tasks which can be waiting to run.
+/// @throw std::runtime_error if Startup() returns an error code.
+inline ThreadPool::ThreadPool(unsigned int num_threads, size_t max_queued_tasks)
+{
+  auto result = Startup(num_threads, max_queued_tasks);
+  if (!result)
+    ETCPAL_THROW(std::runtime_error("Error while starting EtcPal thread pool: " + result.ToString()));
+}
+
+/// @brief Destroy the thread pool, waiting for any submitted tasks to finish.
+inline ThreadPool::~ThreadPool()
+{
+  Shutdown();
+}
+
+/// @brief Start the pool's worker threads, using default thread parameters.
+/// @param num_threads The number of worker threads.
+/// @param max_queued_tasks The maximum number of tasks which can be waiting to run.
+/// @return The result of etcpal_threadpool_create().
+inline Error ThreadPool::Startup(unsigned int num_threads, size_t max_queued_tasks) noexcept
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  config.num_threads            = num_threads;
+  config.max_queued_tasks       = max_queued_tasks;
+  return Startup(config);
+}
+
+/// @brief Start the pool's worker threads with the given configuration.
+/// @param config Configuration for the pool.
+/// @return The result of etcpal_threadpool_create(), or #kEtcPalErrAlready if the pool is already
+///         running.
+inline Error ThreadPool::Startup(const EtcPalThreadPoolConfig& config) noexcept
+{
+  if (running_)
+    return kEtcPalErrAlready;
+
+  auto result = etcpal_threadpool_create(&pool_, &config);
+  running_    = (result == kEtcPalErrOk);
+  return result;
+}
+
+/// @brief Wait for any submitted tasks to finish and stop the worker threads.
+///
+/// Does nothing if the pool is not running.
+inline void ThreadPool::Shutdown() noexcept
+{
+  if (running_)
+  {
+    etcpal_threadpool_destroy(&pool_);
+    running_ = false;
+  }
+}
+
+/// @brief Submit a task to the pool.
+///
+/// See etcpal_threadpool_submit().
+///
+/// @param func Callable object with the signature `void()`.
+/// @param timeout_ms How long to wait for room in the pool if it is full, in milliseconds.
+/// @return #kEtcPalErrOk: The task was submitted.
+/// @return #kEtcPalErrNotInit: The pool is not running.
+/// @return #kEtcPalErrWouldBlock: The pool is full and timeout_ms was 0.
+/// @return #kEtcPalErrTimedOut: The pool remained full for timeout_ms milliseconds.
+template <class Function>
+Error ThreadPool::Submit(Function&& func, int timeout_ms)
+{
+  if (!running_)
+    return kEtcPalErrNotInit;
+
+  using FunctionType = typename std::decay<Function>::type;
+  return SubmitImpl(std::forward<Function>(func), timeout_ms, CanSubmitInline<FunctionType>{});
+}
+
+/// @brief Call a function for each index in [0, count), in parallel.
+///
+/// See etcpal_threadpool_parallel_for(). The calling thread takes part, and this function returns
+/// when every index has been processed. If the pool is not running, every index is processed on
+/// the calling thread.
+///
+/// @param count The number of indices.
+/// @param func Callable object with the signature `void(size_t index)`.
+/// @param grain_size The number of indices per chunk, or 0 to choose one automatically.
+template <class Function>
+void ThreadPool::ParallelFor(size_t count, Function&& func, size_t grain_size)
+{
+  using FunctionType = typename std::remove_reference<Function>::type;
+  etcpal_threadpool_parallel_for(running_ ? &pool_ : nullptr, count, grain_size,
+                                 detail::RunParallelForIndices<FunctionType>,
+                                 const_cast<void*>(static_cast<const void*>(std::addressof(func))));
+}
+
+/// @brief Call a function for chunks of the range [0, count), in parallel.
+///
+/// Like ParallelFor(), but the function is called once per chunk with the signature
+/// `void(size_t begin, size_t end)`, which lets it amortize per-chunk setup.
+///
+/// @param count The number of indices.
+/// @param func Callable object with the signature `void(size_t begin, size_t end)`.
+/// @param grain_size The number of indices per chunk, or 0 to choose one automatically.
+template <class Function>
+void ThreadPool::ParallelForChunks(size_t count, Function&& func, size_t grain_size)
+{
+  using FunctionType = typename std::remove_reference<Function>::type;
+  etcpal_threadpool_parallel_for(running_ ? &pool_ : nullptr, count, grain_size,
+                                 detail::RunParallelForChunk<FunctionType>,
+                                 const_cast<void*>(static_cast<const void*>(std::addressof(func))));
+}
+
+/// @brief Wait until all submitted tasks have finished.
+///
+/// Must not be called from a task running on the pool.
+inline void ThreadPool::WaitIdle() noexcept
+{
+  if (running_)
+    etcpal_threadpool_wait_idle(&pool_);
+}
+
+/// @brief Whether the pool's worker threads are running.
+inline bool ThreadPool::IsRunning() const noexcept
+{
+  return running_;
+}
+
+/// @brief Get the number of worker threads in the pool.
+inline unsigned int ThreadPool::num_threads() const noexcept
+{
+  return running_ ? etcpal_threadpool_num_threads(&pool_) : 0;
+}
+
+/// @brief Get a reference to the underlying EtcPalThreadPool type.
+inline EtcPalThreadPool& ThreadPool::get() noexcept
+{
+  return pool_;
+}
+
+template <class Function>
+Error ThreadPool::SubmitImpl(Function&& func, int timeout_ms, std::true_type /*inline*/)
+{
+  using FunctionType = typename std::decay<Function>::type;
+  FunctionType task(std::forward<Function>(func));
+  return etcpal_threadpool_submit_copy(&pool_, detail::RunInlineTask<FunctionType>, &task, sizeof(task), timeout_ms);
+}
+
+template <class Function>
+Error ThreadPool::SubmitImpl(Function&& func, int timeout_ms, std::false_type /*inline*/)
+{
+  using FunctionType = typename std::decay<Function>::type;
+  auto task          = new FunctionType(std::forward<Function>(func));
+  auto result        = etcpal_threadpool_submit(&pool_, detail::RunHeapTask<FunctionType>, task, timeout_ms);
+  if (result != kEtcPalErrOk)
+    delete task;
+  return result;
+}
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_THREADPOOL_H_
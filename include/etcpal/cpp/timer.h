@@ -48,7 +48,8 @@ namespace etcpal
 /// embedded RTOS platform with native tick counts.
 ///
 /// Provides a class for representing points in time (TimePoint) and one which implements a passive
-/// monotonic timer (Timer).
+/// monotonic timer (Timer). HighResTimePoint and HighResTimer are nanosecond-resolution
+/// equivalents, based on etcpal_getns(), for timing intervals shorter than a millisecond.
 
 /// @ingroup etcpal_cpp_timer
 /// @brief Get a string represention of a millisecond duration.
@@ -330,6 +331,187 @@ inline void Timer::Reset() noexcept
   etcpal_timer_reset(&timer_);
 }
 
+/// @ingroup etcpal_cpp_timer
+/// @brief Represents a point in time with nanosecond resolution.
+///
+/// Stores the number of nanoseconds elapsed since an arbitrary point in the past, as returned by
+/// etcpal_getns(). This number is stored as a 64-bit unsigned integer, so unlike TimePoint, it
+/// does not wrap in practice. The differences between HighResTimePoints are expressed as
+/// std::chrono::nanoseconds.
+///
+/// @code
+/// auto start_time = etcpal::HighResTimePoint::Now();
+///
+/// // Do some work...
+///
+/// std::chrono::nanoseconds interval = etcpal::HighResTimePoint::Now() - start_time;
+/// @endcode
+///
+/// The actual resolution depends on the platform; see @ref etcpal_timer.
+class HighResTimePoint
+{
+public:
+  /// @brief Construct a HighResTimePoint with a value of 0 by default.
+  HighResTimePoint() = default;
+  constexpr HighResTimePoint(uint64_t ns);
+
+  constexpr uint64_t value() const noexcept;
+
+  template <typename Rep, typename Period>
+  ETCPAL_CONSTEXPR_14 HighResTimePoint& operator+=(const std::chrono::duration<Rep, Period>& duration) noexcept;
+  template <typename Rep, typename Period>
+  ETCPAL_CONSTEXPR_14 HighResTimePoint& operator-=(const std::chrono::duration<Rep, Period>& duration) noexcept;
+
+  static HighResTimePoint Now() noexcept;
+  static HighResTimePoint NowCoarse() noexcept;
+
+private:
+  uint64_t ns_{0};
+};
+
+/// @brief Construct a HighResTimePoint from a number of nanoseconds elapsed since a point in the past.
+constexpr HighResTimePoint::HighResTimePoint(uint64_t ns) : ns_(ns)
+{
+}
+
+/// @brief Get the raw nanosecond value from a HighResTimePoint.
+constexpr uint64_t HighResTimePoint::value() const noexcept
+{
+  return ns_;
+}
+
+/// @brief Add a duration to a HighResTimePoint.
+template <typename Rep, typename Period>
+ETCPAL_CONSTEXPR_14_OR_INLINE HighResTimePoint& HighResTimePoint::operator+=(
+    const std::chrono::duration<Rep, Period>& duration) noexcept
+{
+  ns_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  return *this;
+}
+
+/// @brief Subtract a duration from a HighResTimePoint.
+template <typename Rep, typename Period>
+ETCPAL_CONSTEXPR_14_OR_INLINE HighResTimePoint& HighResTimePoint::operator-=(
+    const std::chrono::duration<Rep, Period>& duration) noexcept
+{
+  ns_ -= static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  return *this;
+}
+
+/// @brief Get a HighResTimePoint representing the current time.
+inline HighResTimePoint HighResTimePoint::Now() noexcept
+{
+  return etcpal_getns();
+}
+
+/// @brief Get a HighResTimePoint representing the current time, from the cheaper coarse clock.
+///
+/// See etcpal_getns_coarse().
+inline HighResTimePoint HighResTimePoint::NowCoarse() noexcept
+{
+  return etcpal_getns_coarse();
+}
+
+/// @ingroup etcpal_cpp_timer
+/// @brief A passive monotonic timer with nanosecond resolution.
+///
+/// Behaves like Timer, but with intervals expressed as std::chrono durations and timed using
+/// etcpal_getns().
+///
+/// @code
+/// etcpal::HighResTimer timer(std::chrono::microseconds(22727)); // One 44 Hz frame period
+///
+/// // Some time later...
+/// std::chrono::nanoseconds elapsed = timer.GetElapsed();
+/// bool is_expired = timer.IsExpired();
+///
+/// timer.Reset(); // Reset the timer for another interval of the same length
+/// @endcode
+class HighResTimer
+{
+public:
+  /// @brief Creates an expired timer with an interval of 0.
+  HighResTimer() = default;
+  template <typename Rep, typename Period>
+  explicit HighResTimer(const std::chrono::duration<Rep, Period>& interval) noexcept;
+
+  HighResTimePoint         GetStartTime() const noexcept;
+  std::chrono::nanoseconds GetInterval() const noexcept;
+  std::chrono::nanoseconds GetElapsed() const noexcept;
+  std::chrono::nanoseconds GetRemaining() const noexcept;
+  bool                     IsExpired() const noexcept;
+
+  template <typename Rep, typename Period>
+  void Start(const std::chrono::duration<Rep, Period>& interval) noexcept;
+  void Reset() noexcept;
+
+private:
+  uint64_t reset_time_{0};
+  uint64_t interval_{0};
+};
+
+/// @brief Create and start a timer with the given interval.
+///
+/// Note: negative intervals are treated as 0.
+template <typename Rep, typename Period>
+HighResTimer::HighResTimer(const std::chrono::duration<Rep, Period>& interval) noexcept
+{
+  Start(interval);
+}
+
+/// @brief Get the time when this timer was started or reset.
+inline HighResTimePoint HighResTimer::GetStartTime() const noexcept
+{
+  return reset_time_;
+}
+
+/// @brief Get the current interval being timed by the timer.
+inline std::chrono::nanoseconds HighResTimer::GetInterval() const noexcept
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(interval_));
+}
+
+/// @brief Get the time since the timer was reset.
+inline std::chrono::nanoseconds HighResTimer::GetElapsed() const noexcept
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(etcpal_getns() - reset_time_));
+}
+
+/// @brief Get the amount of time remaining in the timer's interval (returns 0 if the timer is expired).
+inline std::chrono::nanoseconds HighResTimer::GetRemaining() const noexcept
+{
+  if (interval_ != 0)
+  {
+    uint64_t elapsed = etcpal_getns() - reset_time_;
+    if (elapsed < interval_)
+      return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(interval_ - elapsed));
+  }
+  return std::chrono::nanoseconds(0);
+}
+
+/// @brief Whether the timer's interval is expired.
+inline bool HighResTimer::IsExpired() const noexcept
+{
+  return (interval_ == 0) || ((etcpal_getns() - reset_time_) > interval_);
+}
+
+/// @brief Start the timer with a new interval.
+/// @param interval Interval to time. Negative intervals are treated as 0. An interval of 0 will
+///                 result in a timer that is always expired.
+template <typename Rep, typename Period>
+void HighResTimer::Start(const std::chrono::duration<Rep, Period>& interval) noexcept
+{
+  auto interval_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+  interval_        = static_cast<uint64_t>(std::max(interval_ns, static_cast<std::chrono::nanoseconds::rep>(0)));
+  reset_time_      = etcpal_getns();
+}
+
+/// @brief Reset the timer while keeping the same interval.
+inline void HighResTimer::Reset() noexcept
+{
+  reset_time_ = etcpal_getns();
+}
+
 /// @addtogroup etcpal_cpp_timer
 /// @{
 
@@ -371,6 +553,46 @@ constexpr bool operator>=(const TimePoint& a, const TimePoint& b) noexcept
   return !(a < b);
 }
 
+/// @}
+
+/// @name HighResTimePoint operators
+/// @{
+
+constexpr std::chrono::nanoseconds operator-(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(a.value() - b.value()));
+}
+
+constexpr bool operator==(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return (a.value() == b.value());
+}
+
+constexpr bool operator!=(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return !(a == b);
+}
+
+constexpr bool operator<(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return a.value() < b.value();
+}
+
+constexpr bool operator>(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return b < a;
+}
+
+constexpr bool operator<=(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return !(b < a);
+}
+
+constexpr bool operator>=(const HighResTimePoint& a, const HighResTimePoint& b) noexcept
+{
+  return !(a < b);
+}
+
 /// @}
 /// @}
 
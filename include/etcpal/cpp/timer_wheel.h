@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/// @file etcpal/cpp/timer_wheel.h
+/// @brief C++ wrapper and utilities for etcpal/timer_wheel.h
+
+#ifndef ETCPAL_CPP_TIMER_WHEEL_H_
+#define ETCPAL_CPP_TIMER_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "etcpal/timer_wheel.h"
+
+namespace etcpal
+{
+/// @defgroup etcpal_cpp_timer_wheel timer_wheel (Timer Wheels)
+/// @ingroup etcpal_cpp
+/// @brief C++ utilities for the @ref etcpal_timer_wheel module.
+///
+/// **WARNING:** This module must be explicitly initialized before use. Initialize the module by
+/// calling etcpal_init() with the relevant feature mask:
+/// @code
+/// etcpal_init(ETCPAL_FEATURE_TIMERS);
+/// @endcode
+
+/// @ingroup etcpal_cpp_timer_wheel
+/// @brief A wrapper class for the EtcPal timer wheel type.
+///
+/// Example usage:
+/// @code
+/// etcpal::TimerWheel wheel;
+///
+/// etcpal::TimerWheel::Timer heartbeat([&]() {
+///   // Handle the timeout...
+/// });
+/// wheel.Schedule(heartbeat, 15000);
+///
+/// // In the event loop:
+/// while (running)
+/// {
+///   auto event = poll_context.Wait(wheel.NextTimeout());
+///   // Handle event...
+///   wheel.Process();
+/// }
+/// @endcode
+///
+/// See @ref etcpal_timer_wheel for more information.
+class TimerWheel
+{
+public:
+  class Timer;
+
+  TimerWheel() noexcept;
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel& other) = delete;
+  TimerWheel& operator=(const TimerWheel& other) = delete;
+  TimerWheel(TimerWheel&& other)                 = delete;
+  TimerWheel& operator=(TimerWheel&& other) = delete;
+
+  void Schedule(Timer& timer, uint32_t interval_ms) noexcept;
+  void Cancel(Timer& timer) noexcept;
+  void Clear() noexcept;
+
+  size_t Process();
+  int    NextTimeout() const noexcept;
+  size_t size() const noexcept;
+
+  EtcPalTimerWheel& get() noexcept;
+
+private:
+  EtcPalTimerWheel wheel_{};
+};
+
+/// @ingroup etcpal_cpp_timer_wheel
+/// @brief A timer which can be scheduled on a TimerWheel.
+///
+/// The timer is cancelled automatically when it is destroyed. Not copyable or movable, as the
+/// wheel refers to it by address while it is scheduled.
+class TimerWheel::Timer
+{
+public:
+  /// A function called when the timer expires.
+  using Handler = std::function<void()>;
+
+  Timer() noexcept;
+  explicit Timer(Handler handler) noexcept;
+  ~Timer();
+
+  Timer(const Timer& other) = delete;
+  Timer& operator=(const Timer& other) = delete;
+  Timer(Timer&& other)                 = delete;
+  Timer& operator=(Timer&& other) = delete;
+
+  void SetHandler(Handler handler) noexcept;
+  bool IsScheduled() const noexcept;
+
+private:
+  friend class TimerWheel;
+
+  static void Callback(EtcPalTimerWheelEntry* entry, void* context);
+
+  EtcPalTimerWheelEntry entry_{};
+  TimerWheel*           wheel_{nullptr};
+  Handler               handler_;
+};
+
+/// @brief Create a new, empty timer wheel.
+inline TimerWheel::TimerWheel() noexcept
+{
+  etcpal_timer_wheel_init(&wheel_);
+}
+
+/// @brief Destroy the timer wheel, cancelling any timers still scheduled on it.
+inline TimerWheel::~TimerWheel()
+{
+  etcpal_timer_wheel_clear(&wheel_);
+}
+
+/// @brief Schedule a timer to expire after an interval, rescheduling it if it is already scheduled.
+///
+/// See etcpal_timer_wheel_schedule().
+///
+/// @param timer The timer to schedule. If it is scheduled on a different wheel, it is cancelled
+///              there first.
+/// @param interval_ms Milliseconds until the timer expires.
+inline void TimerWheel::Schedule(Timer& timer, uint32_t interval_ms) noexcept
+{
+  if (timer.wheel_ && timer.wheel_ != this)
+    timer.wheel_->Cancel(timer);
+  timer.wheel_ = this;
+  etcpal_timer_wheel_schedule(&wheel_, &timer.entry_, interval_ms);
+}
+
+/// @brief Cancel a scheduled timer. Does nothing if the timer is not scheduled on this wheel.
+/// @param timer The timer to cancel.
+inline void TimerWheel::Cancel(Timer& timer) noexcept
+{
+  if (timer.wheel_ == this)
+    etcpal_timer_wheel_cancel(&wheel_, &timer.entry_);
+}
+
+/// @brief Cancel every timer scheduled on the wheel without calling their handlers.
+inline void TimerWheel::Clear() noexcept
+{
+  etcpal_timer_wheel_clear(&wheel_);
+}
+
+/// @brief Expire all timers which are due, calling their handlers.
+///
+/// See etcpal_timer_wheel_process().
+///
+/// @return The number of timers which expired.
+inline size_t TimerWheel::Process()
+{
+  return etcpal_timer_wheel_process(&wheel_);
+}
+
+/// @brief Get the time until the next timer expires.
+///
+/// See etcpal_timer_wheel_next_timeout().
+///
+/// @return Milliseconds until the next timer expires, or #ETCPAL_WAIT_FOREVER if there are none.
+inline int TimerWheel::NextTimeout() const noexcept
+{
+  return etcpal_timer_wheel_next_timeout(&wheel_);
+}
+
+/// @brief Get the number of timers scheduled on the wheel.
+inline size_t TimerWheel::size() const noexcept
+{
+  return etcpal_timer_wheel_size(&wheel_);
+}
+
+/// @brief Get a reference to the underlying EtcPalTimerWheel type.
+inline EtcPalTimerWheel& TimerWheel::get() noexcept
+{
+  return wheel_;
+}
+
+/// @brief Create a timer with no handler.
+inline TimerWheel::Timer::Timer() noexcept
+{
+  etcpal_timer_wheel_entry_init(&entry_, Callback, this);
+}
+
+/// @brief Create a timer which calls a handler when it expires.
+/// @param handler The function to call when the timer expires.
+inline TimerWheel::Timer::Timer(Handler handler) noexcept : handler_(std::move(handler))
+{
+  etcpal_timer_wheel_entry_init(&entry_, Callback, this);
+}
+
+/// @brief Destroy the timer, cancelling it if it is scheduled.
+inline TimerWheel::Timer::~Timer()
+{
+  if (wheel_)
+    wheel_->Cancel(*this);
+}
+
+/// @brief Set the function to call when the timer expires.
+/// @param handler The new handler.
+inline void TimerWheel::Timer::SetHandler(Handler handler) noexcept
+{
+  handler_ = std::move(handler);
+}
+
+/// @brief Whether the timer is currently scheduled.
+inline bool TimerWheel::Timer::IsScheduled() const noexcept
+{
+  return etcpal_timer_wheel_is_scheduled(&entry_);
+}
+
+inline void TimerWheel::Timer::Callback(EtcPalTimerWheelEntry* /*entry*/, void* context)
+{
+  auto timer = static_cast<Timer*>(context);
+  if (timer->handler_)
+    timer->handler_();
+}
+
+};  // namespace etcpal
+
+#endif  // ETCPAL_CPP_TIMER_WHEEL_H_
@@ -425,6 +425,14 @@ struct hash<::etcpal::Uuid>
     return seed;
   }
 };
+
+// std::hash specialization for the C EtcPalUuid type, so that it can be used directly as a key in
+// hash-based containers, including etcpal::FlatHashMap.
+template <>
+struct hash<EtcPalUuid>
+{
+  std::size_t operator()(const EtcPalUuid& uuid) const noexcept { return etcpal_uuid_hash_key(&uuid); }
+};
 };  // namespace std
 
 /// @endcond
@@ -23,7 +23,9 @@
 #define ETCPAL_HANDLE_MANAGER_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include "etcpal/error.h"
 
 /**
  * @defgroup etcpal_handle_manager handle_manager
@@ -37,7 +39,41 @@
  * This struct and the accompanying functions are a utility to manage handing out integer handles
  * to resources. It first assigns monotonically-increasing positive values starting at 0 to handles;
  * after wraparound, it uses the value_in_use function to find holes where new handle values can be
- * assigned.
+ * assigned. Once many handles are in use, finding a hole can take many calls to value_in_use.
+ *
+ * An #EtcPalHandleTable instead allocates, frees and looks up handles in constant time. Each handle
+ * encodes the index of a slot in the table plus a generation count for that slot, so a handle
+ * which has been freed is recognized as stale even after its slot has been reused. The slot index
+ * can be used to find the resource in an application-owned array:
+ *
+ * @code
+ * #define MAX_SOURCES 64
+ *
+ * static EtcPalHandleSlot  source_slots[MAX_SOURCES];
+ * static SourceState       sources[MAX_SOURCES];
+ * static EtcPalHandleTable source_handles;
+ *
+ * etcpal_handle_table_init_static(&source_handles, source_slots, MAX_SOURCES);
+ *
+ * size_t index;
+ * int    handle = etcpal_handle_table_alloc(&source_handles, &index);
+ * if (handle >= 0)
+ * {
+ *   // Initialize sources[index]
+ * }
+ *
+ * int found = etcpal_handle_table_lookup(&source_handles, handle);
+ * if (found >= 0)
+ * {
+ *   // Use sources[found]
+ * }
+ *
+ * etcpal_handle_table_free(&source_handles, handle);
+ * // etcpal_handle_table_lookup(&source_handles, handle) now returns -1
+ * @endcode
+ *
+ * A handle table is not thread-safe. See etcpal::HandleTable for a C++ wrapper which also stores
+ * the resources.
  *
  * @{
  */
@@ -74,6 +110,55 @@ void init_int_handle_manager(IntHandleManager*        manager,
                              void*                    context);
 int  get_next_int_handle(IntHandleManager* manager);
 
+/** The maximum number of handles which can be allocated from an #EtcPalHandleTable at once. */
+#define ETCPAL_HANDLE_TABLE_MAX_SIZE (1u << 23)
+
+/**
+ * @brief One slot of an #EtcPalHandleTable.
+ *
+ * Used to define fixed storage for etcpal_handle_table_init_static(). Do not access the members
+ * directly.
+ */
+typedef struct EtcPalHandleSlot
+{
+  /** @cond internal_handle_table_members */
+  uint32_t generation;
+  int32_t  next_free;
+  /** @endcond */
+} EtcPalHandleSlot;
+
+/**
+ * @brief State for allocating integer handles with constant-time lookup and stale-handle detection.
+ *
+ * Initialize with etcpal_handle_table_init() or etcpal_handle_table_init_static(). Do not access
+ * the members directly.
+ */
+typedef struct EtcPalHandleTable
+{
+  /** @cond internal_handle_table_members */
+  EtcPalHandleSlot* slots;
+  size_t            capacity;
+  size_t            max_size;
+  size_t            size;
+  unsigned int      index_bits;
+  int32_t           free_head;
+  int32_t           free_tail;
+  bool              owns_storage;
+  /** @endcond */
+} EtcPalHandleTable;
+
+etcpal_error_t etcpal_handle_table_init(EtcPalHandleTable* table, size_t max_size);
+etcpal_error_t etcpal_handle_table_init_static(EtcPalHandleTable* table, EtcPalHandleSlot* slots, size_t capacity);
+void           etcpal_handle_table_deinit(EtcPalHandleTable* table);
+
+int            etcpal_handle_table_alloc(EtcPalHandleTable* table, size_t* index);
+etcpal_error_t etcpal_handle_table_free(EtcPalHandleTable* table, int handle);
+int            etcpal_handle_table_lookup(const EtcPalHandleTable* table, int handle);
+int            etcpal_handle_table_handle_at(const EtcPalHandleTable* table, size_t index);
+void           etcpal_handle_table_clear(EtcPalHandleTable* table);
+size_t         etcpal_handle_table_size(const EtcPalHandleTable* table);
+size_t         etcpal_handle_table_capacity(const EtcPalHandleTable* table);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/* etcpal/hashmap.h: Open-addressing hash maps with inline key and value storage. */
+
+#ifndef ETCPAL_HASHMAP_H_
+#define ETCPAL_HASHMAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "etcpal/error.h"
+
+/**
+ * @defgroup etcpal_hashmap hashmap (Hash Maps)
+ * @ingroup etcpal_core
+ * @brief Cache-friendly hash maps with fixed-size keys and values.
+ *
+ * ```c
+ * #include "etcpal/hashmap.h"
+ * ```
+ *
+ * An #EtcPalHashMap stores copies of fixed-size keys and values directly in a single array of
+ * slots, using open addressing with linear probing. Unlike @ref etcpal_rbtree, there is no
+ * per-entry allocation, and a lookup usually touches a single cache line. Keys and values are
+ * copied with memcpy(), so they must be safe to copy that way.
+ *
+ * Keys are hashed with a user-provided #EtcPalHashMapHashFunc and compared with a user-provided
+ * #EtcPalHashMapKeyEqualFunc. If either is NULL, the raw bytes of the key are hashed or compared,
+ * which is suitable for integer and handle keys (including sockets) and for #EtcPalUuid. Key types
+ * which contain padding or unused bytes need dedicated functions; see etcpal_ip_hash_key() and
+ * etcpal_sockaddr_hash_key() for #EtcPalIpAddr and #EtcPalSockAddr.
+ *
+ * A hash map can either allocate and grow its own storage with malloc(), or use fixed storage
+ * provided by the application, which is the usual choice on embedded targets:
+ *
+ * @code
+ * #define MAX_SOURCES 64
+ *
+ * static ETCPAL_HASHMAP_DEFINE_STORAGE(source_storage, MAX_SOURCES, EtcPalUuid, SourceState);
+ * static EtcPalHashMap sources;
+ *
+ * etcpal_hashmap_init_static(&sources, sizeof(EtcPalUuid), sizeof(SourceState), etcpal_uuid_hash_key,
+ *                            etcpal_uuid_key_equal, source_storage, MAX_SOURCES);
+ *
+ * SourceState state = ...;
+ * etcpal_error_t res = etcpal_hashmap_insert(&sources, &source_cid, &state);
+ * // res == kEtcPalErrExists if the key was already present, kEtcPalErrNoMem if the map is full
+ *
+ * SourceState* found = (SourceState*)etcpal_hashmap_find(&sources, &source_cid);
+ * if (found)
+ * {
+ *   // Update the state in place
+ * }
+ *
+ * etcpal_hashmap_remove(&sources, &source_cid);
+ * @endcode
+ *
+ * Inserting into or removing from a hash map may move other entries, which invalidates pointers
+ * previously returned by etcpal_hashmap_find(). Lookups stay fast while the map is at most about
+ * 3/4 full; hash maps with their own storage grow to stay under this load. A hash map is not
+ * thread-safe.
+ *
+ * See etcpal::FlatHashMap for a C++ wrapper.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A function which computes the hash of a key.
+ *
+ * Keys which compare equal must have equal hashes. The hash does not need to be well-distributed
+ * in every bit; it is mixed again by the hash map.
+ *
+ * @param key The key to hash.
+ * @return The hash of the key.
+ */
+typedef uint32_t (*EtcPalHashMapHashFunc)(const void* key);
+
+/**
+ * @brief A function which determines whether two keys are equal.
+ * @param key_a The first key to compare.
+ * @param key_b The second key to compare.
+ * @return Whether the keys are equal.
+ */
+typedef bool (*EtcPalHashMapKeyEqualFunc)(const void* key_a, const void* key_b);
+
+/** @cond internal_hashmap_macros */
+#define ETCPAL_HASHMAP_ALIGN_UP(size) (((size) + 7u) & ~(size_t)7u)
+/** @endcond */
+
+/**
+ * @brief The size of one slot in a hash map, in bytes.
+ * @param key_size The size of the key type.
+ * @param value_size The size of the value type.
+ */
+#define ETCPAL_HASHMAP_SLOT_SIZE(key_size, value_size) \
+  (8u + ETCPAL_HASHMAP_ALIGN_UP(key_size) + ETCPAL_HASHMAP_ALIGN_UP(value_size))
+
+/**
+ * @brief The size of the storage required for a hash map with a fixed capacity, in bytes.
+ * @param capacity The number of slots in the hash map.
+ * @param key_size The size of the key type.
+ * @param value_size The size of the value type.
+ */
+#define ETCPAL_HASHMAP_STORAGE_SIZE(capacity, key_size, value_size) \
+  ((capacity)*ETCPAL_HASHMAP_SLOT_SIZE(key_size, value_size))
+
+/**
+ * @brief Define a suitably sized and aligned array to be used as fixed hash map storage.
+ * @param name The name of the array.
+ * @param capacity The number of slots in the hash map.
+ * @param key_type The key type.
+ * @param value_type The value type.
+ */
+#define ETCPAL_HASHMAP_DEFINE_STORAGE(name, capacity, key_type, value_type) \
+  uint64_t name[ETCPAL_HASHMAP_STORAGE_SIZE(capacity, sizeof(key_type), sizeof(value_type)) / 8]
+
+/**
+ * @brief A hash map with fixed-size keys and values.
+ *
+ * Initialize with etcpal_hashmap_init() or etcpal_hashmap_init_static(). Do not access the
+ * members directly.
+ */
+typedef struct EtcPalHashMap
+{
+  /** @cond internal_hashmap_members */
+  uint8_t*                  slots;
+  size_t                    capacity;
+  size_t                    size;
+  size_t                    key_size;
+  size_t                    value_size;
+  size_t                    slot_size;
+  EtcPalHashMapHashFunc     hash_fn;
+  EtcPalHashMapKeyEqualFunc key_equal_fn;
+  bool                      owns_storage;
+  /** @endcond */
+} EtcPalHashMap;
+
+/**
+ * @brief An iterator over the entries of a hash map.
+ *
+ * Initialize with etcpal_hashmap_iter_init(). The hash map must not be modified while it is being
+ * iterated over, except through the value pointers returned by etcpal_hashmap_iter_next().
+ */
+typedef struct EtcPalHashMapIter
+{
+  /** @cond internal_hashmap_members */
+  const EtcPalHashMap* map;
+  size_t               index;
+  /** @endcond */
+} EtcPalHashMapIter;
+
+etcpal_error_t etcpal_hashmap_init(EtcPalHashMap*            map,
+                                   size_t                    key_size,
+                                   size_t                    value_size,
+                                   EtcPalHashMapHashFunc     hash_fn,
+                                   EtcPalHashMapKeyEqualFunc key_equal_fn);
+etcpal_error_t etcpal_hashmap_init_static(EtcPalHashMap*            map,
+                                          size_t                    key_size,
+                                          size_t                    value_size,
+                                          EtcPalHashMapHashFunc     hash_fn,
+                                          EtcPalHashMapKeyEqualFunc key_equal_fn,
+                                          void*                     storage,
+                                          size_t                    capacity);
+void           etcpal_hashmap_deinit(EtcPalHashMap* map);
+
+void*          etcpal_hashmap_find(const EtcPalHashMap* map, const void* key);
+etcpal_error_t etcpal_hashmap_insert(EtcPalHashMap* map, const void* key, const void* value);
+etcpal_error_t etcpal_hashmap_remove(EtcPalHashMap* map, const void* key);
+void           etcpal_hashmap_clear(EtcPalHashMap* map);
+etcpal_error_t etcpal_hashmap_reserve(EtcPalHashMap* map, size_t size);
+size_t         etcpal_hashmap_size(const EtcPalHashMap* map);
+size_t         etcpal_hashmap_capacity(const EtcPalHashMap* map);
+
+void etcpal_hashmap_iter_init(EtcPalHashMapIter* iter, const EtcPalHashMap* map);
+bool etcpal_hashmap_iter_next(EtcPalHashMapIter* iter, const void** key, void** value);
+
+uint32_t etcpal_hash_bytes(const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ETCPAL_HASHMAP_H_ */
@@ -405,6 +405,11 @@ int  etcpal_ip_cmp(const EtcPalIpAddr* ip1, const EtcPalIpAddr* ip2);
 bool etcpal_ip_and_port_equal(const EtcPalSockAddr* sock1, const EtcPalSockAddr* sock2);
 int  etcpal_netint_info_cmp(const EtcPalNetintInfo* i1, const EtcPalNetintInfo* i2);
 
+uint32_t etcpal_ip_hash_key(const void* ip);
+bool     etcpal_ip_key_equal(const void* ip_a, const void* ip_b);
+uint32_t etcpal_sockaddr_hash_key(const void* sock);
+bool     etcpal_sockaddr_key_equal(const void* sock_a, const void* sock_b);
+
 unsigned int etcpal_ip_mask_length(const EtcPalIpAddr* netmask);
 EtcPalIpAddr etcpal_ip_mask_from_length(etcpal_iptype_t type, unsigned int mask_length);
 bool etcpal_ip_network_portions_equal(const EtcPalIpAddr* ip1, const EtcPalIpAddr* ip2, const EtcPalIpAddr* netmask);
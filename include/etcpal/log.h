@@ -304,8 +304,9 @@ typedef struct EtcPalLogStrings
   /** Log string formatted for readability per ETC convention. */
   const char* human_readable;
   /**
-   * The original log string that was passed to etcpal_log() or etcpal_vlog(). Will overlap with
-   * one of the strings above.
+   * The original log string that was passed to etcpal_log() or etcpal_vlog(), after formatting.
+   * The message is formatted only once, and this is the copy that was shared to build the strings
+   * above.
    */
   const char* raw;
   /**
@@ -313,6 +314,8 @@ typedef struct EtcPalLogStrings
    * message is being passed to a system syslog daemon.
    */
   int priority;
+  /** The length of raw, not including the null terminator. */
+  size_t raw_len;
 } EtcPalLogStrings;
 
 /**
@@ -326,7 +329,12 @@ typedef struct EtcPalLogStrings
  * blocking is a possibility, consider queueing log messages and dispatching them from a worker
  * thread.
  *
- * **Do not call etcpal_log() or etcpal_vlog() from this function; a deadlock will result.**
+ * On Windows, Linux and macOS, this function may be called concurrently from multiple threads that
+ * are logging at the same time, so it must be thread-safe. On other platforms, calls to this
+ * function are serialized.
+ *
+ * **Do not call etcpal_log() or etcpal_vlog() from this function; depending on the platform, a
+ * deadlock or corrupted log strings will result.**
  *
  * @param[in] context Optional application-provided value that was previously passed to the library
  *                    module.
@@ -22,7 +22,9 @@
 #ifndef ETCPAL_MEMPOOL_H_
 #define ETCPAL_MEMPOOL_H_
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "etcpal/error.h"
 
 /**
@@ -40,7 +42,18 @@
  * `uint8_t[100]`).
  *
  * If EtcPal is built with OS abstraction support (the default in most situations), allocations and
- * deallocations are ensured to be thread-safe by an #etcpal_mutex_t internally.
+ * deallocations are ensured to be thread-safe by an #etcpal_mutex_t internally. Each pool has its own
+ * mutex, so unrelated pools never contend with each other. The mutex is created by
+ * etcpal_mempool_init() and destroyed by etcpal_mempool_deinit().
+ *
+ * Pools defined with ETCPAL_MEMPOOL_DEFINE_LOCKFREE() or ETCPAL_MEMPOOL_DEFINE_ARRAY_LOCKFREE()
+ * instead use a lock-free freelist based on atomic compare-and-swap operations. This is useful for
+ * pools that are allocated from and freed to at high rates by multiple threads. The freelist head
+ * is a 64-bit value holding a 32-bit element index and a 32-bit tag which guards against the ABA
+ * problem; the tag could only fail if a thread were preempted in the middle of an allocation
+ * while 2^32 other updates were made to the same pool. If the target does not provide a native
+ * 64-bit compare-and-swap (e.g. Arm Cortex-M), or the pool has 2^32 - 1 or more elements, these
+ * pools silently fall back to the locking behavior.
  *
  * For example:
  * @code
@@ -74,7 +87,8 @@
  * // Free the item back to the pool
  * etcpal_mempool_free(my_struct_pool, val);
  *
- * // No deinitialization required
+ * // Deinitialize the pool when it is no longer needed
+ * etcpal_mempool_deinit(my_struct_pool);
  * @endcode
  *
  * @{
@@ -105,12 +119,15 @@ struct EtcPalMempool
  */
 typedef struct EtcPalMempoolDesc
 {
-  const size_t         elem_size;    /**< The size of each element. */
-  const size_t         pool_size;    /**< The number of elements in the pool. */
-  EtcPalMempool*       freelist;     /**< The current freelist. */
-  EtcPalMempool* const list;         /**< The array of mempool list structs. */
-  size_t               current_used; /**< The number of pool elements that have currently been allocated. */
-  void* const          pool;         /**< The actual pool memory. */
+  const size_t         elem_size;     /**< The size of each element. */
+  const size_t         pool_size;     /**< The number of elements in the pool. */
+  EtcPalMempool*       freelist;      /**< The current freelist. */
+  EtcPalMempool* const list;          /**< The array of mempool list structs. */
+  size_t               current_used;  /**< The number of pool elements that have currently been allocated. */
+  void* const          pool;          /**< The actual pool memory. */
+  const bool           lockfree;      /**< Whether this pool uses the lock-free freelist. */
+  uint64_t             freelist_head; /**< The tagged freelist head index, used in lock-free mode. */
+  void*                lock;          /**< The mutex guarding the freelist, or NULL if not created. */
 } EtcPalMempoolDesc;
 
 /** @endcond */
@@ -136,15 +153,42 @@ typedef struct EtcPalMempoolDesc
  * @param type The type of each element in the memory pool (e.g. int, struct foo)
  * @param size The number of elements in the memory pool.
  */
-#define ETCPAL_MEMPOOL_DEFINE(name, type, size)                                     \
-  type                     name##_pool[size];                                       \
-  struct EtcPalMempool     name##_pool_list[size];                                  \
-  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type),     /* elem_size */    \
-                                               size,             /* pool_size */    \
-                                               NULL,             /* freelist */     \
-                                               name##_pool_list, /* list */         \
-                                               0,                /* current_used */ \
-                                               name##_pool /* pool */}
+#define ETCPAL_MEMPOOL_DEFINE(name, type, size)                                      \
+  type                     name##_pool[size];                                        \
+  struct EtcPalMempool     name##_pool_list[size];                                   \
+  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type),     /* elem_size */     \
+                                               size,             /* pool_size */     \
+                                               NULL,             /* freelist */      \
+                                               name##_pool_list, /* list */          \
+                                               0,                /* current_used */  \
+                                               name##_pool,      /* pool */          \
+                                               false,            /* lockfree */      \
+                                               0,                /* freelist_head */ \
+                                               NULL /* lock */}
+
+/**
+ * @brief Define a new memory pool which uses a lock-free freelist.
+ *
+ * Identical to ETCPAL_MEMPOOL_DEFINE(), except that allocations and deallocations on this pool are
+ * done using atomic operations instead of a mutex. The lock-free freelist is only used if the pool
+ * has fewer than 2^32 - 1 elements and the target has a native 64-bit compare-and-swap.
+ *
+ * @param name The name of the memory pool.
+ * @param type The type of each element in the memory pool (e.g. int, struct foo)
+ * @param size The number of elements in the memory pool.
+ */
+#define ETCPAL_MEMPOOL_DEFINE_LOCKFREE(name, type, size)                             \
+  type                     name##_pool[size];                                        \
+  struct EtcPalMempool     name##_pool_list[size];                                   \
+  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type),     /* elem_size */     \
+                                               size,             /* pool_size */     \
+                                               NULL,             /* freelist */      \
+                                               name##_pool_list, /* list */          \
+                                               0,                /* current_used */  \
+                                               name##_pool,      /* pool */          \
+                                               true,             /* lockfree */      \
+                                               0,                /* freelist_head */ \
+                                               NULL /* lock */}
 
 /**
  * @brief Define a new memory pool composed of arrays of elements.
@@ -157,29 +201,67 @@ typedef struct EtcPalMempoolDesc
  * @param array_size The number of elements in each array.
  * @param pool_size The number of arrays in the memory pool.
  */
-#define ETCPAL_MEMPOOL_DEFINE_ARRAY(name, type, array_size, pool_size)                      \
-  type                     name##_pool[array_size][pool_size];                              \
-  struct EtcPalMempool     name##_pool_list[pool_size];                                     \
-  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type[array_size]), /* elem_size */    \
-                                               pool_size,                /* pool_size */    \
-                                               NULL,                     /* freelist */     \
-                                               name##_pool_list,         /* list */         \
-                                               0,                        /* current_used */ \
-                                               name##_pool /* pool */}
+#define ETCPAL_MEMPOOL_DEFINE_ARRAY(name, type, array_size, pool_size)                       \
+  type                     name##_pool[array_size][pool_size];                               \
+  struct EtcPalMempool     name##_pool_list[pool_size];                                      \
+  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type[array_size]), /* elem_size */     \
+                                               pool_size,                /* pool_size */     \
+                                               NULL,                     /* freelist */      \
+                                               name##_pool_list,         /* list */          \
+                                               0,                        /* current_used */  \
+                                               name##_pool,              /* pool */          \
+                                               false,                    /* lockfree */      \
+                                               0,                        /* freelist_head */ \
+                                               NULL /* lock */}
+
+/**
+ * @brief Define a new memory pool composed of arrays of elements which uses a lock-free freelist.
+ *
+ * The array equivalent of ETCPAL_MEMPOOL_DEFINE_LOCKFREE().
+ *
+ * @param name The name of the memory pool.
+ * @param type The type of a single array element in the memory pool.
+ * @param array_size The number of elements in each array.
+ * @param pool_size The number of arrays in the memory pool.
+ */
+#define ETCPAL_MEMPOOL_DEFINE_ARRAY_LOCKFREE(name, type, array_size, pool_size)              \
+  type                     name##_pool[array_size][pool_size];                               \
+  struct EtcPalMempool     name##_pool_list[pool_size];                                      \
+  struct EtcPalMempoolDesc name##_pool_desc = {sizeof(type[array_size]), /* elem_size */     \
+                                               pool_size,                /* pool_size */     \
+                                               NULL,                     /* freelist */      \
+                                               name##_pool_list,         /* list */          \
+                                               0,                        /* current_used */  \
+                                               name##_pool,              /* pool */          \
+                                               true,                     /* lockfree */      \
+                                               0,                        /* freelist_head */ \
+                                               NULL /* lock */}
 
 /**
  * @brief Initialize a memory pool.
  *
- * Must be called on a pool before using etcpal_mempool_alloc() or etcpal_mempool_free() on it. There
- * is no deinitialization function because there is no cleanup necessary; to reset a pool, simply
- * call this function again.
+ * Must be called on a pool before using etcpal_mempool_alloc() or etcpal_mempool_free() on it. To
+ * reset a pool, simply call this function again. Resetting a pool must not be done concurrently
+ * with other operations on the same pool.
  *
  * @param name The name of the memory pool to initialize.
  * @return #kEtcPalErrOk: The memory pool was initialized successfully.
+ * @return #kEtcPalErrNoMem: Couldn't allocate memory for the pool's mutex.
  * @return #kEtcPalErrSys: An internal system call error occurred.
  */
 #define etcpal_mempool_init(name) etcpal_mempool_init_priv(&name##_pool_desc)
 
+/**
+ * @brief Deinitialize a memory pool.
+ *
+ * Destroys the mutex created by etcpal_mempool_init(). Any elements still allocated from the pool
+ * must no longer be used. Must not be called concurrently with other operations on the same pool.
+ * The pool can be initialized again afterward.
+ *
+ * @param name The name of the memory pool to deinitialize.
+ */
+#define etcpal_mempool_deinit(name) etcpal_mempool_deinit_priv(&name##_pool_desc)
+
 /**
  * @brief Allocate a new element from a memory pool.
  * @param name The name of the memory pool from which to allocate a new element.
@@ -219,6 +301,7 @@ typedef struct EtcPalMempoolDesc
 /** @cond internal_mempool_functions */
 
 etcpal_error_t etcpal_mempool_init_priv(EtcPalMempoolDesc* desc);
+void           etcpal_mempool_deinit_priv(EtcPalMempoolDesc* desc);
 void*          etcpal_mempool_alloc_priv(EtcPalMempoolDesc* desc);
 void           etcpal_mempool_free_priv(EtcPalMempoolDesc* desc, void* elem);
 size_t         etcpal_mempool_used_priv(EtcPalMempoolDesc* desc);
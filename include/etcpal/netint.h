@@ -92,13 +92,73 @@
  * etcpal_netint_get_interface_for_dest(&dest, &index); // Index now holds the interface that will be used
  * @endcode
  *
+ * When resolving routes for many destinations at once, etcpal_netint_get_interfaces_for_dests()
+ * does the same for an array of destinations in a single call.
+ *
  * The list of network interfaces is cached and will only change if the
  * etcpal_netint_refresh_interfaces() function is called. These functions are all thread-safe, so
  * the interfaces can be refreshed on one thread while other queries are made on another thread.
  *
+ * On platforms that support it (currently Linux), the cache can instead be kept up to date
+ * automatically by starting an interface monitor. The monitor applies address, link state and
+ * routing changes to the cache as the OS reports them, answers etcpal_netint_is_up() from the
+ * cache, and optionally notifies the application of each change:
+ *
+ * @code
+ * void netint_changed(void* context, const EtcPalNetintChange* change)
+ * {
+ *   if (change->type == kEtcPalNetintAddrAdded)
+ *   {
+ *     // change->netint describes the new address
+ *   }
+ * }
+ *
+ * etcpal_netint_start_monitor(netint_changed, NULL);
+ * @endcode
+ *
  * @{
  */
 
+/** The types of changes reported by the network interface monitor. */
+typedef enum
+{
+  /** An IP address was added to a network interface; a new entry is in the interface cache. */
+  kEtcPalNetintAddrAdded,
+  /** An IP address was removed from a network interface; its entry was removed from the cache. */
+  kEtcPalNetintAddrRemoved,
+  /** A network interface appeared or came up. */
+  kEtcPalNetintUp,
+  /** A network interface went down or disappeared. */
+  kEtcPalNetintDown,
+  /** The system routing tables changed; the default interfaces may have changed. */
+  kEtcPalNetintRoutesChanged
+} etcpal_netint_change_t;
+
+/** A change to the set of network interfaces, as reported by the network interface monitor. */
+typedef struct EtcPalNetintChange
+{
+  /** The type of change. */
+  etcpal_netint_change_t type;
+  /** The index of the interface that changed, or 0 for #kEtcPalNetintRoutesChanged. */
+  unsigned int index;
+  /** The interface cache entry that was added or removed. Only valid for #kEtcPalNetintAddrAdded
+   *  and #kEtcPalNetintAddrRemoved. */
+  EtcPalNetintInfo netint;
+} EtcPalNetintChange;
+
+/**
+ * @brief Function called by the network interface monitor when a change has been applied to the
+ *        interface cache.
+ *
+ * Called from the monitor's own thread, after the change is visible through the other functions
+ * in this module (which may be called from the callback). etcpal_netint_stop_monitor() must not be
+ * called from this callback.
+ *
+ * @param context Pointer to opaque data passed to etcpal_netint_start_monitor().
+ * @param change The change that occurred.
+ */
+typedef void (*EtcPalNetintChangeCallback)(void* context, const EtcPalNetintChange* change);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -111,11 +171,17 @@ etcpal_error_t etcpal_netint_get_interface_with_ip(const EtcPalIpAddr* ip, EtcPa
 
 etcpal_error_t etcpal_netint_get_default_interface(etcpal_iptype_t type, unsigned int* netint_index);
 etcpal_error_t etcpal_netint_get_interface_for_dest(const EtcPalIpAddr* dest, unsigned int* netint_index);
+etcpal_error_t etcpal_netint_get_interfaces_for_dests(const EtcPalIpAddr* dests,
+                                                      unsigned int*       netint_indexes,
+                                                      size_t              num_dests);
 
 etcpal_error_t etcpal_netint_refresh_interfaces();
 
 bool etcpal_netint_is_up(unsigned int netint_index);
 
+etcpal_error_t etcpal_netint_start_monitor(EtcPalNetintChangeCallback callback, void* context);
+void           etcpal_netint_stop_monitor(void);
+
 #ifdef __cplusplus
 }
 #endif
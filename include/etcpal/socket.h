@@ -188,6 +188,21 @@ typedef struct EtcPalMsgHdr
   int            flags;      /**< Flags on received message (set by etcpal_recvmsg) */
 } EtcPalMsgHdr;
 
+/** The maximum number of buffers that can be passed to a single call to etcpal_sendmsg(). */
+#define ETCPAL_SENDMSG_MAX_IOV 32
+
+/** A message in an array passed to etcpal_recvmmsg() or etcpal_sendmmsg(). */
+typedef struct EtcPalMMsgHdr
+{
+  /** The message. For etcpal_sendmmsg(), name is the destination address (or an invalid address on
+   *  a connected socket), buf and buflen hold the data to send and control and controllen hold
+   *  optional ancillary data. */
+  EtcPalMsgHdr hdr;
+  /** The number of bytes received or sent for this message (set by etcpal_recvmmsg() or
+   *  etcpal_sendmmsg()). */
+  size_t len;
+} EtcPalMMsgHdr;
+
 /** Ancillary data received from etcpal_recvmsg. */
 typedef struct EtcPalCMsgHdr
 {
@@ -294,16 +309,24 @@ etcpal_error_t etcpal_getsockopt(etcpal_socket_t id,
                                  int             option_name,
                                  void*           option_value,
                                  size_t*         option_len);
+int            etcpal_join_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups);
+int            etcpal_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups);
 etcpal_error_t etcpal_listen(etcpal_socket_t id, int backlog);
 int            etcpal_recv(etcpal_socket_t id, void* buffer, size_t length, int flags);
 int            etcpal_recvfrom(etcpal_socket_t id, void* buffer, size_t length, int flags, EtcPalSockAddr* address);
 int            etcpal_recvmsg(etcpal_socket_t id, EtcPalMsgHdr* msg, int flags);
+int            etcpal_recvmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags);
 bool           etcpal_cmsg_firsthdr(EtcPalMsgHdr* msgh, EtcPalCMsgHdr* firsthdr);
 bool           etcpal_cmsg_nxthdr(EtcPalMsgHdr* msgh, const EtcPalCMsgHdr* cmsg, EtcPalCMsgHdr* nxthdr);
 bool           etcpal_cmsg_to_pktinfo(const EtcPalCMsgHdr* cmsg, EtcPalPktInfo* pktinfo);
 int            etcpal_send(etcpal_socket_t id, const void* message, size_t length, int flags);
-/* sendmsg - not implemented */
+int etcpal_sendmsg(etcpal_socket_t       id,
+                   const EtcPalIoVec*    iov,
+                   size_t                iovcnt,
+                   int                   flags,
+                   const EtcPalSockAddr* dest_addr);
 int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int flags, const EtcPalSockAddr* dest_addr);
+int etcpal_sendmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags);
 etcpal_error_t etcpal_setsockopt(etcpal_socket_t id,
                                  int             level,
                                  int             option_name,
@@ -329,6 +352,8 @@ etcpal_error_t etcpal_getblocking(etcpal_socket_t id, bool* blocking);
 #define ETCPAL_POLL_CONNECT 0x4u  /**< Notify when a non-blocking connect operation has completed. */
 #define ETCPAL_POLL_OOB     0x8u  /**< Notify when there is out-of-band data on a TCP socket. */
 #define ETCPAL_POLL_ERR     0x10u /**< An error has occurred on the socket (output only). */
+#define ETCPAL_POLL_TIMER   0x20u /**< A timer added with etcpal_poll_add_timer() has expired (output only). */
+#define ETCPAL_POLL_WAKEUP  0x40u /**< etcpal_poll_wakeup() has been called on the context (output only). */
 /**
  * @}
  */
@@ -336,16 +361,24 @@ etcpal_error_t etcpal_getblocking(etcpal_socket_t id, bool* blocking);
 /** Mask of valid events for use with etcpal_poll_add_socket(). */
 #define ETCPAL_POLL_VALID_INPUT_EVENT_MASK 0x0fu
 
+/** A handle to a timer added to an EtcPalPollContext with etcpal_poll_add_timer(). */
+typedef int etcpal_poll_timer_t;
+
+/** An invalid value for etcpal_poll_timer_t. */
+#define ETCPAL_POLL_TIMER_INVALID -1
+
 /** A description of an event that occurred on a socket, for usage with etcpal_poll_wait(). */
 typedef struct EtcPalPollEvent
 {
-  etcpal_socket_t      socket;    /**< Socket which had activity. */
+  etcpal_socket_t      socket;    /**< Socket which had activity (ETCPAL_SOCKET_INVALID for timers and wakeups). */
   etcpal_poll_events_t events;    /**< Event(s) that occurred on the socket. */
   etcpal_error_t       err;       /**< More information about an error that occurred on the socket. */
-  void*                user_data; /**< The user data that was given when this socket was added. */
+  void*                user_data; /**< The user data that was given when this socket, timer or wakeup was added. */
+  etcpal_poll_timer_t  timer;     /**< Timer which expired, if events contains #ETCPAL_POLL_TIMER. */
 } EtcPalPollEvent;
 
 etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context);
+etcpal_error_t etcpal_poll_context_init_multithreaded(EtcPalPollContext* context);
 void           etcpal_poll_context_deinit(EtcPalPollContext* context);
 etcpal_error_t etcpal_poll_add_socket(EtcPalPollContext*   context,
                                       etcpal_socket_t      socket,
@@ -355,8 +388,27 @@ etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
                                          etcpal_socket_t      socket,
                                          etcpal_poll_events_t new_events,
                                          void*                new_user_data);
+etcpal_error_t etcpal_poll_rearm_socket(EtcPalPollContext* context, etcpal_socket_t socket);
 void           etcpal_poll_remove_socket(EtcPalPollContext* context, etcpal_socket_t socket);
 etcpal_error_t etcpal_poll_wait(EtcPalPollContext* context, EtcPalPollEvent* event, int timeout_ms);
+int            etcpal_poll_wait_many(EtcPalPollContext* context,
+                                     EtcPalPollEvent*   events,
+                                     size_t             max_events,
+                                     int                timeout_ms);
+
+etcpal_error_t etcpal_poll_add_timer(EtcPalPollContext*   context,
+                                     uint32_t             timeout_ms,
+                                     uint32_t             interval_ms,
+                                     void*                user_data,
+                                     etcpal_poll_timer_t* timer);
+etcpal_error_t etcpal_poll_reset_timer(EtcPalPollContext*  context,
+                                       etcpal_poll_timer_t timer,
+                                       uint32_t            timeout_ms,
+                                       uint32_t            interval_ms);
+void           etcpal_poll_remove_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer);
+etcpal_error_t etcpal_poll_add_wakeup(EtcPalPollContext* context, void* user_data);
+etcpal_error_t etcpal_poll_wakeup(EtcPalPollContext* context);
+void           etcpal_poll_remove_wakeup(EtcPalPollContext* context);
 
 /************************ Mimic getaddrinfo() API ****************************/
 
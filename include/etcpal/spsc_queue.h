@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/* etcpal/spsc_queue.h: Lock-free bounded queues for single-consumer hand-off between threads. */
+
+#ifndef ETCPAL_SPSC_QUEUE_H_
+#define ETCPAL_SPSC_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "etcpal/error.h"
+
+/**
+ * @defgroup etcpal_spsc_queue spsc_queue (Lock-Free Queues)
+ * @ingroup etcpal_core
+ * @brief Bounded lock-free queues for passing fixed-size items between threads.
+ *
+ * ```c
+ * #include "etcpal/spsc_queue.h"
+ * ```
+ *
+ * This module provides two non-blocking queue types which do not use any OS locking primitives:
+ *
+ * - #EtcPalSpscQueue supports exactly one producer thread and one consumer thread. Both
+ *   etcpal_spsc_queue_try_push() and etcpal_spsc_queue_try_pop() are wait-free.
+ * - #EtcPalMpscQueue supports any number of producer threads and exactly one consumer thread.
+ *   etcpal_mpsc_queue_try_pop() is wait-free; etcpal_mpsc_queue_try_push() is lock-free.
+ *
+ * Items are copied into and out of the queue by value, so they must be safe to copy with memcpy().
+ * The caller provides the storage for the queue, and the capacity must be a power of 2.
+ *
+ * @code
+ * #define MSG_QUEUE_SIZE 64
+ *
+ * static MyMessage       msg_buf[MSG_QUEUE_SIZE];
+ * static EtcPalSpscQueue msg_queue;
+ *
+ * etcpal_spsc_queue_init(&msg_queue, msg_buf, sizeof(MyMessage), MSG_QUEUE_SIZE);
+ *
+ * // On the producer thread
+ * MyMessage msg;
+ * if (!etcpal_spsc_queue_try_push(&msg_queue, &msg))
+ * {
+ *   // Queue is full
+ * }
+ *
+ * // On the consumer thread
+ * MyMessage received_msg;
+ * while (etcpal_spsc_queue_try_pop(&msg_queue, &received_msg))
+ * {
+ *   // Handle received_msg
+ * }
+ * @endcode
+ *
+ * These queues never block. See etcpal::SpscQueue and etcpal::MpscQueue for C++ wrappers which
+ * add an optional blocking wait for the consumer.
+ *
+ * This module requires compiler support for atomic operations (GCC, Clang or MSVC). If it is not
+ * available, the init functions return #kEtcPalErrNotImpl.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The cache line size used to separate producer and consumer state in the queue structures. */
+#define ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE 64
+
+/**
+ * @brief A single-producer, single-consumer lock-free queue.
+ *
+ * Initialize with etcpal_spsc_queue_init(). Do not access the members directly.
+ */
+typedef struct EtcPalSpscQueue
+{
+  /** @cond internal_spsc_queue_members */
+  uint8_t* buffer;
+  size_t   item_size;
+  size_t   mask;
+  uint8_t  pad1[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - 3 * sizeof(size_t)];
+
+  // Consumer state
+  size_t  head;
+  size_t  cached_tail;
+  uint8_t pad2[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+
+  // Producer state
+  size_t  tail;
+  size_t  cached_head;
+  uint8_t pad3[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+  /** @endcond */
+} EtcPalSpscQueue;
+
+/**
+ * @brief A multiple-producer, single-consumer lock-free queue.
+ *
+ * Initialize with etcpal_mpsc_queue_init(). Do not access the members directly.
+ */
+typedef struct EtcPalMpscQueue
+{
+  /** @cond internal_spsc_queue_members */
+  uint8_t* buffer;
+  size_t*  sequences;
+  size_t   item_size;
+  size_t   mask;
+  uint8_t  pad1[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - 4 * sizeof(size_t)];
+
+  // Consumer state
+  size_t  head;
+  uint8_t pad2[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - sizeof(size_t)];
+
+  // Producer state
+  size_t  tail;
+  uint8_t pad3[ETCPAL_SPSC_QUEUE_CACHE_LINE_SIZE - sizeof(size_t)];
+  /** @endcond */
+} EtcPalMpscQueue;
+
+etcpal_error_t etcpal_spsc_queue_init(EtcPalSpscQueue* queue, void* buffer, size_t item_size, size_t capacity);
+bool           etcpal_spsc_queue_try_push(EtcPalSpscQueue* queue, const void* item);
+bool           etcpal_spsc_queue_try_pop(EtcPalSpscQueue* queue, void* item);
+size_t         etcpal_spsc_queue_size(const EtcPalSpscQueue* queue);
+
+etcpal_error_t etcpal_mpsc_queue_init(EtcPalMpscQueue* queue,
+                                      void*            buffer,
+                                      size_t*          sequence_buffer,
+                                      size_t           item_size,
+                                      size_t           capacity);
+bool           etcpal_mpsc_queue_try_push(EtcPalMpscQueue* queue, const void* item);
+bool           etcpal_mpsc_queue_try_pop(EtcPalMpscQueue* queue, void* item);
+size_t         etcpal_mpsc_queue_size(const EtcPalMpscQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ETCPAL_SPSC_QUEUE_H_ */
@@ -117,14 +117,17 @@ extern "C" {
  *
  * The members of this structure are not all honored on all platforms. Here is a breakdown:
  *
- * Platform | Priority Honored | Stack Size Honored | Thread Name Honored | Platform Data Available    |
- * ---------|------------------|--------------------|---------------------|----------------------------|
- * FreeRTOS | Yes              | Yes                | Yes                 | No                         |
- * Linux    | No               | Yes                | Yes                 | No                         |
- * macOS    | No               | Yes                | Yes                 | No                         |
- * MQX      | Yes              | Yes                | Yes                 | Yes, EtcPalThreadParamsMqx |
- * Windows  | Yes              | Yes                | Yes                 | No                         |
- * Zephyr   | Yes              | Yes                | Yes                 | No                         |
+ * Platform | Priority Honored    | Stack Size Honored | Thread Name Honored | Platform Data Available      |
+ * ---------|---------------------|--------------------|---------------------|------------------------------|
+ * FreeRTOS | Yes                 | Yes                | Yes                 | No                           |
+ * Linux    | With SCHED_FIFO/_RR | Yes                | Yes                 | Yes, EtcPalThreadParamsLinux |
+ * macOS    | No                  | Yes                | Yes                 | No                           |
+ * MQX      | Yes                 | Yes                | Yes                 | Yes, EtcPalThreadParamsMqx   |
+ * Windows  | Yes                 | Yes                | Yes                 | No                           |
+ * Zephyr   | Yes                 | Yes                | Yes                 | No                           |
+ *
+ * On Linux, the priority is only meaningful for the real-time scheduling policies, which are
+ * selected using EtcPalThreadParamsLinux. It is clamped to the range supported by the policy.
  */
 typedef struct EtcPalThreadParams
 {
@@ -145,7 +148,7 @@ typedef struct EtcPalThreadParams
    * @brief Pointer to a platform-specific parameter structure.
    *
    * This is used to set thread attributes that are not shared between platforms. Currently the
-   * only platform that has a valid value for this member is MQX, which has the following
+   * platforms that have a valid value for this member are MQX, which has the following
    * structure:
    *
    * @code
@@ -155,6 +158,20 @@ typedef struct EtcPalThreadParams
    *   _mqx_uint time_slice; // Corresponds to the DEFAULT_TIME_SLICE member of TASK_TEMPLATE_STRUCT
    * } EtcPalThreadParamsMqx;
    * @endcode
+   *
+   * And Linux (#ETCPAL_THREAD_HAS_SCHED_PARAMS), which has the following structure:
+   *
+   * @code
+   * typedef struct EtcPalThreadParamsLinux
+   * {
+   *   int sched_policy; // SCHED_OTHER (default), SCHED_FIFO or SCHED_RR
+   *   unsigned long long cpu_affinity; // Bit n allows the thread to run on CPU n; 0 means any CPU
+   * } EtcPalThreadParamsLinux;
+   * @endcode
+   *
+   * Real-time policies usually require privileges (CAP_SYS_NICE or a nonzero RLIMIT_RTPRIO). If
+   * the thread cannot be created with the requested policy or affinity, it is created with the
+   * default scheduling and affinity instead.
    */
   void* platform_data;
 } EtcPalThreadParams;
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/* etcpal/threadpool.h: A pool of worker threads which run short tasks. */
+
+#ifndef ETCPAL_THREADPOOL_H_
+#define ETCPAL_THREADPOOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "etcpal/error.h"
+#include "etcpal/mutex.h"
+#include "etcpal/sem.h"
+#include "etcpal/thread.h"
+
+/**
+ * @defgroup etcpal_threadpool threadpool (Thread Pools)
+ * @ingroup etcpal_os
+ * @brief Run many short tasks on a fixed set of worker threads.
+ *
+ * ```c
+ * #include "etcpal/threadpool.h"
+ * ```
+ *
+ * A thread pool owns a fixed number of worker threads, each with its own queue of tasks. Tasks
+ * submitted from outside the pool are spread across the workers' queues; tasks submitted from a
+ * task running on a worker go to that worker's own queue. A worker which runs out of tasks steals
+ * them from the other workers' queues, so the load evens out without all submissions contending on
+ * a single lock.
+ *
+ * @code
+ * void process_universe(void* context)
+ * {
+ *   Universe* universe = (Universe*)context;
+ *   // ...
+ * }
+ *
+ * EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+ * config.num_threads = 4;
+ *
+ * EtcPalThreadPool pool;
+ * if (etcpal_threadpool_create(&pool, &config) == kEtcPalErrOk)
+ * {
+ *   for (size_t i = 0; i < num_universes; ++i)
+ *     etcpal_threadpool_submit(&pool, process_universe, &universes[i], ETCPAL_WAIT_FOREVER);
+ *
+ *   etcpal_threadpool_wait_idle(&pool);  // Wait for all of them to finish
+ *   etcpal_threadpool_destroy(&pool);
+ * }
+ * @endcode
+ *
+ * The number of tasks waiting to run is bounded by EtcPalThreadPoolConfig::max_queued_tasks, and
+ * submitting blocks (up to the timeout given) while the pool is full. Nothing is allocated after
+ * the pool is created: each queued task is a function pointer plus either a context pointer
+ * (etcpal_threadpool_submit()) or up to #ETCPAL_THREADPOOL_TASK_DATA_SIZE bytes of data copied
+ * into the queue (etcpal_threadpool_submit_copy()).
+ *
+ * etcpal_threadpool_parallel_for() splits a range of indices into chunks and runs them across the
+ * pool, with the calling thread taking part. It may be called from within a task.
+ *
+ * Tasks run in no particular order. A task must not block waiting for another task to run, except
+ * through etcpal_threadpool_parallel_for() or etcpal_threadpool_wait_idle() from outside the
+ * pool, as all of the workers could be occupied by tasks waiting in the same way.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The maximum size of the data that can be copied into the pool with each task. */
+#define ETCPAL_THREADPOOL_TASK_DATA_SIZE 48
+
+/**
+ * @brief A task function.
+ * @param context The context pointer given to etcpal_threadpool_submit(), or a pointer to the
+ *                copy of the data given to etcpal_threadpool_submit_copy(), which is valid until
+ *                the function returns.
+ */
+typedef void (*EtcPalThreadPoolTaskFn)(void* context);
+
+/**
+ * @brief A function which processes one chunk of an etcpal_threadpool_parallel_for() range.
+ * @param context The context pointer given to etcpal_threadpool_parallel_for().
+ * @param begin The first index in the chunk.
+ * @param end One past the last index in the chunk.
+ */
+typedef void (*EtcPalThreadPoolRangeFn)(void* context, size_t begin, size_t end);
+
+/** Configuration for a thread pool. */
+typedef struct EtcPalThreadPoolConfig
+{
+  /** The number of worker threads. Must be at least 1. */
+  unsigned int num_threads;
+  /** The maximum number of tasks which can be waiting to run. Must be at least 1. */
+  size_t max_queued_tasks;
+  /** The parameters used to create each worker thread. */
+  EtcPalThreadParams thread_params;
+} EtcPalThreadPoolConfig;
+
+/** The default number of worker threads in #ETCPAL_THREADPOOL_CONFIG_INIT. */
+#define ETCPAL_THREADPOOL_DEFAULT_NUM_THREADS 4
+/** The default maximum number of queued tasks in #ETCPAL_THREADPOOL_CONFIG_INIT. */
+#define ETCPAL_THREADPOOL_DEFAULT_MAX_QUEUED_TASKS 1024
+
+/** A default-value initializer for an EtcPalThreadPoolConfig struct. */
+#define ETCPAL_THREADPOOL_CONFIG_INIT              \
+  {                                                \
+    ETCPAL_THREADPOOL_DEFAULT_NUM_THREADS,         \
+    ETCPAL_THREADPOOL_DEFAULT_MAX_QUEUED_TASKS,    \
+    ETCPAL_THREAD_PARAMS_INIT                      \
+  }
+
+/** @cond internal_threadpool_members */
+typedef struct EtcPalThreadPoolWorker EtcPalThreadPoolWorker;
+/** @endcond */
+
+/**
+ * @brief A thread pool.
+ *
+ * Create with etcpal_threadpool_create(). Do not access the members directly.
+ */
+typedef struct EtcPalThreadPool
+{
+  /** @cond internal_threadpool_members */
+  EtcPalThreadPoolWorker* workers;
+  unsigned int            num_workers;
+  unsigned int            next_worker;
+  long                    num_outstanding;
+  long                    stopping;
+  etcpal_sem_t            tasks_available;
+  etcpal_sem_t            slots_available;
+  etcpal_mutex_t          idle_lock;
+  etcpal_sem_t            idle_sem;
+  unsigned int            num_idle_waiters;
+  /** @endcond */
+} EtcPalThreadPool;
+
+etcpal_error_t etcpal_threadpool_create(EtcPalThreadPool* pool, const EtcPalThreadPoolConfig* config);
+void           etcpal_threadpool_destroy(EtcPalThreadPool* pool);
+
+etcpal_error_t etcpal_threadpool_submit(EtcPalThreadPool*      pool,
+                                        EtcPalThreadPoolTaskFn fn,
+                                        void*                  context,
+                                        int                    timeout_ms);
+etcpal_error_t etcpal_threadpool_submit_copy(EtcPalThreadPool*      pool,
+                                             EtcPalThreadPoolTaskFn fn,
+                                             const void*            data,
+                                             size_t                 data_size,
+                                             int                    timeout_ms);
+
+void etcpal_threadpool_wait_idle(EtcPalThreadPool* pool);
+void etcpal_threadpool_parallel_for(EtcPalThreadPool*       pool,
+                                    size_t                  count,
+                                    size_t                  grain_size,
+                                    EtcPalThreadPoolRangeFn fn,
+                                    void*                   context);
+
+unsigned int etcpal_threadpool_num_threads(const EtcPalThreadPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ETCPAL_THREADPOOL_H_ */
@@ -84,6 +84,25 @@
  * etcpal_timer_start(&timer, 1000); // Reuse the timer for a different interval, in this case 1 second.
  * @endcode
  *
+ * For finer-grained timing, etcpal_getns() and etcpal_getus() get 64-bit time points in
+ * nanoseconds and microseconds from a monotonic clock which they share. These do not wrap in
+ * practice, so they can be compared and subtracted directly. This clock is not necessarily the one
+ * behind etcpal_getms() (on Windows, for example, etcpal_getms() uses timeGetTime() and
+ * etcpal_getns() uses the performance counter), so the two can drift apart; only compare time
+ * points obtained from the same function family.
+ *
+ * @code
+ * uint64_t start_ns = etcpal_getns();
+ * // Do some work...
+ * uint64_t elapsed_ns = etcpal_getns() - start_ns;
+ * @endcode
+ *
+ * The actual resolution depends on the platform: it is typically sub-microsecond on Linux, macOS
+ * and Windows, but only as fine as the system tick on RTOS platforms. etcpal_getns_coarse() is a
+ * cheaper variant for timestamping in hot paths, at the cost of resolution (on Linux, it reads
+ * CLOCK_MONOTONIC_COARSE, which typically advances once per scheduler tick; on other platforms,
+ * it is the same as etcpal_getns()).
+ *
  * @{
  */
 
@@ -119,8 +138,30 @@ typedef struct EtcPalTimer
  */
 uint32_t etcpal_getms(void);
 
+/**
+ * @brief Get a monotonically-increasing nanosecond value.
+ *
+ * The time base is shared with etcpal_getus() and etcpal_getns_coarse(), but not necessarily with
+ * etcpal_getms().
+ *
+ * @return The current timestamp in nanoseconds.
+ */
+uint64_t etcpal_getns(void);
+
+/**
+ * @brief Get a monotonically-increasing nanosecond value from a cheaper, lower-resolution clock.
+ *
+ * Uses the same time base as etcpal_getns(), but may lag it by up to the platform's coarse clock
+ * resolution (typically a few milliseconds).
+ *
+ * @return The current coarse timestamp in nanoseconds.
+ */
+uint64_t etcpal_getns_coarse(void);
+
 /* Functions with platform-neutral definitions */
 
+uint64_t etcpal_getus(void);
+
 void     etcpal_timer_start(EtcPalTimer* timer, uint32_t interval);
 void     etcpal_timer_reset(EtcPalTimer* timer);
 uint32_t etcpal_timer_elapsed(const EtcPalTimer* timer);
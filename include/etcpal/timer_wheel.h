@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/* etcpal/timer_wheel.h: A hierarchical timer wheel for managing many timeouts at once. */
+
+#ifndef ETCPAL_TIMER_WHEEL_H_
+#define ETCPAL_TIMER_WHEEL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "etcpal/common.h"
+
+/**
+ * @defgroup etcpal_timer_wheel timer_wheel (Timer Wheels)
+ * @ingroup etcpal_core
+ * @brief Schedule and expire large numbers of timeouts efficiently.
+ *
+ * ```c
+ * #include "etcpal/timer_wheel.h"
+ * ```
+ *
+ * **WARNING:** This module uses etcpal_getms(), so the @ref etcpal_timer module must be
+ * initialized before use. Initialize it by calling etcpal_init() with the relevant feature mask:
+ * @code
+ * etcpal_init(ETCPAL_FEATURE_TIMERS);
+ * @endcode
+ *
+ * An #EtcPalTimer must be polled to find out whether it has expired, which gets expensive when a
+ * component manages thousands of timeouts. A timer wheel instead keeps its timers sorted into
+ * buckets by expiry time, so that scheduling or cancelling a timer is O(1) and processing the
+ * wheel only touches the timers which have actually expired.
+ *
+ * The caller provides the storage for each timer (an #EtcPalTimerWheelEntry), typically as a
+ * member of the structure whose timeout it represents. Nothing is allocated by this module.
+ *
+ * @code
+ * typedef struct Client
+ * {
+ *   EtcPalTimerWheelEntry heartbeat_timer;
+ *   // ...
+ * } Client;
+ *
+ * void heartbeat_expired(EtcPalTimerWheelEntry* entry, void* context)
+ * {
+ *   Client* client = (Client*)context;
+ *   // Handle the timeout...
+ * }
+ *
+ * EtcPalTimerWheel wheel;
+ * etcpal_timer_wheel_init(&wheel);
+ *
+ * etcpal_timer_wheel_entry_init(&client->heartbeat_timer, heartbeat_expired, client);
+ * etcpal_timer_wheel_schedule(&wheel, &client->heartbeat_timer, 15000);
+ *
+ * // In the event loop:
+ * while (running)
+ * {
+ *   etcpal_poll_wait(&poll_context, &event, etcpal_timer_wheel_next_timeout(&wheel));
+ *   // Handle event...
+ *   etcpal_timer_wheel_process(&wheel);
+ * }
+ * @endcode
+ *
+ * Timers have millisecond resolution and may be scheduled up to #ETCPAL_TIMER_WHEEL_MAX_INTERVAL
+ * milliseconds in the future. Expiry callbacks are called from etcpal_timer_wheel_process(), in
+ * order of expiry time. A callback may schedule or cancel any timer, including its own.
+ *
+ * A timer wheel is not thread-safe; all functions for a given wheel and its timers must be called
+ * from the same thread or serialized by the caller.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond internal_timer_wheel_constants */
+#define ETCPAL_TIMER_WHEEL_LEVELS    6
+#define ETCPAL_TIMER_WHEEL_SLOT_BITS 6
+#define ETCPAL_TIMER_WHEEL_SLOTS     (1u << ETCPAL_TIMER_WHEEL_SLOT_BITS)
+/** @endcond */
+
+/** The longest interval, in milliseconds, with which a timer can be scheduled. */
+#define ETCPAL_TIMER_WHEEL_MAX_INTERVAL 0x7fffffffu
+
+typedef struct EtcPalTimerWheelEntry EtcPalTimerWheelEntry;
+
+/**
+ * @brief A function called when a timer expires.
+ * @param entry The timer that expired. It is no longer scheduled, and may be rescheduled.
+ * @param context The context pointer given to etcpal_timer_wheel_entry_init().
+ */
+typedef void (*EtcPalTimerWheelCallback)(EtcPalTimerWheelEntry* entry, void* context);
+
+/**
+ * @brief A timer which can be scheduled on an #EtcPalTimerWheel.
+ *
+ * Initialize with etcpal_timer_wheel_entry_init(). The storage must remain valid, and must not be
+ * re-initialized, while the timer is scheduled.
+ */
+struct EtcPalTimerWheelEntry
+{
+  EtcPalTimerWheelCallback callback; /**< The function called when the timer expires. */
+  void*                    context;  /**< Passed to the callback. */
+
+  /** @cond internal_timer_wheel_members */
+  uint32_t                expiry;
+  int                     bucket;
+  EtcPalTimerWheelEntry*  next;
+  EtcPalTimerWheelEntry** pprev;
+  /** @endcond */
+};
+
+/**
+ * @brief A hierarchical timer wheel.
+ *
+ * Initialize with etcpal_timer_wheel_init(). Do not access the members directly. A wheel must not
+ * be moved or copied in memory while any timers are scheduled on it.
+ */
+typedef struct EtcPalTimerWheel
+{
+  /** @cond internal_timer_wheel_members */
+  uint32_t               now;
+  size_t                 num_timers;
+  uint64_t               occupied[ETCPAL_TIMER_WHEEL_LEVELS];
+  EtcPalTimerWheelEntry* slots[ETCPAL_TIMER_WHEEL_LEVELS][ETCPAL_TIMER_WHEEL_SLOTS];
+  EtcPalTimerWheelEntry* due;
+  EtcPalTimerWheelEntry* firing;
+  /** @endcond */
+} EtcPalTimerWheel;
+
+void etcpal_timer_wheel_init(EtcPalTimerWheel* wheel);
+void etcpal_timer_wheel_clear(EtcPalTimerWheel* wheel);
+
+void etcpal_timer_wheel_entry_init(EtcPalTimerWheelEntry* entry, EtcPalTimerWheelCallback callback, void* context);
+void etcpal_timer_wheel_schedule(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry, uint32_t interval);
+void etcpal_timer_wheel_cancel(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry);
+bool etcpal_timer_wheel_is_scheduled(const EtcPalTimerWheelEntry* entry);
+
+size_t etcpal_timer_wheel_process(EtcPalTimerWheel* wheel);
+int    etcpal_timer_wheel_next_timeout(const EtcPalTimerWheel* wheel);
+size_t etcpal_timer_wheel_size(const EtcPalTimerWheel* wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ETCPAL_TIMER_WHEEL_H_ */
@@ -127,6 +127,9 @@ extern const EtcPalUuid kEtcPalNullUuid;
 bool etcpal_uuid_to_string(const EtcPalUuid* uuid, char* buf);
 bool etcpal_string_to_uuid(const char* str, EtcPalUuid* uuid);
 
+uint32_t etcpal_uuid_hash_key(const void* uuid);
+bool     etcpal_uuid_key_equal(const void* uuid_a, const void* uuid_b);
+
 /************************ UUID Generation Functions **************************/
 
 etcpal_error_t etcpal_generate_v1_uuid(EtcPalUuid* uuid);
@@ -38,8 +38,15 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_interface_with_ip, const EtcPalIpAddr*, EtcPalNetintInfo*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_default_interface, etcpal_iptype_t, unsigned int*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_interface_for_dest, const EtcPalIpAddr*, unsigned int*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
+                        etcpal_netint_get_interfaces_for_dests,
+                        const EtcPalIpAddr*,
+                        unsigned int*,
+                        size_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_refresh_interfaces);
 DECLARE_FAKE_VALUE_FUNC(bool, etcpal_netint_is_up, unsigned int);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_start_monitor, EtcPalNetintChangeCallback, void*);
+DECLARE_FAKE_VOID_FUNC(etcpal_netint_stop_monitor);
 
 void etcpal_netint_reset_all_fakes(void);
 
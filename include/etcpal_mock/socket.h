@@ -42,15 +42,20 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_connect, etcpal_socket_t, const E
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getpeername, etcpal_socket_t, EtcPalSockAddr*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getsockname, etcpal_socket_t, EtcPalSockAddr*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getsockopt, etcpal_socket_t, int, int, void*, size_t*);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_join_groups, etcpal_socket_t, const EtcPalGroupReq*, size_t);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_leave_groups, etcpal_socket_t, const EtcPalGroupReq*, size_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_listen, etcpal_socket_t, int);
 DECLARE_FAKE_VALUE_FUNC(int, etcpal_recv, etcpal_socket_t, void*, size_t, int);
 DECLARE_FAKE_VALUE_FUNC(int, etcpal_recvfrom, etcpal_socket_t, void*, size_t, int, EtcPalSockAddr*);
 DECLARE_FAKE_VALUE_FUNC(int, etcpal_recvmsg, etcpal_socket_t, EtcPalMsgHdr*, int);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_recvmmsg, etcpal_socket_t, EtcPalMMsgHdr*, size_t, int);
 DECLARE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_firsthdr, EtcPalMsgHdr*, EtcPalCMsgHdr*);
 DECLARE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_nxthdr, EtcPalMsgHdr*, const EtcPalCMsgHdr*, EtcPalCMsgHdr*);
 DECLARE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_to_pktinfo, const EtcPalCMsgHdr*, EtcPalPktInfo*);
 DECLARE_FAKE_VALUE_FUNC(int, etcpal_send, etcpal_socket_t, const void*, size_t, int);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_sendmsg, etcpal_socket_t, const EtcPalIoVec*, size_t, int, const EtcPalSockAddr*);
 DECLARE_FAKE_VALUE_FUNC(int, etcpal_sendto, etcpal_socket_t, const void*, size_t, int, const EtcPalSockAddr*);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_sendmmsg, etcpal_socket_t, EtcPalMMsgHdr*, size_t, int);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_setsockopt, etcpal_socket_t, int, int, const void*, size_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_shutdown, etcpal_socket_t, int);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_socket, unsigned int, unsigned int, etcpal_socket_t*);
@@ -59,6 +64,7 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_setblocking, etcpal_socket_t, boo
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getblocking, etcpal_socket_t, bool*);
 
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_context_init, EtcPalPollContext*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_context_init_multithreaded, EtcPalPollContext*);
 DECLARE_FAKE_VOID_FUNC(etcpal_poll_context_deinit, EtcPalPollContext*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         etcpal_poll_add_socket,
@@ -72,8 +78,22 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         etcpal_socket_t,
                         etcpal_poll_events_t,
                         void*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_rearm_socket, EtcPalPollContext*, etcpal_socket_t);
 DECLARE_FAKE_VOID_FUNC(etcpal_poll_remove_socket, EtcPalPollContext*, etcpal_socket_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_wait, EtcPalPollContext*, EtcPalPollEvent*, int);
+DECLARE_FAKE_VALUE_FUNC(int, etcpal_poll_wait_many, EtcPalPollContext*, EtcPalPollEvent*, size_t, int);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
+                        etcpal_poll_add_timer,
+                        EtcPalPollContext*,
+                        uint32_t,
+                        uint32_t,
+                        void*,
+                        etcpal_poll_timer_t*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_reset_timer, EtcPalPollContext*, etcpal_poll_timer_t, uint32_t, uint32_t);
+DECLARE_FAKE_VOID_FUNC(etcpal_poll_remove_timer, EtcPalPollContext*, etcpal_poll_timer_t);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_add_wakeup, EtcPalPollContext*, void*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_wakeup, EtcPalPollContext*);
+DECLARE_FAKE_VOID_FUNC(etcpal_poll_remove_wakeup, EtcPalPollContext*);
 
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         etcpal_getaddrinfo,
@@ -30,6 +30,8 @@ extern "C" {
 #endif
 
 DECLARE_FAKE_VALUE_FUNC(uint32_t, etcpal_getms);
+DECLARE_FAKE_VALUE_FUNC(uint64_t, etcpal_getns);
+DECLARE_FAKE_VALUE_FUNC(uint64_t, etcpal_getns_coarse);
 
 void etcpal_timer_reset_all_fakes(void);
 
@@ -32,12 +32,16 @@ extern "C" {
 typedef uint32_t etcpal_event_bits_t;
 #define ETCPAL_EVENT_BITS_INIT 0
 
+/* A thread blocked in etcpal_event_group_wait(). Defined in os_event_group.c. */
+typedef struct EtcPalEventGroupWaiter EtcPalEventGroupWaiter;
+
 typedef struct
 {
-  bool                valid;
-  pthread_cond_t      cond;
-  pthread_mutex_t     mutex;
-  etcpal_event_bits_t bits;
+  bool                    valid;
+  pthread_mutex_t         mutex;
+  etcpal_event_bits_t     bits;
+  EtcPalEventGroupWaiter* waiters_head;
+  EtcPalEventGroupWaiter* waiters_tail;
 } etcpal_event_group_t;
 #define ETCPAL_EVENT_GROUP_INIT \
   {                             \
@@ -45,7 +49,7 @@ typedef struct
 
 #define ETCPAL_EVENT_GROUP_HAS_TIMED_WAIT         0
 #define ETCPAL_EVENT_GROUP_HAS_ISR_FUNCTIONS      0
-#define ETCPAL_EVENT_GROUP_WAKES_MULTIPLE_THREADS 0
+#define ETCPAL_EVENT_GROUP_WAKES_MULTIPLE_THREADS 1
 #define ETCPAL_EVENT_GROUP_NUM_USABLE_BITS        32
 
 bool                etcpal_event_group_create(etcpal_event_group_t* id);
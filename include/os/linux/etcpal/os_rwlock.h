@@ -31,7 +31,7 @@ extern "C" {
 typedef pthread_rwlock_t etcpal_rwlock_t;
 #define ETCPAL_RWLOCK_INIT PTHREAD_RWLOCK_INITIALIZER
 
-#define ETCPAL_RWLOCK_HAS_TIMED_LOCK 0
+#define ETCPAL_RWLOCK_HAS_TIMED_LOCK 1
 
 #define etcpal_rwlock_create(idptr)       ((bool)(!pthread_rwlock_init((idptr), NULL)))
 #define etcpal_rwlock_readlock(idptr)     ((bool)(!pthread_rwlock_rdlock(idptr)))
@@ -22,6 +22,7 @@
 
 #include <sys/socket.h>
 #include "etcpal/inet.h"
+#include "etcpal/mutex.h"
 #include "etcpal/rbtree.h"
 
 #ifdef __cplusplus
@@ -43,9 +44,15 @@ typedef int etcpal_socket_t;
 
 typedef struct EtcPalPollContext
 {
-  bool         valid;
-  int          epoll_fd;
-  EtcPalRbTree sockets;
+  bool           valid;
+  bool           multithreaded;
+  etcpal_mutex_t lock;
+  int            epoll_fd;
+  EtcPalRbTree   sockets;
+  EtcPalRbTree   timers;
+  uint32_t       next_generation;
+  int            wakeup_fd;
+  void*          wakeup_user_data;
 } EtcPalPollContext;
 #define ETCPAL_POLL_CONTEXT_INIT \
   {                              \
@@ -22,16 +22,32 @@
 
 #include <stdbool.h>
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define ETCPAL_THREAD_DEFAULT_PRIORITY 0    /* Priority ignored on Linux */
+/* Platform-specific thread parameters, pointed to by EtcPalThreadParams::platform_data */
+typedef struct EtcPalThreadParamsLinux
+{
+  /* The scheduling policy: SCHED_OTHER (the default), SCHED_FIFO or SCHED_RR. */
+  int sched_policy;
+  /* A mask of CPUs the thread may run on, where bit n represents CPU n. 0 means no restriction. */
+  unsigned long long cpu_affinity;
+} EtcPalThreadParamsLinux;
+
+#define ETCPAL_THREAD_LINUX_PARAMS_INIT \
+  {                                     \
+    SCHED_OTHER, 0                      \
+  }
+
+#define ETCPAL_THREAD_DEFAULT_PRIORITY 0    /* Priority only honored with SCHED_FIFO or SCHED_RR */
 #define ETCPAL_THREAD_DEFAULT_STACK    0    /* 0 means keep default */
 #define ETCPAL_THREAD_DEFAULT_NAME     NULL /* Name ignored on Linux */
 #define ETCPAL_THREAD_HAS_TIMED_JOIN   0    /* Timeout unavailable on linux */
+#define ETCPAL_THREAD_HAS_SCHED_PARAMS 1    /* EtcPalThreadParamsLinux available */
 
 #define ETCPAL_THREAD_NAME_MAX_LENGTH 16
 
@@ -51,7 +51,8 @@ typedef int etcpal_socket_t;
 #define ETCPAL_SOCKET_INVALID -1
 #define ETCPAL_SOCKET_INIT    ETCPAL_SOCKET_INVALID
 
-#define ETCPAL_SOCKET_MAX_POLL_SIZE FD_SETSIZE
+#define ETCPAL_SOCKET_MAX_POLL_SIZE   FD_SETSIZE
+#define ETCPAL_SOCKET_MAX_POLL_TIMERS 8
 
 /* Definitions for etcpal_poll API */
 
@@ -62,6 +63,15 @@ typedef struct EtcPalPollSocket
   void*                user_data;
 } EtcPalPollSocket;
 
+typedef struct EtcPalPollTimer
+{
+  bool     valid;
+  bool     armed;
+  uint32_t expiry_ms;
+  uint32_t interval_ms;
+  void*    user_data;
+} EtcPalPollTimer;
+
 typedef struct EtcPalPollFdSet
 {
   fd_set set;
@@ -76,6 +86,13 @@ typedef struct EtcPalPollContext
   size_t           num_valid_sockets;
   int              max_fd;
 
+  EtcPalPollTimer timers[ETCPAL_SOCKET_MAX_POLL_TIMERS];
+  size_t          num_valid_timers;
+
+  etcpal_socket_t wakeup_recv_sock;
+  etcpal_socket_t wakeup_send_sock;
+  void*           wakeup_user_data;
+
   EtcPalPollFdSet readfds;
   EtcPalPollFdSet writefds;
   EtcPalPollFdSet exceptfds;
@@ -22,32 +22,32 @@
 
 #include "etcpal/common.h"
 #include "etcpal/queue.h"
+#include "etcpal/mutex.h"
 #include "etcpal/sem.h"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct EtcPalQueueNode
-{
-  void* data;
-} EtcPalQueueNode;
-
 typedef struct
 {
-  unsigned         head;
-  unsigned         tail;
-  EtcPalQueueNode* node_list;
-  size_t           max_queue_size;
-  size_t           queue_size;
-
-  etcpal_sem_t lock;
-  etcpal_sem_t spots_available;
-  etcpal_sem_t spots_filled;
-  size_t       element_size;
+  uint8_t*       buffer;
+  void*          buffer_mem;
+  size_t         element_size;
+  size_t         index_mask;
+  size_t         head;
+  size_t         tail;
+  size_t         max_queue_size;
+  size_t         queue_size;
+  unsigned int   send_waiters;
+  unsigned int   receive_waiters;
+  etcpal_mutex_t lock;
+  etcpal_sem_t   spots_available;
+  etcpal_sem_t   spots_filled;
 } etcpal_queue_t;
 #define ETCPAL_QUEUE_INIT \
   {                       \
@@ -61,13 +61,15 @@ bool etcpal_queue_create(etcpal_queue_t* id, size_t size, size_t item_size);
 bool etcpal_queue_create_static(etcpal_queue_t* id, size_t size, size_t item_size, uint8_t* buffer);
 void etcpal_queue_destroy(etcpal_queue_t* id);
 
-bool etcpal_queue_send(etcpal_queue_t* id, const void* data);
-bool etcpal_queue_timed_send(etcpal_queue_t* id, const void* data, int timeout_ms);
-bool etcpal_queue_send_from_isr(etcpal_queue_t* id, const void* data);
+bool   etcpal_queue_send(etcpal_queue_t* id, const void* data);
+bool   etcpal_queue_timed_send(etcpal_queue_t* id, const void* data, int timeout_ms);
+bool   etcpal_queue_send_from_isr(etcpal_queue_t* id, const void* data);
+size_t etcpal_queue_send_many(etcpal_queue_t* id, const void* data, size_t num_items, int timeout_ms);
 
-bool etcpal_queue_receive(etcpal_queue_t* id, void* data);
-bool etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms);
-bool etcpal_queue_receive_from_isr(etcpal_queue_t* id, void* data);
+bool   etcpal_queue_receive(etcpal_queue_t* id, void* data);
+bool   etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms);
+bool   etcpal_queue_receive_from_isr(etcpal_queue_t* id, void* data);
+size_t etcpal_queue_receive_many(etcpal_queue_t* id, void* data, size_t max_items, int timeout_ms);
 
 bool etcpal_queue_reset(etcpal_queue_t* id);
 
@@ -24,6 +24,7 @@
 #include <sys/select.h>
 #include <sys/socket.h>
 #include "etcpal/inet.h"
+#include "etcpal/mutex.h"
 #include "etcpal/rbtree.h"
 
 #ifdef __cplusplus
@@ -45,9 +46,15 @@ typedef int etcpal_socket_t;
 
 typedef struct EtcPalPollContext
 {
-  bool         valid;
-  int          kq_fd;
-  EtcPalRbTree sockets;
+  bool           valid;
+  bool           multithreaded;
+  etcpal_mutex_t lock;
+  int            kq_fd;
+  EtcPalRbTree   sockets;
+  EtcPalRbTree   timers;
+  int            next_timer_id;
+  int            wakeup_fds[2];
+  void*          wakeup_user_data;
 } EtcPalPollContext;
 #define ETCPAL_POLL_CONTEXT_INIT \
   {                              \
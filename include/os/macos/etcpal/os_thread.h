@@ -32,6 +32,7 @@ extern "C" {
 #define ETCPAL_THREAD_DEFAULT_STACK    0    /* 0 means keep default */
 #define ETCPAL_THREAD_DEFAULT_NAME     NULL /* Name ignored on macOS */
 #define ETCPAL_THREAD_HAS_TIMED_JOIN   0    /* Timeout unavailable on macOS */
+#define ETCPAL_THREAD_HAS_SCHED_PARAMS 0
 
 #define ETCPAL_THREAD_NAME_MAX_LENGTH 16
 
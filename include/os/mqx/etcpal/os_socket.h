@@ -41,7 +41,8 @@ typedef uint32_t etcpal_socket_t;
 #define ETCPAL_SOCKET_INVALID RTCS_SOCKET_ERROR
 #define ETCPAL_SOCKET_INIT    ETCPAL_SOCKET_INVALID
 
-#define ETCPAL_SOCKET_MAX_POLL_SIZE RTCSCFG_FD_SETSIZE
+#define ETCPAL_SOCKET_MAX_POLL_SIZE   RTCSCFG_FD_SETSIZE
+#define ETCPAL_SOCKET_MAX_POLL_TIMERS 8
 
 typedef struct EtcPalPollCtxSocket
 {
@@ -50,6 +51,15 @@ typedef struct EtcPalPollCtxSocket
   void*                user_data;
 } EtcPalPollCtxSocket;
 
+typedef struct EtcPalPollTimer
+{
+  bool     valid;
+  bool     armed;
+  uint32_t expiry_ms;
+  uint32_t interval_ms;
+  void*    user_data;
+} EtcPalPollTimer;
+
 typedef struct EtcPalPollFdSet
 {
   rtcs_fd_set set;
@@ -63,6 +73,13 @@ typedef struct EtcPalPollContext
   EtcPalPollCtxSocket sockets[ETCPAL_SOCKET_MAX_POLL_SIZE];
   size_t              num_valid_sockets;
 
+  EtcPalPollTimer timers[ETCPAL_SOCKET_MAX_POLL_TIMERS];
+  size_t          num_valid_timers;
+
+  etcpal_socket_t wakeup_recv_sock;
+  etcpal_socket_t wakeup_send_sock;
+  void*           wakeup_user_data;
+
   EtcPalPollFdSet readfds;
   EtcPalPollFdSet writefds;
 } EtcPalPollContext;
@@ -40,6 +40,7 @@ typedef struct EtcPalThreadParamsMqx
 #define ETCPAL_THREAD_MQX_DEFAULT_ATTRIBUTES 0
 #define ETCPAL_THREAD_MQX_DEFAULT_TIME_SLICE 0
 #define ETCPAL_THREAD_HAS_TIMED_JOIN         0 /* Timeout unavailable on mqx */
+#define ETCPAL_THREAD_HAS_SCHED_PARAMS       0
 
 typedef _task_id etcpal_thread_os_handle_t;
 #define ETCPAL_THREAD_OS_HANDLE_INVALID MQX_NULL_TASK_ID
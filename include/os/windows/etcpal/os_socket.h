@@ -69,6 +69,12 @@ typedef struct EtcPalPollContext
   etcpal_mutex_t lock;
 
   EtcPalRbTree sockets;
+  EtcPalRbTree timers;
+  int          next_timer_id;
+
+  etcpal_socket_t wakeup_recv_sock;
+  etcpal_socket_t wakeup_send_sock;
+  void*           wakeup_user_data;
 
   EtcPalPollFdSet readfds;
   EtcPalPollFdSet writefds;
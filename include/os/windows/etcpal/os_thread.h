@@ -44,6 +44,7 @@ extern "C" {
 #define ETCPAL_THREAD_DEFAULT_STACK    0
 #define ETCPAL_THREAD_DEFAULT_NAME     "etcpal_thread"
 #define ETCPAL_THREAD_HAS_TIMED_JOIN   1
+#define ETCPAL_THREAD_HAS_SCHED_PARAMS 0
 
 #define ETCPAL_THREAD_NAME_MAX_LENGTH 32
 
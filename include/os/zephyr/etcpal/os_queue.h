@@ -52,10 +52,12 @@ void etcpal_queue_destroy(etcpal_queue_t* id);
 #define etcpal_queue_send(idptr, dataptr) (etcpal_queue_timed_send((idptr), (dataptr), ETCPAL_WAIT_FOREVER))
 bool etcpal_queue_timed_send(etcpal_queue_t* id, const void* data, int timeout_ms);
 #define etcpal_queue_send_from_isr(idptr, dataptr) etcpal_queue_timed_send((idptr), (dataptr), ETCPAL_NO_WAIT)
+size_t etcpal_queue_send_many(etcpal_queue_t* id, const void* data, size_t num_items, int timeout_ms);
 
 #define etcpal_queue_receive(idptr, dataptr) (etcpal_queue_timed_receive((idptr), (dataptr), ETCPAL_WAIT_FOREVER))
 bool etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms);
 #define etcpal_queue_receive_from_isr(idptr, dataptr) etcpal_queue_timed_receive((idptr), (dataptr), ETCPAL_NO_WAIT)
+size_t etcpal_queue_receive_many(etcpal_queue_t* id, void* data, size_t max_items, int timeout_ms);
 
 bool etcpal_queue_reset(etcpal_queue_t* id);
 
@@ -33,7 +33,8 @@ extern "C" {
 #define ETCPAL_THREAD_DEFAULT_NAME     "etcpal_thread"
 #define ETCPAL_THREAD_NAME_MAX_LENGTH  CONFIG_THREAD_MAX_NAME_LEN
 
-#define ETCPAL_THREAD_HAS_TIMED_JOIN 1
+#define ETCPAL_THREAD_HAS_TIMED_JOIN   1
+#define ETCPAL_THREAD_HAS_SCHED_PARAMS 0
 
 typedef k_tid_t etcpal_thread_os_handle_t;
 #define ETCPAL_THREAD_OS_HANDLE_INVALID NULL
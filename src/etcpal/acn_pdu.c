@@ -19,6 +19,12 @@
 
 #include "etcpal/acn_pdu.h"
 
+static bool parse_pdu_at(const uint8_t*           this_pdu,
+                         const uint8_t*           buf_end,
+                         const AcnPduConstraints* constraints,
+                         bool                     first_in_block,
+                         AcnPdu*                  pdu);
+
 /**
  * @brief Parse a generic ACN PDU.
  *
@@ -39,22 +45,92 @@ bool acn_parse_pdu(const uint8_t* buf, size_t buflen, const AcnPduConstraints* c
 
   const uint8_t* buf_end = buf + buflen;
 
-  const uint8_t* this_pdu  = buf;
-  const uint8_t* prev_vect = NULL;
-  const uint8_t* prev_head = NULL;
-  const uint8_t* prev_data = NULL;
   if (pdu->pnextpdu)
   {
     // We have already parsed one or more PDUs in this block. Try to parse the next one.
     if (pdu->pnextpdu < buf || pdu->pnextpdu >= buf_end)
       return false;
 
-    this_pdu  = pdu->pnextpdu;
-    prev_vect = pdu->pvector;
-    prev_head = pdu->pheader;
-    prev_data = pdu->pdata;
+    return parse_pdu_at(pdu->pnextpdu, buf_end, constraints, false, pdu);
   }
-  // Else this is the first PDU in the block - leave pointers at their default values
+
+  // Else this is the first PDU in the block
+  return parse_pdu_at(buf, buf_end, constraints, true, pdu);
+}
+
+/**
+ * @brief Parse all PDUs in a generic ACN PDU block in one pass.
+ *
+ * Equivalent to calling acn_parse_pdu() repeatedly and copying out the AcnPdu after each call, but
+ * without the per-call overhead. Each PDU filled in points into buf; no data is copied.
+ *
+ * Parsing stops at the end of the block, at the first PDU which fails to parse, or when max_pdus
+ * PDUs have been parsed. If last_pdu is provided, it is left describing the last PDU parsed, so
+ * that a further call continues where this one stopped, and the whole block was parsed
+ * successfully once last_pdu->pnextpdu == buf + buflen.
+ *
+ * @param[in] buf Byte buffer containing a PDU block.
+ * @param[in] buflen Size in bytes of buf.
+ * @param[in] constraints Specific information about the PDUs being parsed.
+ * @param[in,out] last_pdu (optional) PDU data from the last PDU parsed in this block, which must be
+ *                         initialized with #ACN_PDU_INIT before the first call. Replaced with data
+ *                         from the last PDU parsed by this call. If NULL, parsing starts at the
+ *                         beginning of the block.
+ * @param[out] pdus Array of PDUs to fill in.
+ * @param[in] max_pdus Size of the pdus array.
+ * @return Number of PDUs parsed.
+ */
+size_t acn_parse_pdu_block(const uint8_t*           buf,
+                           size_t                   buflen,
+                           const AcnPduConstraints* constraints,
+                           AcnPdu*                  last_pdu,
+                           AcnPdu*                  pdus,
+                           size_t                   max_pdus)
+{
+  if (!buf || !buflen || !constraints || !pdus)
+    return 0;
+
+  const uint8_t* buf_end  = buf + buflen;
+  const uint8_t* this_pdu = buf;
+  bool           first    = true;
+  AcnPdu         cur_pdu  = ACN_PDU_INIT;
+  if (last_pdu && last_pdu->pnextpdu)
+  {
+    if (last_pdu->pnextpdu < buf || last_pdu->pnextpdu >= buf_end)
+      return 0;
+
+    cur_pdu  = *last_pdu;
+    this_pdu = last_pdu->pnextpdu;
+    first    = false;
+  }
+
+  size_t num_parsed = 0;
+  while (num_parsed < max_pdus && this_pdu < buf_end && parse_pdu_at(this_pdu, buf_end, constraints, first, &cur_pdu))
+  {
+    pdus[num_parsed++] = cur_pdu;
+    this_pdu           = cur_pdu.pnextpdu;
+    first              = false;
+  }
+
+  if (last_pdu && num_parsed > 0)
+    *last_pdu = cur_pdu;
+  return num_parsed;
+}
+
+/*
+ * Parse the PDU starting at this_pdu, inheriting from the previous PDU in the block (described by
+ * the existing contents of pdu) as needed. pdu is only modified on success.
+ */
+bool parse_pdu_at(const uint8_t*           this_pdu,
+                  const uint8_t*           buf_end,
+                  const AcnPduConstraints* constraints,
+                  bool                     first_in_block,
+                  AcnPdu*                  pdu)
+{
+  // The first PDU in a block has nothing to inherit from
+  const uint8_t* prev_vect = first_in_block ? NULL : pdu->pvector;
+  const uint8_t* prev_head = first_in_block ? NULL : pdu->pheader;
+  const uint8_t* prev_data = first_in_block ? NULL : pdu->pdata;
 
   // Check the inheritance and the size of the length field
   uint8_t flags_byte  = *this_pdu;
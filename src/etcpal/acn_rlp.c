@@ -49,6 +49,7 @@ static void evaluate_pdu_inheritance(const AcnRootLayerPdu* pdu_block,
                                      AcnRootLayerPdu*       last_pdu,
                                      uint8_t*               cur_ptr,
                                      PduInheritance*        inheritance);
+static size_t pack_pdu_header(uint8_t* buf, const AcnRootLayerPdu* pdu, const PduInheritance* inheritance);
 
 /**
  * @brief Parse an ACN TCP Preamble.
@@ -378,45 +379,81 @@ size_t acn_pack_root_layer_block(uint8_t* buf, size_t buflen, const AcnRootLayer
   {
     PduInheritance inheritance = {false, false, false};
     evaluate_pdu_inheritance(pdu_block, pdu, &last_pdu, cur_ptr, &inheritance);
+    cur_ptr += pack_pdu_header(cur_ptr, pdu, &inheritance);
 
-    // Check if we are required to use the 3-byte length field, either by the higher-level protocol
-    // or because the length is greater than 4096
-    if (PROT_MANDATES_L_FLAG(pdu->vector) ||
-        RLP_EXTENDED_LENGTH(inheritance.vector, inheritance.header, inheritance.data ? 0 : pdu->data_len))
-    {
-      size_t len = 3u + (inheritance.vector ? 0u : RLP_VECTOR_SIZE) + (inheritance.header ? 0u : ACN_RLP_HEADER_SIZE) +
-                   (inheritance.data ? 0u : pdu->data_len);
-      ACN_PDU_SET_L_FLAG(*cur_ptr);
-      ACN_PDU_PACK_EXT_LEN(cur_ptr, len);
-      cur_ptr += 3;
-    }
-    else
+    if (!inheritance.data)
     {
-      size_t len = 2 + (inheritance.vector ? 0u : RLP_VECTOR_SIZE) + (inheritance.header ? 0u : ACN_RLP_HEADER_SIZE) +
-                   (inheritance.data ? 0u : pdu->data_len);
-      ACN_PDU_PACK_NORMAL_LEN(cur_ptr, len);
-      cur_ptr += 2;
+      memcpy(cur_ptr, pdu->pdata, pdu->data_len);
+      cur_ptr += pdu->data_len;
     }
+  }
+  return (size_t)(cur_ptr - buf);
+}
 
-    if (!inheritance.vector)
-    {
-      etcpal_pack_u32b(cur_ptr, pdu->vector);
-      cur_ptr += 4;
-    }
+/**
+ * @brief Pack a Root Layer PDU block as a list of buffers, without copying the PDU data.
+ *
+ * Produces the same bytes as acn_pack_root_layer_block(), but only the PDU headers are packed
+ * (into header_buf); the data segments are referenced in place. The resulting list of buffers can
+ * be passed to etcpal_sendmsg(), optionally after a buffer containing an ACN preamble. The
+ * referenced data must remain valid until the buffers have been sent.
+ *
+ * The total length of the block is the sum of the lengths of the buffers filled in.
+ *
+ * @param[out] header_buf Buffer into which to pack the Root Layer PDU headers.
+ * @param[in] header_buflen Size in bytes of header_buf. Should be at least
+ *                          #ACN_RLP_IOV_HEADER_BUF_SIZE(num_pdus).
+ * @param[in] pdu_block Array of AcnRootLayerPdu representing the PDU block to pack.
+ * @param[in] num_pdus Number of AcnRootLayerPdu that make up the pdu_block array.
+ * @param[out] iov Array of buffers to fill in.
+ * @param[in] max_iov Size of the iov array. #ACN_RLP_IOV_MAX_COUNT(num_pdus) is always enough.
+ * @return Number of buffers filled in (success) or 0 (failure).
+ */
+size_t acn_pack_root_layer_block_iov(uint8_t*               header_buf,
+                                     size_t                 header_buflen,
+                                     const AcnRootLayerPdu* pdu_block,
+                                     size_t                 num_pdus,
+                                     EtcPalIoVec*           iov,
+                                     size_t                 max_iov)
+{
+  if (!header_buf || !pdu_block || !iov || num_pdus == 0 || header_buflen < ACN_RLP_IOV_HEADER_BUF_SIZE(num_pdus))
+    return 0;
 
-    if (!inheritance.header)
-    {
-      memcpy(cur_ptr, pdu->sender_cid.data, ETCPAL_UUID_BYTES);
-      cur_ptr += ETCPAL_UUID_BYTES;
-    }
+  uint8_t*        cur_ptr      = header_buf;
+  uint8_t*        header_start = header_buf;
+  size_t          num_iov      = 0;
+  AcnRootLayerPdu last_pdu     = {{{0}}, 0, NULL, 0};
+  for (const AcnRootLayerPdu* pdu = pdu_block; pdu < pdu_block + num_pdus; ++pdu)
+  {
+    PduInheritance inheritance = {false, false, false};
+    evaluate_pdu_inheritance(pdu_block, pdu, &last_pdu, cur_ptr, &inheritance);
+    cur_ptr += pack_pdu_header(cur_ptr, pdu, &inheritance);
 
-    if (!inheritance.data)
+    // Headers of consecutive PDUs that inherit their data are contiguous in header_buf and share
+    // one buffer.
+    if (!inheritance.data && pdu->data_len > 0)
     {
-      memcpy(cur_ptr, pdu->pdata, pdu->data_len);
-      cur_ptr += pdu->data_len;
+      if (num_iov + 2 > max_iov)
+        return 0;
+      iov[num_iov].base = header_start;
+      iov[num_iov].len  = (size_t)(cur_ptr - header_start);
+      ++num_iov;
+      iov[num_iov].base = pdu->pdata;
+      iov[num_iov].len  = pdu->data_len;
+      ++num_iov;
+      header_start = cur_ptr;
     }
   }
-  return (size_t)(cur_ptr - buf);
+
+  if (cur_ptr > header_start)
+  {
+    if (num_iov + 1 > max_iov)
+      return 0;
+    iov[num_iov].base = header_start;
+    iov[num_iov].len  = (size_t)(cur_ptr - header_start);
+    ++num_iov;
+  }
+  return num_iov;
 }
 
 void evaluate_pdu_inheritance(const AcnRootLayerPdu* pdu_block,
@@ -480,3 +517,41 @@ void evaluate_pdu_inheritance(const AcnRootLayerPdu* pdu_block,
     }
   }
 }
+
+size_t pack_pdu_header(uint8_t* buf, const AcnRootLayerPdu* pdu, const PduInheritance* inheritance)
+{
+  uint8_t* cur_ptr = buf;
+
+  // Check if we are required to use the 3-byte length field, either by the higher-level protocol
+  // or because the length is greater than 4096
+  if (PROT_MANDATES_L_FLAG(pdu->vector) ||
+      RLP_EXTENDED_LENGTH(inheritance->vector, inheritance->header, inheritance->data ? 0 : pdu->data_len))
+  {
+    size_t len = 3u + (inheritance->vector ? 0u : RLP_VECTOR_SIZE) + (inheritance->header ? 0u : ACN_RLP_HEADER_SIZE) +
+                 (inheritance->data ? 0u : pdu->data_len);
+    ACN_PDU_SET_L_FLAG(*cur_ptr);
+    ACN_PDU_PACK_EXT_LEN(cur_ptr, len);
+    cur_ptr += 3;
+  }
+  else
+  {
+    size_t len = 2 + (inheritance->vector ? 0u : RLP_VECTOR_SIZE) + (inheritance->header ? 0u : ACN_RLP_HEADER_SIZE) +
+                 (inheritance->data ? 0u : pdu->data_len);
+    ACN_PDU_PACK_NORMAL_LEN(cur_ptr, len);
+    cur_ptr += 2;
+  }
+
+  if (!inheritance->vector)
+  {
+    etcpal_pack_u32b(cur_ptr, pdu->vector);
+    cur_ptr += 4;
+  }
+
+  if (!inheritance->header)
+  {
+    memcpy(cur_ptr, pdu->sender_cid.data, ETCPAL_UUID_BYTES);
+    cur_ptr += ETCPAL_UUID_BYTES;
+  }
+
+  return (size_t)(cur_ptr - buf);
+}
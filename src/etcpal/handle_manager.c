@@ -20,6 +20,27 @@
 #include "etcpal/handle_manager.h"
 
 #include <limits.h>
+#include <stdlib.h>
+
+/****************************** Private macros *******************************/
+
+// A slot's generation is incremented both when it is allocated and when it is freed, so it is odd
+// while the slot is in use. The handle for a slot combines the number of times the slot has been
+// allocated, truncated to the bits left over in a non-negative int, with the slot index.
+#define SLOT_IN_USE(slot)          (((slot)->generation & 1u) != 0)
+#define INDEX_MASK(table)          ((1u << (table)->index_bits) - 1u)
+#define GENERATION_MASK(table)     ((1u << (31u - (table)->index_bits)) - 1u)
+#define NO_FREE_SLOT               (-1)
+#define MIN_DYNAMIC_TABLE_CAPACITY 16u
+
+/*********************** Private function prototypes *************************/
+
+static etcpal_error_t init_table(EtcPalHandleTable* table, size_t max_size);
+static void           push_free_slot(EtcPalHandleTable* table, size_t index);
+static bool           grow_table(EtcPalHandleTable* table);
+static int            handle_for(const EtcPalHandleTable* table, size_t index);
+
+/*************************** Function definitions ****************************/
 
 /**
  * @brief Initialize an IntHandleManager instance.
@@ -86,3 +107,282 @@ int get_next_int_handle(IntHandleManager* manager)
 
   return new_handle;
 }
+
+/**
+ * @brief Initialize a handle table which allocates and grows its own storage.
+ *
+ * No memory is allocated until the first handle is allocated. The storage is freed by
+ * etcpal_handle_table_deinit().
+ *
+ * @param[out] table The handle table to initialize.
+ * @param[in] max_size The maximum number of handles which can be allocated at once. Must be at most
+ *                     #ETCPAL_HANDLE_TABLE_MAX_SIZE. Smaller values leave more bits of each handle
+ *                     for detecting stale handles.
+ * @return #kEtcPalErrOk: The handle table was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ */
+etcpal_error_t etcpal_handle_table_init(EtcPalHandleTable* table, size_t max_size)
+{
+  return init_table(table, max_size);
+}
+
+/**
+ * @brief Initialize a handle table which uses fixed storage provided by the application.
+ *
+ * The handle table never allocates memory, and can hold at most capacity handles at once. Slot
+ * indices returned by the handle table are less than capacity.
+ *
+ * @param[out] table The handle table to initialize.
+ * @param[in] slots Storage for the slots of the handle table. Must remain valid for the lifetime of
+ *                  the handle table.
+ * @param[in] capacity The number of slots in the slots array. Must be at most
+ *                     #ETCPAL_HANDLE_TABLE_MAX_SIZE.
+ * @return #kEtcPalErrOk: The handle table was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ */
+etcpal_error_t etcpal_handle_table_init_static(EtcPalHandleTable* table, EtcPalHandleSlot* slots, size_t capacity)
+{
+  if (!slots)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = init_table(table, capacity);
+  if (res != kEtcPalErrOk)
+    return res;
+
+  table->slots        = slots;
+  table->capacity     = capacity;
+  table->owns_storage = false;
+  for (size_t i = 0; i < capacity; ++i)
+  {
+    slots[i].generation = 0;
+    push_free_slot(table, i);
+  }
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Deinitialize a handle table, freeing its storage if it was allocated by the handle table.
+ *
+ * All handles are invalidated. A handle table with its own storage can be reused afterward.
+ *
+ * @param[in] table The handle table to deinitialize.
+ */
+void etcpal_handle_table_deinit(EtcPalHandleTable* table)
+{
+  if (!table)
+    return;
+
+  if (table->owns_storage)
+  {
+    free(table->slots);
+    table->slots     = NULL;
+    table->capacity  = 0;
+    table->free_head = NO_FREE_SLOT;
+    table->free_tail = NO_FREE_SLOT;
+    table->size      = 0;
+  }
+  else
+  {
+    etcpal_handle_table_clear(table);
+  }
+}
+
+/**
+ * @brief Allocate a new handle.
+ *
+ * Runs in constant time, apart from growing the storage of a handle table which owns its storage.
+ * Freed slots are reused in the order they were freed, which maximizes the time before a stale
+ * handle's value is handed out again.
+ *
+ * @param[in,out] table The handle table to allocate from.
+ * @param[out] index Optionally filled in with the slot index of the new handle. May be NULL.
+ * @return The new handle, which is non-negative, or -1 if the table is full or out of memory.
+ */
+int etcpal_handle_table_alloc(EtcPalHandleTable* table, size_t* index)
+{
+  if (!table)
+    return -1;
+
+  if (table->free_head == NO_FREE_SLOT && !grow_table(table))
+    return -1;
+
+  size_t            new_index = (size_t)table->free_head;
+  EtcPalHandleSlot* slot      = &table->slots[new_index];
+
+  table->free_head = slot->next_free;
+  if (table->free_head == NO_FREE_SLOT)
+    table->free_tail = NO_FREE_SLOT;
+
+  ++slot->generation;
+  slot->next_free = NO_FREE_SLOT;
+  ++table->size;
+
+  if (index)
+    *index = new_index;
+  return handle_for(table, new_index);
+}
+
+/**
+ * @brief Free a handle so that its slot can be reused.
+ *
+ * After this call, the handle is stale and etcpal_handle_table_lookup() returns -1 for it.
+ *
+ * @param[in,out] table The handle table the handle was allocated from.
+ * @param[in] handle The handle to free.
+ * @return #kEtcPalErrOk: The handle was freed.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNotFound: The handle is not currently allocated.
+ */
+etcpal_error_t etcpal_handle_table_free(EtcPalHandleTable* table, int handle)
+{
+  if (!table)
+    return kEtcPalErrInvalid;
+
+  int index = etcpal_handle_table_lookup(table, handle);
+  if (index < 0)
+    return kEtcPalErrNotFound;
+
+  ++table->slots[index].generation;
+  push_free_slot(table, (size_t)index);
+  --table->size;
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Find the slot index of a handle.
+ * @param[in] table The handle table the handle was allocated from.
+ * @param[in] handle The handle to look up.
+ * @return The slot index of the handle, or -1 if the handle is not currently allocated.
+ */
+int etcpal_handle_table_lookup(const EtcPalHandleTable* table, int handle)
+{
+  if (!table || handle < 0)
+    return -1;
+
+  size_t index = (size_t)handle & INDEX_MASK(table);
+  if (index >= table->capacity || !SLOT_IN_USE(&table->slots[index]) || handle_for(table, index) != handle)
+    return -1;
+  return (int)index;
+}
+
+/**
+ * @brief Get the handle currently allocated at a slot index.
+ *
+ * Can be used to iterate over the allocated handles by looping over the slot indices from 0 to
+ * etcpal_handle_table_capacity().
+ *
+ * @param[in] table The handle table to inspect.
+ * @param[in] index The slot index.
+ * @return The handle allocated at the slot index, or -1 if the slot is not in use.
+ */
+int etcpal_handle_table_handle_at(const EtcPalHandleTable* table, size_t index)
+{
+  if (!table || index >= table->capacity || !SLOT_IN_USE(&table->slots[index]))
+    return -1;
+  return handle_for(table, index);
+}
+
+/**
+ * @brief Free all handles in a handle table.
+ *
+ * All handles previously allocated from the table become stale.
+ *
+ * @param[in,out] table The handle table to clear.
+ */
+void etcpal_handle_table_clear(EtcPalHandleTable* table)
+{
+  if (!table)
+    return;
+
+  for (size_t i = 0; i < table->capacity; ++i)
+  {
+    if (SLOT_IN_USE(&table->slots[i]))
+    {
+      ++table->slots[i].generation;
+      push_free_slot(table, i);
+    }
+  }
+  table->size = 0;
+}
+
+/**
+ * @brief Get the number of handles currently allocated from a handle table.
+ * @param[in] table The handle table.
+ * @return The number of allocated handles.
+ */
+size_t etcpal_handle_table_size(const EtcPalHandleTable* table)
+{
+  return table ? table->size : 0;
+}
+
+/**
+ * @brief Get the number of slots currently in a handle table.
+ *
+ * All slot indices returned by the handle table are less than this value.
+ *
+ * @param[in] table The handle table.
+ * @return The number of slots.
+ */
+size_t etcpal_handle_table_capacity(const EtcPalHandleTable* table)
+{
+  return table ? table->capacity : 0;
+}
+
+etcpal_error_t init_table(EtcPalHandleTable* table, size_t max_size)
+{
+  if (!table || max_size == 0 || max_size > ETCPAL_HANDLE_TABLE_MAX_SIZE)
+    return kEtcPalErrInvalid;
+
+  table->slots        = NULL;
+  table->capacity     = 0;
+  table->max_size     = max_size;
+  table->size         = 0;
+  table->free_head    = NO_FREE_SLOT;
+  table->free_tail    = NO_FREE_SLOT;
+  table->owns_storage = true;
+
+  // Use as few index bits as possible, to leave as many generation bits as possible.
+  table->index_bits = 1;
+  while (((size_t)1 << table->index_bits) < max_size)
+    ++table->index_bits;
+  return kEtcPalErrOk;
+}
+
+void push_free_slot(EtcPalHandleTable* table, size_t index)
+{
+  table->slots[index].next_free = NO_FREE_SLOT;
+  if (table->free_tail == NO_FREE_SLOT)
+    table->free_head = (int32_t)index;
+  else
+    table->slots[table->free_tail].next_free = (int32_t)index;
+  table->free_tail = (int32_t)index;
+}
+
+bool grow_table(EtcPalHandleTable* table)
+{
+  if (!table->owns_storage || table->capacity >= table->max_size)
+    return false;
+
+  size_t new_capacity = (table->capacity == 0) ? MIN_DYNAMIC_TABLE_CAPACITY : table->capacity * 2;
+  if (new_capacity > table->max_size)
+    new_capacity = table->max_size;
+
+  EtcPalHandleSlot* new_slots = (EtcPalHandleSlot*)realloc(table->slots, new_capacity * sizeof(EtcPalHandleSlot));
+  if (!new_slots)
+    return false;
+
+  table->slots = new_slots;
+  for (size_t i = table->capacity; i < new_capacity; ++i)
+  {
+    new_slots[i].generation = 0;
+    push_free_slot(table, i);
+  }
+  table->capacity = new_capacity;
+  return true;
+}
+
+int handle_for(const EtcPalHandleTable* table, size_t index)
+{
+  uint32_t generation = (table->slots[index].generation >> 1) & GENERATION_MASK(table);
+  return (int)((generation << table->index_bits) | (uint32_t)index);
+}
@@ -0,0 +1,509 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/hashmap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/****************************** Private macros *******************************/
+
+// Each slot is laid out as: [uint32_t hash][padding][key][value], with the key and value each
+// starting on an 8-byte boundary. A stored hash of 0 marks an empty slot.
+#define SLOT_HEADER_SIZE 8u
+#define EMPTY_SLOT_HASH  0u
+
+#define SLOT_AT(map, index)   ((map)->slots + (index) * (map)->slot_size)
+#define SLOT_HASH(slot)       (*(uint32_t*)(slot))
+#define SLOT_KEY(slot)        ((slot) + SLOT_HEADER_SIZE)
+#define SLOT_VALUE(map, slot) ((slot) + SLOT_HEADER_SIZE + ETCPAL_HASHMAP_ALIGN_UP((map)->key_size))
+
+// Hash maps with their own storage grow when they would become more than 3/4 full.
+#define HASHMAP_MIN_DYNAMIC_CAPACITY 16u
+#define HASHMAP_EXCEEDS_MAX_LOAD(size, capacity) ((size)*4u > (capacity)*3u)
+
+/*********************** Private function prototypes *************************/
+
+static uint32_t hash_key(const EtcPalHashMap* map, const void* key);
+static bool     keys_equal(const EtcPalHashMap* map, const void* key_a, const void* key_b);
+static size_t   home_index(const EtcPalHashMap* map, uint32_t hash);
+static uint8_t* find_slot(const EtcPalHashMap* map, const void* key, uint32_t hash);
+static void     place_entry(EtcPalHashMap* map, uint32_t hash, const void* key, const void* value);
+static bool     resize(EtcPalHashMap* map, size_t new_capacity);
+static uint32_t mix32(uint32_t hash);
+
+/*************************** Function definitions ****************************/
+
+/**
+ * @brief Initialize a hash map which allocates and grows its own storage.
+ *
+ * No memory is allocated until the first insertion or call to etcpal_hashmap_reserve(). The
+ * storage is freed by etcpal_hashmap_deinit().
+ *
+ * @param[out] map The hash map to initialize.
+ * @param[in] key_size The size in bytes of each key.
+ * @param[in] value_size The size in bytes of each value. May be 0 to use the hash map as a set.
+ * @param[in] hash_fn Function to hash keys, or NULL to hash the bytes of the key.
+ * @param[in] key_equal_fn Function to compare keys, or NULL to compare the bytes of the key.
+ * @return #kEtcPalErrOk: The hash map was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ */
+etcpal_error_t etcpal_hashmap_init(EtcPalHashMap*            map,
+                                   size_t                    key_size,
+                                   size_t                    value_size,
+                                   EtcPalHashMapHashFunc     hash_fn,
+                                   EtcPalHashMapKeyEqualFunc key_equal_fn)
+{
+  if (!map || key_size == 0)
+    return kEtcPalErrInvalid;
+
+  map->slots        = NULL;
+  map->capacity     = 0;
+  map->size         = 0;
+  map->key_size     = key_size;
+  map->value_size   = value_size;
+  map->slot_size    = ETCPAL_HASHMAP_SLOT_SIZE(key_size, value_size);
+  map->hash_fn      = hash_fn;
+  map->key_equal_fn = key_equal_fn;
+  map->owns_storage = true;
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Initialize a hash map which uses fixed storage provided by the application.
+ *
+ * The hash map never allocates memory, and can hold at most capacity entries.
+ *
+ * @param[out] map The hash map to initialize.
+ * @param[in] key_size The size in bytes of each key.
+ * @param[in] value_size The size in bytes of each value. May be 0 to use the hash map as a set.
+ * @param[in] hash_fn Function to hash keys, or NULL to hash the bytes of the key.
+ * @param[in] key_equal_fn Function to compare keys, or NULL to compare the bytes of the key.
+ * @param[in] storage Storage for the slots of the hash map. Must be at least
+ *                    #ETCPAL_HASHMAP_STORAGE_SIZE(capacity, key_size, value_size) bytes, aligned
+ *                    to 8 bytes, and remain valid for the lifetime of the hash map. Use
+ *                    #ETCPAL_HASHMAP_DEFINE_STORAGE() to define it statically, or allocate it from
+ *                    a memory pool.
+ * @param[in] capacity The number of slots in storage. Lookups are fastest if it is at least 4/3 of
+ *                     the number of entries the hash map is expected to hold.
+ * @return #kEtcPalErrOk: The hash map was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ */
+etcpal_error_t etcpal_hashmap_init_static(EtcPalHashMap*            map,
+                                          size_t                    key_size,
+                                          size_t                    value_size,
+                                          EtcPalHashMapHashFunc     hash_fn,
+                                          EtcPalHashMapKeyEqualFunc key_equal_fn,
+                                          void*                     storage,
+                                          size_t                    capacity)
+{
+  if (!map || key_size == 0 || !storage || capacity == 0 || ((uintptr_t)storage % 8) != 0)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = etcpal_hashmap_init(map, key_size, value_size, hash_fn, key_equal_fn);
+  if (res != kEtcPalErrOk)
+    return res;
+
+  map->slots        = (uint8_t*)storage;
+  map->capacity     = capacity;
+  map->owns_storage = false;
+  etcpal_hashmap_clear(map);
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Deinitialize a hash map, freeing its storage if it was allocated by the hash map.
+ *
+ * The hash map is left empty, and a hash map with its own storage can be reused afterward.
+ *
+ * @param[in] map The hash map to deinitialize.
+ */
+void etcpal_hashmap_deinit(EtcPalHashMap* map)
+{
+  if (!map)
+    return;
+
+  if (map->owns_storage)
+  {
+    free(map->slots);
+    map->slots    = NULL;
+    map->capacity = 0;
+  }
+  map->size = 0;
+}
+
+/**
+ * @brief Find the value associated with a key.
+ *
+ * The returned pointer is invalidated by any subsequent insertion into or removal from the hash
+ * map.
+ *
+ * @param[in] map The hash map to search.
+ * @param[in] key The key to find.
+ * @return Pointer to the value associated with the key, or NULL if the key is not present.
+ */
+void* etcpal_hashmap_find(const EtcPalHashMap* map, const void* key)
+{
+  if (!map || !key || map->size == 0)
+    return NULL;
+
+  uint8_t* slot = find_slot(map, key, hash_key(map, key));
+  return (slot ? SLOT_VALUE(map, slot) : NULL);
+}
+
+/**
+ * @brief Insert a new entry into a hash map.
+ *
+ * The key and value are copied into the hash map.
+ *
+ * @param[in] map The hash map to insert into.
+ * @param[in] key The key to insert.
+ * @param[in] value The value to associate with the key. May be NULL if the value size is 0.
+ * @return #kEtcPalErrOk: The entry was inserted.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrExists: The key is already present; the existing value was not changed.
+ * @return #kEtcPalErrNoMem: The hash map is full (fixed storage) or could not grow.
+ */
+etcpal_error_t etcpal_hashmap_insert(EtcPalHashMap* map, const void* key, const void* value)
+{
+  if (!map || !key || (!value && map->value_size != 0))
+    return kEtcPalErrInvalid;
+
+  uint32_t hash = hash_key(map, key);
+  if (map->size != 0 && find_slot(map, key, hash))
+    return kEtcPalErrExists;
+
+  if (map->owns_storage)
+  {
+    if (map->capacity == 0 || HASHMAP_EXCEEDS_MAX_LOAD(map->size + 1, map->capacity))
+    {
+      size_t new_capacity = (map->capacity == 0 ? HASHMAP_MIN_DYNAMIC_CAPACITY : map->capacity * 2);
+      if (!resize(map, new_capacity))
+        return kEtcPalErrNoMem;
+    }
+  }
+  else if (map->size == map->capacity)
+  {
+    return kEtcPalErrNoMem;
+  }
+
+  place_entry(map, hash, key, value);
+  ++map->size;
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Remove an entry from a hash map.
+ * @param[in] map The hash map to remove from.
+ * @param[in] key The key of the entry to remove.
+ * @return #kEtcPalErrOk: The entry was removed.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNotFound: The key is not present.
+ */
+etcpal_error_t etcpal_hashmap_remove(EtcPalHashMap* map, const void* key)
+{
+  if (!map || !key)
+    return kEtcPalErrInvalid;
+  if (map->size == 0)
+    return kEtcPalErrNotFound;
+
+  uint8_t* slot = find_slot(map, key, hash_key(map, key));
+  if (!slot)
+    return kEtcPalErrNotFound;
+
+  // Backward-shift deletion: move later entries in the same probe run back into the hole, so that
+  // no tombstones are needed and lookups never probe past an empty slot.
+  size_t hole  = (size_t)(slot - map->slots) / map->slot_size;
+  size_t index = hole;
+  for (size_t step = 1; step < map->capacity; ++step)
+  {
+    index              = (index + 1 == map->capacity ? 0 : index + 1);
+    uint8_t* next_slot = SLOT_AT(map, index);
+    if (SLOT_HASH(next_slot) == EMPTY_SLOT_HASH)
+      break;
+
+    // An entry can only move back if its home slot is not cyclically within (hole, index].
+    size_t home  = home_index(map, SLOT_HASH(next_slot));
+    bool   stays = (hole <= index) ? (hole < home && home <= index) : (hole < home || home <= index);
+    if (!stays)
+    {
+      memcpy(SLOT_AT(map, hole), next_slot, map->slot_size);
+      hole = index;
+    }
+  }
+
+  SLOT_HASH(SLOT_AT(map, hole)) = EMPTY_SLOT_HASH;
+  --map->size;
+  return kEtcPalErrOk;
+}
+
+/**
+ * @brief Remove all entries from a hash map.
+ *
+ * The storage is kept; use etcpal_hashmap_deinit() to free it.
+ *
+ * @param[in] map The hash map to clear.
+ */
+void etcpal_hashmap_clear(EtcPalHashMap* map)
+{
+  if (!map)
+    return;
+
+  for (size_t i = 0; i < map->capacity; ++i)
+    SLOT_HASH(SLOT_AT(map, i)) = EMPTY_SLOT_HASH;
+  map->size = 0;
+}
+
+/**
+ * @brief Make sure a hash map can hold a number of entries without growing.
+ * @param[in] map The hash map.
+ * @param[in] size The number of entries to make room for.
+ * @return #kEtcPalErrOk: The hash map can hold size entries without allocating.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNoMem: Allocation failed, or the hash map has fixed storage which is too small.
+ */
+etcpal_error_t etcpal_hashmap_reserve(EtcPalHashMap* map, size_t size)
+{
+  if (!map)
+    return kEtcPalErrInvalid;
+
+  if (!map->owns_storage)
+    return (size <= map->capacity ? kEtcPalErrOk : kEtcPalErrNoMem);
+
+  if (size == 0 || (map->capacity != 0 && !HASHMAP_EXCEEDS_MAX_LOAD(size, map->capacity)))
+    return kEtcPalErrOk;
+
+  size_t new_capacity = (map->capacity == 0 ? HASHMAP_MIN_DYNAMIC_CAPACITY : map->capacity);
+  while (HASHMAP_EXCEEDS_MAX_LOAD(size, new_capacity))
+    new_capacity *= 2;
+  return (resize(map, new_capacity) ? kEtcPalErrOk : kEtcPalErrNoMem);
+}
+
+/**
+ * @brief Get the number of entries in a hash map.
+ * @param[in] map The hash map.
+ * @return The number of entries.
+ */
+size_t etcpal_hashmap_size(const EtcPalHashMap* map)
+{
+  return (map ? map->size : 0);
+}
+
+/**
+ * @brief Get the number of slots in a hash map.
+ * @param[in] map The hash map.
+ * @return The number of slots currently allocated or provided.
+ */
+size_t etcpal_hashmap_capacity(const EtcPalHashMap* map)
+{
+  return (map ? map->capacity : 0);
+}
+
+/**
+ * @brief Initialize an iterator over the entries of a hash map.
+ *
+ * Entries are visited in an unspecified order.
+ *
+ * @param[out] iter The iterator to initialize.
+ * @param[in] map The hash map to iterate over.
+ */
+void etcpal_hashmap_iter_init(EtcPalHashMapIter* iter, const EtcPalHashMap* map)
+{
+  if (iter)
+  {
+    iter->map   = map;
+    iter->index = 0;
+  }
+}
+
+/**
+ * @brief Advance an iterator to the next entry of a hash map.
+ * @param[in,out] iter The iterator.
+ * @param[out] key Filled in with a pointer to the key of the next entry (optional).
+ * @param[out] value Filled in with a pointer to the value of the next entry (optional).
+ * @return true: An entry was found and the pointers were filled in.
+ * @return false: There are no more entries.
+ */
+bool etcpal_hashmap_iter_next(EtcPalHashMapIter* iter, const void** key, void** value)
+{
+  if (!iter || !iter->map)
+    return false;
+
+  const EtcPalHashMap* map = iter->map;
+  while (iter->index < map->capacity)
+  {
+    uint8_t* slot = SLOT_AT(map, iter->index++);
+    if (SLOT_HASH(slot) != EMPTY_SLOT_HASH)
+    {
+      if (key)
+        *key = SLOT_KEY(slot);
+      if (value)
+        *value = SLOT_VALUE(map, slot);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Hash an arbitrary sequence of bytes.
+ *
+ * This is MurmurHash3 (x86, 32-bit) with a seed of 0. It can be used to build
+ * #EtcPalHashMapHashFunc implementations for composite keys.
+ *
+ * @param[in] data The bytes to hash.
+ * @param[in] size The number of bytes to hash.
+ * @return The 32-bit hash of the data.
+ */
+uint32_t etcpal_hash_bytes(const void* data, size_t size)
+{
+  const uint8_t* bytes = (const uint8_t*)data;
+  const uint32_t c1    = 0xcc9e2d51u;
+  const uint32_t c2    = 0x1b873593u;
+  uint32_t       hash  = 0;
+
+  size_t num_blocks = size / 4;
+  for (size_t i = 0; i < num_blocks; ++i)
+  {
+    uint32_t block;
+    memcpy(&block, &bytes[i * 4], 4);
+    block *= c1;
+    block = (block << 15) | (block >> 17);
+    block *= c2;
+    hash ^= block;
+    hash = (hash << 13) | (hash >> 19);
+    hash = hash * 5 + 0xe6546b64u;
+  }
+
+  const uint8_t* tail = &bytes[num_blocks * 4];
+  uint32_t       k    = 0;
+  switch (size & 3)
+  {
+    case 3:
+      k ^= (uint32_t)tail[2] << 16;
+      // fall through
+    case 2:
+      k ^= (uint32_t)tail[1] << 8;
+      // fall through
+    case 1:
+      k ^= tail[0];
+      k *= c1;
+      k = (k << 15) | (k >> 17);
+      k *= c2;
+      hash ^= k;
+      break;
+    default:
+      break;
+  }
+
+  hash ^= (uint32_t)size;
+  return mix32(hash);
+}
+
+uint32_t hash_key(const EtcPalHashMap* map, const void* key)
+{
+  uint32_t hash = (map->hash_fn ? mix32(map->hash_fn(key)) : etcpal_hash_bytes(key, map->key_size));
+  return (hash == EMPTY_SLOT_HASH ? 1u : hash);
+}
+
+bool keys_equal(const EtcPalHashMap* map, const void* key_a, const void* key_b)
+{
+  if (map->key_equal_fn)
+    return map->key_equal_fn(key_a, key_b);
+  return (memcmp(key_a, key_b, map->key_size) == 0);
+}
+
+// Maps a hash onto [0, capacity) with a multiply and shift, which works for any capacity.
+size_t home_index(const EtcPalHashMap* map, uint32_t hash)
+{
+  return (size_t)(((uint64_t)hash * (uint64_t)map->capacity) >> 32);
+}
+
+uint8_t* find_slot(const EtcPalHashMap* map, const void* key, uint32_t hash)
+{
+  size_t index = home_index(map, hash);
+  for (size_t probes = 0; probes < map->capacity; ++probes)
+  {
+    uint8_t* slot      = SLOT_AT(map, index);
+    uint32_t slot_hash = SLOT_HASH(slot);
+    if (slot_hash == EMPTY_SLOT_HASH)
+      return NULL;
+    if (slot_hash == hash && keys_equal(map, SLOT_KEY(slot), key))
+      return slot;
+    index = (index + 1 == map->capacity ? 0 : index + 1);
+  }
+  return NULL;
+}
+
+// Places an entry in the first empty slot of its probe run. There must be at least one empty slot.
+void place_entry(EtcPalHashMap* map, uint32_t hash, const void* key, const void* value)
+{
+  size_t index = home_index(map, hash);
+  while (SLOT_HASH(SLOT_AT(map, index)) != EMPTY_SLOT_HASH)
+    index = (index + 1 == map->capacity ? 0 : index + 1);
+
+  uint8_t* slot   = SLOT_AT(map, index);
+  SLOT_HASH(slot) = hash;
+  memcpy(SLOT_KEY(slot), key, map->key_size);
+  if (map->value_size != 0)
+    memcpy(SLOT_VALUE(map, slot), value, map->value_size);
+}
+
+bool resize(EtcPalHashMap* map, size_t new_capacity)
+{
+  uint8_t* new_slots = (uint8_t*)malloc(new_capacity * map->slot_size);
+  if (!new_slots)
+    return false;
+
+  uint8_t* old_slots    = map->slots;
+  size_t   old_capacity = map->capacity;
+
+  map->slots    = new_slots;
+  map->capacity = new_capacity;
+  for (size_t i = 0; i < new_capacity; ++i)
+    SLOT_HASH(SLOT_AT(map, i)) = EMPTY_SLOT_HASH;
+
+  // Stored hashes are reused, so keys are not hashed again.
+  for (size_t i = 0; i < old_capacity; ++i)
+  {
+    uint8_t* old_slot = old_slots + i * map->slot_size;
+    if (SLOT_HASH(old_slot) != EMPTY_SLOT_HASH)
+    {
+      size_t index = home_index(map, SLOT_HASH(old_slot));
+      while (SLOT_HASH(SLOT_AT(map, index)) != EMPTY_SLOT_HASH)
+        index = (index + 1 == map->capacity ? 0 : index + 1);
+      memcpy(SLOT_AT(map, index), old_slot, map->slot_size);
+    }
+  }
+
+  free(old_slots);
+  return true;
+}
+
+// The MurmurHash3 finalizer, which spreads the entropy of a hash across all of its bits. The slot
+// index is taken from the high bits of the hash, which weak hash functions leave mostly unchanged.
+uint32_t mix32(uint32_t hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
@@ -20,6 +20,7 @@
 #ifndef ETCPAL_NO_NETWORKING_SUPPORT
 
 #include "etcpal/inet.h"
+#include "etcpal/hashmap.h"
 
 /***************************** Global variables ******************************/
 
@@ -48,6 +49,10 @@ const EtcPalMacAddr kEtcPalNullMacAddr = {{0}};
 static const uint8_t kV6Wildcard[ETCPAL_IPV6_BYTES] = {0};
 static const uint8_t kV6Loopback[ETCPAL_IPV6_BYTES] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
 
+/*********************** Private function prototypes *************************/
+
+static uint32_t hash_ip_and_port(const EtcPalIpAddr* ip, uint16_t port);
+
 /*************************** Function definitions ****************************/
 
 /**
@@ -242,6 +247,64 @@ bool etcpal_ip_and_port_equal(const EtcPalSockAddr* sock1, const EtcPalSockAddr*
   return false;
 }
 
+/**
+ * @brief Hash an IP address for use as a hash map key.
+ *
+ * Matches the #EtcPalHashMapHashFunc signature; see @ref etcpal_hashmap. Consistent with
+ * etcpal_ip_cmp(): only the type and the address bytes in use are hashed, and the IPv6 scope ID
+ * is ignored.
+ *
+ * @param[in] ip Pointer to the EtcPalIpAddr to hash.
+ * @return The hash of the IP address.
+ */
+uint32_t etcpal_ip_hash_key(const void* ip)
+{
+  return hash_ip_and_port((const EtcPalIpAddr*)ip, 0);
+}
+
+/**
+ * @brief Determine whether two IP addresses used as hash map keys are equal.
+ *
+ * Matches the #EtcPalHashMapKeyEqualFunc signature; see @ref etcpal_hashmap.
+ *
+ * @param[in] ip_a Pointer to the first EtcPalIpAddr to compare.
+ * @param[in] ip_b Pointer to the second EtcPalIpAddr to compare.
+ * @return Whether the IP addresses are equal, according to etcpal_ip_cmp().
+ */
+bool etcpal_ip_key_equal(const void* ip_a, const void* ip_b)
+{
+  return (etcpal_ip_cmp((const EtcPalIpAddr*)ip_a, (const EtcPalIpAddr*)ip_b) == 0);
+}
+
+/**
+ * @brief Hash an IP address and port for use as a hash map key.
+ *
+ * Matches the #EtcPalHashMapHashFunc signature; see @ref etcpal_hashmap. Consistent with
+ * etcpal_ip_and_port_equal().
+ *
+ * @param[in] sock Pointer to the EtcPalSockAddr to hash.
+ * @return The hash of the IP address and port.
+ */
+uint32_t etcpal_sockaddr_hash_key(const void* sock)
+{
+  const EtcPalSockAddr* sock_addr = (const EtcPalSockAddr*)sock;
+  return hash_ip_and_port(&sock_addr->ip, sock_addr->port);
+}
+
+/**
+ * @brief Determine whether two IP addresses and ports used as hash map keys are equal.
+ *
+ * Matches the #EtcPalHashMapKeyEqualFunc signature; see @ref etcpal_hashmap.
+ *
+ * @param[in] sock_a Pointer to the first EtcPalSockAddr to compare.
+ * @param[in] sock_b Pointer to the second EtcPalSockAddr to compare.
+ * @return Whether the IP addresses and ports are equal, according to etcpal_ip_and_port_equal().
+ */
+bool etcpal_sockaddr_key_equal(const void* sock_a, const void* sock_b)
+{
+  return etcpal_ip_and_port_equal((const EtcPalSockAddr*)sock_a, (const EtcPalSockAddr*)sock_b);
+}
+
 /**
  * @brief Compare two EtcPalNetintInfos.
  *
@@ -609,4 +672,28 @@ etcpal_error_t etcpal_string_to_mac(const char* src, EtcPalMacAddr* dest)
   return kEtcPalErrInvalid;
 }
 
+// Hashes the type and the address bytes in use, followed by the port, as one byte sequence.
+uint32_t hash_ip_and_port(const EtcPalIpAddr* ip, uint16_t port)
+{
+  uint8_t buf[1 + ETCPAL_IPV6_BYTES + 2];
+  size_t  len = 0;
+
+  buf[len++] = (uint8_t)ip->type;
+  if (ip->type == kEtcPalIpTypeV4)
+  {
+    uint32_t v4 = ETCPAL_IP_V4_ADDRESS(ip);
+    memcpy(&buf[len], &v4, sizeof v4);
+    len += sizeof v4;
+  }
+  else if (ip->type == kEtcPalIpTypeV6)
+  {
+    memcpy(&buf[len], ETCPAL_IP_V6_ADDRESS(ip), ETCPAL_IPV6_BYTES);
+    len += ETCPAL_IPV6_BYTES;
+  }
+  memcpy(&buf[len], &port, sizeof port);
+  len += sizeof port;
+
+  return etcpal_hash_bytes(buf, len);
+}
+
 #endif  // ETCPAL_NO_NETWORKING_SUPPORT
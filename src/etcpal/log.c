@@ -35,11 +35,6 @@
 #ifdef _MSC_VER
 /* Suppress strncpy() warnings on Windows/MSVC. */
 #pragma warning(disable : 4996)
-
-/* Provide va_copy() in pre-VS2013 environments. */
-#if _MSC_VER < 1800
-#define va_copy(dest, src) (dest = src)
-#endif
 #endif
 
 /*************************** Private constants *******************************/
@@ -53,6 +48,22 @@
 /* 1-32 alphanumeric characters, terminated by ": " and a null */
 #define LEGACY_SYSLOG_TAG_MAX_LEN 35
 
+/* On hosted platforms, each thread builds its log strings in its own thread-local buffers, so
+ * threads logging concurrently don't contend with each other. Elsewhere, thread-local storage is
+ * not reliably available, so a single set of buffers is shared under a lock. */
+#if !ETCPAL_NO_OS_SUPPORT && !defined(ETCPAL_OS_IS_ZEPHYR) && \
+    (defined(_WIN32) || defined(__linux__) || defined(__APPLE__))
+#if defined(_MSC_VER)
+#define LOG_THREAD_LOCAL __declspec(thread)
+#else
+#define LOG_THREAD_LOCAL __thread
+#endif
+#define LOG_USE_BUF_LOCK 0
+#else
+#define LOG_THREAD_LOCAL
+#define LOG_USE_BUF_LOCK (!ETCPAL_NO_OS_SUPPORT)
+#endif
+
 // clang-format off
 static const char* const kLogSeverityStrings[] = {
   "EMRG", // ETCPAL_LOG_EMERG
@@ -81,16 +92,49 @@ static const char* const kMonthNames[12] = {
 };
 // clang-format on
 
+/* The offset of the milliseconds in a valid timestamp built by make_iso_timestamp(). */
+#define ISO_TIMESTAMP_MSEC_OFFSET 20
+
+/****************************** Private types ********************************/
+
+/* A timestamp string, along with the time it was last built from. Log messages tend to come in
+ * bursts, so the string is reused as long as the time has not moved on to another second. */
+typedef struct LogTimestampCache
+{
+  bool               valid;
+  EtcPalLogTimestamp timestamp;
+  char               str[ETCPAL_LOG_TIMESTAMP_LEN];
+} LogTimestampCache;
+
+typedef struct LogBuffers
+{
+  char              body[ETCPAL_RAW_LOG_MSG_MAX_LEN + 1];
+  char              syslog_msg[ETCPAL_SYSLOG_STR_MAX_LEN + 1];
+  char              legacy_syslog_msg[ETCPAL_SYSLOG_STR_MAX_LEN + 1];
+  char              human_log_msg[ETCPAL_LOG_STR_MAX_LEN + 1];
+  LogTimestampCache iso_timestamp;
+  LogTimestampCache legacy_syslog_timestamp;
+} LogBuffers;
+
 /**************************** Private variables ******************************/
 
 static bool initialized = false;
-#if !ETCPAL_NO_OS_SUPPORT
+#if LOG_USE_BUF_LOCK
 static etcpal_mutex_t buf_lock;
 #endif
+static LOG_THREAD_LOCAL LogBuffers log_buffers;
 
 /*********************** Private function prototypes *************************/
 
-static char* create_log_str(char*                     buf,
+static void create_and_dispatch_log_strs(LogBuffers*               buffers,
+                                         const EtcPalLogParams*    params,
+                                         const EtcPalLogTimestamp* timestamp,
+                                         int                       pri,
+                                         const char*               format,
+                                         va_list                   args);
+static size_t format_body(char* buf, size_t buflen, const char* format, va_list args);
+static char*  append_body(char* buf, size_t buflen, int header_size, const char* body, size_t body_len);
+static char*  create_log_str(char*                     buf,
                             size_t                    buflen,
                             const EtcPalLogTimestamp* timestamp,
                             int                       pri,
@@ -111,20 +155,37 @@ static char* create_legacy_syslog_str(char*                     buf,
                                       const char*               format,
                                       va_list                   args);
 
+static int make_log_header(char* buf, size_t buflen, const char* timestamp_str, int pri);
+static int make_syslog_header(char*                     buf,
+                              size_t                    buflen,
+                              const char*               timestamp_str,
+                              const EtcPalSyslogParams* syslog_params,
+                              int                       pri);
+static int make_legacy_syslog_header(char*                     buf,
+                                     size_t                    buflen,
+                                     const char*               timestamp_str,
+                                     const EtcPalSyslogParams* syslog_params,
+                                     int                       pri);
+
 static void sanitize_str(char* str);
 
 static void make_iso_timestamp(const EtcPalLogTimestamp* timestamp, char* buf, bool human_readable);
+static void make_human_timestamp_from_iso(const char* iso_timestamp, char* buf);
+static const char* get_cached_iso_timestamp(LogTimestampCache* cache, const EtcPalLogTimestamp* timestamp);
+static const char* get_cached_legacy_syslog_timestamp(LogTimestampCache*        cache,
+                                                      const EtcPalLogTimestamp* timestamp);
+static bool        timestamps_in_same_second(const EtcPalLogTimestamp* a, const EtcPalLogTimestamp* b);
 static void make_legacy_syslog_timestamp(const EtcPalLogTimestamp* timestamp, char* buf);
 static void make_legacy_syslog_tag_str(const EtcPalSyslogParams* syslog_params, char* buf);
 static bool get_time(const EtcPalLogParams* params, EtcPalLogTimestamp* timestamp);
 
 /*************************** Function definitions ****************************/
 
-/* Initialize the etcpal_log module. Creates the mutex which locks the static buffers that log
- * messages are written into. */
+/* Initialize the etcpal_log module. On platforms without thread-local storage, creates the mutex
+ * which locks the static buffers that log messages are written into. */
 etcpal_error_t etcpal_log_init(void)
 {
-#if !ETCPAL_NO_OS_SUPPORT
+#if LOG_USE_BUF_LOCK
   if (!etcpal_mutex_create(&buf_lock))
     return kEtcPalErrSys;
 #endif
@@ -135,7 +196,7 @@ etcpal_error_t etcpal_log_init(void)
 /* Deinitialize the etcpal_log module. */
 void etcpal_log_deinit(void)
 {
-#if !ETCPAL_NO_OS_SUPPORT
+#if LOG_USE_BUF_LOCK
   etcpal_mutex_destroy(&buf_lock);
 #endif
   initialized = false;
@@ -483,71 +544,107 @@ void etcpal_vlog(const EtcPalLogParams* params, int pri, const char* format, va_
   EtcPalLogTimestamp timestamp;
   bool               have_time = get_time(params, &timestamp);
 
-#if !ETCPAL_NO_OS_SUPPORT
+#if LOG_USE_BUF_LOCK
   if (etcpal_mutex_lock(&buf_lock))
   {
+    create_and_dispatch_log_strs(&log_buffers, params, have_time ? &timestamp : NULL, pri, format, args);
+    etcpal_mutex_unlock(&buf_lock);
+  }
+#else
+  create_and_dispatch_log_strs(&log_buffers, params, have_time ? &timestamp : NULL, pri, format, args);
 #endif
-    static char      syslog_msg[ETCPAL_SYSLOG_STR_MAX_LEN + 1];
-    static char      legacy_syslog_msg[ETCPAL_SYSLOG_STR_MAX_LEN + 1];
-    static char      human_log_msg[ETCPAL_LOG_STR_MAX_LEN + 1];
-    EtcPalLogStrings strings = {NULL, NULL, NULL, NULL, 0};
-    strings.priority         = pri;
-
-    // In the below blocks, we check if the va_list will need to be reused further down - if so,
-    // the va_list must be copied. For more info on using a va_list multiple times, see:
-    // https://wiki.sei.cmu.edu/confluence/display/c/MSC39-C.+Do+not+call+va_arg%28%29+on+a+va_list+that+has+an+indeterminate+value
-    // https://stackoverflow.com/a/26919307
-    if (params->action & ETCPAL_LOG_CREATE_HUMAN_READABLE)
-    {
-      if (params->action & (ETCPAL_LOG_CREATE_SYSLOG | ETCPAL_LOG_CREATE_LEGACY_SYSLOG))
-      {
-        va_list args_copy;  // NOLINT
-        va_copy(args_copy, args);
-        strings.raw = create_log_str(human_log_msg, ETCPAL_LOG_STR_MAX_LEN + 1, have_time ? &timestamp : NULL, pri,
-                                     format, args_copy);
-        va_end(args_copy);
-      }
-      else
-      {
-        strings.raw =
-            create_log_str(human_log_msg, ETCPAL_LOG_STR_MAX_LEN + 1, have_time ? &timestamp : NULL, pri, format, args);
-      }
-      if (strings.raw)
-        strings.human_readable = human_log_msg;
-    }
+}
 
-    if (params->action & ETCPAL_LOG_CREATE_SYSLOG)
-    {
-      if (params->action & ETCPAL_LOG_CREATE_LEGACY_SYSLOG)
-      {
-        va_list args_copy;  // NOLINT
-        va_copy(args_copy, args);
-        strings.raw = create_syslog_str(syslog_msg, ETCPAL_SYSLOG_STR_MAX_LEN + 1, have_time ? &timestamp : NULL,
-                                        &params->syslog_params, pri, format, args_copy);
-        va_end(args_copy);
-      }
-      else
-      {
-        strings.raw = create_syslog_str(syslog_msg, ETCPAL_SYSLOG_STR_MAX_LEN + 1, have_time ? &timestamp : NULL,
-                                        &params->syslog_params, pri, format, args);
-      }
-      if (strings.raw)
-        strings.syslog = syslog_msg;
-    }
+/*
+ * Build the strings requested by params->action into the given buffers and pass them to the log
+ * callback. Only the requested strings are built. The message itself is formatted only once, into
+ * the body buffer, and then copied in after the header of each requested string.
+ */
+void create_and_dispatch_log_strs(LogBuffers*               buffers,
+                                  const EtcPalLogParams*    params,
+                                  const EtcPalLogTimestamp* timestamp,
+                                  int                       pri,
+                                  const char*               format,
+                                  va_list                   args)
+{
+  EtcPalLogStrings strings = {NULL, NULL, NULL, NULL, 0, 0};
+  strings.priority         = pri;
 
-    if (params->action & ETCPAL_LOG_CREATE_LEGACY_SYSLOG)
-    {
-      strings.raw = create_legacy_syslog_str(legacy_syslog_msg, ETCPAL_SYSLOG_STR_MAX_LEN + 1,
-                                             have_time ? &timestamp : NULL, &params->syslog_params, pri, format, args);
-      if (strings.raw)
-        strings.legacy_syslog = legacy_syslog_msg;
-    }
+  size_t body_len = format_body(buffers->body, ETCPAL_RAW_LOG_MSG_MAX_LEN + 1, format, args);
+  strings.raw     = buffers->body;
+  strings.raw_len = body_len;
 
-    params->log_fn(params->context, &strings);
-#if !ETCPAL_NO_OS_SUPPORT
-    etcpal_mutex_unlock(&buf_lock);
+  // The human-readable and RFC 5424 timestamps differ only in the date/time separator, so the
+  // timestamp is only printed once if both are requested.
+  const char* iso_timestamp_str = NILVALUE_STR;
+  if (params->action & (ETCPAL_LOG_CREATE_HUMAN_READABLE | ETCPAL_LOG_CREATE_SYSLOG))
+    iso_timestamp_str = get_cached_iso_timestamp(&buffers->iso_timestamp, timestamp);
+
+  if (params->action & ETCPAL_LOG_CREATE_HUMAN_READABLE)
+  {
+    char timestamp_str[ETCPAL_LOG_TIMESTAMP_LEN];
+    make_human_timestamp_from_iso(iso_timestamp_str, timestamp_str);
+
+    int header_size = make_log_header(buffers->human_log_msg, ETCPAL_LOG_STR_MIN_LEN + 1, timestamp_str, pri);
+    if (append_body(buffers->human_log_msg, ETCPAL_LOG_STR_MAX_LEN + 1, header_size, buffers->body, body_len))
+      strings.human_readable = buffers->human_log_msg;
   }
-#endif
+
+  if (params->action & ETCPAL_LOG_CREATE_SYSLOG)
+  {
+    int header_size = make_syslog_header(buffers->syslog_msg, ETCPAL_SYSLOG_HEADER_MAX_LEN, iso_timestamp_str,
+                                         &params->syslog_params, pri);
+    if (append_body(buffers->syslog_msg, ETCPAL_SYSLOG_STR_MAX_LEN + 1, header_size, buffers->body, body_len))
+      strings.syslog = buffers->syslog_msg;
+  }
+
+  if (params->action & ETCPAL_LOG_CREATE_LEGACY_SYSLOG)
+  {
+    const char* timestamp_str = get_cached_legacy_syslog_timestamp(&buffers->legacy_syslog_timestamp, timestamp);
+
+    int header_size = make_legacy_syslog_header(buffers->legacy_syslog_msg, ETCPAL_SYSLOG_HEADER_MAX_LEN,
+                                                timestamp_str, &params->syslog_params, pri);
+    if (append_body(buffers->legacy_syslog_msg, ETCPAL_SYSLOG_STR_MAX_LEN + 1, header_size, buffers->body, body_len))
+      strings.legacy_syslog = buffers->legacy_syslog_msg;
+  }
+
+  params->log_fn(params->context, &strings);
+}
+
+/*
+ * Format a log message into the given buffer, truncating it if necessary. Returns the length of
+ * the formatted message.
+ */
+size_t format_body(char* buf, size_t buflen, const char* format, va_list args)
+{
+  if (!ETCPAL_ASSERT_VERIFY(buf) || !ETCPAL_ASSERT_VERIFY(buflen > 0) || !ETCPAL_ASSERT_VERIFY(format))
+    return 0;
+
+  // vsnprintf will write up to count - 1 bytes and always null-terminates. It returns the length
+  // the message would have had if it had not been truncated.
+  int print_res = vsnprintf(buf, buflen, format, args);
+  if (print_res < 0)
+  {
+    buf[0] = '\0';
+    return 0;
+  }
+  return ETCPAL_MIN((size_t)print_res, buflen - 1);
+}
+
+/*
+ * Copy an already-formatted log message in after a header of header_size bytes, truncating it if
+ * necessary. Returns a pointer to the message within buf, or NULL if the header could not be
+ * created.
+ */
+char* append_body(char* buf, size_t buflen, int header_size, const char* body, size_t body_len)
+{
+  if (header_size < 0 || (size_t)header_size >= buflen)
+    return NULL;
+
+  size_t copy_len = ETCPAL_MIN(body_len, buflen - (size_t)header_size - 1);
+  memcpy(&buf[header_size], body, copy_len);
+  buf[(size_t)header_size + copy_len] = '\0';
+  return &buf[header_size];
 }
 
 /*
@@ -571,16 +668,7 @@ char* create_log_str(char*                     buf,
   char timestamp_str[ETCPAL_LOG_TIMESTAMP_LEN];
   make_iso_timestamp(timestamp, timestamp_str, true);
 
-  int header_size = 0;
-  if (timestamp_str[0] == '\0')
-  {
-    header_size = snprintf(buf, ETCPAL_LOG_STR_MIN_LEN + 1, "[%s] ", kLogSeverityStrings[pri]);
-  }
-  else
-  {
-    header_size = snprintf(buf, ETCPAL_LOG_STR_MIN_LEN + 1, "%s [%s] ", timestamp_str, kLogSeverityStrings[pri]);
-  }
-
+  int header_size = make_log_header(buf, ETCPAL_LOG_STR_MIN_LEN + 1, timestamp_str, pri);
   if (header_size >= 0)
   {
     // Copy in the message. vsnprintf will write up to count - 1 bytes and always null-terminates.
@@ -613,12 +701,7 @@ char* create_syslog_str(char*                     buf,
   char timestamp_str[ETCPAL_LOG_TIMESTAMP_LEN];
   make_iso_timestamp(timestamp, timestamp_str, false);
 
-  int prival = ETCPAL_LOG_PRI(pri) | syslog_params->facility;
-  int syslog_header_size =
-      snprintf(buf, ETCPAL_SYSLOG_HEADER_MAX_LEN, "<%d>%d %s %s %s %s %s %s ", prival, SYSLOG_PROT_VERSION,
-               timestamp_str, syslog_params->hostname[0] ? syslog_params->hostname : NILVALUE_STR,
-               syslog_params->app_name[0] ? syslog_params->app_name : NILVALUE_STR,
-               syslog_params->procid[0] ? syslog_params->procid : NILVALUE_STR, MSGID_STR, STRUCTURED_DATA_STR);
+  int syslog_header_size = make_syslog_header(buf, ETCPAL_SYSLOG_HEADER_MAX_LEN, timestamp_str, syslog_params, pri);
   if (syslog_header_size >= 0)
   {
     // Copy in the message. vsnprintf will write up to count - 1 bytes and always null-terminates.
@@ -650,6 +733,58 @@ char* create_legacy_syslog_str(char*                     buf,
 
   char timestamp_str[ETCPAL_LOG_TIMESTAMP_LEN];
   make_legacy_syslog_timestamp(timestamp, timestamp_str);
+
+  int syslog_header_size =
+      make_legacy_syslog_header(buf, ETCPAL_SYSLOG_HEADER_MAX_LEN, timestamp_str, syslog_params, pri);
+  if (syslog_header_size >= 0)
+  {
+    // Copy in the message. vsnprintf will write up to count - 1 bytes and always null-terminates.
+    // This allows ETCPAL_LOG_MSG_MAX_LEN valid bytes to be written.
+    vsnprintf(&buf[syslog_header_size], buflen - (size_t)syslog_header_size, format, args);
+    return &buf[syslog_header_size];
+  }
+
+  return NULL;
+}
+
+/*
+ * Print the human-readable header given a timestamp from make_iso_timestamp(). Returns the length
+ * of the header, or a negative value on failure.
+ */
+int make_log_header(char* buf, size_t buflen, const char* timestamp_str, int pri)
+{
+  if (timestamp_str[0] == '\0')
+    return snprintf(buf, buflen, "[%s] ", kLogSeverityStrings[pri]);
+  return snprintf(buf, buflen, "%s [%s] ", timestamp_str, kLogSeverityStrings[pri]);
+}
+
+/*
+ * Print the RFC 5424 header given a timestamp from make_iso_timestamp(). Returns the length of the
+ * header, or a negative value on failure.
+ */
+int make_syslog_header(char*                     buf,
+                       size_t                    buflen,
+                       const char*               timestamp_str,
+                       const EtcPalSyslogParams* syslog_params,
+                       int                       pri)
+{
+  int prival = ETCPAL_LOG_PRI(pri) | syslog_params->facility;
+  return snprintf(buf, buflen, "<%d>%d %s %s %s %s %s %s ", prival, SYSLOG_PROT_VERSION, timestamp_str,
+                  syslog_params->hostname[0] ? syslog_params->hostname : NILVALUE_STR,
+                  syslog_params->app_name[0] ? syslog_params->app_name : NILVALUE_STR,
+                  syslog_params->procid[0] ? syslog_params->procid : NILVALUE_STR, MSGID_STR, STRUCTURED_DATA_STR);
+}
+
+/*
+ * Print the RFC 3164 header given a timestamp from make_legacy_syslog_timestamp(). Returns the
+ * length of the header, or a negative value on failure.
+ */
+int make_legacy_syslog_header(char*                     buf,
+                              size_t                    buflen,
+                              const char*               timestamp_str,
+                              const EtcPalSyslogParams* syslog_params,
+                              int                       pri)
+{
   char tag_str[LEGACY_SYSLOG_TAG_MAX_LEN];
   make_legacy_syslog_tag_str(syslog_params, tag_str);
 
@@ -669,17 +804,7 @@ char* create_legacy_syslog_str(char*                     buf,
   }
 
   int prival = ETCPAL_LOG_PRI(pri) | syslog_params->facility;
-  int syslog_header_size =
-      snprintf(buf, ETCPAL_SYSLOG_HEADER_MAX_LEN, header_format, prival, timestamp_str, hostname_str, tag_str);
-  if (syslog_header_size >= 0)
-  {
-    // Copy in the message. vsnprintf will write up to count - 1 bytes and always null-terminates.
-    // This allows ETCPAL_LOG_MSG_MAX_LEN valid bytes to be written.
-    vsnprintf(&buf[syslog_header_size], buflen - (size_t)syslog_header_size, format, args);
-    return &buf[syslog_header_size];
-  }
-
-  return NULL;
+  return snprintf(buf, buflen, header_format, prival, timestamp_str, hostname_str, tag_str);
 }
 
 /* Replace non-printing characters and spaces with '_'. Replace characters above 127 with '?'. */
@@ -746,6 +871,85 @@ void make_iso_timestamp(const EtcPalLogTimestamp* timestamp, char* buf, bool hum
   }
 }
 
+/*
+ * Convert a timestamp built by make_iso_timestamp() for syslog into its human-readable form. Both
+ * buffers must be of length ETCPAL_LOG_TIMESTAMP_LEN.
+ */
+void make_human_timestamp_from_iso(const char* iso_timestamp, char* buf)
+{
+  if (!ETCPAL_ASSERT_VERIFY(iso_timestamp) || !ETCPAL_ASSERT_VERIFY(buf))
+    return;
+
+  // The date is always printed with a 4-digit year, so the separator is always at the same place.
+  if (iso_timestamp[0] == '\0' || strcmp(iso_timestamp, NILVALUE_STR) == 0)
+  {
+    buf[0] = '\0';
+  }
+  else
+  {
+    strcpy(buf, iso_timestamp);  // NOLINT
+    buf[10] = ' ';
+  }
+}
+
+/*
+ * Get the RFC 5424 timestamp string for the given time, rebuilding it only if the time is not in
+ * the same second as the cached string. Otherwise, only the milliseconds are patched in.
+ */
+const char* get_cached_iso_timestamp(LogTimestampCache* cache, const EtcPalLogTimestamp* timestamp)
+{
+  if (!timestamp || !etcpal_validate_log_timestamp(timestamp))
+  {
+    cache->valid = false;
+    return NILVALUE_STR;
+  }
+
+  if (cache->valid && timestamps_in_same_second(&cache->timestamp, timestamp))
+  {
+    if (cache->timestamp.msec != timestamp->msec)
+    {
+      cache->str[ISO_TIMESTAMP_MSEC_OFFSET]     = (char)('0' + timestamp->msec / 100);
+      cache->str[ISO_TIMESTAMP_MSEC_OFFSET + 1] = (char)('0' + (timestamp->msec / 10) % 10);
+      cache->str[ISO_TIMESTAMP_MSEC_OFFSET + 2] = (char)('0' + timestamp->msec % 10);
+      cache->timestamp.msec                     = timestamp->msec;
+    }
+    return cache->str;
+  }
+
+  make_iso_timestamp(timestamp, cache->str, false);
+  cache->timestamp = *timestamp;
+  cache->valid     = true;
+  return cache->str;
+}
+
+/*
+ * Get the RFC 3164 timestamp string for the given time, which does not include milliseconds, so it
+ * is only rebuilt when the time moves on to another second.
+ */
+const char* get_cached_legacy_syslog_timestamp(LogTimestampCache* cache, const EtcPalLogTimestamp* timestamp)
+{
+  if (!timestamp || !etcpal_validate_log_timestamp(timestamp))
+  {
+    cache->valid = false;
+    return "";
+  }
+
+  if (!cache->valid || !timestamps_in_same_second(&cache->timestamp, timestamp))
+  {
+    make_legacy_syslog_timestamp(timestamp, cache->str);
+    cache->timestamp = *timestamp;
+    cache->valid     = true;
+  }
+  return cache->str;
+}
+
+/* Whether two timestamps differ by no more than their milliseconds. */
+bool timestamps_in_same_second(const EtcPalLogTimestamp* a, const EtcPalLogTimestamp* b)
+{
+  return (a->second == b->second && a->minute == b->minute && a->hour == b->hour && a->day == b->day &&
+          a->month == b->month && a->year == b->year && a->utc_offset == b->utc_offset);
+}
+
 void make_legacy_syslog_timestamp(const EtcPalLogTimestamp* timestamp, char* buf)
 {
   if (!ETCPAL_ASSERT_VERIFY(buf))
@@ -20,15 +20,96 @@
 #include "etcpal/mempool.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "etcpal/common.h"
 #if !ETCPAL_NO_OS_SUPPORT
+#include <stdlib.h>
 #include "etcpal/mutex.h"
 #endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**************************** Private constants ******************************/
+
+// The lock-free freelist head packs an element index in the low 32 bits and an ABA tag in the high
+// 32 bits, which is incremented on every successful update of the head. The head is 64 bits wide on
+// all targets so that the tag does not wrap quickly on 32-bit targets.
+#define MEMPOOL_INDEX_BITS  32
+#define MEMPOOL_INDEX_MASK  (((uint64_t)1 << MEMPOOL_INDEX_BITS) - 1)
+#define MEMPOOL_INDEX_EMPTY MEMPOOL_INDEX_MASK
+
+/****************************** Private macros *******************************/
+
+// The lock-free freelist is only used where the compiler can do a native 64-bit compare-and-swap.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define MEMPOOL_HAVE_ATOMICS                1
+#define MEMPOOL_ATOMIC_LOAD_HEAD(ptr)       __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define MEMPOOL_ATOMIC_LOAD_NEXT(ptr)       __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define MEMPOOL_ATOMIC_LOAD_COUNT(ptr)      __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define MEMPOOL_ATOMIC_STORE_NEXT(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define MEMPOOL_ATOMIC_INCREMENT(ptr)       (void)__atomic_add_fetch((ptr), 1, __ATOMIC_RELAXED)
+#define MEMPOOL_ATOMIC_DECREMENT(ptr)       (void)__atomic_sub_fetch((ptr), 1, __ATOMIC_RELAXED)
+#define MEMPOOL_ATOMIC_CAS(ptr, old, new) \
+  __atomic_compare_exchange_n((ptr), &(old), (new), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER)
+#define MEMPOOL_HAVE_ATOMICS 1
+// Aligned pointer-size loads and stores are atomic on all Windows targets; the volatile access
+// has acquire/release semantics under MSVC's default /volatile:ms.
+#define MEMPOOL_ATOMIC_LOAD_NEXT(ptr)       (*(EtcPalMempool* volatile const*)(ptr))
+#define MEMPOOL_ATOMIC_LOAD_COUNT(ptr)      (*(volatile const size_t*)(ptr))
+#define MEMPOOL_ATOMIC_STORE_NEXT(ptr, val) (*(EtcPalMempool* volatile*)(ptr) = (val))
+#ifdef _WIN64
+#define MEMPOOL_ATOMIC_LOAD_HEAD(ptr) (*(volatile const uint64_t*)(ptr))
+#define MEMPOOL_ATOMIC_INCREMENT(ptr) (void)_InterlockedIncrement64((volatile __int64*)(ptr))
+#define MEMPOOL_ATOMIC_DECREMENT(ptr) (void)_InterlockedDecrement64((volatile __int64*)(ptr))
+#else
+// A plain 64-bit load can tear on 32-bit targets, so read the head with a no-op compare-and-swap.
+#define MEMPOOL_ATOMIC_LOAD_HEAD(ptr) ((uint64_t)_InterlockedCompareExchange64((volatile __int64*)(ptr), 0, 0))
+#define MEMPOOL_ATOMIC_INCREMENT(ptr) (void)_InterlockedIncrement((volatile long*)(ptr))
+#define MEMPOOL_ATOMIC_DECREMENT(ptr) (void)_InterlockedDecrement((volatile long*)(ptr))
+#endif
+#define MEMPOOL_ATOMIC_CAS(ptr, old, new) mempool_msvc_cas((ptr), &(old), (new))
+#else
+#define MEMPOOL_HAVE_ATOMICS 0
+#endif
+
+#define MEMPOOL_HEAD_INDEX(head) ((size_t)((head)&MEMPOOL_INDEX_MASK))
+#define MEMPOOL_HEAD_NEXT(head, new_index) \
+  (((((head) >> MEMPOOL_INDEX_BITS) + 1) << MEMPOOL_INDEX_BITS) | (uint64_t)(new_index))
+
+// Some 32-bit ABIs (e.g. i386 System V) only align 64-bit struct members to 4 bytes, and 64-bit
+// atomics are not guaranteed to work on those.
+#if UINTPTR_MAX > 0xffffffffu
+#define MEMPOOL_HEAD_ALIGNED(desc) true
+#else
+#define MEMPOOL_HEAD_ALIGNED(desc) (((uintptr_t)&(desc)->freelist_head & 7u) == 0)
+#endif
 
 #if !ETCPAL_NO_OS_SUPPORT
-static bool           mempool_lock_initted = false;
-static etcpal_mutex_t mempool_lock;
+// The pool's mutex is kept behind a pointer so that the layout of EtcPalMempoolDesc does not depend
+// on whether EtcPal is built with OS support.
+#define MEMPOOL_LOCK(desc) ((etcpal_mutex_t*)(desc)->lock)
+#endif
+
+#if MEMPOOL_HAVE_ATOMICS
+#define USE_LOCKFREE(desc) \
+  ((desc)->lockfree && (desc)->pool_size < MEMPOOL_INDEX_EMPTY && MEMPOOL_HEAD_ALIGNED(desc))
+#else
+#define USE_LOCKFREE(desc) false
+#endif
+
+/*********************** Private function prototypes *************************/
+
+#if MEMPOOL_HAVE_ATOMICS
+static void* alloc_lockfree(EtcPalMempoolDesc* desc);
+static void  free_lockfree(EtcPalMempoolDesc* desc, size_t index);
 #endif
+#if defined(_MSC_VER) && !defined(__clang__)
+static bool mempool_msvc_cas(uint64_t* ptr, uint64_t* old_val, uint64_t new_val);
+#endif
+
+/*************************** Function definitions ****************************/
 
 etcpal_error_t etcpal_mempool_init_priv(EtcPalMempoolDesc* desc)
 {
@@ -36,27 +117,35 @@ etcpal_error_t etcpal_mempool_init_priv(EtcPalMempoolDesc* desc)
     return kEtcPalErrInvalid;
 
 #if !ETCPAL_NO_OS_SUPPORT
-  if (!mempool_lock_initted)
+  // The lock lives until the pool is deinitialized, so it is only created on the first
+  // initialization.
+  if (!desc->lock)
   {
-    if (etcpal_mutex_create(&mempool_lock))
-      mempool_lock_initted = true;
-    else
+    etcpal_mutex_t* lock = (etcpal_mutex_t*)malloc(sizeof(etcpal_mutex_t));
+    if (!lock)
+      return kEtcPalErrNoMem;
+    if (!etcpal_mutex_create(lock))
+    {
+      free(lock);
       return kEtcPalErrSys;
+    }
+    desc->lock = lock;
   }
 
   etcpal_error_t res = kEtcPalErrSys;
-  if (etcpal_mutex_lock(&mempool_lock))
+  if (etcpal_mutex_lock(MEMPOOL_LOCK(desc)))
   {
 #endif
     size_t i = 0;
     for (; i < desc->pool_size - 1; ++i)
       desc->list[i].next = &desc->list[i + 1];
-    desc->list[i].next = NULL;
-    desc->freelist     = desc->list;
-    desc->current_used = 0;
+    desc->list[i].next  = NULL;
+    desc->freelist      = desc->list;
+    desc->current_used  = 0;
+    desc->freelist_head = 0;
 #if !ETCPAL_NO_OS_SUPPORT
     res = kEtcPalErrOk;
-    etcpal_mutex_unlock(&mempool_lock);
+    etcpal_mutex_unlock(MEMPOOL_LOCK(desc));
   }
   return res;
 #else
@@ -64,15 +153,35 @@ etcpal_error_t etcpal_mempool_init_priv(EtcPalMempoolDesc* desc)
 #endif
 }
 
+void etcpal_mempool_deinit_priv(EtcPalMempoolDesc* desc)
+{
+  if (!desc)
+    return;
+
+#if !ETCPAL_NO_OS_SUPPORT
+  if (desc->lock)
+  {
+    etcpal_mutex_destroy(MEMPOOL_LOCK(desc));
+    free(desc->lock);
+    desc->lock = NULL;
+  }
+#endif
+}
+
 void* etcpal_mempool_alloc_priv(EtcPalMempoolDesc* desc)
 {
   if (!desc)
     return NULL;
 
+#if MEMPOOL_HAVE_ATOMICS
+  if (USE_LOCKFREE(desc))
+    return alloc_lockfree(desc);
+#endif
+
   void* elem = NULL;
 
 #if !ETCPAL_NO_OS_SUPPORT
-  if (etcpal_mutex_lock(&mempool_lock))
+  if (etcpal_mutex_lock(MEMPOOL_LOCK(desc)))
   {
 #endif
     char*          c_pool    = (char*)desc->pool;
@@ -88,7 +197,7 @@ void* etcpal_mempool_alloc_priv(EtcPalMempoolDesc* desc)
       }
     }
 #if !ETCPAL_NO_OS_SUPPORT
-    etcpal_mutex_unlock(&mempool_lock);
+    etcpal_mutex_unlock(MEMPOOL_LOCK(desc));
   }
 #endif
 
@@ -107,17 +216,26 @@ void etcpal_mempool_free_priv(EtcPalMempoolDesc* desc, void* elem)
   {
     if (((size_t)offset % desc->elem_size == 0))
     {
+      size_t index = (size_t)offset / desc->elem_size;
+
+#if MEMPOOL_HAVE_ATOMICS
+      if (USE_LOCKFREE(desc))
+      {
+        free_lockfree(desc, index);
+        return;
+      }
+#endif
+
 #if !ETCPAL_NO_OS_SUPPORT
-      if (etcpal_mutex_lock(&mempool_lock))
+      if (etcpal_mutex_lock(MEMPOOL_LOCK(desc)))
       {
 #endif
-        size_t         index     = (size_t)offset / desc->elem_size;
         EtcPalMempool* elem_desc = &desc->list[index];
         elem_desc->next          = desc->freelist;
         desc->freelist           = elem_desc;
         --desc->current_used;
 #if !ETCPAL_NO_OS_SUPPORT
-        etcpal_mutex_unlock(&mempool_lock);
+        etcpal_mutex_unlock(MEMPOOL_LOCK(desc));
       }
 #endif
     }
@@ -129,15 +247,72 @@ size_t etcpal_mempool_used_priv(EtcPalMempoolDesc* desc)
   if (!desc)
     return 0;
 
+#if MEMPOOL_HAVE_ATOMICS
+  if (USE_LOCKFREE(desc))
+    return MEMPOOL_ATOMIC_LOAD_COUNT(&desc->current_used);
+#endif
+
 #if ETCPAL_NO_OS_SUPPORT
   return desc->current_used;
 #else
   size_t res = 0;
-  if (etcpal_mutex_lock(&mempool_lock))
+  if (etcpal_mutex_lock(MEMPOOL_LOCK(desc)))
   {
     res = desc->current_used;
-    etcpal_mutex_unlock(&mempool_lock);
+    etcpal_mutex_unlock(MEMPOOL_LOCK(desc));
   }
   return res;
 #endif
 }
+
+#if MEMPOOL_HAVE_ATOMICS
+
+// Pop an element from the lock-free freelist. The tag in the high bits of freelist_head guards
+// against the ABA problem, where an element is popped and pushed back between our read of the
+// head and our compare-and-swap.
+void* alloc_lockfree(EtcPalMempoolDesc* desc)
+{
+  uint64_t head = MEMPOOL_ATOMIC_LOAD_HEAD(&desc->freelist_head);
+  size_t   index;
+  for (;;)
+  {
+    index = MEMPOOL_HEAD_INDEX(head);
+    if (index >= desc->pool_size)
+      return NULL;
+
+    EtcPalMempool* next       = MEMPOOL_ATOMIC_LOAD_NEXT(&desc->list[index].next);
+    uint64_t       next_index = next ? (uint64_t)(next - desc->list) : MEMPOOL_INDEX_EMPTY;
+    if (MEMPOOL_ATOMIC_CAS(&desc->freelist_head, head, MEMPOOL_HEAD_NEXT(head, next_index)))
+      break;
+  }
+
+  MEMPOOL_ATOMIC_INCREMENT(&desc->current_used);
+  return (void*)((char*)desc->pool + (index * desc->elem_size));
+}
+
+// Push an element back onto the lock-free freelist.
+void free_lockfree(EtcPalMempoolDesc* desc, size_t index)
+{
+  EtcPalMempool* elem_desc = &desc->list[index];
+  uint64_t       head      = MEMPOOL_ATOMIC_LOAD_HEAD(&desc->freelist_head);
+  do
+  {
+    size_t head_index = MEMPOOL_HEAD_INDEX(head);
+    MEMPOOL_ATOMIC_STORE_NEXT(&elem_desc->next, head_index < desc->pool_size ? &desc->list[head_index] : NULL);
+  } while (!MEMPOOL_ATOMIC_CAS(&desc->freelist_head, head, MEMPOOL_HEAD_NEXT(head, index)));
+
+  MEMPOOL_ATOMIC_DECREMENT(&desc->current_used);
+}
+
+#endif  // MEMPOOL_HAVE_ATOMICS
+
+#if defined(_MSC_VER) && !defined(__clang__)
+bool mempool_msvc_cas(uint64_t* ptr, uint64_t* old_val, uint64_t new_val)
+{
+  uint64_t prev = (uint64_t)_InterlockedCompareExchange64((volatile __int64*)ptr, (__int64)new_val, (__int64)*old_val);
+  if (prev == *old_val)
+    return true;
+  *old_val = prev;
+  return false;
+}
+#endif
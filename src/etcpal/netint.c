@@ -22,17 +22,33 @@
 #include "etcpal/netint.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include "etcpal/common.h"
 #include "etcpal/mutex.h"
 #include "etcpal/private/common.h"
 #include "etcpal/private/netint.h"
 
+/****************************** Private types ********************************/
+
+// The last known link state of an interface, maintained while the interface monitor is running.
+typedef struct NetintLinkState
+{
+  unsigned int index;
+  bool         is_up;
+} NetintLinkState;
+
 /**************************** Private variables ******************************/
 
 static bool             initialized  = false;
 static CachedNetintInfo netint_cache = {0};
 etcpal_mutex_t          mutex;
 
+static bool                       monitoring       = false;
+static EtcPalNetintChangeCallback monitor_callback = NULL;
+static void*                      monitor_context  = NULL;
+static NetintLinkState*           link_states      = NULL;
+static size_t                     num_link_states  = 0;
+
 /*********************** Private function prototypes *************************/
 
 static int            compare_netints(const void* a, const void* b);
@@ -44,6 +60,14 @@ static etcpal_error_t get_interfaces(EtcPalNetintInfo*   netints,
                                      unsigned int        index,
                                      const EtcPalIpAddr* specific_ip);
 
+// Applying changes from the interface monitor. All of these need lock.
+static bool             add_cached_netint(EtcPalNetintInfo* netint);
+static bool             remove_cached_netint(EtcPalNetintInfo* netint);
+static void             update_default_flags(void);
+static NetintLinkState* find_link_state(unsigned int index);
+static bool             set_link_state(unsigned int index, bool is_up);
+static void             clear_link_states(void);
+
 /*************************** Function definitions ****************************/
 
 etcpal_error_t etcpal_netint_init(void)
@@ -63,6 +87,7 @@ etcpal_error_t etcpal_netint_init(void)
 
 void etcpal_netint_deinit(void)
 {
+  etcpal_netint_stop_monitor();
   clear_netint_cache();
   etcpal_mutex_destroy(&mutex);
   initialized = false;
@@ -243,6 +268,67 @@ etcpal_error_t etcpal_netint_get_interface_for_dest(const EtcPalIpAddr* dest, un
   return res;
 }
 
+/**
+ * @brief Get the network interfaces that the system will choose when routing IP packets to each of
+ *        a set of destinations.
+ *
+ * Equivalent to calling etcpal_netint_get_interface_for_dest() for each destination, but the
+ * interface cache is only locked once for the whole set. Prefer this function when resolving routes
+ * for many destinations at once.
+ *
+ * Destinations for which no route can be resolved have their corresponding entry in netint_indexes
+ * set to 0, which is never a valid interface index.
+ *
+ * @param[in] dests Array of destination IP addresses.
+ * @param[out] netint_indexes Array of size num_dests to fill in with the index of the interface
+ *                            chosen for each destination.
+ * @param[in] num_dests Size of the dests and netint_indexes arrays.
+ * @return #kEtcPalErrOk: An interface was resolved for every destination.
+ * @return #kEtcPalErrInvalid: Invalid argument provided.
+ * @return #kEtcPalErrNotInit: Module not initialized.
+ * @return #kEtcPalErrNoNetints: No network interfaces found on system.
+ * @return #kEtcPalErrNotFound: No route was able to be resolved to one or more of the destinations.
+ *         The indexes of the destinations that were resolved are still filled in.
+ */
+etcpal_error_t etcpal_netint_get_interfaces_for_dests(const EtcPalIpAddr* dests,
+                                                      unsigned int*       netint_indexes,
+                                                      size_t              num_dests)
+{
+  if (!dests || !netint_indexes || num_dests == 0)
+    return kEtcPalErrInvalid;
+  if (!initialized)
+    return kEtcPalErrNotInit;
+
+  if (!etcpal_mutex_lock(&mutex))
+    return kEtcPalErrSys;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  if (netint_cache.num_netints == 0)
+    res = kEtcPalErrNoNetints;
+
+  if (res == kEtcPalErrOk)
+  {
+    for (size_t i = 0; i < num_dests; ++i)
+    {
+      netint_indexes[i]          = 0;
+      etcpal_error_t resolve_res = os_resolve_route(&dests[i], &netint_cache, &netint_indexes[i]);
+      if (resolve_res == kEtcPalErrNotFound)
+      {
+        netint_indexes[i] = 0;
+        res               = kEtcPalErrNotFound;
+      }
+      else if (resolve_res != kEtcPalErrOk)
+      {
+        res = resolve_res;
+        break;
+      }
+    }
+  }
+
+  etcpal_mutex_unlock(&mutex);
+  return res;
+}
+
 int compare_netints(const void* a, const void* b)
 {
   if (!ETCPAL_ASSERT_VERIFY(a) || !ETCPAL_ASSERT_VERIFY(b))
@@ -344,6 +430,8 @@ etcpal_error_t etcpal_netint_refresh_interfaces()
  *
  * @note On Windows, cached network interface information is used to determine this, so the result
  *       for a given index will not change until etcpal_netint_refresh_interfaces() is called.
+ * @note While the interface monitor is running (see etcpal_netint_start_monitor()), the link state
+ *       it keeps is used to determine this, without querying the OS.
  *
  * @param netint_index Index of the interface to check.
  * @return true: The interface indicated by netint_index is up.
@@ -357,10 +445,278 @@ bool etcpal_netint_is_up(unsigned int netint_index)
   if (!etcpal_mutex_lock(&mutex))
     return false;
 
-  bool res = os_netint_is_up(netint_index, &netint_cache);
+  bool res = false;
+  if (monitoring)
+  {
+    const NetintLinkState* link_state = find_link_state(netint_index);
+    res                               = (link_state && link_state->is_up);
+  }
+  else
+  {
+    res = os_netint_is_up(netint_index, &netint_cache);
+  }
+
+  etcpal_mutex_unlock(&mutex);
+  return res;
+}
+
+/**
+ * @brief Start monitoring the system for network interface changes.
+ *
+ * Starts a background thread which listens for address, link state and routing changes reported by
+ * the OS and applies them to the cached interface information as they occur, so that
+ * etcpal_netint_refresh_interfaces() does not need to be called periodically. While the monitor is
+ * running, etcpal_netint_is_up() is answered from the cache.
+ *
+ * The interface cache is refreshed once when the monitor starts. After each change has been
+ * applied, the callback (if provided) is notified of it from the monitor thread.
+ *
+ * This function and etcpal_netint_stop_monitor() should not be called concurrently with each other.
+ *
+ * @param[in] callback Function to call with each change, or NULL if no notification is needed.
+ * @param[in] context Opaque data pointer passed back to the callback.
+ * @return #kEtcPalErrOk: Monitor started.
+ * @return #kEtcPalErrNotInit: Module not initialized.
+ * @return #kEtcPalErrAlready: The monitor is already running.
+ * @return #kEtcPalErrNotImpl: Interface monitoring is not supported on this platform.
+ * @return Other error codes from the underlying platform are possible here.
+ */
+etcpal_error_t etcpal_netint_start_monitor(EtcPalNetintChangeCallback callback, void* context)
+{
+  if (!initialized)
+    return kEtcPalErrNotInit;
+
+  if (!etcpal_mutex_lock(&mutex))
+    return kEtcPalErrSys;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  if (monitoring)
+  {
+    res = kEtcPalErrAlready;
+  }
+  else
+  {
+    monitor_callback = callback;
+    monitor_context  = context;
+  }
 
   etcpal_mutex_unlock(&mutex);
+  if (res != kEtcPalErrOk)
+    return res;
+
+  // The monitor reports the initial link states through netint_apply_change(), so it must be started
+  // without the lock held.
+  res = os_netint_start_monitor();
+
+  // Refresh the cache now that changes are being monitored, so that no change made before the
+  // monitor started is missed.
+  if (res == kEtcPalErrOk && etcpal_mutex_lock(&mutex))
+  {
+    clear_netint_cache();
+    res = populate_netint_cache();
+    if (res == kEtcPalErrOk)
+      monitoring = true;
+    etcpal_mutex_unlock(&mutex);
+
+    if (res != kEtcPalErrOk)
+      os_netint_stop_monitor();
+  }
+
+  if (res != kEtcPalErrOk && etcpal_mutex_lock(&mutex))
+  {
+    monitor_callback = NULL;
+    monitor_context  = NULL;
+    clear_link_states();
+    etcpal_mutex_unlock(&mutex);
+  }
+
   return res;
 }
 
+/**
+ * @brief Stop monitoring the system for network interface changes.
+ *
+ * Blocks until the monitor thread has exited; no change callbacks are in progress or will be made
+ * after this function returns. The cached interface information is kept, but will only change if
+ * etcpal_netint_refresh_interfaces() is called. Must not be called from the change callback.
+ */
+void etcpal_netint_stop_monitor(void)
+{
+  if (!initialized || !etcpal_mutex_lock(&mutex))
+    return;
+
+  bool was_monitoring = monitoring;
+  monitoring          = false;
+  etcpal_mutex_unlock(&mutex);
+
+  if (!was_monitoring)
+    return;
+
+  os_netint_stop_monitor();
+
+  if (etcpal_mutex_lock(&mutex))
+  {
+    monitor_callback = NULL;
+    monitor_context  = NULL;
+    clear_link_states();
+    etcpal_mutex_unlock(&mutex);
+  }
+}
+
+// Takes lock
+void netint_apply_change(const EtcPalNetintChange* change, bool notify)
+{
+  if (!ETCPAL_ASSERT_VERIFY(change))
+    return;
+
+  if (!etcpal_mutex_lock(&mutex))
+    return;
+
+  // The change is reported with the information as it was applied to the cache.
+  EtcPalNetintChange applied = *change;
+  bool               changed = false;
+  switch (change->type)
+  {
+    case kEtcPalNetintAddrAdded:
+      changed = add_cached_netint(&applied.netint);
+      break;
+    case kEtcPalNetintAddrRemoved:
+      changed = remove_cached_netint(&applied.netint);
+      break;
+    case kEtcPalNetintUp:
+    case kEtcPalNetintDown:
+      changed = set_link_state(change->index, (change->type == kEtcPalNetintUp));
+      break;
+    case kEtcPalNetintRoutesChanged:
+      os_netint_update_routes(&netint_cache);
+      update_default_flags();
+      changed = true;
+      break;
+    default:
+      break;
+  }
+
+  EtcPalNetintChangeCallback callback = monitor_callback;
+  void*                      context  = monitor_context;
+  etcpal_mutex_unlock(&mutex);
+
+  if (changed && notify && callback)
+    callback(context, &applied);
+}
+
+// Needs lock. Adds a new address entry to the cache in index order, filling in its is_default flag.
+// Returns false if an entry for this address already exists, in which case it is updated instead.
+bool add_cached_netint(EtcPalNetintInfo* netint)
+{
+  if (!ETCPAL_ASSERT_VERIFY(netint))
+    return false;
+
+  if (ETCPAL_IP_IS_V4(&netint->addr))
+    netint->is_default = (netint_cache.def.v4_valid && netint_cache.def.v4_index == netint->index);
+  else
+    netint->is_default = (netint_cache.def.v6_valid && netint_cache.def.v6_index == netint->index);
+
+  size_t insert_pos = netint_cache.num_netints;
+  for (size_t i = 0; i < netint_cache.num_netints; ++i)
+  {
+    EtcPalNetintInfo* existing = &netint_cache.netints[i];
+    if (existing->index == netint->index && etcpal_ip_cmp(&existing->addr, &netint->addr) == 0)
+    {
+      *existing = *netint;
+      return false;
+    }
+    if (existing->index > netint->index && insert_pos == netint_cache.num_netints)
+      insert_pos = i;
+  }
+
+  EtcPalNetintInfo* new_netints =
+      (EtcPalNetintInfo*)realloc(netint_cache.netints, (netint_cache.num_netints + 1) * sizeof(EtcPalNetintInfo));
+  if (!new_netints)
+    return false;
+
+  memmove(&new_netints[insert_pos + 1], &new_netints[insert_pos],
+          (netint_cache.num_netints - insert_pos) * sizeof(EtcPalNetintInfo));
+  new_netints[insert_pos] = *netint;
+  netint_cache.netints    = new_netints;
+  ++netint_cache.num_netints;
+  return true;
+}
+
+// Needs lock. Removes the entry matching the index and address of netint from the cache and fills
+// in netint with the removed entry. Returns false if no entry matched.
+bool remove_cached_netint(EtcPalNetintInfo* netint)
+{
+  if (!ETCPAL_ASSERT_VERIFY(netint))
+    return false;
+
+  for (size_t i = 0; i < netint_cache.num_netints; ++i)
+  {
+    EtcPalNetintInfo* existing = &netint_cache.netints[i];
+    if (existing->index == netint->index && etcpal_ip_cmp(&existing->addr, &netint->addr) == 0)
+    {
+      *netint = *existing;
+      memmove(existing, existing + 1, (netint_cache.num_netints - i - 1) * sizeof(EtcPalNetintInfo));
+      --netint_cache.num_netints;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Needs lock
+void update_default_flags(void)
+{
+  for (EtcPalNetintInfo* netint = netint_cache.netints; netint < netint_cache.netints + netint_cache.num_netints;
+       ++netint)
+  {
+    if (ETCPAL_IP_IS_V4(&netint->addr))
+      netint->is_default = (netint_cache.def.v4_valid && netint_cache.def.v4_index == netint->index);
+    else
+      netint->is_default = (netint_cache.def.v6_valid && netint_cache.def.v6_index == netint->index);
+  }
+}
+
+// Needs lock
+NetintLinkState* find_link_state(unsigned int index)
+{
+  for (NetintLinkState* link_state = link_states; link_state < link_states + num_link_states; ++link_state)
+  {
+    if (link_state->index == index)
+      return link_state;
+  }
+  return NULL;
+}
+
+// Needs lock. Returns true if the link state changed, or if a new link appeared in the up state.
+bool set_link_state(unsigned int index, bool is_up)
+{
+  NetintLinkState* link_state = find_link_state(index);
+  if (link_state)
+  {
+    bool changed      = (link_state->is_up != is_up);
+    link_state->is_up = is_up;
+    return changed;
+  }
+
+  NetintLinkState* new_link_states =
+      (NetintLinkState*)realloc(link_states, (num_link_states + 1) * sizeof(NetintLinkState));
+  if (!new_link_states)
+    return false;
+
+  link_states                        = new_link_states;
+  link_states[num_link_states].index = index;
+  link_states[num_link_states].is_up = is_up;
+  ++num_link_states;
+  return is_up;
+}
+
+// Needs lock
+void clear_link_states(void)
+{
+  if (link_states)
+    free(link_states);
+  link_states     = NULL;
+  num_link_states = 0;
+}
+
 #endif  // ETCPAL_NO_NETWORKING_SUPPORT
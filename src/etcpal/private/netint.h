@@ -48,4 +48,18 @@ void           os_free_interfaces(CachedNetintInfo* cache);
 etcpal_error_t os_resolve_route(const EtcPalIpAddr* dest, const CachedNetintInfo* cache, unsigned int* index);
 bool           os_netint_is_up(unsigned int index, const CachedNetintInfo* cache);
 
+// Interface monitoring. Platforms that can't monitor interface changes return kEtcPalErrNotImpl
+// from os_netint_start_monitor(). A running monitor reports changes from its own thread by calling
+// netint_apply_change(); os_netint_stop_monitor() must not return until that thread has exited.
+etcpal_error_t os_netint_start_monitor(void);
+void           os_netint_stop_monitor(void);
+// Called with the cache locked after the monitor reports kEtcPalNetintRoutesChanged, to install the
+// platform's updated routing information and refresh the default interfaces in the cache.
+void os_netint_update_routes(CachedNetintInfo* cache);
+
+// Defined in netint.c. Applies a change from the monitor to the cache; if notify is false, the
+// application's change callback is not called (used while taking the initial snapshot of the
+// interfaces' link states).
+void netint_apply_change(const EtcPalNetintChange* change, bool notify);
+
 #endif /* ETCPAL_PRIVATE_NETINT_H_ */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+/* etcpal/private/route_index.h: A longest-prefix-match index over IP routing table entries. */
+
+#ifndef ETCPAL_PRIVATE_ROUTE_INDEX_H_
+#define ETCPAL_PRIVATE_ROUTE_INDEX_H_
+
+#include <stddef.h>
+#include "etcpal/error.h"
+#include "etcpal/inet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A path-compressed binary trie keyed on the bits of an IP address. Each node stores the full
+ * prefix it represents; a node with a value >= 0 corresponds to a route. Nodes are kept in one
+ * contiguous array and refer to their children by array index, so the index can be built with a
+ * handful of reallocations and walked without chasing heap pointers.
+ *
+ * An index holds routes of a single IP address family; use one index per routing table.
+ */
+
+typedef struct RouteIndexNode
+{
+  uint8_t      prefix[ETCPAL_IPV6_BYTES];
+  unsigned int prefix_len;
+  int          child[2];
+  int          value;
+} RouteIndexNode;
+
+typedef struct RouteIndex
+{
+  RouteIndexNode* nodes;
+  size_t          num_nodes;
+  size_t          capacity;
+} RouteIndex;
+
+void           route_index_init(RouteIndex* index);
+void           route_index_clear(RouteIndex* index);
+etcpal_error_t route_index_insert(RouteIndex* index, const EtcPalIpAddr* prefix, unsigned int prefix_len, int value);
+int            route_index_lookup(const RouteIndex* index, const EtcPalIpAddr* addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ETCPAL_PRIVATE_ROUTE_INDEX_H_ */
@@ -2,184 +2,36 @@
 
 #include "etcpal/queue.h"
 #include "etcpal/private/common.h"
+#include <stdlib.h>
 #include <string.h>
+#include "etcpal/timer.h"
 
 #if !ETCPAL_TARGETING_FREERTOS
 
-static inline bool wait_for_space_timed(const etcpal_queue_t* queue, int timeout_ms)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
-
-  return etcpal_sem_timed_wait((etcpal_sem_t*)&queue->spots_available, timeout_ms);
-}
-
-static inline bool notify_space_available(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
-
-  return etcpal_sem_post((etcpal_sem_t*)&queue->spots_available);
-}
-
-static inline bool notify_space_available_from_isr(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
-
-  return etcpal_sem_post_from_isr((etcpal_sem_t*)&queue->spots_available);
-}
+/*
+ * The queue is a single contiguous ring buffer whose capacity is rounded up to a power of two, so
+ * that indices can be wrapped with a mask. All queue state is protected by one mutex.
+ *
+ * The two semaphores are not used to count items or spaces. They are only posted when a thread is
+ * actually waiting on the queue (i.e. when it was empty or full), so the common uncontended path
+ * is a single lock/unlock.
+ */
 
-static inline bool wait_for_data_timed(const etcpal_queue_t* queue, int timeout_ms)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
-
-  return etcpal_sem_timed_wait((etcpal_sem_t*)&queue->spots_filled, timeout_ms);
-}
-
-static inline bool notify_data_available(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
+/**************************** Private constants ******************************/
 
-  return etcpal_sem_post((etcpal_sem_t*)&queue->spots_filled);
-}
+#define QUEUE_BUFFER_ALIGNMENT 64
+#define QUEUE_MAX_WAITERS      0x7fffffffu
 
-static inline bool notify_data_available_from_isr(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
+/*********************** Private function prototypes *************************/
 
-  return etcpal_sem_post_from_isr((etcpal_sem_t*)&queue->spots_filled);
-}
+static size_t round_up_to_power_of_2(size_t val);
+static int    get_remaining_timeout(uint32_t start_time, int timeout_ms);
+static bool   wait_for_wakeup(etcpal_queue_t* queue, etcpal_sem_t* sem, unsigned int* num_waiters, int timeout_ms);
+static void   wake_waiters(etcpal_sem_t* sem, unsigned int* num_waiters, size_t max_to_wake);
+static size_t push_items(etcpal_queue_t* queue, const void* data, size_t num_items, int timeout_ms);
+static size_t pop_items(etcpal_queue_t* queue, void* data, size_t max_items, int timeout_ms);
 
-static inline bool lock(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return false;
-
-  bool success = etcpal_sem_wait((etcpal_sem_t*)&queue->lock);
-  return success;
-}
-
-static inline void unlock(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return;
-
-  (void)etcpal_sem_post((etcpal_sem_t*)&queue->lock);
-}
-
-static inline void unlock_from_isr(const etcpal_queue_t* queue)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue))
-    return;
-
-  (void)etcpal_sem_post_from_isr((etcpal_sem_t*)&queue->lock);
-}
-
-static inline bool push_data_timed(etcpal_queue_t* queue, const void* data, int timeout_ms)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
-    return false;
-
-  bool true_if_success = false;
-
-  if (wait_for_space_timed(queue, timeout_ms))
-  {
-    lock(queue);
-
-    memcpy(queue->node_list[queue->head].data, data, queue->element_size);
-
-    queue->head++;
-    queue->head %= (queue->max_queue_size + 1);
-    queue->queue_size++;
-
-    true_if_success = true;
-
-    unlock(queue);
-    notify_data_available(queue);
-  }
-
-  return true_if_success;
-}
-
-static inline bool push_data_from_isr(etcpal_queue_t* queue, const void* data)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
-    return false;
-
-  bool true_if_success = false;
-
-  if (wait_for_space_timed(queue, 0))
-  {
-    lock(queue);
-
-    memcpy(queue->node_list[queue->head].data, data, queue->element_size);
-
-    queue->head++;
-    queue->head %= (queue->max_queue_size + 1);
-    queue->queue_size++;
-
-    true_if_success = true;
-
-    unlock_from_isr(queue);
-    notify_data_available_from_isr(queue);
-  }
-
-  return true_if_success;
-}
-
-static inline bool pop_data_timed(etcpal_queue_t* queue, void* data, int timeout_ms)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
-    return false;
-
-  bool true_if_success = false;
-  if (wait_for_data_timed(queue, timeout_ms))
-  {
-    lock(queue);
-    memcpy(data, queue->node_list[queue->tail].data, queue->element_size);
-
-    queue->tail++;
-    queue->tail %= (queue->max_queue_size + 1);
-
-    queue->queue_size--;
-
-    true_if_success = true;
-
-    unlock(queue);
-    notify_space_available(queue);
-  }
-
-  return true_if_success;
-}
-
-static inline bool pop_data_from_isr(etcpal_queue_t* queue, void* data)
-{
-  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
-    return false;
-
-  bool true_if_success = false;
-  if (wait_for_data_timed(queue, 0))
-  {
-    lock(queue);
-    memcpy(data, queue->node_list[queue->tail].data, queue->element_size);
-
-    queue->tail++;
-    queue->tail %= (queue->max_queue_size + 1);
-
-    queue->queue_size--;
-
-    true_if_success = true;
-
-    unlock(queue);
-    notify_space_available_from_isr(queue);
-  }
-
-  return true_if_success;
-}
+/*************************** Function definitions ****************************/
 
 // NOLINTNEXTLINE(readability-non-const-parameter)
 bool etcpal_queue_create_static(etcpal_queue_t* id, size_t size, size_t item_size, uint8_t* buffer)
@@ -200,75 +52,52 @@ bool etcpal_queue_create(etcpal_queue_t* id, size_t size, size_t item_size)
   // Initialize queue
   memset(id, 0, sizeof(etcpal_queue_t));
 
-  id->element_size = item_size;
+  id->element_size   = item_size;
+  id->max_queue_size = size;
+  id->index_mask     = round_up_to_power_of_2(size) - 1;
 
-  // Initialize locks
-  if (!etcpal_sem_create(&id->lock, 1, 1))
+  // Allocate storage for all items at once, aligned to a cache line
+  id->buffer_mem = malloc(((id->index_mask + 1) * item_size) + QUEUE_BUFFER_ALIGNMENT - 1);
+  if (!id->buffer_mem)
     return false;
-  if (!etcpal_sem_create(&id->spots_available, (unsigned)size, (unsigned)size))
+  id->buffer = (uint8_t*)(((uintptr_t)id->buffer_mem + QUEUE_BUFFER_ALIGNMENT - 1) &
+                          ~(uintptr_t)(QUEUE_BUFFER_ALIGNMENT - 1));
+
+  // Initialize locks
+  if (!etcpal_mutex_create(&id->lock))
   {
-    etcpal_sem_destroy(&id->lock);
+    free(id->buffer_mem);
     return false;
   }
-  if (!etcpal_sem_create(&id->spots_filled, 0, (unsigned)size))
+  if (!etcpal_sem_create(&id->spots_available, 0, QUEUE_MAX_WAITERS))
   {
-    etcpal_sem_destroy(&id->spots_available);
-    etcpal_sem_destroy(&id->spots_filled);
+    etcpal_mutex_destroy(&id->lock);
+    free(id->buffer_mem);
     return false;
   }
-
-  // Circular buffers need space for an extra item
-  id->node_list = calloc(sizeof(EtcPalQueueNode), size + 1);
-  if (id->node_list)
-  {
-    for (unsigned item_index = 0; item_index < size + 1; item_index++)
-    {
-      id->node_list[item_index].data = calloc(item_size, 1);
-    }
-  }
-  else
+  if (!etcpal_sem_create(&id->spots_filled, 0, QUEUE_MAX_WAITERS))
   {
+    etcpal_sem_destroy(&id->spots_available);
+    etcpal_mutex_destroy(&id->lock);
+    free(id->buffer_mem);
     return false;
   }
 
-  id->max_queue_size = size;
-  id->queue_size     = 0;
-
-  id->tail = 0;
-  id->head = 0;
   return true;
 }
 
 void etcpal_queue_destroy(etcpal_queue_t* id)
 {
-  if (!id)
+  if (!id || !id->buffer_mem)
     return;
 
-  lock(id);
-  if (id->node_list)
-  {
-    for (unsigned item_index = 0; item_index < id->max_queue_size + 1; item_index++)
-    {
-      free(id->node_list[item_index].data);
-    }
-  }
-
-  free(id->node_list);
+  free(id->buffer_mem);
+  id->buffer_mem = NULL;
+  id->buffer     = NULL;
 
-#if ETCPAL_SEM_MUST_BE_BALANCED
-  // Reset the semaphores to their initial counts before destroying
-  for (size_t i = 0; i < id->queue_size; ++i)
-  {
-    etcpal_sem_wait(&id->spots_filled);
-    etcpal_sem_post(&id->spots_available);
-  }
-#endif
-
-  unlock(id);
-
-  etcpal_sem_destroy(&id->lock);
-  etcpal_sem_destroy(&id->spots_available);
   etcpal_sem_destroy(&id->spots_filled);
+  etcpal_sem_destroy(&id->spots_available);
+  etcpal_mutex_destroy(&id->lock);
 }
 
 bool etcpal_queue_send(etcpal_queue_t* id, const void* data)
@@ -276,11 +105,7 @@ bool etcpal_queue_send(etcpal_queue_t* id, const void* data)
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
-
-  true_if_success = push_data_timed(id, data, ETCPAL_WAIT_FOREVER);
-
-  return true_if_success;
+  return (push_items(id, data, 1, ETCPAL_WAIT_FOREVER) == 1);
 }
 
 bool etcpal_queue_timed_send(etcpal_queue_t* id, const void* data, int timeout_ms)
@@ -288,47 +113,39 @@ bool etcpal_queue_timed_send(etcpal_queue_t* id, const void* data, int timeout_m
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
-
-  true_if_success = push_data_timed(id, data, timeout_ms);
-
-  return true_if_success;
+  return (push_items(id, data, 1, timeout_ms) == 1);
 }
 
-bool etcpal_queue_receive(etcpal_queue_t* id, void* data)
+bool etcpal_queue_send_from_isr(etcpal_queue_t* id, const void* data)
 {
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
+  return (push_items(id, data, 1, 0) == 1);
+}
 
-  true_if_success = pop_data_timed(id, data, ETCPAL_WAIT_FOREVER);
+size_t etcpal_queue_send_many(etcpal_queue_t* id, const void* data, size_t num_items, int timeout_ms)
+{
+  if (!id || !data || num_items == 0)
+    return 0;
 
-  return true_if_success;
+  return push_items(id, data, num_items, timeout_ms);
 }
 
-bool etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms)
+bool etcpal_queue_receive(etcpal_queue_t* id, void* data)
 {
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
-
-  true_if_success = pop_data_timed(id, data, timeout_ms);
-
-  return true_if_success;
+  return (pop_items(id, data, 1, ETCPAL_WAIT_FOREVER) == 1);
 }
 
-bool etcpal_queue_send_from_isr(etcpal_queue_t* id, const void* data)
+bool etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms)
 {
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
-
-  true_if_success = push_data_from_isr(id, data);
-
-  return true_if_success;
+  return (pop_items(id, data, 1, timeout_ms) == 1);
 }
 
 bool etcpal_queue_receive_from_isr(etcpal_queue_t* id, void* data)
@@ -336,11 +153,15 @@ bool etcpal_queue_receive_from_isr(etcpal_queue_t* id, void* data)
   if (!id || !data)
     return false;
 
-  bool true_if_success = false;
+  return (pop_items(id, data, 1, 0) == 1);
+}
 
-  true_if_success = pop_data_from_isr(id, data);
+size_t etcpal_queue_receive_many(etcpal_queue_t* id, void* data, size_t max_items, int timeout_ms)
+{
+  if (!id || !data || max_items == 0)
+    return 0;
 
-  return true_if_success;
+  return pop_items(id, data, max_items, timeout_ms);
 }
 
 bool etcpal_queue_reset(etcpal_queue_t* id)
@@ -348,114 +169,219 @@ bool etcpal_queue_reset(etcpal_queue_t* id)
   if (!id)
     return false;
 
-  bool true_if_success = true;
-
-  lock(id);
-
-  // Reset the semaphores to their initial counts
-  for (size_t i = 0; i < id->queue_size; ++i)
-  {
-    true_if_success = etcpal_sem_wait(&id->spots_filled) && true_if_success;
-    true_if_success = etcpal_sem_post(&id->spots_available) && true_if_success;
-  }
-
-  id->queue_size = 0;
+  if (!etcpal_mutex_lock(&id->lock))
+    return false;
 
-  id->tail = 0;
-  id->head = 0;
+  size_t num_removed = id->queue_size;
+  id->queue_size     = 0;
+  id->tail           = 0;
+  id->head           = 0;
+  wake_waiters(&id->spots_available, &id->send_waiters, num_removed);
 
-  unlock(id);
-  return true_if_success;
+  etcpal_mutex_unlock(&id->lock);
+  return true;
 }
 
 bool etcpal_queue_is_empty(const etcpal_queue_t* id)
-{
-  if (!id)
-    return true;
-
-  bool true_if_empty = false;
-  lock(id);
-  true_if_empty = (id->queue_size == 0);
-  unlock(id);
-  return true_if_empty;
-}
-
-bool etcpal_queue_is_empty_from_isr(const etcpal_queue_t* id)
 {
   if (!id)
     return true;
 
   bool true_if_empty = true;
-  if (lock(id))
+  if (etcpal_mutex_lock((etcpal_mutex_t*)&id->lock))
   {
     true_if_empty = (id->queue_size == 0);
-    unlock_from_isr(id);
+    etcpal_mutex_unlock((etcpal_mutex_t*)&id->lock);
   }
   return true_if_empty;
 }
 
-bool etcpal_queue_is_full(const etcpal_queue_t* id)
+bool etcpal_queue_is_empty_from_isr(const etcpal_queue_t* id)
 {
-  if (!id)
-    return true;
-
-  bool true_if_full = false;
-  lock(id);
-  true_if_full = (id->queue_size == id->max_queue_size);
-  unlock(id);
-  return true_if_full;
+  return etcpal_queue_is_empty(id);
 }
 
-bool etcpal_queue_is_full_from_isr(const etcpal_queue_t* id)
+bool etcpal_queue_is_full(const etcpal_queue_t* id)
 {
   if (!id)
     return true;
 
   bool true_if_full = true;
-  if (lock(id))
+  if (etcpal_mutex_lock((etcpal_mutex_t*)&id->lock))
   {
     true_if_full = (id->queue_size == id->max_queue_size);
-    unlock_from_isr(id);
+    etcpal_mutex_unlock((etcpal_mutex_t*)&id->lock);
   }
   return true_if_full;
 }
 
+bool etcpal_queue_is_full_from_isr(const etcpal_queue_t* id)
+{
+  return etcpal_queue_is_full(id);
+}
+
 size_t etcpal_queue_slots_used(const etcpal_queue_t* id)
 {
   if (!id)
     return 0;
 
   size_t size = 0;
-  lock(id);
-  size = id->queue_size;
-  unlock(id);
-
+  if (etcpal_mutex_lock((etcpal_mutex_t*)&id->lock))
+  {
+    size = id->queue_size;
+    etcpal_mutex_unlock((etcpal_mutex_t*)&id->lock);
+  }
   return size;
 }
 
 size_t etcpal_queue_slots_used_from_isr(const etcpal_queue_t* id)
+{
+  return etcpal_queue_slots_used(id);
+}
+
+size_t etcpal_queue_slots_available(const etcpal_queue_t* id)
 {
   if (!id)
     return 0;
 
-  size_t size = 0;
-  if (lock(id))
+  size_t elements = 0;
+  if (etcpal_mutex_lock((etcpal_mutex_t*)&id->lock))
   {
-    unlock_from_isr(id);
+    elements = id->max_queue_size - id->queue_size;
+    etcpal_mutex_unlock((etcpal_mutex_t*)&id->lock);
   }
-  return size;
+  return elements;
 }
 
-size_t etcpal_queue_slots_available(const etcpal_queue_t* id)
+size_t round_up_to_power_of_2(size_t val)
 {
-  if (!id)
+  size_t res = 1;
+  while (res < val)
+    res <<= 1;
+  return res;
+}
+
+int get_remaining_timeout(uint32_t start_time, int timeout_ms)
+{
+  if (timeout_ms == ETCPAL_WAIT_FOREVER)
+    return ETCPAL_WAIT_FOREVER;
+
+  uint32_t elapsed = etcpal_getms() - start_time;
+  return (timeout_ms <= 0 || elapsed >= (uint32_t)timeout_ms) ? 0 : (timeout_ms - (int)elapsed);
+}
+
+// Wait to be woken up by another thread operating on the queue. Must be called with the queue lock
+// held; the lock is released while waiting and is held again when this function returns. Returns
+// false if the wait timed out without a wakeup.
+bool wait_for_wakeup(etcpal_queue_t* queue, etcpal_sem_t* sem, unsigned int* num_waiters, int timeout_ms)
+{
+  ++(*num_waiters);
+  etcpal_mutex_unlock(&queue->lock);
+  bool woken = etcpal_sem_timed_wait(sem, timeout_ms);
+  (void)etcpal_mutex_lock(&queue->lock);
+
+  if (!woken)
+  {
+    // A wakeup may have been posted for us after the wait timed out but before the lock was
+    // reacquired. Consume it in that case; otherwise, we are still counted as a waiter.
+    if (etcpal_sem_try_wait(sem))
+      woken = true;
+    else
+      --(*num_waiters);
+  }
+  return woken;
+}
+
+// Must be called with the queue lock held.
+void wake_waiters(etcpal_sem_t* sem, unsigned int* num_waiters, size_t max_to_wake)
+{
+  for (; *num_waiters > 0 && max_to_wake > 0; --max_to_wake)
+  {
+    --(*num_waiters);
+    (void)etcpal_sem_post(sem);
+  }
+}
+
+size_t push_items(etcpal_queue_t* queue, const void* data, size_t num_items, int timeout_ms)
+{
+  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
     return 0;
 
-  lock(id);
-  size_t elements = id->max_queue_size - id->queue_size;
-  unlock(id);
+  uint32_t start_time = (timeout_ms > 0 ? etcpal_getms() : 0);
+  if (!etcpal_mutex_lock(&queue->lock))
+    return 0;
 
-  return elements;
+  while (queue->queue_size == queue->max_queue_size)
+  {
+    int remaining_ms = get_remaining_timeout(start_time, timeout_ms);
+    if (remaining_ms == 0 || !wait_for_wakeup(queue, &queue->spots_available, &queue->send_waiters, remaining_ms))
+      break;
+  }
+
+  size_t num_to_send = queue->max_queue_size - queue->queue_size;
+  if (num_to_send > num_items)
+    num_to_send = num_items;
+
+  if (num_to_send > 0)
+  {
+    // Copy in up to two chunks, splitting where the ring buffer wraps around.
+    size_t start_index = queue->head & queue->index_mask;
+    size_t first_chunk = (queue->index_mask + 1) - start_index;
+    if (first_chunk > num_to_send)
+      first_chunk = num_to_send;
+
+    memcpy(&queue->buffer[start_index * queue->element_size], data, first_chunk * queue->element_size);
+    memcpy(queue->buffer, (const uint8_t*)data + (first_chunk * queue->element_size),
+           (num_to_send - first_chunk) * queue->element_size);
+
+    queue->head += num_to_send;
+    queue->queue_size += num_to_send;
+    wake_waiters(&queue->spots_filled, &queue->receive_waiters, num_to_send);
+  }
+
+  etcpal_mutex_unlock(&queue->lock);
+  return num_to_send;
+}
+
+size_t pop_items(etcpal_queue_t* queue, void* data, size_t max_items, int timeout_ms)
+{
+  if (!ETCPAL_ASSERT_VERIFY(queue) || !ETCPAL_ASSERT_VERIFY(data))
+    return 0;
+
+  uint32_t start_time = (timeout_ms > 0 ? etcpal_getms() : 0);
+  if (!etcpal_mutex_lock(&queue->lock))
+    return 0;
+
+  while (queue->queue_size == 0)
+  {
+    int remaining_ms = get_remaining_timeout(start_time, timeout_ms);
+    if (remaining_ms == 0 || !wait_for_wakeup(queue, &queue->spots_filled, &queue->receive_waiters, remaining_ms))
+      break;
+  }
+
+  size_t num_to_receive = queue->queue_size;
+  if (num_to_receive > max_items)
+    num_to_receive = max_items;
+
+  if (num_to_receive > 0)
+  {
+    // Copy out in up to two chunks, splitting where the ring buffer wraps around.
+    size_t start_index = queue->tail & queue->index_mask;
+    size_t first_chunk = (queue->index_mask + 1) - start_index;
+    if (first_chunk > num_to_receive)
+      first_chunk = num_to_receive;
+
+    memcpy(data, &queue->buffer[start_index * queue->element_size], first_chunk * queue->element_size);
+    memcpy((uint8_t*)data + (first_chunk * queue->element_size), queue->buffer,
+           (num_to_receive - first_chunk) * queue->element_size);
+
+    queue->tail += num_to_receive;
+    queue->queue_size -= num_to_receive;
+    wake_waiters(&queue->spots_available, &queue->send_waiters, num_to_receive);
+  }
+
+  etcpal_mutex_unlock(&queue->lock);
+  return num_to_receive;
 }
 
 #endif  // !ETCPAL_TARGETING_FREERTOS
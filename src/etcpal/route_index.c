@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/private/route_index.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "etcpal/common.h"
+#include "etcpal/private/common.h"
+
+/**************************** Private constants ******************************/
+
+#define ROUTE_INDEX_INITIAL_CAPACITY 16
+
+/*********************** Private function prototypes *************************/
+
+static unsigned int addr_to_key(const EtcPalIpAddr* addr, uint8_t* key);
+static void         mask_key(uint8_t* key, unsigned int len);
+static unsigned int key_bit(const uint8_t* key, unsigned int bit);
+static unsigned int common_prefix_len(const uint8_t* key1, const uint8_t* key2, unsigned int max_len);
+static int          new_node(RouteIndex* index, const uint8_t* key, unsigned int prefix_len, int value);
+
+/*************************** Function definitions ****************************/
+
+/*
+ * Initialize an empty route index.
+ */
+void route_index_init(RouteIndex* index)
+{
+  if (!ETCPAL_ASSERT_VERIFY(index))
+    return;
+
+  index->nodes     = NULL;
+  index->num_nodes = 0;
+  index->capacity  = 0;
+}
+
+/*
+ * Free all memory held by a route index and return it to the empty state.
+ */
+void route_index_clear(RouteIndex* index)
+{
+  if (!ETCPAL_ASSERT_VERIFY(index))
+    return;
+
+  if (index->nodes)
+    free(index->nodes);
+  route_index_init(index);
+}
+
+/*
+ * Add a route for the network prefix/prefix_len to the index, associated with value (which must be
+ * >= 0). Host bits in prefix beyond prefix_len are ignored. If a route for the same network already
+ * exists, the existing value is kept; this way, inserting routes in order of preference (e.g.
+ * ascending metric) leaves the most preferred route in the index.
+ */
+etcpal_error_t route_index_insert(RouteIndex* index, const EtcPalIpAddr* prefix, unsigned int prefix_len, int value)
+{
+  if (!ETCPAL_ASSERT_VERIFY(index) || !ETCPAL_ASSERT_VERIFY(prefix) || !ETCPAL_ASSERT_VERIFY(value >= 0))
+    return kEtcPalErrSys;
+
+  uint8_t      key[ETCPAL_IPV6_BYTES];
+  unsigned int max_len = addr_to_key(prefix, key);
+  if (max_len == 0 || prefix_len > max_len)
+    return kEtcPalErrInvalid;
+  mask_key(key, prefix_len);
+
+  // The root node represents the zero-length prefix and is always present.
+  if (index->num_nodes == 0 && new_node(index, key, 0, -1) < 0)
+    return kEtcPalErrNoMem;
+
+  // Invariant: the prefix of node cur is a prefix of key, and is no longer than prefix_len.
+  int cur = 0;
+  while (true)
+  {
+    if (index->nodes[cur].prefix_len == prefix_len)
+    {
+      if (index->nodes[cur].value < 0)
+        index->nodes[cur].value = value;
+      return kEtcPalErrOk;
+    }
+
+    unsigned int bit   = key_bit(key, index->nodes[cur].prefix_len);
+    int          child = index->nodes[cur].child[bit];
+    if (child < 0)
+    {
+      int leaf = new_node(index, key, prefix_len, value);
+      if (leaf < 0)
+        return kEtcPalErrNoMem;
+      index->nodes[cur].child[bit] = leaf;
+      return kEtcPalErrOk;
+    }
+
+    unsigned int child_len = index->nodes[child].prefix_len;
+    unsigned int common =
+        common_prefix_len(key, index->nodes[child].prefix, (prefix_len < child_len ? prefix_len : child_len));
+    if (common == child_len)
+    {
+      cur = child;
+      continue;
+    }
+
+    // The new prefix diverges from (or is contained in) the child's prefix; split the edge.
+    if (common == prefix_len)
+    {
+      int split = new_node(index, key, prefix_len, value);
+      if (split < 0)
+        return kEtcPalErrNoMem;
+      index->nodes[split].child[key_bit(index->nodes[child].prefix, prefix_len)] = child;
+      index->nodes[cur].child[bit]                                              = split;
+    }
+    else
+    {
+      int split = new_node(index, key, common, -1);
+      if (split < 0)
+        return kEtcPalErrNoMem;
+      int leaf = new_node(index, key, prefix_len, value);
+      if (leaf < 0)
+        return kEtcPalErrNoMem;
+      index->nodes[split].child[key_bit(key, common)]                      = leaf;
+      index->nodes[split].child[key_bit(index->nodes[child].prefix, common)] = child;
+      index->nodes[cur].child[bit]                                           = split;
+    }
+    return kEtcPalErrOk;
+  }
+}
+
+/*
+ * Find the value associated with the longest prefix in the index that contains addr. Returns -1 if
+ * no route matches.
+ */
+int route_index_lookup(const RouteIndex* index, const EtcPalIpAddr* addr)
+{
+  if (!ETCPAL_ASSERT_VERIFY(index) || !ETCPAL_ASSERT_VERIFY(addr))
+    return -1;
+
+  uint8_t      key[ETCPAL_IPV6_BYTES];
+  unsigned int max_len = addr_to_key(addr, key);
+  if (max_len == 0 || index->num_nodes == 0)
+    return -1;
+
+  int best = -1;
+  int cur  = 0;
+  while (cur >= 0)
+  {
+    const RouteIndexNode* node = &index->nodes[cur];
+    if (node->prefix_len > max_len || common_prefix_len(key, node->prefix, node->prefix_len) != node->prefix_len)
+      break;
+    if (node->value >= 0)
+      best = node->value;
+    if (node->prefix_len == max_len)
+      break;
+    cur = node->child[key_bit(key, node->prefix_len)];
+  }
+  return best;
+}
+
+// Write the address bytes in network order to key, returning the number of bits in the key, or 0
+// if the address is invalid.
+unsigned int addr_to_key(const EtcPalIpAddr* addr, uint8_t* key)
+{
+  memset(key, 0, ETCPAL_IPV6_BYTES);
+  if (ETCPAL_IP_IS_V4(addr))
+  {
+    uint32_t v4 = ETCPAL_IP_V4_ADDRESS(addr);
+    key[0]      = (uint8_t)(v4 >> 24);
+    key[1]      = (uint8_t)(v4 >> 16);
+    key[2]      = (uint8_t)(v4 >> 8);
+    key[3]      = (uint8_t)v4;
+    return 32;
+  }
+  if (ETCPAL_IP_IS_V6(addr))
+  {
+    memcpy(key, ETCPAL_IP_V6_ADDRESS(addr), ETCPAL_IPV6_BYTES);
+    return ETCPAL_IPV6_BYTES * 8;
+  }
+  return 0;
+}
+
+// Zero all bits of key past the first len bits.
+void mask_key(uint8_t* key, unsigned int len)
+{
+  unsigned int byte = len / 8;
+  if (byte >= ETCPAL_IPV6_BYTES)
+    return;
+  if (len % 8)
+    key[byte++] &= (uint8_t)(0xffu << (8 - len % 8));
+  memset(&key[byte], 0, ETCPAL_IPV6_BYTES - byte);
+}
+
+unsigned int key_bit(const uint8_t* key, unsigned int bit)
+{
+  return (key[bit / 8] >> (7 - bit % 8)) & 1u;
+}
+
+// Get the number of leading bits that key1 and key2 have in common, up to max_len.
+unsigned int common_prefix_len(const uint8_t* key1, const uint8_t* key2, unsigned int max_len)
+{
+  unsigned int len = 0;
+  for (size_t i = 0; len < max_len; ++i)
+  {
+    uint8_t diff = key1[i] ^ key2[i];
+    if (diff == 0)
+    {
+      len += 8;
+      continue;
+    }
+    while (!(diff & 0x80u))
+    {
+      diff = (uint8_t)(diff << 1);
+      ++len;
+    }
+    break;
+  }
+  return (len < max_len ? len : max_len);
+}
+
+// Append a node to the index, growing the node array if necessary. Returns the new node's array
+// index, or -1 on allocation failure. Invalidates any pointers into the node array.
+int new_node(RouteIndex* index, const uint8_t* key, unsigned int prefix_len, int value)
+{
+  if (index->num_nodes == index->capacity)
+  {
+    size_t          new_capacity = (index->capacity ? index->capacity * 2 : ROUTE_INDEX_INITIAL_CAPACITY);
+    RouteIndexNode* new_nodes    = (RouteIndexNode*)realloc(index->nodes, new_capacity * sizeof(RouteIndexNode));
+    if (!new_nodes)
+      return -1;
+    index->nodes    = new_nodes;
+    index->capacity = new_capacity;
+  }
+
+  RouteIndexNode* node = &index->nodes[index->num_nodes];
+  memcpy(node->prefix, key, ETCPAL_IPV6_BYTES);
+  mask_key(node->prefix, prefix_len);
+  node->prefix_len = prefix_len;
+  node->child[0]   = -1;
+  node->child[1]   = -1;
+  node->value      = value;
+  return (int)index->num_nodes++;
+}
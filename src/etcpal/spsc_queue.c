@@ -0,0 +1,333 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/spsc_queue.h"
+
+#include <string.h>
+#include "etcpal/common.h"
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/****************************** Private macros *******************************/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SPSC_HAVE_ATOMICS                1
+#define SPSC_LOAD_RELAXED(ptr)           __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define SPSC_LOAD_ACQUIRE(ptr)           __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define SPSC_STORE_RELAXED(ptr, val)     __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#define SPSC_STORE_RELEASE(ptr, val)     __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define SPSC_CAS_RELAXED(ptr, old, new) \
+  __atomic_compare_exchange_n((ptr), (old), (new), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+// Aligned size_t loads and stores are atomic on all Windows targets; volatile accesses have
+// acquire/release semantics under MSVC's default /volatile:ms.
+#define SPSC_HAVE_ATOMICS               1
+#define SPSC_LOAD_RELAXED(ptr)          (*(volatile const size_t*)(ptr))
+#define SPSC_LOAD_ACQUIRE(ptr)          (*(volatile const size_t*)(ptr))
+#define SPSC_STORE_RELAXED(ptr, val)    (*(volatile size_t*)(ptr) = (val))
+#define SPSC_STORE_RELEASE(ptr, val)    (*(volatile size_t*)(ptr) = (val))
+#define SPSC_CAS_RELAXED(ptr, old, new) spsc_msvc_cas((ptr), (old), (new))
+#else
+#define SPSC_HAVE_ATOMICS 0
+#endif
+
+#define IS_POWER_OF_2(val) ((val) != 0 && ((val) & ((val)-1)) == 0)
+
+/*********************** Private function prototypes *************************/
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static bool spsc_msvc_cas(size_t* ptr, size_t* old_val, size_t new_val);
+#endif
+
+/*************************** Function definitions ****************************/
+
+/**
+ * @brief Initialize a single-producer, single-consumer queue.
+ *
+ * Must not be called while any other thread is using the queue.
+ *
+ * @param[out] queue The queue to initialize.
+ * @param[in] buffer Storage for the queue's items. Must be at least item_size * capacity bytes and
+ *                   remain valid for the lifetime of the queue.
+ * @param[in] item_size The size in bytes of each item.
+ * @param[in] capacity The maximum number of items the queue can hold. Must be a power of 2.
+ * @return #kEtcPalErrOk: The queue was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNotImpl: Atomic operations are not available on this platform.
+ */
+etcpal_error_t etcpal_spsc_queue_init(EtcPalSpscQueue* queue, void* buffer, size_t item_size, size_t capacity)
+{
+  if (!queue || !buffer || item_size == 0 || !IS_POWER_OF_2(capacity))
+    return kEtcPalErrInvalid;
+
+#if SPSC_HAVE_ATOMICS
+  memset(queue, 0, sizeof(EtcPalSpscQueue));
+  queue->buffer    = (uint8_t*)buffer;
+  queue->item_size = item_size;
+  queue->mask      = capacity - 1;
+  return kEtcPalErrOk;
+#else
+  return kEtcPalErrNotImpl;
+#endif
+}
+
+/**
+ * @brief Add an item to a single-producer, single-consumer queue.
+ *
+ * Must only be called from the producer thread. Never blocks.
+ *
+ * @param[in,out] queue The queue to which to add an item.
+ * @param[in] item The item to copy into the queue.
+ * @return true: The item was added.
+ * @return false: The queue was full (or invalid argument).
+ */
+bool etcpal_spsc_queue_try_push(EtcPalSpscQueue* queue, const void* item)
+{
+  if (!queue || !item)
+    return false;
+
+#if SPSC_HAVE_ATOMICS
+  size_t tail = queue->tail;
+  if (tail - queue->cached_head > queue->mask)
+  {
+    // Only touch the consumer's cache line when our cached copy says the queue is full.
+    queue->cached_head = SPSC_LOAD_ACQUIRE(&queue->head);
+    if (tail - queue->cached_head > queue->mask)
+      return false;
+  }
+
+  memcpy(&queue->buffer[(tail & queue->mask) * queue->item_size], item, queue->item_size);
+  SPSC_STORE_RELEASE(&queue->tail, tail + 1);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Remove the oldest item from a single-producer, single-consumer queue.
+ *
+ * Must only be called from the consumer thread. Never blocks.
+ *
+ * @param[in,out] queue The queue from which to remove an item.
+ * @param[out] item Filled in with the item removed from the queue.
+ * @return true: An item was removed.
+ * @return false: The queue was empty (or invalid argument).
+ */
+bool etcpal_spsc_queue_try_pop(EtcPalSpscQueue* queue, void* item)
+{
+  if (!queue || !item)
+    return false;
+
+#if SPSC_HAVE_ATOMICS
+  size_t head = queue->head;
+  if (head == queue->cached_tail)
+  {
+    // Only touch the producer's cache line when our cached copy says the queue is empty.
+    queue->cached_tail = SPSC_LOAD_ACQUIRE(&queue->tail);
+    if (head == queue->cached_tail)
+      return false;
+  }
+
+  memcpy(item, &queue->buffer[(head & queue->mask) * queue->item_size], queue->item_size);
+  SPSC_STORE_RELEASE(&queue->head, head + 1);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Get the number of items currently in a single-producer, single-consumer queue.
+ *
+ * When called concurrently with push or pop operations, the result is only a snapshot.
+ *
+ * @param[in] queue The queue to inspect.
+ * @return The number of items in the queue.
+ */
+size_t etcpal_spsc_queue_size(const EtcPalSpscQueue* queue)
+{
+  if (!queue)
+    return 0;
+
+#if SPSC_HAVE_ATOMICS
+  size_t head = SPSC_LOAD_ACQUIRE(&queue->head);
+  size_t tail = SPSC_LOAD_ACQUIRE(&queue->tail);
+  return tail - head;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Initialize a multiple-producer, single-consumer queue.
+ *
+ * Must not be called while any other thread is using the queue.
+ *
+ * @param[out] queue The queue to initialize.
+ * @param[in] buffer Storage for the queue's items. Must be at least item_size * capacity bytes and
+ *                   remain valid for the lifetime of the queue.
+ * @param[in] sequence_buffer Storage for the queue's per-slot sequence numbers. Must be an array of
+ *                            at least capacity elements and remain valid for the lifetime of the
+ *                            queue.
+ * @param[in] item_size The size in bytes of each item.
+ * @param[in] capacity The maximum number of items the queue can hold. Must be a power of 2.
+ * @return #kEtcPalErrOk: The queue was initialized.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNotImpl: Atomic operations are not available on this platform.
+ */
+etcpal_error_t etcpal_mpsc_queue_init(EtcPalMpscQueue* queue,
+                                      void*            buffer,
+                                      size_t*          sequence_buffer,
+                                      size_t           item_size,
+                                      size_t           capacity)
+{
+  if (!queue || !buffer || !sequence_buffer || item_size == 0 || !IS_POWER_OF_2(capacity))
+    return kEtcPalErrInvalid;
+
+#if SPSC_HAVE_ATOMICS
+  memset(queue, 0, sizeof(EtcPalMpscQueue));
+  queue->buffer    = (uint8_t*)buffer;
+  queue->sequences = sequence_buffer;
+  queue->item_size = item_size;
+  queue->mask      = capacity - 1;
+  for (size_t i = 0; i < capacity; ++i)
+    queue->sequences[i] = i;
+  return kEtcPalErrOk;
+#else
+  return kEtcPalErrNotImpl;
+#endif
+}
+
+/**
+ * @brief Add an item to a multiple-producer, single-consumer queue.
+ *
+ * Can be called from any number of threads concurrently. Never blocks.
+ *
+ * @param[in,out] queue The queue to which to add an item.
+ * @param[in] item The item to copy into the queue.
+ * @return true: The item was added.
+ * @return false: The queue was full (or invalid argument).
+ */
+bool etcpal_mpsc_queue_try_push(EtcPalMpscQueue* queue, const void* item)
+{
+  if (!queue || !item)
+    return false;
+
+#if SPSC_HAVE_ATOMICS
+  // Each slot's sequence number equals the position that may next be written to it; producers
+  // claim a position by advancing the tail, then publish the item by advancing the sequence.
+  size_t pos = SPSC_LOAD_RELAXED(&queue->tail);
+  size_t slot;
+  for (;;)
+  {
+    slot          = pos & queue->mask;
+    size_t seq    = SPSC_LOAD_ACQUIRE(&queue->sequences[slot]);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0)
+    {
+      if (SPSC_CAS_RELAXED(&queue->tail, &pos, pos + 1))
+        break;
+    }
+    else if (diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = SPSC_LOAD_RELAXED(&queue->tail);
+    }
+  }
+
+  memcpy(&queue->buffer[slot * queue->item_size], item, queue->item_size);
+  SPSC_STORE_RELEASE(&queue->sequences[slot], pos + 1);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Remove the oldest item from a multiple-producer, single-consumer queue.
+ *
+ * Must only be called from the consumer thread. Never blocks.
+ *
+ * @param[in,out] queue The queue from which to remove an item.
+ * @param[out] item Filled in with the item removed from the queue.
+ * @return true: An item was removed.
+ * @return false: The queue was empty (or invalid argument).
+ */
+bool etcpal_mpsc_queue_try_pop(EtcPalMpscQueue* queue, void* item)
+{
+  if (!queue || !item)
+    return false;
+
+#if SPSC_HAVE_ATOMICS
+  size_t pos  = queue->head;
+  size_t slot = pos & queue->mask;
+  if (SPSC_LOAD_ACQUIRE(&queue->sequences[slot]) != pos + 1)
+    return false;
+
+  memcpy(item, &queue->buffer[slot * queue->item_size], queue->item_size);
+  SPSC_STORE_RELEASE(&queue->sequences[slot], pos + queue->mask + 1);
+  SPSC_STORE_RELAXED(&queue->head, pos + 1);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Get the number of items currently in a multiple-producer, single-consumer queue.
+ *
+ * When called concurrently with push or pop operations, the result is only a snapshot. It includes
+ * items which producers have claimed space for but not yet finished copying.
+ *
+ * @param[in] queue The queue to inspect.
+ * @return The number of items in the queue.
+ */
+size_t etcpal_mpsc_queue_size(const EtcPalMpscQueue* queue)
+{
+  if (!queue)
+    return 0;
+
+#if SPSC_HAVE_ATOMICS
+  size_t head = SPSC_LOAD_RELAXED(&queue->head);
+  size_t tail = SPSC_LOAD_RELAXED(&queue->tail);
+  return (tail > head ? tail - head : 0);
+#else
+  return 0;
+#endif
+}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+bool spsc_msvc_cas(size_t* ptr, size_t* old_val, size_t new_val)
+{
+#ifdef _WIN64
+  size_t prev = (size_t)_InterlockedCompareExchange64((volatile __int64*)ptr, (__int64)new_val, (__int64)*old_val);
+#else
+  size_t prev = (size_t)_InterlockedCompareExchange((volatile long*)ptr, (long)new_val, (long)*old_val);
+#endif
+  if (prev == *old_val)
+    return true;
+  *old_val = prev;
+  return false;
+}
+#endif
@@ -0,0 +1,716 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/threadpool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "etcpal/common.h"
+
+/****************************** Private macros *******************************/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define THREADPOOL_HAVE_ATOMICS        1
+#define THREADPOOL_INCREMENT(ptr)      __atomic_add_fetch((ptr), 1, __ATOMIC_ACQ_REL)
+#define THREADPOOL_DECREMENT(ptr)      __atomic_sub_fetch((ptr), 1, __ATOMIC_ACQ_REL)
+#define THREADPOOL_LOAD(ptr)           __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define THREADPOOL_STORE(ptr, val)     __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define THREADPOOL_FETCH_ADD(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define THREADPOOL_HAVE_ATOMICS        1
+#define THREADPOOL_INCREMENT(ptr)      _InterlockedIncrement((volatile long*)(ptr))
+#define THREADPOOL_DECREMENT(ptr)      _InterlockedDecrement((volatile long*)(ptr))
+#define THREADPOOL_LOAD(ptr)           (*(volatile const long*)(ptr))
+#define THREADPOOL_STORE(ptr, val)     (*(volatile long*)(ptr) = (val))
+#define THREADPOOL_FETCH_ADD(ptr, val) ((unsigned long)_InterlockedExchangeAdd((volatile long*)(ptr), (long)(val)))
+#else
+#define THREADPOOL_HAVE_ATOMICS 0
+#endif
+
+#define THREADPOOL_MAX_SEM_COUNT 0x7fffffff
+
+/****************************** Private types ********************************/
+
+typedef struct ThreadPoolTask
+{
+  EtcPalThreadPoolTaskFn fn;
+  void*                  context;
+  bool                   inline_data;  // True if fn is passed a pointer to data rather than context
+  union
+  {
+    void*         align_ptr;
+    double        align_double;
+    unsigned long align_long;
+    unsigned char bytes[ETCPAL_THREADPOOL_TASK_DATA_SIZE];
+  } data;
+} ThreadPoolTask;
+
+struct EtcPalThreadPoolWorker
+{
+  EtcPalThreadPool*         pool;
+  unsigned int              index;
+  etcpal_thread_t           thread;
+  etcpal_thread_os_handle_t os_handle;  // Written by the worker itself before it posts 'started'
+  bool                      thread_started;
+  etcpal_sem_t*             started;
+
+  // A ring buffer of tasks. The owning worker pushes and pops at the tail; other threads steal from
+  // the head, taking the oldest tasks.
+  etcpal_mutex_t  lock;
+  ThreadPoolTask* tasks;
+  size_t          capacity;
+  size_t          head;
+  size_t          count;
+};
+
+// Tracks the chunks of one etcpal_threadpool_parallel_for() call. Each chunk posts the done
+// semaphore when it finishes.
+typedef struct ParallelForBatch
+{
+  EtcPalThreadPoolRangeFn fn;
+  void*                   context;
+  etcpal_sem_t            done;
+} ParallelForBatch;
+
+typedef struct ParallelForChunk
+{
+  ParallelForBatch* batch;
+  size_t            begin;
+  size_t            end;
+} ParallelForChunk;
+
+/*********************** Private function prototypes *************************/
+
+static void           worker_thread(void* arg);
+static etcpal_error_t submit_task(EtcPalThreadPool* pool, const ThreadPoolTask* task, int timeout_ms);
+static bool           wait_for_slot(EtcPalThreadPool* pool, int timeout_ms);
+static int            find_current_worker(const EtcPalThreadPool* pool);
+static void           push_task(EtcPalThreadPool* pool, const ThreadPoolTask* task);
+static void           take_task(EtcPalThreadPool* pool, int self_index, ThreadPoolTask* task);
+static bool           pop_tail(EtcPalThreadPoolWorker* worker, ThreadPoolTask* task);
+static bool           pop_head(EtcPalThreadPoolWorker* worker, ThreadPoolTask* task);
+static void           run_task(EtcPalThreadPool* pool, ThreadPoolTask* task);
+static void           destroy_workers(EtcPalThreadPool* pool, unsigned int num_workers);
+static void           run_parallel_for_chunk(void* context);
+
+static long atomic_increment(EtcPalThreadPool* pool, long* val);
+static long atomic_decrement(EtcPalThreadPool* pool, long* val);
+static long atomic_load(EtcPalThreadPool* pool, long* val);
+
+/*************************** Function definitions ****************************/
+
+/**
+ * @brief Create a thread pool and start its worker threads.
+ *
+ * @param[out] pool Pool to initialize.
+ * @param[in] config Configuration for the pool.
+ * @return #kEtcPalErrOk: The pool was created.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNoMem: Couldn't allocate memory for the task queues.
+ * @return #kEtcPalErrSys: Couldn't create an OS synchronization primitive.
+ * @return Other error codes are possible from etcpal_thread_create().
+ */
+etcpal_error_t etcpal_threadpool_create(EtcPalThreadPool* pool, const EtcPalThreadPoolConfig* config)
+{
+  if (!pool || !config || config->num_threads == 0 || config->max_queued_tasks == 0)
+    return kEtcPalErrInvalid;
+
+  memset(pool, 0, sizeof(EtcPalThreadPool));
+
+  pool->workers = (EtcPalThreadPoolWorker*)calloc(config->num_threads, sizeof(EtcPalThreadPoolWorker));
+  if (!pool->workers)
+    return kEtcPalErrNoMem;
+
+  if (!etcpal_sem_create(&pool->tasks_available, 0, THREADPOOL_MAX_SEM_COUNT))
+  {
+    free(pool->workers);
+    return kEtcPalErrSys;
+  }
+  if (!etcpal_sem_create(&pool->slots_available, (unsigned int)config->max_queued_tasks, THREADPOOL_MAX_SEM_COUNT))
+  {
+    etcpal_sem_destroy(&pool->tasks_available);
+    free(pool->workers);
+    return kEtcPalErrSys;
+  }
+  if (!etcpal_mutex_create(&pool->idle_lock))
+  {
+    etcpal_sem_destroy(&pool->slots_available);
+    etcpal_sem_destroy(&pool->tasks_available);
+    free(pool->workers);
+    return kEtcPalErrSys;
+  }
+  if (!etcpal_sem_create(&pool->idle_sem, 0, THREADPOOL_MAX_SEM_COUNT))
+  {
+    etcpal_mutex_destroy(&pool->idle_lock);
+    etcpal_sem_destroy(&pool->slots_available);
+    etcpal_sem_destroy(&pool->tasks_available);
+    free(pool->workers);
+    return kEtcPalErrSys;
+  }
+
+  // Each worker records its own OS handle when it starts, and posts this semaphore. Waiting for all
+  // of them before returning means that every handle is visible to find_current_worker() on any
+  // thread which uses the pool.
+  etcpal_sem_t started;
+  if (!etcpal_sem_create(&started, 0, THREADPOOL_MAX_SEM_COUNT))
+  {
+    etcpal_sem_destroy(&pool->idle_sem);
+    etcpal_mutex_destroy(&pool->idle_lock);
+    etcpal_sem_destroy(&pool->slots_available);
+    etcpal_sem_destroy(&pool->tasks_available);
+    free(pool->workers);
+    return kEtcPalErrSys;
+  }
+
+  // Each worker's queue can hold an even share of the maximum, rounded up, so there is always room
+  // somewhere for a task which has been granted a slot.
+  size_t worker_capacity = (config->max_queued_tasks + config->num_threads - 1) / config->num_threads;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  unsigned int   num_initialized;
+  for (num_initialized = 0; num_initialized < config->num_threads; ++num_initialized)
+  {
+    EtcPalThreadPoolWorker* worker = &pool->workers[num_initialized];
+    worker->pool                   = pool;
+    worker->index                  = num_initialized;
+    worker->capacity               = worker_capacity;
+    worker->started                = &started;
+    worker->tasks                  = (ThreadPoolTask*)malloc(worker_capacity * sizeof(ThreadPoolTask));
+    if (!worker->tasks)
+    {
+      res = kEtcPalErrNoMem;
+      break;
+    }
+    if (!etcpal_mutex_create(&worker->lock))
+    {
+      free(worker->tasks);
+      res = kEtcPalErrSys;
+      break;
+    }
+  }
+  pool->num_workers = num_initialized;
+
+  for (unsigned int i = 0; res == kEtcPalErrOk && i < pool->num_workers; ++i)
+  {
+    EtcPalThreadPoolWorker* worker = &pool->workers[i];
+    res = etcpal_thread_create(&worker->thread, &config->thread_params, worker_thread, worker);
+    if (res == kEtcPalErrOk)
+      worker->thread_started = true;
+  }
+
+  for (unsigned int i = 0; i < pool->num_workers; ++i)
+  {
+    if (pool->workers[i].thread_started)
+      (void)etcpal_sem_wait(&started);
+  }
+  etcpal_sem_destroy(&started);
+
+  if (res != kEtcPalErrOk)
+  {
+    destroy_workers(pool, num_initialized);
+    etcpal_sem_destroy(&pool->idle_sem);
+    etcpal_mutex_destroy(&pool->idle_lock);
+    etcpal_sem_destroy(&pool->slots_available);
+    etcpal_sem_destroy(&pool->tasks_available);
+    pool->workers = NULL;
+  }
+  return res;
+}
+
+/**
+ * @brief Destroy a thread pool.
+ *
+ * Waits for all submitted tasks to finish, then stops the worker threads. No tasks may be
+ * submitted during or after this call. Must not be called from a task running on the pool.
+ *
+ * @param[in] pool Pool to destroy.
+ */
+void etcpal_threadpool_destroy(EtcPalThreadPool* pool)
+{
+  if (!pool || !pool->workers)
+    return;
+
+  etcpal_threadpool_wait_idle(pool);
+
+  destroy_workers(pool, pool->num_workers);
+  etcpal_sem_destroy(&pool->idle_sem);
+  etcpal_mutex_destroy(&pool->idle_lock);
+  etcpal_sem_destroy(&pool->slots_available);
+  etcpal_sem_destroy(&pool->tasks_available);
+  pool->workers     = NULL;
+  pool->num_workers = 0;
+}
+
+/**
+ * @brief Submit a task to a thread pool.
+ *
+ * @param[in] pool Pool on which to run the task.
+ * @param[in] fn Function to run.
+ * @param[in] context Pointer passed to the function. Must remain valid until the task finishes.
+ * @param[in] timeout_ms How long to wait for room in the pool if it is full, in milliseconds. Use
+ *                       #ETCPAL_WAIT_FOREVER to wait indefinitely.
+ * @return #kEtcPalErrOk: The task was submitted.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrWouldBlock: The pool is full and timeout_ms was 0.
+ * @return #kEtcPalErrTimedOut: The pool remained full for timeout_ms milliseconds.
+ */
+etcpal_error_t etcpal_threadpool_submit(EtcPalThreadPool*      pool,
+                                        EtcPalThreadPoolTaskFn fn,
+                                        void*                  context,
+                                        int                    timeout_ms)
+{
+  if (!pool || !pool->workers || !fn)
+    return kEtcPalErrInvalid;
+
+  ThreadPoolTask task;
+  task.fn          = fn;
+  task.context     = context;
+  task.inline_data = false;
+  return submit_task(pool, &task, timeout_ms);
+}
+
+/**
+ * @brief Submit a task to a thread pool, copying its data into the pool.
+ *
+ * The function is called with a pointer to a copy of the data, which is suitably aligned for any
+ * object type that could be stored in it. This allows tasks to carry small arguments without the
+ * caller having to keep them alive until the task runs.
+ *
+ * @param[in] pool Pool on which to run the task.
+ * @param[in] fn Function to run.
+ * @param[in] data Data to copy.
+ * @param[in] data_size Size of the data; must be at most #ETCPAL_THREADPOOL_TASK_DATA_SIZE.
+ * @param[in] timeout_ms How long to wait for room in the pool if it is full, in milliseconds. Use
+ *                       #ETCPAL_WAIT_FOREVER to wait indefinitely.
+ * @return #kEtcPalErrOk: The task was submitted.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrWouldBlock: The pool is full and timeout_ms was 0.
+ * @return #kEtcPalErrTimedOut: The pool remained full for timeout_ms milliseconds.
+ */
+etcpal_error_t etcpal_threadpool_submit_copy(EtcPalThreadPool*      pool,
+                                             EtcPalThreadPoolTaskFn fn,
+                                             const void*            data,
+                                             size_t                 data_size,
+                                             int                    timeout_ms)
+{
+  if (!pool || !pool->workers || !fn || (!data && data_size != 0) ||
+      data_size > ETCPAL_THREADPOOL_TASK_DATA_SIZE)
+  {
+    return kEtcPalErrInvalid;
+  }
+
+  ThreadPoolTask task;
+  task.fn          = fn;
+  task.context     = NULL;
+  task.inline_data = true;
+  if (data_size != 0)
+    memcpy(task.data.bytes, data, data_size);
+  return submit_task(pool, &task, timeout_ms);
+}
+
+/**
+ * @brief Wait until all tasks submitted to a thread pool have finished.
+ *
+ * Must not be called from a task running on the pool.
+ *
+ * @param[in] pool Pool on which to wait.
+ */
+void etcpal_threadpool_wait_idle(EtcPalThreadPool* pool)
+{
+  if (!pool || !pool->workers)
+    return;
+
+  while (true)
+  {
+    if (!etcpal_mutex_lock(&pool->idle_lock))
+      return;
+    if (atomic_load(pool, &pool->num_outstanding) == 0)
+    {
+      etcpal_mutex_unlock(&pool->idle_lock);
+      return;
+    }
+    ++pool->num_idle_waiters;
+    etcpal_mutex_unlock(&pool->idle_lock);
+
+    (void)etcpal_sem_wait(&pool->idle_sem);
+  }
+}
+
+/**
+ * @brief Run a function over a range of indices in parallel.
+ *
+ * Splits [0, count) into chunks of grain_size indices and calls fn for each chunk, using the
+ * workers in the pool as well as the calling thread. Returns when every chunk has been processed.
+ * May be called from a task running on the pool.
+ *
+ * @param[in] pool Pool on which to run the chunks.
+ * @param[in] count The number of indices in the range.
+ * @param[in] grain_size The number of indices per chunk, or 0 to choose one based on the number
+ *                       of workers.
+ * @param[in] fn Function to call for each chunk.
+ * @param[in] context Pointer passed to the function.
+ */
+void etcpal_threadpool_parallel_for(EtcPalThreadPool*       pool,
+                                    size_t                  count,
+                                    size_t                  grain_size,
+                                    EtcPalThreadPoolRangeFn fn,
+                                    void*                   context)
+{
+  if (!fn || count == 0)
+    return;
+
+  if (!pool || !pool->workers)
+  {
+    fn(context, 0, count);
+    return;
+  }
+
+  if (grain_size == 0)
+  {
+    // A few chunks per thread (including the caller) evens out chunks which take different times.
+    size_t num_chunks = ((size_t)pool->num_workers + 1) * 4;
+    grain_size        = (count + num_chunks - 1) / num_chunks;
+  }
+
+  size_t num_chunks = (count + grain_size - 1) / grain_size;
+  if (num_chunks == 1)
+  {
+    fn(context, 0, count);
+    return;
+  }
+
+  ParallelForBatch batch;
+  batch.fn      = fn;
+  batch.context = context;
+  if (!etcpal_sem_create(&batch.done, 0, THREADPOOL_MAX_SEM_COUNT))
+  {
+    fn(context, 0, count);
+    return;
+  }
+
+  // The first chunk is run on this thread. The rest are submitted, or run here too if the pool is
+  // full rather than blocking, as this may be a worker which the pool needs to make progress.
+  for (size_t i = 1; i < num_chunks; ++i)
+  {
+    ParallelForChunk chunk;
+    chunk.batch = &batch;
+    chunk.begin = i * grain_size;
+    chunk.end   = (i == num_chunks - 1) ? count : (i + 1) * grain_size;
+    if (etcpal_threadpool_submit_copy(pool, run_parallel_for_chunk, &chunk, sizeof(chunk), ETCPAL_NO_WAIT) !=
+        kEtcPalErrOk)
+    {
+      run_parallel_for_chunk(&chunk);
+    }
+  }
+
+  ParallelForChunk first_chunk;
+  first_chunk.batch = &batch;
+  first_chunk.begin = 0;
+  first_chunk.end   = grain_size;
+  run_parallel_for_chunk(&first_chunk);
+
+  // Help with any queued tasks while waiting for the other chunks to finish. Once no tasks are
+  // waiting to run, every remaining chunk has been picked up by a thread that is running it.
+  int    self_index = find_current_worker(pool);
+  size_t num_done   = 0;
+  while (num_done < num_chunks)
+  {
+    if (etcpal_sem_try_wait(&batch.done))
+    {
+      ++num_done;
+    }
+    else if (etcpal_sem_try_wait(&pool->tasks_available))
+    {
+      ThreadPoolTask task;
+      take_task(pool, self_index, &task);
+      run_task(pool, &task);
+    }
+    else if (etcpal_sem_wait(&batch.done))
+    {
+      ++num_done;
+    }
+  }
+  etcpal_sem_destroy(&batch.done);
+}
+
+/**
+ * @brief Get the number of worker threads in a thread pool.
+ * @param[in] pool Pool to check.
+ * @return The number of worker threads.
+ */
+unsigned int etcpal_threadpool_num_threads(const EtcPalThreadPool* pool)
+{
+  return pool ? pool->num_workers : 0;
+}
+
+void worker_thread(void* arg)
+{
+  EtcPalThreadPoolWorker* worker = (EtcPalThreadPoolWorker*)arg;
+  EtcPalThreadPool*       pool   = worker->pool;
+
+  worker->os_handle = etcpal_thread_get_current_os_handle();
+  (void)etcpal_sem_post(worker->started);
+
+  while (true)
+  {
+    // Each post of tasks_available corresponds to one task pushed to some worker's queue, so once
+    // we take one, there is a task waiting for us somewhere.
+    (void)etcpal_sem_wait(&pool->tasks_available);
+#if THREADPOOL_HAVE_ATOMICS
+    if (THREADPOOL_LOAD(&pool->stopping))
+      break;
+#else
+    long stopping = 0;
+    if (etcpal_mutex_lock(&pool->idle_lock))
+    {
+      stopping = pool->stopping;
+      etcpal_mutex_unlock(&pool->idle_lock);
+    }
+    if (stopping)
+      break;
+#endif
+
+    ThreadPoolTask task;
+    take_task(pool, (int)worker->index, &task);
+    run_task(pool, &task);
+  }
+}
+
+etcpal_error_t submit_task(EtcPalThreadPool* pool, const ThreadPoolTask* task, int timeout_ms)
+{
+  if (!wait_for_slot(pool, timeout_ms))
+    return (timeout_ms == ETCPAL_NO_WAIT) ? kEtcPalErrWouldBlock : kEtcPalErrTimedOut;
+
+  atomic_increment(pool, &pool->num_outstanding);
+  push_task(pool, task);
+  (void)etcpal_sem_post(&pool->tasks_available);
+  return kEtcPalErrOk;
+}
+
+bool wait_for_slot(EtcPalThreadPool* pool, int timeout_ms)
+{
+  if (timeout_ms == ETCPAL_NO_WAIT)
+    return etcpal_sem_try_wait(&pool->slots_available);
+  if (timeout_ms == ETCPAL_WAIT_FOREVER)
+    return etcpal_sem_wait(&pool->slots_available);
+  return etcpal_sem_timed_wait(&pool->slots_available, timeout_ms);
+}
+
+// Get the index of the worker running on the current thread, or -1 if it isn't a worker.
+int find_current_worker(const EtcPalThreadPool* pool)
+{
+  etcpal_thread_os_handle_t current = etcpal_thread_get_current_os_handle();
+  for (unsigned int i = 0; i < pool->num_workers; ++i)
+  {
+    if (pool->workers[i].os_handle == current)
+      return (int)i;
+  }
+  return -1;
+}
+
+void push_task(EtcPalThreadPool* pool, const ThreadPoolTask* task)
+{
+  // Tasks submitted by a worker go to its own queue, where it is likely to run them while their data
+  // is still in its cache. Others are spread across the workers.
+  int          self_index = find_current_worker(pool);
+  unsigned int start;
+  if (self_index >= 0)
+  {
+    start = (unsigned int)self_index;
+  }
+  else
+  {
+#if THREADPOOL_HAVE_ATOMICS
+    start = (unsigned int)(THREADPOOL_FETCH_ADD(&pool->next_worker, 1u) % pool->num_workers);
+#else
+    start = 0;
+    if (etcpal_mutex_lock(&pool->idle_lock))
+    {
+      start = pool->next_worker++ % pool->num_workers;
+      etcpal_mutex_unlock(&pool->idle_lock);
+    }
+#endif
+  }
+
+  // The caller holds a slot, so at least one queue has room.
+  for (unsigned int i = 0;; ++i)
+  {
+    EtcPalThreadPoolWorker* worker = &pool->workers[(start + i) % pool->num_workers];
+    if (etcpal_mutex_lock(&worker->lock))
+    {
+      if (worker->count < worker->capacity)
+      {
+        worker->tasks[(worker->head + worker->count) % worker->capacity] = *task;
+        ++worker->count;
+        etcpal_mutex_unlock(&worker->lock);
+        return;
+      }
+      etcpal_mutex_unlock(&worker->lock);
+    }
+  }
+}
+
+// Take a task from the given worker's own queue if possible, otherwise steal one from another
+// worker. The caller must have taken a count from tasks_available, which guarantees that a task is
+// available.
+void take_task(EtcPalThreadPool* pool, int self_index, ThreadPoolTask* task)
+{
+  if (self_index >= 0 && pop_tail(&pool->workers[self_index], task))
+  {
+    (void)etcpal_sem_post(&pool->slots_available);
+    return;
+  }
+
+  unsigned int start = (self_index >= 0) ? (unsigned int)self_index + 1 : 0;
+  for (unsigned int i = 0;; ++i)
+  {
+    if (pop_head(&pool->workers[(start + i) % pool->num_workers], task))
+    {
+      (void)etcpal_sem_post(&pool->slots_available);
+      return;
+    }
+  }
+}
+
+bool pop_tail(EtcPalThreadPoolWorker* worker, ThreadPoolTask* task)
+{
+  bool found = false;
+  if (etcpal_mutex_lock(&worker->lock))
+  {
+    if (worker->count > 0)
+    {
+      --worker->count;
+      *task = worker->tasks[(worker->head + worker->count) % worker->capacity];
+      found = true;
+    }
+    etcpal_mutex_unlock(&worker->lock);
+  }
+  return found;
+}
+
+bool pop_head(EtcPalThreadPoolWorker* worker, ThreadPoolTask* task)
+{
+  bool found = false;
+  if (etcpal_mutex_lock(&worker->lock))
+  {
+    if (worker->count > 0)
+    {
+      *task        = worker->tasks[worker->head];
+      worker->head = (worker->head + 1) % worker->capacity;
+      --worker->count;
+      found = true;
+    }
+    etcpal_mutex_unlock(&worker->lock);
+  }
+  return found;
+}
+
+void run_task(EtcPalThreadPool* pool, ThreadPoolTask* task)
+{
+  task->fn(task->inline_data ? task->data.bytes : task->context);
+
+  if (atomic_decrement(pool, &pool->num_outstanding) == 0 && etcpal_mutex_lock(&pool->idle_lock))
+  {
+    for (; pool->num_idle_waiters > 0; --pool->num_idle_waiters)
+      (void)etcpal_sem_post(&pool->idle_sem);
+    etcpal_mutex_unlock(&pool->idle_lock);
+  }
+}
+
+void destroy_workers(EtcPalThreadPool* pool, unsigned int num_workers)
+{
+#if THREADPOOL_HAVE_ATOMICS
+  THREADPOOL_STORE(&pool->stopping, 1);
+#else
+  if (etcpal_mutex_lock(&pool->idle_lock))
+  {
+    pool->stopping = 1;
+    etcpal_mutex_unlock(&pool->idle_lock);
+  }
+#endif
+
+  for (unsigned int i = 0; i < num_workers; ++i)
+  {
+    if (pool->workers[i].thread_started)
+      (void)etcpal_sem_post(&pool->tasks_available);
+  }
+  for (unsigned int i = 0; i < num_workers; ++i)
+  {
+    EtcPalThreadPoolWorker* worker = &pool->workers[i];
+    if (worker->thread_started)
+      etcpal_thread_join(&worker->thread);
+    etcpal_mutex_destroy(&worker->lock);
+    free(worker->tasks);
+  }
+  free(pool->workers);
+}
+
+void run_parallel_for_chunk(void* context)
+{
+  ParallelForChunk* chunk = (ParallelForChunk*)context;
+  ParallelForBatch* batch = chunk->batch;
+
+  batch->fn(batch->context, chunk->begin, chunk->end);
+  (void)etcpal_sem_post(&batch->done);
+}
+
+long atomic_increment(EtcPalThreadPool* pool, long* val)
+{
+#if THREADPOOL_HAVE_ATOMICS
+  ETCPAL_UNUSED_ARG(pool);
+  return THREADPOOL_INCREMENT(val);
+#else
+  long res = 0;
+  if (etcpal_mutex_lock(&pool->idle_lock))
+  {
+    res = ++(*val);
+    etcpal_mutex_unlock(&pool->idle_lock);
+  }
+  return res;
+#endif
+}
+
+long atomic_decrement(EtcPalThreadPool* pool, long* val)
+{
+#if THREADPOOL_HAVE_ATOMICS
+  ETCPAL_UNUSED_ARG(pool);
+  return THREADPOOL_DECREMENT(val);
+#else
+  long res = 0;
+  if (etcpal_mutex_lock(&pool->idle_lock))
+  {
+    res = --(*val);
+    etcpal_mutex_unlock(&pool->idle_lock);
+  }
+  return res;
+#endif
+}
+
+long atomic_load(EtcPalThreadPool* pool, long* val)
+{
+#if THREADPOOL_HAVE_ATOMICS
+  ETCPAL_UNUSED_ARG(pool);
+  return THREADPOOL_LOAD(val);
+#else
+  // Only called with idle_lock held
+  ETCPAL_UNUSED_ARG(pool);
+  return *val;
+#endif
+}
@@ -21,6 +21,15 @@
 
 /*************************** Function definitions ****************************/
 
+/**
+ * @brief Get a monotonically-increasing microsecond value.
+ * @return The current timestamp in microseconds, from the same clock as etcpal_getns().
+ */
+uint64_t etcpal_getus(void)
+{
+  return etcpal_getns() / 1000u;
+}
+
 /**
  * @brief Start a timer.
  * @param timer Pointer to the EtcPalTimer to start.
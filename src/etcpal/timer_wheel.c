@@ -0,0 +1,417 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/timer_wheel.h"
+
+#include <string.h>
+#include "etcpal/common.h"
+#include "etcpal/timer.h"
+
+/****************************** Private macros *******************************/
+
+#define SLOT_MASK          (ETCPAL_TIMER_WHEEL_SLOTS - 1u)
+#define LEVEL_SHIFT(level) ((level)*ETCPAL_TIMER_WHEEL_SLOT_BITS)
+
+// The top level only spans the 2 bits of the 32-bit time left over from the levels below it.
+#define LEVEL_NUM_SLOTS(level) \
+  ((level) == ETCPAL_TIMER_WHEEL_LEVELS - 1 ? (1u << (32 - LEVEL_SHIFT(level))) : ETCPAL_TIMER_WHEEL_SLOTS)
+
+// Entries which are not in a wheel slot (the due and firing lists) have this bucket value.
+#define BUCKET_NONE -1
+
+/*********************** Private function prototypes *************************/
+
+static void   add_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry);
+static void   remove_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry);
+static void   link_entry(EtcPalTimerWheelEntry** head, EtcPalTimerWheelEntry* entry, int bucket);
+static void   unlink_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry);
+static void   move_list(EtcPalTimerWheelEntry** from, EtcPalTimerWheelEntry** to);
+static void   advance_to(EtcPalTimerWheel* wheel, uint32_t time);
+static void   cascade(EtcPalTimerWheel* wheel, unsigned int level, unsigned int slot);
+static size_t fire_list(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry** list);
+
+static unsigned int lowest_set_bit(uint64_t bits);
+static unsigned int next_occupied_offset(uint64_t occupied, unsigned int start, unsigned int num_slots);
+
+/*************************** Function definitions ****************************/
+
+/**
+ * @brief Initialize a timer wheel.
+ *
+ * The wheel's notion of the current time starts at etcpal_getms().
+ *
+ * @param[out] wheel The wheel to initialize.
+ */
+void etcpal_timer_wheel_init(EtcPalTimerWheel* wheel)
+{
+  if (!wheel)
+    return;
+
+  memset(wheel, 0, sizeof(EtcPalTimerWheel));
+  wheel->now = etcpal_getms();
+}
+
+/**
+ * @brief Cancel every timer scheduled on a timer wheel.
+ *
+ * No callbacks are called.
+ *
+ * @param[in,out] wheel The wheel to clear.
+ */
+void etcpal_timer_wheel_clear(EtcPalTimerWheel* wheel)
+{
+  if (!wheel)
+    return;
+
+  for (unsigned int level = 0; level < ETCPAL_TIMER_WHEEL_LEVELS; ++level)
+  {
+    for (unsigned int slot = 0; slot < ETCPAL_TIMER_WHEEL_SLOTS; ++slot)
+    {
+      while (wheel->slots[level][slot])
+        remove_entry(wheel, wheel->slots[level][slot]);
+    }
+  }
+  while (wheel->due)
+    remove_entry(wheel, wheel->due);
+  while (wheel->firing)
+    remove_entry(wheel, wheel->firing);
+}
+
+/**
+ * @brief Initialize a timer for use with a timer wheel.
+ *
+ * Must not be called on a timer which is currently scheduled.
+ *
+ * @param[out] entry The timer to initialize.
+ * @param[in] callback The function to call when the timer expires.
+ * @param[in] context Opaque pointer passed to the callback.
+ */
+void etcpal_timer_wheel_entry_init(EtcPalTimerWheelEntry* entry, EtcPalTimerWheelCallback callback, void* context)
+{
+  if (!entry)
+    return;
+
+  entry->callback = callback;
+  entry->context  = context;
+  entry->expiry   = 0;
+  entry->bucket   = BUCKET_NONE;
+  entry->next     = NULL;
+  entry->pprev    = NULL;
+}
+
+/**
+ * @brief Schedule a timer to expire after an interval.
+ *
+ * If the timer is already scheduled, it is rescheduled. The interval is measured from the current
+ * etcpal_getms() time. A timer scheduled with an interval of 0 expires on the next call to
+ * etcpal_timer_wheel_process().
+ *
+ * @param[in,out] wheel The wheel on which to schedule the timer.
+ * @param[in,out] entry The timer to schedule.
+ * @param[in] interval Milliseconds until the timer expires. Values greater than
+ *                     #ETCPAL_TIMER_WHEEL_MAX_INTERVAL are treated as
+ *                     #ETCPAL_TIMER_WHEEL_MAX_INTERVAL.
+ */
+void etcpal_timer_wheel_schedule(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry, uint32_t interval)
+{
+  if (!wheel || !entry)
+    return;
+
+  if (entry->pprev)
+    remove_entry(wheel, entry);
+
+  if (interval > ETCPAL_TIMER_WHEEL_MAX_INTERVAL)
+    interval = ETCPAL_TIMER_WHEEL_MAX_INTERVAL;
+
+  entry->expiry = etcpal_getms() + interval;
+  if (entry->expiry == wheel->now)
+    link_entry(&wheel->due, entry, BUCKET_NONE);
+  else
+    add_entry(wheel, entry);
+  ++wheel->num_timers;
+}
+
+/**
+ * @brief Cancel a scheduled timer.
+ *
+ * Does nothing if the timer is not scheduled.
+ *
+ * @param[in,out] wheel The wheel on which the timer was scheduled.
+ * @param[in,out] entry The timer to cancel.
+ */
+void etcpal_timer_wheel_cancel(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry)
+{
+  if (!wheel || !entry || !entry->pprev)
+    return;
+
+  remove_entry(wheel, entry);
+}
+
+/**
+ * @brief Determine whether a timer is scheduled.
+ * @param[in] entry The timer to check.
+ * @return true (the timer is scheduled and has not yet expired) or false (it is not).
+ */
+bool etcpal_timer_wheel_is_scheduled(const EtcPalTimerWheelEntry* entry)
+{
+  return (entry && entry->pprev);
+}
+
+/**
+ * @brief Expire all timers which are due.
+ *
+ * Advances the wheel to the current etcpal_getms() time, calling the callback for each timer
+ * which expires along the way, in order of expiry time.
+ *
+ * @param[in,out] wheel The wheel to process.
+ * @return The number of timers which expired.
+ */
+size_t etcpal_timer_wheel_process(EtcPalTimerWheel* wheel)
+{
+  if (!wheel)
+    return 0;
+
+  // Timers scheduled with no delay during this call wait for the next one, so that a callback
+  // which keeps rescheduling itself can't hold us here forever.
+  move_list(&wheel->due, &wheel->firing);
+  size_t num_fired = fire_list(wheel, &wheel->firing);
+
+  uint32_t target = etcpal_getms();
+  while (wheel->now != target)
+  {
+    if (wheel->num_timers == 0)
+    {
+      wheel->now = target;
+      break;
+    }
+
+    // Nothing can expire until the lowest occupied level next cascades, so skip ahead to that
+    // point instead of stepping through every millisecond.
+    unsigned int lowest_level = 0;
+    while (lowest_level < ETCPAL_TIMER_WHEEL_LEVELS - 1 && !wheel->occupied[lowest_level])
+      ++lowest_level;
+
+    if (lowest_level > 0)
+    {
+      uint32_t level_mask    = (uint32_t)((1ull << LEVEL_SHIFT(lowest_level)) - 1u);
+      uint32_t ticks_to_next = (uint32_t)(level_mask - (wheel->now & level_mask)) + 1u;
+      if ((uint32_t)(target - wheel->now) < ticks_to_next)
+      {
+        wheel->now = target;
+        break;
+      }
+      wheel->now += ticks_to_next - 1u;
+    }
+
+    advance_to(wheel, wheel->now + 1u);
+    num_fired += fire_list(wheel, &wheel->firing);
+  }
+
+  return num_fired;
+}
+
+/**
+ * @brief Get the time until the next timer on a wheel expires.
+ *
+ * The result is suitable for use as the timeout to a blocking call such as etcpal_poll_wait(),
+ * after which etcpal_timer_wheel_process() should be called. It is exact when the next timer
+ * expires within the next 64 milliseconds, and otherwise may be earlier than the actual expiry
+ * (but never later); processing the wheel at that point simply finds nothing to expire yet.
+ *
+ * @param[in] wheel The wheel to check.
+ * @return Milliseconds until the next timer expires, 0 if a timer has already expired, or
+ *         #ETCPAL_WAIT_FOREVER if no timers are scheduled.
+ */
+int etcpal_timer_wheel_next_timeout(const EtcPalTimerWheel* wheel)
+{
+  if (!wheel || wheel->num_timers == 0)
+    return ETCPAL_WAIT_FOREVER;
+  if (wheel->due || wheel->firing)
+    return 0;
+
+  uint64_t ticks = UINT64_MAX;
+  for (unsigned int level = 0; level < ETCPAL_TIMER_WHEEL_LEVELS; ++level)
+  {
+    if (!wheel->occupied[level])
+      continue;
+
+    unsigned int num_slots  = LEVEL_NUM_SLOTS(level);
+    uint64_t     level_base = (uint64_t)(wheel->now >> LEVEL_SHIFT(level));
+    unsigned int start      = (unsigned int)((level_base + 1) & (num_slots - 1u));
+    unsigned int offset     = next_occupied_offset(wheel->occupied[level], start, num_slots);
+
+    // Level 0 slots expire at exactly their time; higher slots are a lower bound on the expiry of
+    // the timers they contain, as that's when they are cascaded downward.
+    uint64_t level_ticks = ((level_base + offset + 1) << LEVEL_SHIFT(level)) - wheel->now;
+    if (level_ticks < ticks)
+      ticks = level_ticks;
+  }
+
+  uint32_t lag = etcpal_getms() - wheel->now;
+  if (ticks <= lag)
+    return 0;
+  ticks -= lag;
+  return (ticks > ETCPAL_TIMER_WHEEL_MAX_INTERVAL) ? (int)ETCPAL_TIMER_WHEEL_MAX_INTERVAL : (int)ticks;
+}
+
+/**
+ * @brief Get the number of timers scheduled on a wheel.
+ * @param[in] wheel The wheel to check.
+ * @return The number of timers scheduled.
+ */
+size_t etcpal_timer_wheel_size(const EtcPalTimerWheel* wheel)
+{
+  return wheel ? wheel->num_timers : 0;
+}
+
+// Place an entry in the slot for its expiry time, relative to the wheel's current time.
+void add_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry)
+{
+  uint32_t     delta = entry->expiry - wheel->now;
+  unsigned int level = 0;
+  while (level < ETCPAL_TIMER_WHEEL_LEVELS - 1 && delta >= (1ull << LEVEL_SHIFT(level + 1)))
+    ++level;
+
+  unsigned int slot = (unsigned int)(entry->expiry >> LEVEL_SHIFT(level)) & SLOT_MASK;
+  link_entry(&wheel->slots[level][slot], entry, (int)(level * ETCPAL_TIMER_WHEEL_SLOTS + slot));
+  wheel->occupied[level] |= (1ull << slot);
+}
+
+void remove_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry)
+{
+  unlink_entry(wheel, entry);
+  --wheel->num_timers;
+}
+
+void link_entry(EtcPalTimerWheelEntry** head, EtcPalTimerWheelEntry* entry, int bucket)
+{
+  entry->next = *head;
+  if (entry->next)
+    entry->next->pprev = &entry->next;
+  *head         = entry;
+  entry->pprev  = head;
+  entry->bucket = bucket;
+}
+
+void unlink_entry(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry* entry)
+{
+  *entry->pprev = entry->next;
+  if (entry->next)
+    entry->next->pprev = entry->pprev;
+
+  if (entry->bucket != BUCKET_NONE)
+  {
+    unsigned int level = (unsigned int)entry->bucket / ETCPAL_TIMER_WHEEL_SLOTS;
+    unsigned int slot  = (unsigned int)entry->bucket % ETCPAL_TIMER_WHEEL_SLOTS;
+    if (!wheel->slots[level][slot])
+      wheel->occupied[level] &= ~(1ull << slot);
+  }
+
+  entry->next   = NULL;
+  entry->pprev  = NULL;
+  entry->bucket = BUCKET_NONE;
+}
+
+// Move all entries from one list to the front of another.
+void move_list(EtcPalTimerWheelEntry** from, EtcPalTimerWheelEntry** to)
+{
+  while (*from)
+  {
+    EtcPalTimerWheelEntry* entry = *from;
+    *from                        = entry->next;
+    if (*from)
+      (*from)->pprev = from;
+    link_entry(to, entry, BUCKET_NONE);
+  }
+}
+
+// Step the wheel forward to the given time, which must be one tick past its current time. Timers
+// which expire at that time are moved to the firing list.
+void advance_to(EtcPalTimerWheel* wheel, uint32_t time)
+{
+  wheel->now = time;
+
+  // Cascade the higher levels first, so that timers they hand down to a level which is also
+  // cascading at this time end up in the right place.
+  for (unsigned int level = ETCPAL_TIMER_WHEEL_LEVELS - 1; level > 0; --level)
+  {
+    uint32_t lower_mask = (uint32_t)((1ull << LEVEL_SHIFT(level)) - 1u);
+    if ((time & lower_mask) == 0)
+      cascade(wheel, level, (unsigned int)(time >> LEVEL_SHIFT(level)) & SLOT_MASK);
+  }
+
+  unsigned int slot = time & SLOT_MASK;
+  move_list(&wheel->slots[0][slot], &wheel->firing);
+  wheel->occupied[0] &= ~(1ull << slot);
+}
+
+void cascade(EtcPalTimerWheel* wheel, unsigned int level, unsigned int slot)
+{
+  EtcPalTimerWheelEntry* list = NULL;
+  move_list(&wheel->slots[level][slot], &list);
+  wheel->occupied[level] &= ~(1ull << slot);
+
+  while (list)
+  {
+    EtcPalTimerWheelEntry* entry = list;
+    unlink_entry(wheel, entry);
+    add_entry(wheel, entry);
+  }
+}
+
+size_t fire_list(EtcPalTimerWheel* wheel, EtcPalTimerWheelEntry** list)
+{
+  size_t num_fired = 0;
+  while (*list)
+  {
+    EtcPalTimerWheelEntry* entry = *list;
+    remove_entry(wheel, entry);
+    ++num_fired;
+    if (entry->callback)
+      entry->callback(entry, entry->context);
+  }
+  return num_fired;
+}
+
+unsigned int lowest_set_bit(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned int)__builtin_ctzll(bits);
+#else
+  unsigned int index = 0;
+  while (!(bits & 1u))
+  {
+    bits >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+// Find the distance from start to the first occupied slot, wrapping around. occupied must be
+// nonzero.
+unsigned int next_occupied_offset(uint64_t occupied, unsigned int start, unsigned int num_slots)
+{
+  uint64_t rotated = occupied;
+  if (start != 0)
+    rotated = (occupied >> start) | (occupied << (num_slots - start));
+  if (num_slots < 64)
+    rotated &= (1ull << num_slots) - 1u;
+  return lowest_set_bit(rotated);
+}
@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 #include "etcpal/common.h"
+#include "etcpal/hashmap.h"
 #include "etcpal/pack.h"
 #include "etcpal/thirdparty/md5.h"
 #include "etcpal/thirdparty/sha1.h"
@@ -128,6 +129,33 @@ bool etcpal_string_to_uuid(const char* str, EtcPalUuid* uuid)
   return false;
 }
 
+/**
+ * @brief Hash a UUID for use as a hash map key.
+ *
+ * Matches the #EtcPalHashMapHashFunc signature; see @ref etcpal_hashmap.
+ *
+ * @param[in] uuid Pointer to the EtcPalUuid to hash.
+ * @return The hash of the UUID.
+ */
+uint32_t etcpal_uuid_hash_key(const void* uuid)
+{
+  return etcpal_hash_bytes(((const EtcPalUuid*)uuid)->data, ETCPAL_UUID_BYTES);
+}
+
+/**
+ * @brief Determine whether two UUIDs used as hash map keys are equal.
+ *
+ * Matches the #EtcPalHashMapKeyEqualFunc signature; see @ref etcpal_hashmap.
+ *
+ * @param[in] uuid_a Pointer to the first EtcPalUuid to compare.
+ * @param[in] uuid_b Pointer to the second EtcPalUuid to compare.
+ * @return Whether the UUIDs are equal.
+ */
+bool etcpal_uuid_key_equal(const void* uuid_a, const void* uuid_b)
+{
+  return (ETCPAL_UUID_CMP((const EtcPalUuid*)uuid_a, (const EtcPalUuid*)uuid_b) == 0);
+}
+
 #if ETCPAL_NO_OS_SUPPORT || DOXYGEN
 /**
  * @brief Generate a Version 1 UUID.
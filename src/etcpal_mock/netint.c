@@ -28,8 +28,15 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_interface_with_ip, const EtcPalIpAddr*, EtcPalNetintInfo*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_default_interface, etcpal_iptype_t, unsigned int*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_get_interface_for_dest, const EtcPalIpAddr*, unsigned int*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
+                       etcpal_netint_get_interfaces_for_dests,
+                       const EtcPalIpAddr*,
+                       unsigned int*,
+                       size_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_refresh_interfaces);
 DEFINE_FAKE_VALUE_FUNC(bool, etcpal_netint_is_up, unsigned int);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_netint_start_monitor, EtcPalNetintChangeCallback, void*);
+DEFINE_FAKE_VOID_FUNC(etcpal_netint_stop_monitor);
 
 void etcpal_netint_reset_all_fakes(void)
 {
@@ -38,6 +45,9 @@ void etcpal_netint_reset_all_fakes(void)
   RESET_FAKE(etcpal_netint_get_interface_with_ip);
   RESET_FAKE(etcpal_netint_get_default_interface);
   RESET_FAKE(etcpal_netint_get_interface_for_dest);
+  RESET_FAKE(etcpal_netint_get_interfaces_for_dests);
   RESET_FAKE(etcpal_netint_refresh_interfaces);
   RESET_FAKE(etcpal_netint_is_up);
+  RESET_FAKE(etcpal_netint_start_monitor);
+  RESET_FAKE(etcpal_netint_stop_monitor);
 }
@@ -26,15 +26,20 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_connect, etcpal_socket_t, const Et
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getpeername, etcpal_socket_t, EtcPalSockAddr*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getsockname, etcpal_socket_t, EtcPalSockAddr*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getsockopt, etcpal_socket_t, int, int, void*, size_t*);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_join_groups, etcpal_socket_t, const EtcPalGroupReq*, size_t);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_leave_groups, etcpal_socket_t, const EtcPalGroupReq*, size_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_listen, etcpal_socket_t, int);
 DEFINE_FAKE_VALUE_FUNC(int, etcpal_recv, etcpal_socket_t, void*, size_t, int);
 DEFINE_FAKE_VALUE_FUNC(int, etcpal_recvfrom, etcpal_socket_t, void*, size_t, int, EtcPalSockAddr*);
 DEFINE_FAKE_VALUE_FUNC(int, etcpal_recvmsg, etcpal_socket_t, EtcPalMsgHdr*, int);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_recvmmsg, etcpal_socket_t, EtcPalMMsgHdr*, size_t, int);
 DEFINE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_firsthdr, EtcPalMsgHdr*, EtcPalCMsgHdr*);
 DEFINE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_nxthdr, EtcPalMsgHdr*, const EtcPalCMsgHdr*, EtcPalCMsgHdr*);
 DEFINE_FAKE_VALUE_FUNC(bool, etcpal_cmsg_to_pktinfo, const EtcPalCMsgHdr*, EtcPalPktInfo*);
 DEFINE_FAKE_VALUE_FUNC(int, etcpal_send, etcpal_socket_t, const void*, size_t, int);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_sendmsg, etcpal_socket_t, const EtcPalIoVec*, size_t, int, const EtcPalSockAddr*);
 DEFINE_FAKE_VALUE_FUNC(int, etcpal_sendto, etcpal_socket_t, const void*, size_t, int, const EtcPalSockAddr*);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_sendmmsg, etcpal_socket_t, EtcPalMMsgHdr*, size_t, int);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_setsockopt, etcpal_socket_t, int, int, const void*, size_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_shutdown, etcpal_socket_t, int);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_socket, unsigned int, unsigned int, etcpal_socket_t*);
@@ -43,6 +48,7 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_setblocking, etcpal_socket_t, bool
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_getblocking, etcpal_socket_t, bool*);
 
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_context_init, EtcPalPollContext*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_context_init_multithreaded, EtcPalPollContext*);
 DEFINE_FAKE_VOID_FUNC(etcpal_poll_context_deinit, EtcPalPollContext*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        etcpal_poll_add_socket,
@@ -56,8 +62,22 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        etcpal_socket_t,
                        etcpal_poll_events_t,
                        void*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_rearm_socket, EtcPalPollContext*, etcpal_socket_t);
 DEFINE_FAKE_VOID_FUNC(etcpal_poll_remove_socket, EtcPalPollContext*, etcpal_socket_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_wait, EtcPalPollContext*, EtcPalPollEvent*, int);
+DEFINE_FAKE_VALUE_FUNC(int, etcpal_poll_wait_many, EtcPalPollContext*, EtcPalPollEvent*, size_t, int);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
+                       etcpal_poll_add_timer,
+                       EtcPalPollContext*,
+                       uint32_t,
+                       uint32_t,
+                       void*,
+                       etcpal_poll_timer_t*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_reset_timer, EtcPalPollContext*, etcpal_poll_timer_t, uint32_t, uint32_t);
+DEFINE_FAKE_VOID_FUNC(etcpal_poll_remove_timer, EtcPalPollContext*, etcpal_poll_timer_t);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_add_wakeup, EtcPalPollContext*, void*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, etcpal_poll_wakeup, EtcPalPollContext*);
+DEFINE_FAKE_VOID_FUNC(etcpal_poll_remove_wakeup, EtcPalPollContext*);
 
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        etcpal_getaddrinfo,
@@ -77,26 +97,40 @@ void etcpal_socket_reset_all_fakes(void)
   RESET_FAKE(etcpal_getpeername);
   RESET_FAKE(etcpal_getsockname);
   RESET_FAKE(etcpal_getsockopt);
+  RESET_FAKE(etcpal_join_groups);
+  RESET_FAKE(etcpal_leave_groups);
   RESET_FAKE(etcpal_listen);
   RESET_FAKE(etcpal_recv);
   RESET_FAKE(etcpal_recvfrom);
   RESET_FAKE(etcpal_recvmsg);
+  RESET_FAKE(etcpal_recvmmsg);
   RESET_FAKE(etcpal_cmsg_firsthdr);
   RESET_FAKE(etcpal_cmsg_nxthdr);
   RESET_FAKE(etcpal_cmsg_to_pktinfo);
   RESET_FAKE(etcpal_send);
+  RESET_FAKE(etcpal_sendmsg);
   RESET_FAKE(etcpal_sendto);
+  RESET_FAKE(etcpal_sendmmsg);
   RESET_FAKE(etcpal_setsockopt);
   RESET_FAKE(etcpal_shutdown);
   RESET_FAKE(etcpal_socket);
   RESET_FAKE(etcpal_setblocking);
   RESET_FAKE(etcpal_getblocking);
   RESET_FAKE(etcpal_poll_context_init);
+  RESET_FAKE(etcpal_poll_context_init_multithreaded);
   RESET_FAKE(etcpal_poll_context_deinit);
   RESET_FAKE(etcpal_poll_add_socket);
   RESET_FAKE(etcpal_poll_modify_socket);
+  RESET_FAKE(etcpal_poll_rearm_socket);
   RESET_FAKE(etcpal_poll_remove_socket);
   RESET_FAKE(etcpal_poll_wait);
+  RESET_FAKE(etcpal_poll_wait_many);
+  RESET_FAKE(etcpal_poll_add_timer);
+  RESET_FAKE(etcpal_poll_reset_timer);
+  RESET_FAKE(etcpal_poll_remove_timer);
+  RESET_FAKE(etcpal_poll_add_wakeup);
+  RESET_FAKE(etcpal_poll_wakeup);
+  RESET_FAKE(etcpal_poll_remove_wakeup);
   RESET_FAKE(etcpal_getaddrinfo);
   RESET_FAKE(etcpal_nextaddr);
   RESET_FAKE(etcpal_freeaddrinfo);
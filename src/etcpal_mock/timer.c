@@ -20,8 +20,12 @@
 #include "etcpal_mock/timer.h"
 
 DEFINE_FAKE_VALUE_FUNC(uint32_t, etcpal_getms);
+DEFINE_FAKE_VALUE_FUNC(uint64_t, etcpal_getns);
+DEFINE_FAKE_VALUE_FUNC(uint64_t, etcpal_getns_coarse);
 
 void etcpal_timer_reset_all_fakes(void)
 {
   RESET_FAKE(etcpal_getms);
+  RESET_FAKE(etcpal_getns);
+  RESET_FAKE(etcpal_getns_coarse);
 }
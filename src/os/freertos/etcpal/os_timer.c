@@ -41,4 +41,21 @@ uint32_t etcpal_getms(void)
   return (uint32_t)(((uint64_t)xTaskGetTickCount()) * 1000 / configTICK_RATE_HZ);
 }
 
+uint64_t etcpal_getns(void)
+{
+  // Note: resolution is one RTOS tick. The tick count itself wraps, so it is extended with the
+  // kernel's count of tick overflows, which vTaskSetTimeOutState() reads together with it.
+  TimeOut_t time_state;
+  vTaskSetTimeOutState(&time_state);
+  uint64_t ticks = ((uint64_t)time_state.xOverflowCount << (sizeof(TickType_t) * 8)) | time_state.xTimeOnEntering;
+
+  // Split the conversion to avoid overflowing the intermediate product.
+  return (ticks / configTICK_RATE_HZ) * 1000000000u + (ticks % configTICK_RATE_HZ) * 1000000000u / configTICK_RATE_HZ;
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+  return etcpal_getns();
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
@@ -20,9 +20,31 @@
 #include "etcpal/event_group.h"
 #include "etcpal/private/common.h"
 
+/****************************** Private types ********************************/
+
+/*
+ * Each waiting thread has its own condition variable and sits in the event group's waiter list,
+ * so that etcpal_event_group_set_bits() can wake exactly the threads whose conditions it
+ * satisfies. Waiters live on the stack of the waiting thread and are only accessed with the event
+ * group's mutex held.
+ */
+struct EtcPalEventGroupWaiter
+{
+  etcpal_event_bits_t     bits_requested;
+  int                     flags;
+  bool                    satisfied;
+  etcpal_event_bits_t     result;
+  pthread_cond_t          cond;
+  EtcPalEventGroupWaiter* prev;
+  EtcPalEventGroupWaiter* next;
+};
+
 /*********************** Private function prototypes *************************/
 
+static bool check_bits(etcpal_event_bits_t bits, etcpal_event_bits_t bits_requested, int flags);
 static bool check_and_clear_bits(etcpal_event_bits_t* bits, etcpal_event_bits_t bits_requested, int flags);
+static void add_waiter(etcpal_event_group_t* id, EtcPalEventGroupWaiter* waiter);
+static void remove_waiter(etcpal_event_group_t* id, EtcPalEventGroupWaiter* waiter);
 
 /*************************** Function definitions ****************************/
 
@@ -32,14 +54,11 @@ bool etcpal_event_group_create(etcpal_event_group_t* id)
   {
     if (0 == pthread_mutex_init(&id->mutex, NULL))
     {
-      if (0 == pthread_cond_init(&id->cond, NULL))
-      {
-        id->valid = true;
-        id->bits  = 0;
-        return true;
-      }
-
-      pthread_mutex_destroy(&id->mutex);
+      id->valid        = true;
+      id->bits         = 0;
+      id->waiters_head = NULL;
+      id->waiters_tail = NULL;
+      return true;
     }
   }
   return false;
@@ -51,22 +70,36 @@ etcpal_event_bits_t etcpal_event_group_wait(etcpal_event_group_t* id, etcpal_eve
     return 0;
 
   etcpal_event_bits_t result = 0;
-  if (id && id->valid)
+  if (0 == pthread_mutex_lock(&id->mutex))
   {
-    if (0 == pthread_mutex_lock(&id->mutex))
+    result = id->bits;
+    if (!check_and_clear_bits(&id->bits, bits, flags))
     {
-      result = id->bits;
-      while (!check_and_clear_bits(&id->bits, bits, flags))
+      EtcPalEventGroupWaiter waiter;
+      waiter.bits_requested = bits;
+      waiter.flags          = flags;
+      waiter.satisfied      = false;
+      waiter.result         = 0;
+      if (0 != pthread_cond_init(&waiter.cond, NULL))
+      {
+        pthread_mutex_unlock(&id->mutex);
+        return 0;
+      }
+      add_waiter(id, &waiter);
+
+      // etcpal_event_group_set_bits() removes the waiter from the list before waking it.
+      while (!waiter.satisfied)
       {
-        if (0 != pthread_cond_wait(&id->cond, &id->mutex))
+        if (0 != pthread_cond_wait(&waiter.cond, &id->mutex))
         {
-          // On error, the mutex is not locked
-          return false;
+          remove_waiter(id, &waiter);
+          break;
         }
-        result = id->bits;
       }
-      pthread_mutex_unlock(&id->mutex);
+      result = waiter.result;
+      pthread_cond_destroy(&waiter.cond);
     }
+    pthread_mutex_unlock(&id->mutex);
   }
   return result;
 }
@@ -92,6 +125,11 @@ etcpal_event_bits_t etcpal_event_group_timed_wait(etcpal_event_group_t* id,
   return result;
 }
 
+/*
+ * Every waiter is checked against the same state of the bits, so all waiters whose conditions are
+ * met are woken, and bits are only auto-cleared after all of them have been checked. Waiters whose
+ * conditions are not met are not woken.
+ */
 void etcpal_event_group_set_bits(etcpal_event_group_t* id, etcpal_event_bits_t bits_to_set)
 {
   if (!id || !bits_to_set || !id->valid)
@@ -100,7 +138,26 @@ void etcpal_event_group_set_bits(etcpal_event_group_t* id, etcpal_event_bits_t b
   if (0 == pthread_mutex_lock(&id->mutex))
   {
     id->bits |= bits_to_set;
-    pthread_cond_signal(&id->cond);
+
+    etcpal_event_bits_t     bits_to_clear = 0;
+    EtcPalEventGroupWaiter* waiter        = id->waiters_head;
+    while (waiter)
+    {
+      EtcPalEventGroupWaiter* next = waiter->next;
+      if (check_bits(id->bits, waiter->bits_requested, waiter->flags))
+      {
+        if (waiter->flags & ETCPAL_EVENT_GROUP_AUTO_CLEAR)
+          bits_to_clear |= waiter->bits_requested;
+
+        remove_waiter(id, waiter);
+        waiter->result    = id->bits;
+        waiter->satisfied = true;
+        pthread_cond_signal(&waiter->cond);
+      }
+      waiter = next;
+    }
+
+    id->bits &= (~bits_to_clear);
     pthread_mutex_unlock(&id->mutex);
   }
 }
@@ -135,29 +192,24 @@ void etcpal_event_group_destroy(etcpal_event_group_t* id)
 {
   if (id && id->valid)
   {
-    pthread_cond_destroy(&id->cond);
     pthread_mutex_destroy(&id->mutex);
     id->valid = false;
   }
 }
 
+bool check_bits(etcpal_event_bits_t bits, etcpal_event_bits_t bits_requested, int flags)
+{
+  if (flags & ETCPAL_EVENT_GROUP_WAIT_FOR_ALL)
+    return ((bits & bits_requested) == bits_requested);
+  return ((bits & bits_requested) != 0);
+}
+
 bool check_and_clear_bits(etcpal_event_bits_t* bits, etcpal_event_bits_t bits_requested, int flags)
 {
   if (!ETCPAL_ASSERT_VERIFY(bits))
     return false;
 
-  bool result = false;
-
-  if (flags & ETCPAL_EVENT_GROUP_WAIT_FOR_ALL)
-  {
-    if ((*bits & bits_requested) == bits_requested)
-      result = true;
-  }
-  else
-  {
-    if (*bits & bits_requested)
-      result = true;
-  }
+  bool result = check_bits(*bits, bits_requested, flags);
 
   if (result && (flags & ETCPAL_EVENT_GROUP_AUTO_CLEAR))
   {
@@ -166,3 +218,31 @@ bool check_and_clear_bits(etcpal_event_bits_t* bits, etcpal_event_bits_t bits_re
 
   return result;
 }
+
+/* Waiters are kept in the order they started waiting, so that they are woken in that order. */
+void add_waiter(etcpal_event_group_t* id, EtcPalEventGroupWaiter* waiter)
+{
+  waiter->prev = id->waiters_tail;
+  waiter->next = NULL;
+  if (id->waiters_tail)
+    id->waiters_tail->next = waiter;
+  else
+    id->waiters_head = waiter;
+  id->waiters_tail = waiter;
+}
+
+void remove_waiter(etcpal_event_group_t* id, EtcPalEventGroupWaiter* waiter)
+{
+  if (waiter->prev)
+    waiter->prev->next = waiter->next;
+  else
+    id->waiters_head = waiter->next;
+
+  if (waiter->next)
+    waiter->next->prev = waiter->prev;
+  else
+    id->waiters_tail = waiter->prev;
+
+  waiter->prev = NULL;
+  waiter->next = NULL;
+}
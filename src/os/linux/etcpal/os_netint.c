@@ -29,6 +29,9 @@
  * Netlink macros, for decoding netlink messages: http://man7.org/linux/man-pages/man3/netlink.3.html
  * RtNetlink sockets: http://man7.org/linux/man-pages/man7/rtnetlink.7.html
  * Some sample RtNetlink code: https://www.linuxjournal.com/article/8498
+ *
+ * The interface monitor subscribes to the RTNETLINK link, address and route multicast groups and
+ * translates the notifications into changes to the cache kept by netint.c.
  */
 
 #include "etcpal/netint.h"
@@ -47,6 +50,10 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -56,6 +63,7 @@
 #include "etcpal/socket.h"
 #include "etcpal/private/common.h"
 #include "etcpal/private/netint.h"
+#include "etcpal/private/route_index.h"
 #include "os_error.h"
 
 /***************************** Private types *********************************/
@@ -74,6 +82,7 @@ typedef struct RoutingTable
   RoutingTableEntry* entries;
   RoutingTableEntry* default_route;
   size_t             size;
+  RouteIndex         index;  // Longest-prefix-match index of entries, built after the table is sorted
 } RoutingTable;
 
 /* A composite struct representing an RT_NETLINK request sent over a netlink socket. */
@@ -83,11 +92,25 @@ typedef struct RtNetlinkRequest
   struct rtmsg    rt_msg;
 } RtNetlinkRequest;
 
+/**************************** Private constants ******************************/
+
+#define MONITOR_RECV_BUF_SIZE 16384
+
 /**************************** Private variables ******************************/
 
 RoutingTable routing_table_v4 = {0};
 RoutingTable routing_table_v6 = {0};
 
+// Interface monitor state. The pending routing tables are built by the monitor thread without the
+// netint lock held, then swapped in by os_netint_update_routes().
+static int          monitor_sock         = -1;
+static int          monitor_wake_fd      = -1;
+static int          monitor_ioctl_sock   = -1;  // Used to look up hardware addresses on address events
+static pthread_t    monitor_thread;
+static RoutingTable pending_table_v4     = {0};
+static RoutingTable pending_table_v6     = {0};
+static bool         pending_tables_ready = false;
+
 /*********************** Private function prototypes *************************/
 
 // Functions for building the routing tables
@@ -95,6 +118,7 @@ static etcpal_error_t build_routing_tables(void);
 static etcpal_error_t build_routing_table(int family, RoutingTable* table);
 static void           free_routing_tables(void);
 static void           free_routing_table(RoutingTable* table);
+static etcpal_error_t build_route_index(RoutingTable* table);
 
 // Interacting with RTNETLINK
 static etcpal_error_t send_netlink_route_request(int socket, int family);
@@ -108,6 +132,17 @@ static etcpal_error_t parse_netlink_route_reply(int           family,
 static void init_routing_table_entry(RoutingTableEntry* entry);
 static int  compare_routing_table_entries(const void* a, const void* b);
 
+// Interface monitoring
+static void*          monitor_thread_fn(void* arg);
+static etcpal_error_t send_netlink_link_dump_request(int sock);
+static etcpal_error_t snapshot_link_states(bool notify);
+static void           handle_netlink_messages(const char* buffer, size_t size, bool* routes_changed);
+static void           handle_link_message(const struct nlmsghdr* nl_header, bool notify);
+static void           handle_addr_message(const struct nlmsghdr* nl_header);
+static bool           is_main_route_message(const struct nlmsghdr* nl_header);
+static void           report_routes_changed(void);
+static void           resync_after_overrun(void);
+
 #if ETCPAL_NETINT_DEBUG_OUTPUT
 static void debug_print_routing_table(RoutingTable* table);
 #endif
@@ -292,19 +327,9 @@ etcpal_error_t os_resolve_route(const EtcPalIpAddr* dest, const CachedNetintInfo
 
   RoutingTable* table_to_use = (ETCPAL_IP_IS_V6(dest) ? &routing_table_v6 : &routing_table_v4);
 
-  unsigned int index_found = 0;
-  for (RoutingTableEntry* entry = table_to_use->entries; entry < table_to_use->entries + table_to_use->size; ++entry)
-  {
-    if (entry->interface_index <= 0 || ETCPAL_IP_IS_INVALID(&entry->mask))
-      continue;
-
-    // Check each route to see if it matches the destination address explicitly
-    if (etcpal_ip_network_portions_equal(&entry->addr, dest, &entry->mask))
-    {
-      index_found = (unsigned int)entry->interface_index;
-      break;
-    }
-  }
+  // Find the most specific route that matches the destination address explicitly
+  int          route_found = route_index_lookup(&table_to_use->index, dest);
+  unsigned int index_found = (route_found > 0 ? (unsigned int)route_found : 0);
 
   // Fall back to the default route
   if (index_found == 0 && table_to_use->default_route)
@@ -346,6 +371,96 @@ bool os_netint_is_up(unsigned int index, const CachedNetintInfo* cache)
   return false;
 }
 
+etcpal_error_t os_netint_start_monitor(void)
+{
+  monitor_sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (monitor_sock == -1)
+    return errno_os_to_etcpal(errno);
+
+  struct sockaddr_nl addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.nl_family = AF_NETLINK;
+  addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  if (0 != bind(monitor_sock, (struct sockaddr*)&addr, sizeof(addr)))
+    res = errno_os_to_etcpal(errno);
+
+  // Now that we're subscribed, record the current link state of each interface. Any change after
+  // this point will be seen by the monitor thread.
+  if (res == kEtcPalErrOk)
+    res = snapshot_link_states(false);
+
+  if (res == kEtcPalErrOk)
+  {
+    monitor_wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (monitor_wake_fd == -1)
+      res = errno_os_to_etcpal(errno);
+  }
+
+  if (res == kEtcPalErrOk)
+  {
+    monitor_ioctl_sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (monitor_ioctl_sock == -1)
+      res = errno_os_to_etcpal(errno);
+  }
+
+  if (res == kEtcPalErrOk && 0 != pthread_create(&monitor_thread, NULL, monitor_thread_fn, NULL))
+    res = kEtcPalErrSys;
+
+  if (res != kEtcPalErrOk)
+  {
+    if (monitor_ioctl_sock != -1)
+      close(monitor_ioctl_sock);
+    if (monitor_wake_fd != -1)
+      close(monitor_wake_fd);
+    close(monitor_sock);
+    monitor_ioctl_sock = -1;
+    monitor_wake_fd    = -1;
+    monitor_sock       = -1;
+  }
+  return res;
+}
+
+void os_netint_stop_monitor(void)
+{
+  if (monitor_sock == -1)
+    return;
+
+  uint64_t wake_val = 1;
+  if (write(monitor_wake_fd, &wake_val, sizeof(wake_val)) == (ssize_t)sizeof(wake_val))
+    pthread_join(monitor_thread, NULL);
+
+  close(monitor_ioctl_sock);
+  close(monitor_wake_fd);
+  close(monitor_sock);
+  monitor_ioctl_sock = -1;
+  monitor_wake_fd    = -1;
+  monitor_sock       = -1;
+
+  free_routing_table(&pending_table_v4);
+  free_routing_table(&pending_table_v6);
+  pending_tables_ready = false;
+}
+
+void os_netint_update_routes(CachedNetintInfo* cache)
+{
+  if (!ETCPAL_ASSERT_VERIFY(cache) || !pending_tables_ready)
+    return;
+
+  free_routing_tables();
+  routing_table_v4 = pending_table_v4;
+  routing_table_v6 = pending_table_v6;
+  memset(&pending_table_v4, 0, sizeof(pending_table_v4));
+  memset(&pending_table_v6, 0, sizeof(pending_table_v6));
+  pending_tables_ready = false;
+
+  cache->def.v4_valid = (routing_table_v4.default_route != NULL);
+  cache->def.v4_index = (cache->def.v4_valid ? (unsigned int)routing_table_v4.default_route->interface_index : 0);
+  cache->def.v6_valid = (routing_table_v6.default_route != NULL);
+  cache->def.v6_index = (cache->def.v6_valid ? (unsigned int)routing_table_v6.default_route->interface_index : 0);
+}
+
 etcpal_error_t build_routing_tables(void)
 {
   etcpal_error_t res = build_routing_table(AF_INET, &routing_table_v4);
@@ -595,11 +710,37 @@ etcpal_error_t parse_netlink_route_reply(int family, const char* buffer, size_t
         break;
       }
     }
+
+    res = build_route_index(table);
   }
 
   return res;
 }
 
+// Needs the table to be sorted by mask length and metric; the first route inserted for each network
+// is the one that is kept.
+etcpal_error_t build_route_index(RoutingTable* table)
+{
+  if (!ETCPAL_ASSERT_VERIFY(table))
+    return kEtcPalErrSys;
+
+  route_index_clear(&table->index);
+  for (RoutingTableEntry* entry = table->entries; entry < table->entries + table->size; ++entry)
+  {
+    if (entry->interface_index <= 0 || ETCPAL_IP_IS_INVALID(&entry->mask))
+      continue;
+
+    etcpal_error_t res =
+        route_index_insert(&table->index, &entry->addr, etcpal_ip_mask_length(&entry->mask), entry->interface_index);
+    if (res != kEtcPalErrOk)
+    {
+      route_index_clear(&table->index);
+      return res;
+    }
+  }
+  return kEtcPalErrOk;
+}
+
 void init_routing_table_entry(RoutingTableEntry* entry)
 {
   if (!ETCPAL_ASSERT_VERIFY(entry))
@@ -644,12 +785,294 @@ void free_routing_table(RoutingTable* table)
 
   if (table->entries)
     free(table->entries);
+  route_index_clear(&table->index);
 
   table->entries       = NULL;
   table->default_route = NULL;
   table->size          = 0;
 }
 
+void* monitor_thread_fn(void* arg)
+{
+  ETCPAL_UNUSED_ARG(arg);
+
+  char* buffer = (char*)malloc(MONITOR_RECV_BUF_SIZE);
+  if (!buffer)
+    return NULL;
+
+  struct pollfd fds[2];
+  fds[0].fd     = monitor_sock;
+  fds[0].events = POLLIN;
+  fds[1].fd     = monitor_wake_fd;
+  fds[1].events = POLLIN;
+
+  while (true)
+  {
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+    if (poll(fds, 2, -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+    if (fds[1].revents)
+      break;
+
+    // Drain everything that is queued before acting on route changes, so that a burst of route
+    // notifications (e.g. from an address being added) only causes the tables to be rebuilt once.
+    bool routes_changed = false;
+    bool overrun        = false;
+    while (true)
+    {
+      ssize_t recv_res = recv(monitor_sock, buffer, MONITOR_RECV_BUF_SIZE, MSG_DONTWAIT);
+      if (recv_res < 0)
+      {
+        if (errno == ENOBUFS)
+          overrun = true;
+        else if (errno != EINTR)
+          break;
+        continue;
+      }
+      if (recv_res == 0)
+        break;
+      handle_netlink_messages(buffer, (size_t)recv_res, &routes_changed);
+    }
+
+    // The kernel dropped notifications because we didn't keep up; the only way to recover is to
+    // read the complete state again.
+    if (overrun)
+      resync_after_overrun();
+    else if (routes_changed)
+      report_routes_changed();
+  }
+
+  free(buffer);
+  return NULL;
+}
+
+etcpal_error_t send_netlink_link_dump_request(int sock)
+{
+  struct
+  {
+    struct nlmsghdr  nl_header;
+    struct ifinfomsg if_msg;
+  } req;
+  memset(&req, 0, sizeof(req));
+  req.nl_header.nlmsg_len   = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+  req.nl_header.nlmsg_type  = RTM_GETLINK;
+  req.nl_header.nlmsg_flags = (__u16)(NLM_F_REQUEST | NLM_F_DUMP);
+  req.if_msg.ifi_family     = AF_UNSPEC;
+
+  struct sockaddr_nl naddr;
+  memset(&naddr, 0, sizeof(naddr));
+  naddr.nl_family = AF_NETLINK;
+
+  if (sendto(sock, &req, req.nl_header.nlmsg_len, 0, (struct sockaddr*)&naddr, sizeof(naddr)) >= 0)
+    return kEtcPalErrOk;
+
+  return errno_os_to_etcpal(errno);
+}
+
+// Dump the links on a separate socket and record their state in the cache.
+etcpal_error_t snapshot_link_states(bool notify)
+{
+  int sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (sock == -1)
+    return errno_os_to_etcpal(errno);
+
+  etcpal_error_t res = send_netlink_link_dump_request(sock);
+
+  char* buffer = (res == kEtcPalErrOk ? (char*)malloc(MONITOR_RECV_BUF_SIZE) : NULL);
+  if (res == kEtcPalErrOk && !buffer)
+    res = kEtcPalErrNoMem;
+
+  bool done = false;
+  while (res == kEtcPalErrOk && !done)
+  {
+    ssize_t recv_res = recv(sock, buffer, MONITOR_RECV_BUF_SIZE, 0);
+    if (recv_res < 0)
+    {
+      if (errno != EINTR)
+        res = errno_os_to_etcpal(errno);
+      continue;
+    }
+
+    size_t size = (size_t)recv_res;
+    for (const struct nlmsghdr* nl_header = (const struct nlmsghdr*)buffer; NLMSG_OK(nl_header, size);
+         nl_header                        = NLMSG_NEXT(nl_header, size))
+    {
+      if (nl_header->nlmsg_type == NLMSG_DONE)
+        done = true;
+      else if (nl_header->nlmsg_type == NLMSG_ERROR)
+        res = kEtcPalErrSys;
+      else
+        handle_link_message(nl_header, notify);
+    }
+  }
+
+  if (buffer)
+    free(buffer);
+  close(sock);
+  return res;
+}
+
+void handle_netlink_messages(const char* buffer, size_t size, bool* routes_changed)
+{
+  for (const struct nlmsghdr* nl_header = (const struct nlmsghdr*)buffer; NLMSG_OK(nl_header, size);
+       nl_header                        = NLMSG_NEXT(nl_header, size))
+  {
+    switch (nl_header->nlmsg_type)
+    {
+      case RTM_NEWLINK:
+      case RTM_DELLINK:
+        handle_link_message(nl_header, true);
+        break;
+      case RTM_NEWADDR:
+      case RTM_DELADDR:
+        handle_addr_message(nl_header);
+        break;
+      case RTM_NEWROUTE:
+      case RTM_DELROUTE:
+        if (is_main_route_message(nl_header))
+          *routes_changed = true;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void handle_link_message(const struct nlmsghdr* nl_header, bool notify)
+{
+  if (nl_header->nlmsg_type != RTM_NEWLINK && nl_header->nlmsg_type != RTM_DELLINK)
+    return;
+  if (nl_header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg)))
+    return;
+
+  const struct ifinfomsg* if_msg = (const struct ifinfomsg*)NLMSG_DATA(nl_header);
+  if (if_msg->ifi_index <= 0)
+    return;
+
+  EtcPalNetintChange change;
+  memset(&change, 0, sizeof(change));
+  change.index = (unsigned int)if_msg->ifi_index;
+  change.type  = ((nl_header->nlmsg_type == RTM_NEWLINK && (if_msg->ifi_flags & IFF_UP)) ? kEtcPalNetintUp
+                                                                                          : kEtcPalNetintDown);
+  netint_apply_change(&change, notify);
+}
+
+void handle_addr_message(const struct nlmsghdr* nl_header)
+{
+  if (nl_header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifaddrmsg)))
+    return;
+
+  const struct ifaddrmsg* addr_msg = (const struct ifaddrmsg*)NLMSG_DATA(nl_header);
+  if (addr_msg->ifa_family != AF_INET && addr_msg->ifa_family != AF_INET6)
+    return;
+
+  EtcPalNetintChange change;
+  memset(&change, 0, sizeof(change));
+  change.type         = (nl_header->nlmsg_type == RTM_NEWADDR ? kEtcPalNetintAddrAdded : kEtcPalNetintAddrRemoved);
+  change.index        = addr_msg->ifa_index;
+  change.netint.index = addr_msg->ifa_index;
+
+  // IFA_LOCAL is the interface's own address on point-to-point links, where IFA_ADDRESS is the
+  // address of the peer. Otherwise, only IFA_ADDRESS is present.
+  const struct rtattr* addr_attr = NULL;
+  unsigned int         attr_size = (unsigned int)IFA_PAYLOAD(nl_header);
+  for (const struct rtattr* attr = IFA_RTA(addr_msg); RTA_OK(attr, attr_size); attr = RTA_NEXT(attr, attr_size))
+  {
+    if (attr->rta_type == IFA_LOCAL || (attr->rta_type == IFA_ADDRESS && !addr_attr))
+      addr_attr = attr;
+  }
+  if (!addr_attr)
+    return;
+
+  etcpal_iptype_t type;
+  if (addr_msg->ifa_family == AF_INET6)
+  {
+    type = kEtcPalIpTypeV6;
+
+    // Give link-local addresses the interface's scope ID, as getifaddrs() does for the full
+    // refresh, so that the entries compare equal and can be used to send.
+    const struct in6_addr* addr6    = (const struct in6_addr*)RTA_DATA(addr_attr);
+    unsigned long          scope_id = 0;
+    if (IN6_IS_ADDR_LINKLOCAL(addr6) || IN6_IS_ADDR_MC_LINKLOCAL(addr6))
+      scope_id = addr_msg->ifa_index;
+    ETCPAL_IP_SET_V6_ADDRESS_WITH_SCOPE_ID(&change.netint.addr, addr6->s6_addr, scope_id);
+  }
+  else
+  {
+    type = kEtcPalIpTypeV4;
+    ETCPAL_IP_SET_V4_ADDRESS(&change.netint.addr, ntohl(((const struct in_addr*)RTA_DATA(addr_attr))->s_addr));
+  }
+  change.netint.mask = etcpal_ip_mask_from_length(type, addr_msg->ifa_prefixlen);
+
+  // Fill in the rest of the information the same way os_enumerate_interfaces() does. This can fail
+  // for removed addresses if the interface is already gone, which is fine - removals are matched
+  // by index and address.
+  char name[IF_NAMESIZE];
+  if (if_indextoname(addr_msg->ifa_index, name))
+  {
+    strncpy(change.netint.id, name, ETCPAL_NETINTINFO_ID_LEN);
+    change.netint.id[ETCPAL_NETINTINFO_ID_LEN - 1] = '\0';
+    strncpy(change.netint.friendly_name, name, ETCPAL_NETINTINFO_FRIENDLY_NAME_LEN);
+    change.netint.friendly_name[ETCPAL_NETINTINFO_FRIENDLY_NAME_LEN - 1] = '\0';
+
+    struct ifreq if_req = {0};
+    strncpy(if_req.ifr_name, name, IFNAMSIZ - 1);
+    if (ioctl(monitor_ioctl_sock, SIOCGIFHWADDR, &if_req) == 0)
+      memcpy(change.netint.mac.data, if_req.ifr_hwaddr.sa_data, ETCPAL_MAC_BYTES);
+  }
+
+  netint_apply_change(&change, true);
+}
+
+bool is_main_route_message(const struct nlmsghdr* nl_header)
+{
+  if (nl_header->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+    return false;
+
+  const struct rtmsg* rt_message = (const struct rtmsg*)NLMSG_DATA(nl_header);
+  return (rt_message->rtm_table == RT_TABLE_MAIN && rt_message->rtm_type != RTN_LOCAL &&
+          rt_message->rtm_type != RTN_BROADCAST && rt_message->rtm_type != RTN_ANYCAST);
+}
+
+// Rebuild the routing tables without the netint lock held, then have netint.c install them.
+void report_routes_changed(void)
+{
+  free_routing_table(&pending_table_v4);
+  free_routing_table(&pending_table_v6);
+
+  etcpal_error_t res = build_routing_table(AF_INET, &pending_table_v4);
+  if (res == kEtcPalErrOk)
+    res = build_routing_table(AF_INET6, &pending_table_v6);
+
+  if (res == kEtcPalErrOk)
+  {
+    pending_tables_ready = true;
+
+    EtcPalNetintChange change;
+    memset(&change, 0, sizeof(change));
+    change.type = kEtcPalNetintRoutesChanged;
+    netint_apply_change(&change, true);
+  }
+
+  free_routing_table(&pending_table_v4);
+  free_routing_table(&pending_table_v6);
+  pending_tables_ready = false;
+}
+
+// Addresses are resynchronized by refreshing the whole cache, which does not notify of individual
+// address changes; link state changes and the routing change are still reported.
+void resync_after_overrun(void)
+{
+  etcpal_netint_refresh_interfaces();
+  snapshot_link_states(true);
+  report_routes_changed();
+}
+
 #if ETCPAL_NETINT_DEBUG_OUTPUT
 void debug_print_routing_table(RoutingTable* table)
 {
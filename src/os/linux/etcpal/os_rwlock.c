@@ -17,14 +17,49 @@
  * https://github.com/ETCLabs/EtcPal
  ******************************************************************************/
 
+// Needed for pthread_rwlock_clockrdlock() and pthread_rwlock_clockwrlock()
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "etcpal/rwlock.h"
 
+#include "os_timed_wait.h"
+
+// pthread_rwlock_clock*lock() were added in glibc 2.30. Where they are not available, fall back to
+// pthread_rwlock_timed*lock(), which always use CLOCK_REALTIME.
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+#define RWLOCK_CLOCK                      CLOCK_MONOTONIC
+#define RWLOCK_TIMED_RDLOCK(idptr, tsptr) pthread_rwlock_clockrdlock((idptr), CLOCK_MONOTONIC, (tsptr))
+#define RWLOCK_TIMED_WRLOCK(idptr, tsptr) pthread_rwlock_clockwrlock((idptr), CLOCK_MONOTONIC, (tsptr))
+#else
+#define RWLOCK_CLOCK                      CLOCK_REALTIME
+#define RWLOCK_TIMED_RDLOCK(idptr, tsptr) pthread_rwlock_timedrdlock((idptr), (tsptr))
+#define RWLOCK_TIMED_WRLOCK(idptr, tsptr) pthread_rwlock_timedwrlock((idptr), (tsptr))
+#endif
+
 bool etcpal_rwlock_timed_readlock(etcpal_rwlock_t* id, int timeout_ms)
 {
-  return (timeout_ms == 0 ? etcpal_rwlock_try_readlock(id) : etcpal_rwlock_readlock(id));
+  if (timeout_ms == 0)
+    return etcpal_rwlock_try_readlock(id);
+  if (timeout_ms == ETCPAL_WAIT_FOREVER)
+    return etcpal_rwlock_readlock(id);
+
+  struct timespec abs_timeout;
+  if (!timeout_ms_to_abs_timespec(RWLOCK_CLOCK, timeout_ms, &abs_timeout))
+    return false;
+  return (0 == RWLOCK_TIMED_RDLOCK(id, &abs_timeout));
 }
 
 bool etcpal_rwlock_timed_writelock(etcpal_rwlock_t* id, int timeout_ms)
 {
-  return (timeout_ms == 0 ? etcpal_rwlock_try_writelock(id) : etcpal_rwlock_writelock(id));
+  if (timeout_ms == 0)
+    return etcpal_rwlock_try_writelock(id);
+  if (timeout_ms == ETCPAL_WAIT_FOREVER)
+    return etcpal_rwlock_writelock(id);
+
+  struct timespec abs_timeout;
+  if (!timeout_ms_to_abs_timespec(RWLOCK_CLOCK, timeout_ms, &abs_timeout))
+    return false;
+  return (0 == RWLOCK_TIMED_WRLOCK(id, &abs_timeout));
 }
@@ -19,17 +19,28 @@
 
 #include "etcpal/signal.h"
 
+#include "os_timed_wait.h"
+
 bool etcpal_signal_create(etcpal_signal_t* id)
 {
   if (id)
   {
     if (0 == pthread_mutex_init(&id->mutex, NULL))
     {
-      if (0 == pthread_cond_init(&id->cond, NULL))
+      // Use the monotonic clock for timed waits so that they are not affected by changes to the
+      // system time.
+      pthread_condattr_t cond_attr;
+      if (0 == pthread_condattr_init(&cond_attr))
       {
-        id->valid    = true;
-        id->signaled = false;
-        return true;
+        bool cond_created = (0 == pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC) &&
+                             0 == pthread_cond_init(&id->cond, &cond_attr));
+        pthread_condattr_destroy(&cond_attr);
+        if (cond_created)
+        {
+          id->valid    = true;
+          id->signaled = false;
+          return true;
+        }
       }
       pthread_mutex_destroy(&id->mutex);
     }
@@ -79,7 +90,30 @@ bool etcpal_signal_try_wait(etcpal_signal_t* id)
 
 bool etcpal_signal_timed_wait(etcpal_signal_t* id, int timeout_ms)
 {
-  return (timeout_ms == 0 ? etcpal_signal_try_wait(id) : etcpal_signal_wait(id));
+  if (timeout_ms == 0)
+    return etcpal_signal_try_wait(id);
+  if (timeout_ms == ETCPAL_WAIT_FOREVER)
+    return etcpal_signal_wait(id);
+
+  struct timespec abs_timeout;
+  if (!id || !id->valid || !timeout_ms_to_abs_timespec(CLOCK_MONOTONIC, timeout_ms, &abs_timeout))
+    return false;
+
+  bool res = false;
+  if (0 == pthread_mutex_lock(&id->mutex))
+  {
+    int wait_res = 0;
+    while (!id->signaled && wait_res == 0)
+      wait_res = pthread_cond_timedwait(&id->cond, &id->mutex, &abs_timeout);
+
+    if (id->signaled)
+    {
+      res          = true;
+      id->signaled = false;
+    }
+    pthread_mutex_unlock(&id->mutex);
+  }
+  return res;
 }
 
 void etcpal_signal_post(etcpal_signal_t* id)
@@ -26,20 +26,22 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <arpa/inet.h>
 #include <fcntl.h>
-#include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <sys/epoll.h>
-#include <sys/ioctl.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
+#include <sys/timerfd.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include "etcpal/common.h"
 #include "etcpal/private/common.h"
+#include "etcpal/timer.h"
 #include "os_error.h"
 
 /**************************** Private constants ******************************/
@@ -48,9 +50,18 @@
  * Here is a random number. */
 #define EPOLL_CREATE_SIZE 1024
 
+/* The maximum number of events retrieved from the kernel by a single call to
+ * etcpal_poll_wait_many(). */
+#define EPOLL_MAX_EVENTS_PER_WAIT 64
+
+/* The maximum number of messages passed to the kernel by a single recvmmsg() or sendmmsg() call
+ * made by etcpal_recvmmsg() or etcpal_sendmmsg(). */
+#define MMSG_MAX_MSGS_PER_CALL 64
+
 /****************************** Private types ********************************/
 
-/* A struct to track sockets being polled by the etcpal_poll() API */
+/* A struct to track sockets and timers being polled by the etcpal_poll() API. Timers are tracked
+ * by their timerfd, with events set to ETCPAL_POLL_TIMER. */
 typedef struct EtcPalPollSocket
 {
   // 'sock' must always remain as the first member in the struct to facilitate an EtcPalRbTree lookup
@@ -58,6 +69,7 @@ typedef struct EtcPalPollSocket
   etcpal_socket_t      sock;
   etcpal_poll_events_t events;
   void*                user_data;
+  uint32_t             generation;  // Identifies this descriptor in epoll events on a multithreaded context
 } EtcPalPollSocket;
 
 /**************************** Private variables ******************************/
@@ -134,6 +146,9 @@ static int  setsockopt_ip6(etcpal_socket_t id, int option_name, const void* opti
 // Helpers for etcpal_getsockopt()
 static int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, size_t* option_len);
 
+// Helpers for etcpal_join_groups() and etcpal_leave_groups()
+static int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name);
+
 // Helpers for etcpal_poll API
 static void events_etcpal_to_epoll(etcpal_poll_events_t events, struct epoll_event* epoll_evt);
 static void events_epoll_to_etcpal(const struct epoll_event* epoll_evt,
@@ -143,6 +158,22 @@ static void events_epoll_to_etcpal(const struct epoll_event* epoll_evt,
 static int           poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b);
 static EtcPalRbNode* poll_socket_alloc(void);
 static void          poll_socket_free(EtcPalRbNode* node);
+static void          poll_timer_free(EtcPalRbNode* node);
+
+static etcpal_error_t          init_poll_context(EtcPalPollContext* context, bool multithreaded);
+static uint32_t                next_poll_generation(EtcPalPollContext* context);
+static void                    make_epoll_event_data(const EtcPalPollContext* context,
+                                                     const EtcPalPollSocket*  desc,
+                                                     struct epoll_event*      epoll_evt);
+static void                    make_socket_epoll_event(const EtcPalPollContext* context,
+                                                       const EtcPalPollSocket*  sock_desc,
+                                                       struct epoll_event*      epoll_evt);
+static const EtcPalPollSocket* find_poll_desc(EtcPalPollContext* context, const struct epoll_event* epoll_evt);
+static etcpal_error_t          set_poll_timer(int timer_fd, uint32_t timeout_ms, uint32_t interval_ms);
+static bool                    consume_poll_fd(int fd);
+static bool                    fill_poll_event(EtcPalPollContext*        context,
+                                               const struct epoll_event* epoll_evt,
+                                               EtcPalPollEvent*          event);
 
 // Helpers for etcpal_recvmsg()
 static void construct_msghdr(const EtcPalMsgHdr*      in_msg,
@@ -325,6 +356,39 @@ int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, s
   return -1;
 }
 
+int etcpal_join_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_JOIN_GROUP);
+}
+
+int etcpal_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_LEAVE_GROUP);
+}
+
+int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !groups || num_groups == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_done = 0;
+  for (; num_done < num_groups; ++num_done)
+  {
+    const EtcPalGroupReq* greq  = &groups[num_done];
+    int                   level = ETCPAL_IP_IS_V6(&greq->group) ? ETCPAL_IPPROTO_IPV6 : ETCPAL_IPPROTO_IP;
+
+    etcpal_error_t res = etcpal_setsockopt(id, level, option_name, greq, sizeof(EtcPalGroupReq));
+    if (res != kEtcPalErrOk)
+    {
+      if (num_done > 0)
+        break;
+      return (int)res;
+    }
+  }
+
+  return (int)num_done;
+}
+
 etcpal_error_t etcpal_listen(etcpal_socket_t id, int backlog)
 {
   if (id == ETCPAL_SOCKET_INVALID)
@@ -391,6 +455,40 @@ int etcpal_recvmsg(etcpal_socket_t id, EtcPalMsgHdr* msg, int flags)
   return res;
 }
 
+int etcpal_recvmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  if (num_msgs > MMSG_MAX_MSGS_PER_CALL)
+    num_msgs = MMSG_MAX_MSGS_PER_CALL;
+
+  struct mmsghdr          impl_msgs[MMSG_MAX_MSGS_PER_CALL];
+  struct sockaddr_storage impl_names[MMSG_MAX_MSGS_PER_CALL];
+  struct iovec            impl_bufs[MMSG_MAX_MSGS_PER_CALL];
+  for (size_t i = 0; i < num_msgs; ++i)
+  {
+    memset(&impl_msgs[i], 0, sizeof impl_msgs[i]);
+    construct_msghdr(&msgs[i].hdr, &impl_names[i], &impl_bufs[i], &impl_msgs[i].msg_hdr);
+  }
+
+  // MSG_WAITFORONE gives the blocking behavior of recvmsg(): wait for the first datagram, then
+  // take whatever else is already queued.
+  int res = recvmmsg(id, impl_msgs, (unsigned int)num_msgs, rcvmsg_flags_etcpal_to_os(flags) | MSG_WAITFORONE, NULL);
+  if (res < 0)
+    return (int)errno_os_to_etcpal(errno);
+
+  for (int i = 0; i < res; ++i)
+  {
+    msgs[i].len       = impl_msgs[i].msg_len;
+    msgs[i].hdr.flags = rcvmsg_flags_os_to_etcpal(impl_msgs[i].msg_hdr.msg_flags);
+    if (!sockaddr_os_to_etcpal((etcpal_os_sockaddr_t*)&impl_names[i], &msgs[i].hdr.name))
+      return kEtcPalErrSys;
+  }
+
+  return res;
+}
+
 bool etcpal_cmsg_firsthdr(EtcPalMsgHdr* msgh, EtcPalCMsgHdr* firsthdr)
 {
   bool result = false;
@@ -487,6 +585,40 @@ int etcpal_send(etcpal_socket_t id, const void* message, size_t length, int flag
   return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
 }
 
+int etcpal_sendmsg(etcpal_socket_t       id,
+                   const EtcPalIoVec*    iov,
+                   size_t                iovcnt,
+                   int                   flags,
+                   const EtcPalSockAddr* dest_addr)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !iov || iovcnt == 0 || iovcnt > ETCPAL_SENDMSG_MAX_IOV)
+    return (int)kEtcPalErrInvalid;
+
+  struct iovec impl_iov[ETCPAL_SENDMSG_MAX_IOV];
+  for (size_t i = 0; i < iovcnt; ++i)
+  {
+    impl_iov[i].iov_base = (void*)iov[i].base;
+    impl_iov[i].iov_len  = iov[i].len;
+  }
+
+  struct msghdr           impl_msg  = {0};
+  struct sockaddr_storage impl_name = {0};
+  if (dest_addr)
+  {
+    impl_msg.msg_namelen = (socklen_t)sockaddr_etcpal_to_os(dest_addr, (etcpal_os_sockaddr_t*)&impl_name);
+    if (impl_msg.msg_namelen == 0)
+      return (int)kEtcPalErrSys;
+    impl_msg.msg_name = &impl_name;
+  }
+  impl_msg.msg_iov    = impl_iov;
+  impl_msg.msg_iovlen = iovcnt;
+
+  int res = (int)sendmsg(id, &impl_msg, 0);
+  return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
+}
+
 int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int flags, const EtcPalSockAddr* dest_addr)
 {
   ETCPAL_UNUSED_ARG(flags);
@@ -504,6 +636,56 @@ int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int fl
   return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
 }
 
+int etcpal_sendmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  struct mmsghdr          impl_msgs[MMSG_MAX_MSGS_PER_CALL];
+  struct sockaddr_storage impl_names[MMSG_MAX_MSGS_PER_CALL];
+  struct iovec            impl_bufs[MMSG_MAX_MSGS_PER_CALL];
+
+  size_t total_sent = 0;
+  while (total_sent < num_msgs)
+  {
+    EtcPalMMsgHdr* chunk      = &msgs[total_sent];
+    size_t         chunk_size = num_msgs - total_sent;
+    if (chunk_size > MMSG_MAX_MSGS_PER_CALL)
+      chunk_size = MMSG_MAX_MSGS_PER_CALL;
+
+    for (size_t i = 0; i < chunk_size; ++i)
+    {
+      memset(&impl_msgs[i], 0, sizeof impl_msgs[i]);
+      construct_msghdr(&chunk[i].hdr, &impl_names[i], &impl_bufs[i], &impl_msgs[i].msg_hdr);
+      impl_msgs[i].msg_hdr.msg_flags = 0;
+
+      // An invalid destination means the socket is connected.
+      socklen_t name_size = (socklen_t)sockaddr_etcpal_to_os(&chunk[i].hdr.name, (etcpal_os_sockaddr_t*)&impl_names[i]);
+      impl_msgs[i].msg_hdr.msg_name    = (name_size > 0 ? &impl_names[i] : NULL);
+      impl_msgs[i].msg_hdr.msg_namelen = name_size;
+    }
+
+    int res = sendmmsg(id, impl_msgs, (unsigned int)chunk_size, 0);
+    if (res < 0)
+    {
+      if (total_sent > 0)
+        break;
+      return (int)errno_os_to_etcpal(errno);
+    }
+
+    for (int i = 0; i < res; ++i)
+      chunk[i].len = impl_msgs[i].msg_len;
+
+    total_sent += (size_t)res;
+    if ((size_t)res < chunk_size)
+      break;
+  }
+
+  return (int)total_sent;
+}
+
 etcpal_error_t etcpal_setsockopt(etcpal_socket_t id,
                                  int             level,
                                  int             option_name,
@@ -592,31 +774,6 @@ int setsockopt_socket(etcpal_socket_t id, int option_name, const void* option_va
   return -1;
 }
 
-static int ip4_ifindex_to_addr(unsigned int ifindex, struct in_addr* addr)
-{
-  if (!ETCPAL_ASSERT_VERIFY(addr))
-    return -1;
-
-  struct ifreq req = {0};
-  if (if_indextoname(ifindex, req.ifr_name) != NULL)
-  {
-    int ioctl_sock = socket(AF_INET, SOCK_DGRAM, 0);
-    if (ioctl_sock != -1)
-    {
-      int ioctl_res = ioctl(ioctl_sock, SIOCGIFADDR, &req);
-      if (ioctl_res != -1)
-      {
-        *addr = ((struct sockaddr_in*)&req.ifr_addr)->sin_addr;
-        close(ioctl_sock);
-        return 0;
-      }
-      close(ioctl_sock);
-    }
-  }
-
-  return -1;
-}
-
 int setsockopt_ip(etcpal_socket_t id, int option_name, const void* option_value, size_t option_len)
 {
   if (!ETCPAL_ASSERT_VERIFY(id != ETCPAL_SOCKET_INVALID) || !ETCPAL_ASSERT_VERIFY(option_value))
@@ -689,9 +846,9 @@ int setsockopt_ip(etcpal_socket_t id, int option_name, const void* option_value,
     case ETCPAL_IP_MULTICAST_IF:
       if (option_len == sizeof(unsigned int))
       {
-        struct in_addr val = {0};
-        if (0 != ip4_ifindex_to_addr(*(unsigned int*)option_value, &val))
-          return -1;
+        // Linux accepts the interface index directly, so there is no need to look up its address.
+        struct ip_mreqn val = {0};
+        val.imr_ifindex     = (int)*(const unsigned int*)option_value;
         return setsockopt(id, IPPROTO_IP, IP_MULTICAST_IF, &val, sizeof val);
       }
       break;
@@ -847,18 +1004,12 @@ etcpal_error_t etcpal_getblocking(etcpal_socket_t id, bool* blocking)
 
 etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
 {
-  if (!context)
-    return kEtcPalErrInvalid;
-
-  context->epoll_fd = epoll_create(EPOLL_CREATE_SIZE);
-  if (context->epoll_fd >= 0)
-  {
-    etcpal_rbtree_init(&context->sockets, poll_socket_compare, poll_socket_alloc, poll_socket_free);
-    context->valid = true;
-    return kEtcPalErrOk;
-  }
+  return init_poll_context(context, false);
+}
 
-  return errno_os_to_etcpal(errno);
+etcpal_error_t etcpal_poll_context_init_multithreaded(EtcPalPollContext* context)
+{
+  return init_poll_context(context, true);
 }
 
 void etcpal_poll_context_deinit(EtcPalPollContext* context)
@@ -866,7 +1017,11 @@ void etcpal_poll_context_deinit(EtcPalPollContext* context)
   if (context && context->valid)
   {
     etcpal_rbtree_clear(&context->sockets);
+    etcpal_rbtree_clear(&context->timers);
+    if (context->wakeup_fd >= 0)
+      close(context->wakeup_fd);
     close(context->epoll_fd);
+    etcpal_mutex_destroy(&context->lock);
     context->valid = false;
   }
 }
@@ -883,29 +1038,40 @@ etcpal_error_t etcpal_poll_add_socket(EtcPalPollContext*   context,
   if (!sock_desc)
     return kEtcPalErrNoMem;
 
-  sock_desc->sock           = socket;
-  sock_desc->events         = events;
-  sock_desc->user_data      = user_data;
-  etcpal_error_t insert_res = etcpal_rbtree_insert(&context->sockets, sock_desc);
-  if (insert_res != kEtcPalErrOk)
+  sock_desc->sock      = socket;
+  sock_desc->events    = events;
+  sock_desc->user_data = user_data;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
   {
-    free(sock_desc);
-    return insert_res;
-  }
+    sock_desc->generation = next_poll_generation(context);
 
-  struct epoll_event ep_evt = {0};
-  events_etcpal_to_epoll(events, &ep_evt);
-  ep_evt.data.fd = socket;
+    res = etcpal_rbtree_insert(&context->sockets, sock_desc);
+    if (res == kEtcPalErrOk)
+    {
+      struct epoll_event ep_evt = {0};
+      make_socket_epoll_event(context, sock_desc, &ep_evt);
+      if (epoll_ctl(context->epoll_fd, EPOLL_CTL_ADD, socket, &ep_evt) != 0)
+      {
+        res = errno_os_to_etcpal(errno);
+        // Our node dealloc function also deallocates sock_desc, so no need to free it here.
+        etcpal_rbtree_remove(&context->sockets, sock_desc);
+      }
+    }
+    else
+    {
+      free(sock_desc);
+    }
 
-  int res = epoll_ctl(context->epoll_fd, EPOLL_CTL_ADD, socket, &ep_evt);
-  if (res != 0)
+    etcpal_mutex_unlock(&context->lock);
+  }
+  else
   {
-    // Our node dealloc function also deallocates sock_desc, so no need to free it here.
-    etcpal_rbtree_remove(&context->sockets, sock_desc);
-    return errno_os_to_etcpal(errno);
+    free(sock_desc);
   }
 
-  return kEtcPalErrOk;
+  return res;
 }
 
 etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
@@ -919,74 +1085,472 @@ etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
     return kEtcPalErrInvalid;
   }
 
-  EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
-  if (!sock_desc)
-    return kEtcPalErrNotFound;
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
+    if (sock_desc)
+    {
+      etcpal_poll_events_t old_events = sock_desc->events;
+      sock_desc->events               = new_events;
 
-  struct epoll_event ep_evt = {0};
-  events_etcpal_to_epoll(new_events, &ep_evt);
-  ep_evt.data.fd = socket;
+      struct epoll_event ep_evt = {0};
+      make_socket_epoll_event(context, sock_desc, &ep_evt);
+      if (epoll_ctl(context->epoll_fd, EPOLL_CTL_MOD, socket, &ep_evt) == 0)
+      {
+        sock_desc->user_data = new_user_data;
+        res                  = kEtcPalErrOk;
+      }
+      else
+      {
+        sock_desc->events = old_events;
+        res               = errno_os_to_etcpal(errno);
+      }
+    }
+    else
+    {
+      res = kEtcPalErrNotFound;
+    }
 
-  int res = epoll_ctl(context->epoll_fd, EPOLL_CTL_MOD, socket, &ep_evt);
-  if (res != 0)
-    return errno_os_to_etcpal(errno);
+    etcpal_mutex_unlock(&context->lock);
+  }
 
-  sock_desc->events    = new_events;
-  sock_desc->user_data = new_user_data;
-  return kEtcPalErrOk;
+  return res;
+}
+
+etcpal_error_t etcpal_poll_rearm_socket(EtcPalPollContext* context, etcpal_socket_t socket)
+{
+  if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrInvalid;
+
+  // Sockets are only disarmed after an event on a multithreaded context.
+  if (!context->multithreaded)
+    return kEtcPalErrOk;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
+    if (sock_desc)
+    {
+      struct epoll_event ep_evt = {0};
+      make_socket_epoll_event(context, sock_desc, &ep_evt);
+      res = (epoll_ctl(context->epoll_fd, EPOLL_CTL_MOD, socket, &ep_evt) == 0 ? kEtcPalErrOk
+                                                                                 : errno_os_to_etcpal(errno));
+    }
+    else
+    {
+      res = kEtcPalErrNotFound;
+    }
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+
+  return res;
 }
 
 void etcpal_poll_remove_socket(EtcPalPollContext* context, etcpal_socket_t socket)
 {
-  if (context && context->valid)
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
   {
     // Need a dummy struct for portability - some versions require event to always be non-NULL
     // even though it is ignored
     struct epoll_event ep_evt = {0};
     epoll_ctl(context->epoll_fd, EPOLL_CTL_DEL, socket, &ep_evt);
     etcpal_rbtree_remove(&context->sockets, &socket);
+    etcpal_mutex_unlock(&context->lock);
   }
 }
 
 etcpal_error_t etcpal_poll_wait(EtcPalPollContext* context, EtcPalPollEvent* event, int timeout_ms)
 {
-  if (!context || !context->valid || !event)
+  if (!event)
     return kEtcPalErrInvalid;
 
-  if (etcpal_rbtree_size(&context->sockets) == 0)
-    return kEtcPalErrNoSockets;
+  int res = etcpal_poll_wait_many(context, event, 1, timeout_ms);
+  return (res > 0 ? kEtcPalErrOk : (etcpal_error_t)res);
+}
+
+int etcpal_poll_wait_many(EtcPalPollContext* context, EtcPalPollEvent* events, size_t max_events, int timeout_ms)
+{
+  if (!context || !context->valid || !events || max_events == 0)
+    return (int)kEtcPalErrInvalid;
+
+  if (!etcpal_mutex_lock(&context->lock))
+    return (int)kEtcPalErrSys;
+  bool have_sources = (etcpal_rbtree_size(&context->sockets) > 0 || etcpal_rbtree_size(&context->timers) > 0 ||
+                       context->wakeup_fd >= 0);
+  etcpal_mutex_unlock(&context->lock);
+
+  if (!have_sources)
+    return (int)kEtcPalErrNoSockets;
+
+  int sys_max = (int)(max_events < EPOLL_MAX_EVENTS_PER_WAIT ? max_events : EPOLL_MAX_EVENTS_PER_WAIT);
+
+  EtcPalTimer timeout_timer;
+  if (timeout_ms != ETCPAL_WAIT_FOREVER)
+    etcpal_timer_start(&timeout_timer, (uint32_t)timeout_ms);
 
-  int sys_timeout = (timeout_ms == ETCPAL_WAIT_FOREVER ? -1 : timeout_ms);
+  // A timer, wakeup or socket which was reset or removed after epoll reported it is not reported. If
+  // that leaves nothing to report, wait again for the rest of the timeout.
+  int num_events = 0;
+  while (num_events == 0)
+  {
+    int sys_timeout = -1;
+    if (timeout_ms != ETCPAL_WAIT_FOREVER)
+      sys_timeout = (int)etcpal_timer_remaining(&timeout_timer);
+
+    struct epoll_event epoll_evts[EPOLL_MAX_EVENTS_PER_WAIT];
+    int                wait_res = epoll_wait(context->epoll_fd, epoll_evts, sys_max, sys_timeout);
+    if (wait_res == 0)
+      return (int)kEtcPalErrTimedOut;
+    if (wait_res < 0)
+      return (int)errno_os_to_etcpal(errno);
+
+    if (!etcpal_mutex_lock(&context->lock))
+      return (int)kEtcPalErrSys;
 
-  struct epoll_event epoll_evt = {0};
-  int                wait_res  = epoll_wait(context->epoll_fd, &epoll_evt, 1, sys_timeout);
-  if (wait_res == 0)
-    return kEtcPalErrTimedOut;
-  if (wait_res < 0)
+    for (int i = 0; i < wait_res; ++i)
+    {
+      if (fill_poll_event(context, &epoll_evts[i], &events[num_events]))
+        ++num_events;
+    }
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+
+  return num_events;
+}
+
+etcpal_error_t etcpal_poll_add_timer(EtcPalPollContext*   context,
+                                     uint32_t             timeout_ms,
+                                     uint32_t             interval_ms,
+                                     void*                user_data,
+                                     etcpal_poll_timer_t* timer)
+{
+  if (!context || !context->valid || !timer)
+    return kEtcPalErrInvalid;
+
+  int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd < 0)
     return errno_os_to_etcpal(errno);
 
-  EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &epoll_evt.data.fd);
-  if (!sock_desc)
+  EtcPalPollSocket* timer_desc = (EtcPalPollSocket*)malloc(sizeof(EtcPalPollSocket));
+  if (!timer_desc)
+  {
+    close(timer_fd);
+    return kEtcPalErrNoMem;
+  }
+
+  timer_desc->sock      = timer_fd;
+  timer_desc->events    = ETCPAL_POLL_TIMER;
+  timer_desc->user_data = user_data;
+
+  if (!etcpal_mutex_lock(&context->lock))
+  {
+    close(timer_fd);
+    free(timer_desc);
     return kEtcPalErrSys;
+  }
+
+  timer_desc->generation = next_poll_generation(context);
+
+  etcpal_error_t res = etcpal_rbtree_insert(&context->timers, timer_desc);
+  if (res != kEtcPalErrOk)
+  {
+    etcpal_mutex_unlock(&context->lock);
+    close(timer_fd);
+    free(timer_desc);
+    return res;
+  }
+
+  // Timers are level-triggered even on a multithreaded context; if more than one thread is woken
+  // for the same expiration, only the one which reads the timerfd first reports it.
+  struct epoll_event ep_evt = {0};
+  make_epoll_event_data(context, timer_desc, &ep_evt);
+  ep_evt.events = EPOLLIN;
+
+  if (epoll_ctl(context->epoll_fd, EPOLL_CTL_ADD, timer_fd, &ep_evt) != 0)
+    res = errno_os_to_etcpal(errno);
+  else
+    res = set_poll_timer(timer_fd, timeout_ms, interval_ms);
+
+  if (res == kEtcPalErrOk)
+  {
+    *timer = timer_fd;
+  }
+  else
+  {
+    // Our node dealloc function also closes the timerfd and deallocates timer_desc.
+    etcpal_rbtree_remove(&context->timers, timer_desc);
+  }
+
+  etcpal_mutex_unlock(&context->lock);
+  return res;
+}
+
+etcpal_error_t etcpal_poll_reset_timer(EtcPalPollContext*  context,
+                                       etcpal_poll_timer_t timer,
+                                       uint32_t            timeout_ms,
+                                       uint32_t            interval_ms)
+{
+  if (!context || !context->valid || timer == ETCPAL_POLL_TIMER_INVALID)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    // timerfd_settime() also discards any expirations which have not been read yet.
+    if (etcpal_rbtree_find(&context->timers, &timer))
+      res = set_poll_timer(timer, timeout_ms, interval_ms);
+    else
+      res = kEtcPalErrNotFound;
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+
+  return res;
+}
+
+void etcpal_poll_remove_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer)
+{
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
+  {
+    if (etcpal_rbtree_find(&context->timers, &timer))
+    {
+      struct epoll_event ep_evt = {0};
+      epoll_ctl(context->epoll_fd, EPOLL_CTL_DEL, timer, &ep_evt);
+      etcpal_rbtree_remove(&context->timers, &timer);
+    }
+    etcpal_mutex_unlock(&context->lock);
+  }
+}
+
+etcpal_error_t etcpal_poll_add_wakeup(EtcPalPollContext* context, void* user_data)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+
+  if (!etcpal_mutex_lock(&context->lock))
+    return kEtcPalErrSys;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  if (context->wakeup_fd >= 0)
+  {
+    res = kEtcPalErrExists;
+  }
+  else
+  {
+    int wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd >= 0)
+    {
+      // A zero data field identifies the wakeup in epoll events, as it can never be confused with one
+      // of the socket or timer descriptors.
+      struct epoll_event ep_evt = {0};
+      ep_evt.events             = EPOLLIN;
+      ep_evt.data.u64           = 0;
+      if (epoll_ctl(context->epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ep_evt) == 0)
+      {
+        context->wakeup_fd        = wakeup_fd;
+        context->wakeup_user_data = user_data;
+      }
+      else
+      {
+        res = errno_os_to_etcpal(errno);
+        close(wakeup_fd);
+      }
+    }
+    else
+    {
+      res = errno_os_to_etcpal(errno);
+    }
+  }
+
+  etcpal_mutex_unlock(&context->lock);
+  return res;
+}
+
+etcpal_error_t etcpal_poll_wakeup(EtcPalPollContext* context)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+  if (context->wakeup_fd < 0)
+    return kEtcPalErrNotFound;
+
+  // The eventfd counter accumulates until it is read, so all wakeups which happen before the
+  // waiting thread gets to them are reported as one event. EAGAIN means the counter is saturated,
+  // in which case a wakeup is already pending.
+  uint64_t count = 1;
+  if (write(context->wakeup_fd, &count, sizeof count) < 0 && errno != EAGAIN)
+    return errno_os_to_etcpal(errno);
+  return kEtcPalErrOk;
+}
+
+void etcpal_poll_remove_wakeup(EtcPalPollContext* context)
+{
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
+  {
+    if (context->wakeup_fd >= 0)
+    {
+      struct epoll_event ep_evt = {0};
+      epoll_ctl(context->epoll_fd, EPOLL_CTL_DEL, context->wakeup_fd, &ep_evt);
+      close(context->wakeup_fd);
+      context->wakeup_fd        = -1;
+      context->wakeup_user_data = NULL;
+    }
+    etcpal_mutex_unlock(&context->lock);
+  }
+}
+
+etcpal_error_t init_poll_context(EtcPalPollContext* context, bool multithreaded)
+{
+  if (!context)
+    return kEtcPalErrInvalid;
+
+  if (!etcpal_mutex_create(&context->lock))
+    return kEtcPalErrSys;
+
+  context->epoll_fd = epoll_create(EPOLL_CREATE_SIZE);
+  if (context->epoll_fd >= 0)
+  {
+    etcpal_rbtree_init(&context->sockets, poll_socket_compare, poll_socket_alloc, poll_socket_free);
+    etcpal_rbtree_init(&context->timers, poll_socket_compare, poll_socket_alloc, poll_timer_free);
+    context->multithreaded    = multithreaded;
+    context->next_generation  = 1;
+    context->wakeup_fd        = -1;
+    context->wakeup_user_data = NULL;
+    context->valid            = true;
+    return kEtcPalErrOk;
+  }
+
+  etcpal_error_t res = errno_os_to_etcpal(errno);
+  etcpal_mutex_destroy(&context->lock);
+  return res;
+}
+
+uint32_t next_poll_generation(EtcPalPollContext* context)
+{
+  uint32_t generation = context->next_generation++;
+  // Generation 0 is never used, so that no socket or timer descriptor has zero epoll event data.
+  if (context->next_generation == 0)
+    context->next_generation = 1;
+  return generation;
+}
+
+void make_epoll_event_data(const EtcPalPollContext* context,
+                           const EtcPalPollSocket*  desc,
+                           struct epoll_event*      epoll_evt)
+{
+  // On a multithreaded context, a socket or timer can be removed by one thread after epoll has
+  // reported it to another, so the descriptor is looked up by fd and generation instead of being
+  // carried as a pointer which might no longer be valid.
+  if (context->multithreaded)
+    epoll_evt->data.u64 = ((uint64_t)desc->generation << 32) | (uint32_t)desc->sock;
+  else
+    epoll_evt->data.ptr = (void*)desc;
+}
+
+void make_socket_epoll_event(const EtcPalPollContext* context,
+                             const EtcPalPollSocket*  sock_desc,
+                             struct epoll_event*      epoll_evt)
+{
+  events_etcpal_to_epoll(sock_desc->events, epoll_evt);
+  // EPOLLONESHOT disables the socket once an event on it has been reported to one thread, so that
+  // no other thread is woken for it until etcpal_poll_rearm_socket().
+  if (context->multithreaded)
+    epoll_evt->events |= EPOLLONESHOT;
+  make_epoll_event_data(context, sock_desc, epoll_evt);
+}
+
+const EtcPalPollSocket* find_poll_desc(EtcPalPollContext* context, const struct epoll_event* epoll_evt)
+{
+  if (!context->multithreaded)
+    return (const EtcPalPollSocket*)epoll_evt->data.ptr;
+
+  int      fd         = (int)(uint32_t)(epoll_evt->data.u64 & 0xffffffffu);
+  uint32_t generation = (uint32_t)(epoll_evt->data.u64 >> 32);
+
+  const EtcPalPollSocket* desc = (const EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &fd);
+  if (!desc || desc->generation != generation)
+    desc = (const EtcPalPollSocket*)etcpal_rbtree_find(&context->timers, &fd);
+  return ((desc && desc->generation == generation) ? desc : NULL);
+}
+
+etcpal_error_t set_poll_timer(int timer_fd, uint32_t timeout_ms, uint32_t interval_ms)
+{
+  struct itimerspec spec;
+  memset(&spec, 0, sizeof spec);
+  spec.it_value.tv_sec  = (time_t)(timeout_ms / 1000);
+  spec.it_value.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+  // An all-zero it_value disarms a timerfd, so a timeout of 0 expires after 1 ns instead.
+  if (timeout_ms == 0)
+    spec.it_value.tv_nsec = 1;
+  spec.it_interval.tv_sec  = (time_t)(interval_ms / 1000);
+  spec.it_interval.tv_nsec = (long)(interval_ms % 1000) * 1000000;
+
+  if (timerfd_settime(timer_fd, 0, &spec, NULL) != 0)
+    return errno_os_to_etcpal(errno);
+  return kEtcPalErrOk;
+}
+
+// Read the counter of a timerfd or eventfd, which resets it. Returns false if there was nothing to
+// read.
+bool consume_poll_fd(int fd)
+{
+  uint64_t count = 0;
+  return (read(fd, &count, sizeof count) == (ssize_t)sizeof count);
+}
+
+// Translate one epoll event into an EtcPalPollEvent. Returns false if there is nothing to report.
+// Must be called with the context lock held.
+bool fill_poll_event(EtcPalPollContext* context, const struct epoll_event* epoll_evt, EtcPalPollEvent* event)
+{
+  event->err   = kEtcPalErrOk;
+  event->timer = ETCPAL_POLL_TIMER_INVALID;
+
+  if (epoll_evt->data.u64 == 0)
+  {
+    if (context->wakeup_fd < 0 || !consume_poll_fd(context->wakeup_fd))
+      return false;
+
+    event->socket    = ETCPAL_SOCKET_INVALID;
+    event->events    = ETCPAL_POLL_WAKEUP;
+    event->user_data = context->wakeup_user_data;
+    return true;
+  }
+
+  const EtcPalPollSocket* sock_desc = find_poll_desc(context, epoll_evt);
+  if (!sock_desc)
+    return false;
 
-  event->socket = sock_desc->sock;
-  events_epoll_to_etcpal(&epoll_evt, sock_desc, &event->events);
-  event->err       = kEtcPalErrOk;
   event->user_data = sock_desc->user_data;
 
-  // Check for errors
-  int       error      = 0;
-  socklen_t error_size = sizeof error;
-  if (getsockopt(sock_desc->sock, SOL_SOCKET, SO_ERROR, &error, &error_size) == 0)
+  if (sock_desc->events & ETCPAL_POLL_TIMER)
   {
-    if (error != 0)
+    if (!consume_poll_fd(sock_desc->sock))
+      return false;
+
+    event->socket = ETCPAL_SOCKET_INVALID;
+    event->events = ETCPAL_POLL_TIMER;
+    event->timer  = sock_desc->sock;
+    return true;
+  }
+
+  event->socket = sock_desc->sock;
+  events_epoll_to_etcpal(epoll_evt, sock_desc, &event->events);
+
+  // Only go back to the kernel for the error code if epoll has told us there is one.
+  if (epoll_evt->events & (EPOLLERR | EPOLLHUP))
+  {
+    int       error      = 0;
+    socklen_t error_size = sizeof error;
+    if (getsockopt(sock_desc->sock, SOL_SOCKET, SO_ERROR, &error, &error_size) == 0 && error != 0)
     {
       event->events |= ETCPAL_POLL_ERR;
       event->err = errno_os_to_etcpal(error);
     }
   }
-
-  return kEtcPalErrOk;
+  return true;
 }
 
 void events_etcpal_to_epoll(etcpal_poll_events_t events, struct epoll_event* epoll_evt)
@@ -1055,6 +1619,20 @@ void poll_socket_free(EtcPalRbNode* node)
   free(node);
 }
 
+void poll_timer_free(EtcPalRbNode* node)
+{
+  if (!ETCPAL_ASSERT_VERIFY(node))
+    return;
+
+  if (ETCPAL_ASSERT_VERIFY(node->value))
+  {
+    close(((EtcPalPollSocket*)node->value)->sock);
+    free(node->value);
+  }
+
+  free(node);
+}
+
 void construct_msghdr(const EtcPalMsgHdr*      in_msg,
                       struct sockaddr_storage* name_store,
                       struct iovec*            buf_store,
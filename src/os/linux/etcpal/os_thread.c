@@ -17,13 +17,14 @@
  * https://github.com/ETCLabs/EtcPal
  ******************************************************************************/
 
-// For pthread_setname_np() - this is a Linux-specific file
+// For pthread_setname_np() and pthread_attr_setaffinity_np() - this is a Linux-specific file
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
 
 #include "etcpal/thread.h"
 
+#include <errno.h>
 #include <string.h>
 #include <time.h>
 #include "etcpal/common.h"
@@ -35,6 +36,7 @@
 /*********************** Private function prototypes *************************/
 
 static void* thread_func_internal(void* arg);
+static int   create_pthread(etcpal_thread_t* id, const EtcPalThreadParams* params, bool sched_policy, bool affinity);
 
 /*************************** Function definitions ****************************/
 
@@ -46,16 +48,6 @@ etcpal_error_t etcpal_thread_create(etcpal_thread_t*          id,
   if (!id || !params || !thread_fn)
     return kEtcPalErrInvalid;
 
-  pthread_attr_t  thread_attr;
-  pthread_attr_t* p_thread_attr = NULL;
-
-  if (params && params->stack_size != ETCPAL_THREAD_DEFAULT_STACK)
-  {
-    pthread_attr_init(&thread_attr);
-    pthread_attr_setstacksize(&thread_attr, params->stack_size);
-    p_thread_attr = &thread_attr;
-  }
-
   if (params->thread_name)
   {
     strncpy(id->name, params->thread_name, ETCPAL_THREAD_NAME_MAX_LENGTH);
@@ -66,16 +58,29 @@ etcpal_error_t etcpal_thread_create(etcpal_thread_t*          id,
     id->name[0] = '\0';
   }
 
-  id->fn             = thread_fn;
-  id->arg            = thread_arg;
-  etcpal_error_t res = kEtcPalErrOk;
-  if (0 != pthread_create(&id->handle, p_thread_attr, thread_func_internal, id))
-    res = errno_os_to_etcpal(errno);
+  id->fn  = thread_fn;
+  id->arg = thread_arg;
 
-  if (p_thread_attr)
-    pthread_attr_destroy(p_thread_attr);
+  bool sched_policy = false;
+  bool affinity     = false;
+  if (params->platform_data)
+  {
+    const EtcPalThreadParamsLinux* platform_params = (const EtcPalThreadParamsLinux*)params->platform_data;
+    sched_policy = (platform_params->sched_policy == SCHED_FIFO || platform_params->sched_policy == SCHED_RR);
+    affinity     = (platform_params->cpu_affinity != 0);
+  }
 
-  return res;
+  int create_res = create_pthread(id, params, sched_policy, affinity);
+
+  // Real-time scheduling usually requires privileges (CAP_SYS_NICE or a nonzero RLIMIT_RTPRIO), and
+  // the affinity mask might not contain any CPU available to this process. Rather than failing,
+  // fall back to default scheduling, then to default affinity.
+  if ((create_res == EPERM || create_res == EINVAL) && sched_policy)
+    create_res = create_pthread(id, params, false, affinity);
+  if ((create_res == EPERM || create_res == EINVAL) && affinity)
+    create_res = create_pthread(id, params, false, false);
+
+  return (create_res == 0 ? kEtcPalErrOk : errno_os_to_etcpal(create_res));
 }
 
 etcpal_error_t etcpal_thread_sleep(unsigned int sleep_ms)
@@ -133,6 +138,63 @@ void* thread_func_internal(void* arg)
   return NULL;
 }
 
+// Create the underlying pthread, optionally applying the scheduling policy/priority and the CPU
+// affinity from the Linux-specific parameters. Returns the result of pthread_create().
+int create_pthread(etcpal_thread_t* id, const EtcPalThreadParams* params, bool sched_policy, bool affinity)
+{
+  pthread_attr_t  thread_attr;
+  pthread_attr_t* p_thread_attr = NULL;
+
+  if (params->stack_size != ETCPAL_THREAD_DEFAULT_STACK || sched_policy || affinity)
+  {
+    pthread_attr_init(&thread_attr);
+    p_thread_attr = &thread_attr;
+  }
+
+  if (params->stack_size != ETCPAL_THREAD_DEFAULT_STACK)
+    pthread_attr_setstacksize(&thread_attr, params->stack_size);
+
+  const EtcPalThreadParamsLinux* platform_params = (const EtcPalThreadParamsLinux*)params->platform_data;
+  if (sched_policy)
+  {
+    // Clamp the priority to the range supported by the policy (1-99 on current kernels).
+    int min_priority = sched_get_priority_min(platform_params->sched_policy);
+    int max_priority = sched_get_priority_max(platform_params->sched_policy);
+
+    struct sched_param sched_param;
+    memset(&sched_param, 0, sizeof sched_param);
+    if (params->priority < (unsigned int)min_priority)
+      sched_param.sched_priority = min_priority;
+    else if (params->priority > (unsigned int)max_priority)
+      sched_param.sched_priority = max_priority;
+    else
+      sched_param.sched_priority = (int)params->priority;
+
+    pthread_attr_setinheritsched(&thread_attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&thread_attr, platform_params->sched_policy);
+    pthread_attr_setschedparam(&thread_attr, &sched_param);
+  }
+
+  if (affinity)
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu = 0; cpu < (int)(sizeof(platform_params->cpu_affinity) * 8) && cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (platform_params->cpu_affinity & (1ull << cpu))
+        CPU_SET(cpu, &cpu_set);
+    }
+    pthread_attr_setaffinity_np(&thread_attr, sizeof cpu_set, &cpu_set);
+  }
+
+  int res = pthread_create(&id->handle, p_thread_attr, thread_func_internal, id);
+
+  if (p_thread_attr)
+    pthread_attr_destroy(p_thread_attr);
+
+  return res;
+}
+
 etcpal_thread_os_handle_t etcpal_thread_get_os_handle(etcpal_thread_t* id)
 {
   return (id ? id->handle : ETCPAL_THREAD_OS_HANDLE_INVALID);
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#ifndef ETCPAL_OS_TIMED_WAIT_H_
+#define ETCPAL_OS_TIMED_WAIT_H_
+
+#include <stdbool.h>
+#include <time.h>
+
+// Convert a relative timeout in milliseconds to an absolute time on the given clock, as used by the
+// pthread and semaphore timed wait functions.
+static inline bool timeout_ms_to_abs_timespec(clockid_t clock_id, int timeout_ms, struct timespec* ts)
+{
+  if (clock_gettime(clock_id, ts) == -1)
+    return false;
+
+  ts->tv_sec += (time_t)(timeout_ms / 1000);
+  ts->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+  if (ts->tv_nsec >= 1000000000L)
+  {
+    ts->tv_sec++;
+    ts->tv_nsec -= 1000000000L;
+  }
+  return true;
+}
+
+#endif /* ETCPAL_OS_TIMED_WAIT_H_ */
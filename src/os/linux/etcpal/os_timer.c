@@ -27,6 +27,7 @@
 #if !defined(ETCPAL_BUILDING_MOCK_LIB)
 
 static const uint64_t kMsWrapPoint = (uint64_t)UINT32_MAX + 1;
+static const uint64_t kNsPerSec    = 1000000000u;
 
 etcpal_error_t etcpal_timer_init(void)
 {
@@ -51,4 +52,25 @@ uint32_t etcpal_getms(void)
   return 0;
 }
 
+uint64_t etcpal_getns(void)
+{
+  struct timespec os_time;
+  if (0 == clock_gettime(CLOCK_MONOTONIC, &os_time))
+    return (uint64_t)os_time.tv_sec * kNsPerSec + (uint64_t)os_time.tv_nsec;
+  return 0;
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+#ifdef CLOCK_MONOTONIC_COARSE
+  // Read from the vDSO without touching the clocksource hardware; resolution is one kernel tick.
+  struct timespec os_time;
+  if (0 == clock_gettime(CLOCK_MONOTONIC_COARSE, &os_time))
+    return (uint64_t)os_time.tv_sec * kNsPerSec + (uint64_t)os_time.tv_nsec;
+  return 0;
+#else
+  return etcpal_getns();
+#endif
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
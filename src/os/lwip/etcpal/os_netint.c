@@ -245,6 +245,20 @@ bool os_netint_is_up(unsigned int index, const CachedNetintInfo* cache)
   return res;
 }
 
+etcpal_error_t os_netint_start_monitor(void)
+{
+  return kEtcPalErrNotImpl;
+}
+
+void os_netint_stop_monitor(void)
+{
+}
+
+void os_netint_update_routes(CachedNetintInfo* cache)
+{
+  ETCPAL_UNUSED_ARG(cache);
+}
+
 // Must be called with lwIP TCP/IP core locked
 void copy_common_interface_info(const struct netif* lwip_netif, EtcPalNetintInfo* netint)
 {
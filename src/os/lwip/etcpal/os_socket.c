@@ -27,8 +27,15 @@
 
 #include "etcpal/common.h"
 #include "etcpal/private/common.h"
+#include "etcpal/thread.h"
+#include "etcpal/timer.h"
 #include "os_error.h"
 
+/**************************** Private constants ******************************/
+
+// How long etcpal_poll_wait() sleeps at a time when a context has only disarmed timers to wait on.
+#define POLL_IDLE_SLEEP_MS 1000
+
 /***************************** Private macros ********************************/
 
 #define ETCPAL_FD_ZERO(setptr) \
@@ -128,12 +135,22 @@ static int setsockopt_ip(etcpal_socket_t id, int option_name, const void* option
 static int setsockopt_ip6(etcpal_socket_t id, int option_name, const void* option_value, size_t option_len);
 #endif
 
+// Helpers for etcpal_join_groups() and etcpal_leave_groups()
+static int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name);
+
 // Helper functions for the etcpal_poll API
 static void              init_context_socket_array(EtcPalPollContext* context);
 static EtcPalPollSocket* find_socket(EtcPalPollContext* context, etcpal_socket_t sock);
 static EtcPalPollSocket* find_hole(EtcPalPollContext* context);
 static void              set_in_fd_sets(EtcPalPollContext* context, const EtcPalPollSocket* sock);
 static void              clear_in_fd_sets(EtcPalPollContext* context, const EtcPalPollSocket* sock);
+static EtcPalPollTimer*  find_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer);
+static void              start_poll_timer(EtcPalPollTimer* timer, uint32_t timeout_ms, uint32_t interval_ms);
+static bool              get_expired_timer(EtcPalPollContext* context, EtcPalPollEvent* event);
+static int               get_next_timer_timeout(EtcPalPollContext* context);
+static etcpal_error_t    create_wakeup_sockets(EtcPalPollContext* context);
+static void              close_wakeup_sockets(EtcPalPollContext* context);
+static void              handle_wakeup(EtcPalPollContext* context, EtcPalPollEvent* event);
 static etcpal_error_t    handle_select_result(EtcPalPollContext* context,
                                               EtcPalPollEvent*   event,
                                               const fd_set*      readfds,
@@ -261,6 +278,39 @@ etcpal_error_t etcpal_getsockopt(etcpal_socket_t id, int level, int option_name,
   return kEtcPalErrNotImpl;
 }
 
+int etcpal_join_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_JOIN_GROUP);
+}
+
+int etcpal_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_LEAVE_GROUP);
+}
+
+int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !groups || num_groups == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_done = 0;
+  for (; num_done < num_groups; ++num_done)
+  {
+    const EtcPalGroupReq* greq  = &groups[num_done];
+    int                   level = ETCPAL_IP_IS_V6(&greq->group) ? ETCPAL_IPPROTO_IPV6 : ETCPAL_IPPROTO_IP;
+
+    etcpal_error_t res = etcpal_setsockopt(id, level, option_name, greq, sizeof(EtcPalGroupReq));
+    if (res != kEtcPalErrOk)
+    {
+      if (num_done > 0)
+        break;
+      return (int)res;
+    }
+  }
+
+  return (int)num_done;
+}
+
 etcpal_error_t etcpal_listen(etcpal_socket_t id, int backlog)
 {
   if (id == ETCPAL_SOCKET_INVALID)
@@ -327,6 +377,20 @@ int etcpal_recvmsg(etcpal_socket_t id, EtcPalMsgHdr* msg, int flags)
   return res;
 }
 
+int etcpal_recvmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // No batch receive on this platform; receive one datagram per call.
+  int res = etcpal_recvmsg(id, &msgs[0].hdr, flags);
+  if (res < 0)
+    return res;
+
+  msgs[0].len = (size_t)res;
+  return 1;
+}
+
 bool etcpal_cmsg_firsthdr(EtcPalMsgHdr* msgh, EtcPalCMsgHdr* firsthdr)
 {
   bool result = false;
@@ -410,6 +474,40 @@ int etcpal_send(etcpal_socket_t id, const void* message, size_t length, int flag
   return (res >= 0 ? res : (int)errno_lwip_to_etcpal(errno));
 }
 
+int etcpal_sendmsg(etcpal_socket_t       id,
+                   const EtcPalIoVec*    iov,
+                   size_t                iovcnt,
+                   int                   flags,
+                   const EtcPalSockAddr* dest_addr)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !iov || iovcnt == 0 || iovcnt > ETCPAL_SENDMSG_MAX_IOV)
+    return (int)kEtcPalErrInvalid;
+
+  struct iovec impl_iov[ETCPAL_SENDMSG_MAX_IOV];
+  for (size_t i = 0; i < iovcnt; ++i)
+  {
+    impl_iov[i].iov_base = (void*)iov[i].base;
+    impl_iov[i].iov_len  = iov[i].len;
+  }
+
+  struct msghdr           impl_msg  = {0};
+  struct sockaddr_storage impl_name = {0};
+  if (dest_addr)
+  {
+    impl_msg.msg_namelen = (socklen_t)sockaddr_etcpal_to_os(dest_addr, (etcpal_os_sockaddr_t*)&impl_name);
+    if (impl_msg.msg_namelen == 0)
+      return (int)kEtcPalErrSys;
+    impl_msg.msg_name = &impl_name;
+  }
+  impl_msg.msg_iov    = impl_iov;
+  impl_msg.msg_iovlen = (int)iovcnt;
+
+  int res = (int)lwip_sendmsg(id, &impl_msg, 0);
+  return (res >= 0 ? res : (int)errno_lwip_to_etcpal(errno));
+}
+
 int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int flags, const EtcPalSockAddr* dest_addr)
 {
   ETCPAL_UNUSED_ARG(flags);
@@ -426,6 +524,31 @@ int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int fl
   return (res >= 0 ? res : (int)errno_lwip_to_etcpal(errno));
 }
 
+int etcpal_sendmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_sent = 0;
+  for (; num_sent < num_msgs; ++num_sent)
+  {
+    const EtcPalMsgHdr* msg = &msgs[num_sent].hdr;
+
+    // An invalid destination means the socket is connected.
+    int res = ETCPAL_IP_IS_INVALID(&msg->name.ip) ? etcpal_send(id, msg->buf, msg->buflen, flags)
+                                                  : etcpal_sendto(id, msg->buf, msg->buflen, flags, &msg->name);
+    if (res < 0)
+    {
+      if (num_sent > 0)
+        break;
+      return res;
+    }
+    msgs[num_sent].len = (size_t)res;
+  }
+
+  return (int)num_sent;
+}
+
 etcpal_error_t etcpal_setsockopt(etcpal_socket_t id,
                                  int             level,
                                  int             option_name,
@@ -765,6 +888,12 @@ etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
 
   init_context_socket_array(context);
   context->max_fd = -1;
+  for (EtcPalPollTimer* timer = context->timers; timer < context->timers + ETCPAL_SOCKET_MAX_POLL_TIMERS; ++timer)
+    timer->valid = false;
+  context->num_valid_timers = 0;
+  context->wakeup_recv_sock = ETCPAL_SOCKET_INVALID;
+  context->wakeup_send_sock = ETCPAL_SOCKET_INVALID;
+  context->wakeup_user_data = NULL;
   ETCPAL_FD_ZERO(&context->readfds);
   ETCPAL_FD_ZERO(&context->writefds);
   ETCPAL_FD_ZERO(&context->exceptfds);
@@ -773,11 +902,20 @@ etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
   return kEtcPalErrOk;
 }
 
+etcpal_error_t etcpal_poll_context_init_multithreaded(EtcPalPollContext* context)
+{
+  // select() cannot hand an event on a socket to only one of several waiting threads.
+  ETCPAL_UNUSED_ARG(context);
+  return kEtcPalErrNotImpl;
+}
+
 void etcpal_poll_context_deinit(EtcPalPollContext* context)
 {
   if (!context)
     return;
 
+  if (context->valid)
+    close_wakeup_sockets(context);
   context->valid = false;
 }
 
@@ -833,6 +971,15 @@ etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
   return kEtcPalErrNotFound;
 }
 
+etcpal_error_t etcpal_poll_rearm_socket(EtcPalPollContext* context, etcpal_socket_t socket)
+{
+  if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrInvalid;
+
+  // Multithreaded contexts are not supported, so sockets are never disarmed.
+  return kEtcPalErrOk;
+}
+
 void etcpal_poll_remove_socket(EtcPalPollContext* context, etcpal_socket_t socket)
 {
   if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
@@ -861,30 +1008,176 @@ etcpal_error_t etcpal_poll_wait(EtcPalPollContext* context, EtcPalPollEvent* eve
   if (!context || !context->valid || !event)
     return kEtcPalErrInvalid;
 
-  if (context->readfds.count == 0 && context->writefds.count == 0 && context->exceptfds.count == 0)
+  if (context->readfds.count == 0 && context->writefds.count == 0 && context->exceptfds.count == 0 &&
+      context->num_valid_timers == 0 && context->wakeup_recv_sock == ETCPAL_SOCKET_INVALID)
   {
-    // No valid sockets are currently added to the context.
+    // No valid sockets, timers or wakeups are currently added to the context.
     return kEtcPalErrNoSockets;
   }
 
-  fd_set readfds   = context->readfds.set;
-  fd_set writefds  = context->writefds.set;
-  fd_set exceptfds = context->exceptfds.set;
-
-  struct timeval os_timeout = {0};
+  EtcPalTimer timeout_timer;
   if (timeout_ms != ETCPAL_WAIT_FOREVER)
-    ms_to_timeval(timeout_ms, &os_timeout);
+    etcpal_timer_start(&timeout_timer, (uint32_t)timeout_ms);
+
+  // select() knows nothing about timers, so its timeout is bounded by the next timer expiration. If
+  // that comes before the caller's timeout, go around again to report the timer.
+  for (bool first_pass = true;; first_pass = false)
+  {
+    if (get_expired_timer(context, event))
+      return kEtcPalErrOk;
 
-  int sel_res = lwip_select(context->max_fd + 1, context->readfds.count ? &readfds : NULL,
-                            context->writefds.count ? &writefds : NULL, context->exceptfds.count ? &exceptfds : NULL,
-                            timeout_ms == ETCPAL_WAIT_FOREVER ? NULL : &os_timeout);
+    if (!first_pass && timeout_ms != ETCPAL_WAIT_FOREVER && etcpal_timer_is_expired(&timeout_timer))
+      return kEtcPalErrTimedOut;
 
-  if (sel_res < 0)
-    return errno_lwip_to_etcpal(errno);
-  else if (sel_res == 0)
-    return kEtcPalErrTimedOut;
+    int wait_ms = get_next_timer_timeout(context);
+    if (timeout_ms != ETCPAL_WAIT_FOREVER)
+    {
+      int remaining_ms = (int)etcpal_timer_remaining(&timeout_timer);
+      if (wait_ms == ETCPAL_WAIT_FOREVER || remaining_ms < wait_ms)
+        wait_ms = remaining_ms;
+    }
+
+    fd_set readfds      = context->readfds.set;
+    fd_set writefds     = context->writefds.set;
+    fd_set exceptfds    = context->exceptfds.set;
+    int    nfds         = context->max_fd + 1;
+    bool   have_readfds = (context->readfds.count > 0);
+    if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+    {
+      FD_SET(context->wakeup_recv_sock, &readfds);
+      have_readfds = true;
+      if (context->wakeup_recv_sock >= nfds)
+        nfds = context->wakeup_recv_sock + 1;
+    }
+
+    if (!have_readfds && context->writefds.count == 0 && context->exceptfds.count == 0)
+    {
+      // Only timers are added to the context, so there is nothing for select() to wait on.
+      etcpal_thread_sleep(wait_ms == ETCPAL_WAIT_FOREVER ? POLL_IDLE_SLEEP_MS : (unsigned int)wait_ms);
+      continue;
+    }
+
+    struct timeval os_timeout = {0};
+    if (wait_ms != ETCPAL_WAIT_FOREVER)
+      ms_to_timeval(wait_ms, &os_timeout);
+
+    int sel_res = lwip_select(nfds, have_readfds ? &readfds : NULL, context->writefds.count ? &writefds : NULL,
+                              context->exceptfds.count ? &exceptfds : NULL,
+                              wait_ms == ETCPAL_WAIT_FOREVER ? NULL : &os_timeout);
+
+    if (sel_res < 0)
+      return errno_lwip_to_etcpal(errno);
+
+    if (sel_res > 0)
+    {
+      if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID && FD_ISSET(context->wakeup_recv_sock, &readfds))
+      {
+        handle_wakeup(context, event);
+        return kEtcPalErrOk;
+      }
+      return handle_select_result(context, event, &readfds, &writefds, &exceptfds);
+    }
+  }
+}
+
+int etcpal_poll_wait_many(EtcPalPollContext* context, EtcPalPollEvent* events, size_t max_events, int timeout_ms)
+{
+  if (!events || max_events == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // The select()-based implementation only reports one event per call.
+  etcpal_error_t res = etcpal_poll_wait(context, events, timeout_ms);
+  return (res == kEtcPalErrOk ? 1 : (int)res);
+}
+
+etcpal_error_t etcpal_poll_add_timer(EtcPalPollContext*   context,
+                                     uint32_t             timeout_ms,
+                                     uint32_t             interval_ms,
+                                     void*                user_data,
+                                     etcpal_poll_timer_t* timer)
+{
+  if (!context || !context->valid || !timer)
+    return kEtcPalErrInvalid;
 
-  return handle_select_result(context, event, &readfds, &writefds, &exceptfds);
+  for (size_t i = 0; i < ETCPAL_SOCKET_MAX_POLL_TIMERS; ++i)
+  {
+    EtcPalPollTimer* timer_desc = &context->timers[i];
+    if (!timer_desc->valid)
+    {
+      timer_desc->valid     = true;
+      timer_desc->user_data = user_data;
+      start_poll_timer(timer_desc, timeout_ms, interval_ms);
+      ++context->num_valid_timers;
+      *timer = (etcpal_poll_timer_t)i;
+      return kEtcPalErrOk;
+    }
+  }
+
+  return kEtcPalErrNoMem;
+}
+
+etcpal_error_t etcpal_poll_reset_timer(EtcPalPollContext*  context,
+                                       etcpal_poll_timer_t timer,
+                                       uint32_t            timeout_ms,
+                                       uint32_t            interval_ms)
+{
+  if (!context || !context->valid || timer == ETCPAL_POLL_TIMER_INVALID)
+    return kEtcPalErrInvalid;
+
+  EtcPalPollTimer* timer_desc = find_timer(context, timer);
+  if (!timer_desc)
+    return kEtcPalErrNotFound;
+
+  start_poll_timer(timer_desc, timeout_ms, interval_ms);
+  return kEtcPalErrOk;
+}
+
+void etcpal_poll_remove_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer)
+{
+  if (!context || !context->valid)
+    return;
+
+  EtcPalPollTimer* timer_desc = find_timer(context, timer);
+  if (timer_desc)
+  {
+    timer_desc->valid = false;
+    --context->num_valid_timers;
+  }
+}
+
+etcpal_error_t etcpal_poll_add_wakeup(EtcPalPollContext* context, void* user_data)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+  if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrExists;
+  etcpal_error_t res = create_wakeup_sockets(context);
+  if (res == kEtcPalErrOk)
+    context->wakeup_user_data = user_data;
+  return res;
+}
+
+etcpal_error_t etcpal_poll_wakeup(EtcPalPollContext* context)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+  if (context->wakeup_send_sock == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrNotFound;
+
+  // All datagrams queued before the waiting thread gets to them are drained at once, so they are
+  // reported as one event. kEtcPalErrWouldBlock means the socket buffer is full, in which case a
+  // wakeup is already pending.
+  const uint8_t wakeup_byte = 0;
+  int           send_res    = etcpal_send(context->wakeup_send_sock, &wakeup_byte, 1, 0);
+  if (send_res < 0 && send_res != (int)kEtcPalErrWouldBlock)
+    return (etcpal_error_t)send_res;
+  return kEtcPalErrOk;
+}
+
+void etcpal_poll_remove_wakeup(EtcPalPollContext* context)
+{
+  if (context && context->valid)
+    close_wakeup_sockets(context);
 }
 
 etcpal_error_t handle_select_result(EtcPalPollContext* context,
@@ -920,6 +1213,7 @@ etcpal_error_t handle_select_result(EtcPalPollContext* context,
       res              = kEtcPalErrOk;
       event->socket    = sock_desc->sock;
       event->user_data = sock_desc->user_data;
+      event->timer     = ETCPAL_POLL_TIMER_INVALID;
 
       if (FD_ISSET(sock_desc->sock, readfds))
       {
@@ -1040,6 +1334,171 @@ bool get_first_compatible_cmsg(struct msghdr* msg, struct cmsghdr* start, EtcPal
   return cmsg->valid;
 }
 
+EtcPalPollTimer* find_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return NULL;
+
+  if (timer < 0 || timer >= ETCPAL_SOCKET_MAX_POLL_TIMERS || !context->timers[timer].valid)
+    return NULL;
+  return &context->timers[timer];
+}
+
+void start_poll_timer(EtcPalPollTimer* timer, uint32_t timeout_ms, uint32_t interval_ms)
+{
+  if (!ETCPAL_ASSERT_VERIFY(timer))
+    return;
+
+  timer->armed       = true;
+  timer->expiry_ms   = etcpal_getms() + timeout_ms;
+  timer->interval_ms = interval_ms;
+}
+
+// Fill in an event for the first expired timer in the context, if there is one.
+bool get_expired_timer(EtcPalPollContext* context, EtcPalPollEvent* event)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context) || !ETCPAL_ASSERT_VERIFY(event))
+    return false;
+
+  uint32_t now = etcpal_getms();
+  for (size_t i = 0; i < ETCPAL_SOCKET_MAX_POLL_TIMERS; ++i)
+  {
+    EtcPalPollTimer* timer_desc = &context->timers[i];
+    if (timer_desc->valid && timer_desc->armed && (int32_t)(now - timer_desc->expiry_ms) >= 0)
+    {
+      // A periodic timer which expired more than once since it was last reported is reported once.
+      if (timer_desc->interval_ms == 0)
+      {
+        timer_desc->armed = false;
+      }
+      else
+      {
+        do
+        {
+          timer_desc->expiry_ms += timer_desc->interval_ms;
+        } while ((int32_t)(now - timer_desc->expiry_ms) >= 0);
+      }
+
+      event->socket    = ETCPAL_SOCKET_INVALID;
+      event->events    = ETCPAL_POLL_TIMER;
+      event->err       = kEtcPalErrOk;
+      event->user_data = timer_desc->user_data;
+      event->timer     = (etcpal_poll_timer_t)i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Get the time in milliseconds until the next timer in the context expires, or
+// ETCPAL_WAIT_FOREVER if no timers are armed.
+int get_next_timer_timeout(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return ETCPAL_WAIT_FOREVER;
+
+  uint32_t now = etcpal_getms();
+  int      res = ETCPAL_WAIT_FOREVER;
+  for (const EtcPalPollTimer* timer_desc = context->timers;
+       timer_desc < context->timers + ETCPAL_SOCKET_MAX_POLL_TIMERS; ++timer_desc)
+  {
+    if (timer_desc->valid && timer_desc->armed)
+    {
+      int32_t remaining = (int32_t)(timer_desc->expiry_ms - now);
+      if (remaining < 0)
+        remaining = 0;
+      if (res == ETCPAL_WAIT_FOREVER || remaining < res)
+        res = (int)remaining;
+    }
+  }
+
+  return res;
+}
+
+// Create a pair of loopback UDP sockets. A datagram sent on the send socket makes the receive socket
+// readable, which wakes up select(). Each socket is connected to the other, so that the receive
+// socket ignores datagrams from anywhere else.
+etcpal_error_t create_wakeup_sockets(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return kEtcPalErrSys;
+
+  etcpal_socket_t recv_sock = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t send_sock = ETCPAL_SOCKET_INVALID;
+
+  EtcPalSockAddr recv_addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&recv_addr.ip, 0x7f000001u);
+  recv_addr.port = 0;
+  EtcPalSockAddr send_addr;
+
+  etcpal_error_t res = etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_sock);
+  if (res == kEtcPalErrOk)
+    res = etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock);
+  if (res == kEtcPalErrOk)
+    res = etcpal_bind(recv_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_getsockname(recv_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_connect(send_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_getsockname(send_sock, &send_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_connect(recv_sock, &send_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_setblocking(recv_sock, false);
+  if (res == kEtcPalErrOk)
+    res = etcpal_setblocking(send_sock, false);
+
+  if (res != kEtcPalErrOk)
+  {
+    if (recv_sock != ETCPAL_SOCKET_INVALID)
+      etcpal_close(recv_sock);
+    if (send_sock != ETCPAL_SOCKET_INVALID)
+      etcpal_close(send_sock);
+    return res;
+  }
+
+  context->wakeup_recv_sock = recv_sock;
+  context->wakeup_send_sock = send_sock;
+  return kEtcPalErrOk;
+}
+
+void close_wakeup_sockets(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return;
+
+  if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+  {
+    etcpal_close(context->wakeup_recv_sock);
+    etcpal_close(context->wakeup_send_sock);
+    context->wakeup_recv_sock = ETCPAL_SOCKET_INVALID;
+    context->wakeup_send_sock = ETCPAL_SOCKET_INVALID;
+    context->wakeup_user_data = NULL;
+  }
+}
+
+// Drain all pending wakeup datagrams and fill in the wakeup event.
+void handle_wakeup(EtcPalPollContext* context, EtcPalPollEvent* event)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context) || !ETCPAL_ASSERT_VERIFY(event))
+    return;
+
+  uint8_t buf[16];
+  int     recv_res = 0;
+  do
+  {
+    recv_res = etcpal_recv(context->wakeup_recv_sock, buf, sizeof buf, 0);
+  } while (recv_res > 0);
+
+  event->socket    = ETCPAL_SOCKET_INVALID;
+  event->events    = ETCPAL_POLL_WAKEUP;
+  event->err       = kEtcPalErrOk;
+  event->user_data = context->wakeup_user_data;
+  event->timer     = ETCPAL_POLL_TIMER_INVALID;
+}
+
 void init_context_socket_array(EtcPalPollContext* context)
 {
   if (!ETCPAL_ASSERT_VERIFY(context))
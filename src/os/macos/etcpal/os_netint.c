@@ -352,6 +352,20 @@ bool os_netint_is_up(unsigned int index, const CachedNetintInfo* cache)
   return false;
 }
 
+etcpal_error_t os_netint_start_monitor(void)
+{
+  return kEtcPalErrNotImpl;
+}
+
+void os_netint_stop_monitor(void)
+{
+}
+
+void os_netint_update_routes(CachedNetintInfo* cache)
+{
+  ETCPAL_UNUSED_ARG(cache);
+}
+
 /******************************************************************************
  * Internal Functions
  *****************************************************************************/
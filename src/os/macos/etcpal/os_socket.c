@@ -31,6 +31,7 @@
 #include "etcpal/private/socket.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <stdlib.h>
 
 #include <arpa/inet.h>
@@ -45,6 +46,8 @@
 #include <unistd.h>
 
 #include "etcpal/common.h"
+#include "etcpal/netint.h"
+#include "etcpal/timer.h"
 #include "os_error.h"
 
 /**************************** Private constants ******************************/
@@ -52,6 +55,10 @@
 /* The maximum number of kevents that can be added in one call to an etcpal_poll API function. */
 #define ETCPAL_SOCKET_MAX_KEVENTS 3
 
+/* The number of addresses checked for an IPv4 address when looking up an interface in the netint
+ * cache. */
+#define ETCPAL_SOCKET_NETINT_LOOKUP_SIZE 4
+
 /****************************** Private types ********************************/
 
 /* A struct to track sockets being polled by the etcpal_poll() API */
@@ -61,8 +68,20 @@ typedef struct EtcPalPollSocket
   // shortcut
   etcpal_socket_t      sock;
   etcpal_poll_events_t events;
+  void*                user_data;
 } EtcPalPollSocket;
 
+/* A struct to track timers being polled by the etcpal_poll() API */
+typedef struct EtcPalPollTimer
+{
+  // 'id' must always remain as the first member in the struct to facilitate an EtcPalRbTree lookup
+  // shortcut
+  etcpal_poll_timer_t id;
+  uint32_t            interval_ms;
+  bool                rearm;  // Re-add as a periodic timer with interval_ms when the timer first expires
+  void*               user_data;
+} EtcPalPollTimer;
+
 typedef struct EtcPalOsEvents
 {
   struct kevent events[ETCPAL_SOCKET_MAX_KEVENTS];
@@ -142,17 +161,32 @@ static int  setsockopt_ip6(etcpal_socket_t id, int option_name, const void* opti
 // Helpers for etcpal_getsockopt()
 static int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, size_t* option_len);
 
+// Helpers for etcpal_join_groups() and etcpal_leave_groups()
+static int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name);
+
 // Helpers for etcpal_poll API
 static int                  events_etcpal_to_kqueue(etcpal_socket_t      socket,
                                                     etcpal_poll_events_t prev_events,
                                                     etcpal_poll_events_t new_events,
                                                     void*                user_data,
+                                                    uint16_t             add_flags,
                                                     EtcPalOsEvents*      events);
 static etcpal_poll_events_t events_kqueue_to_etcpal(const struct kevent* kevent, const EtcPalPollSocket* sock_desc);
 
 static int           poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b);
 static EtcPalRbNode* poll_socket_alloc(void);
 static void          poll_socket_free(EtcPalRbNode* node);
+static int           poll_timer_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b);
+
+static etcpal_error_t arm_poll_timer(EtcPalPollContext* context,
+                                     EtcPalPollTimer*   timer_desc,
+                                     uint32_t           timeout_ms,
+                                     uint32_t           interval_ms);
+static bool           fill_timer_event(EtcPalPollContext* context, const struct kevent* kevt, EtcPalPollEvent* event);
+static bool           fill_wakeup_event(EtcPalPollContext* context, EtcPalPollEvent* event);
+static etcpal_error_t init_poll_context(EtcPalPollContext* context, bool multithreaded);
+static uint16_t       socket_kqueue_flags(const EtcPalPollContext* context);
+static bool           fill_poll_event(EtcPalPollContext* context, const struct kevent* kevt, EtcPalPollEvent* event);
 
 // Helpers for etcpal_recvmsg()
 static void construct_msghdr(const EtcPalMsgHdr*      in_msg,
@@ -328,6 +362,16 @@ int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, s
   return -1;
 }
 
+int etcpal_join_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_JOIN_GROUP);
+}
+
+int etcpal_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_LEAVE_GROUP);
+}
+
 etcpal_error_t etcpal_listen(etcpal_socket_t id, int backlog)
 {
   if (id == ETCPAL_SOCKET_INVALID)
@@ -394,6 +438,42 @@ int etcpal_recvmsg(etcpal_socket_t id, EtcPalMsgHdr* msg, int flags)
   return res;
 }
 
+int etcpal_recvmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // No recvmmsg() here; wait for the first datagram as recvmsg() would, then take whatever else is
+  // already queued without blocking.
+  int os_flags = rcvmsg_flags_etcpal_to_os(flags);
+
+  size_t num_received = 0;
+  for (; num_received < num_msgs; ++num_received)
+  {
+    EtcPalMsgHdr* msg = &msgs[num_received].hdr;
+
+    struct msghdr           impl_msg  = {0};
+    struct sockaddr_storage impl_name = {0};
+    struct iovec            impl_buf  = {0};
+    construct_msghdr(msg, &impl_name, &impl_buf, &impl_msg);
+
+    ssize_t res = recvmsg(id, &impl_msg, (num_received == 0 ? os_flags : os_flags | MSG_DONTWAIT));
+    if (res < 0)
+    {
+      if (num_received > 0)
+        break;
+      return (int)errno_os_to_etcpal(errno);
+    }
+
+    msg->flags             = rcvmsg_flags_os_to_etcpal(impl_msg.msg_flags);
+    msgs[num_received].len = (size_t)res;
+    if (!sockaddr_os_to_etcpal((etcpal_os_sockaddr_t*)&impl_name, &msg->name))
+      return kEtcPalErrSys;
+  }
+
+  return (int)num_received;
+}
+
 bool etcpal_cmsg_firsthdr(EtcPalMsgHdr* msgh, EtcPalCMsgHdr* firsthdr)
 {
   bool result = false;
@@ -490,6 +570,40 @@ int etcpal_send(etcpal_socket_t id, const void* message, size_t length, int flag
   return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
 }
 
+int etcpal_sendmsg(etcpal_socket_t       id,
+                   const EtcPalIoVec*    iov,
+                   size_t                iovcnt,
+                   int                   flags,
+                   const EtcPalSockAddr* dest_addr)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !iov || iovcnt == 0 || iovcnt > ETCPAL_SENDMSG_MAX_IOV)
+    return (int)kEtcPalErrInvalid;
+
+  struct iovec impl_iov[ETCPAL_SENDMSG_MAX_IOV];
+  for (size_t i = 0; i < iovcnt; ++i)
+  {
+    impl_iov[i].iov_base = (void*)iov[i].base;
+    impl_iov[i].iov_len  = iov[i].len;
+  }
+
+  struct msghdr           impl_msg  = {0};
+  struct sockaddr_storage impl_name = {0};
+  if (dest_addr)
+  {
+    impl_msg.msg_namelen = (socklen_t)sockaddr_etcpal_to_os(dest_addr, (etcpal_os_sockaddr_t*)&impl_name);
+    if (impl_msg.msg_namelen == 0)
+      return (int)kEtcPalErrSys;
+    impl_msg.msg_name = &impl_name;
+  }
+  impl_msg.msg_iov    = impl_iov;
+  impl_msg.msg_iovlen = (int)iovcnt;
+
+  int res = (int)sendmsg(id, &impl_msg, 0);
+  return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
+}
+
 int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int flags, const EtcPalSockAddr* dest_addr)
 {
   ETCPAL_UNUSED_ARG(flags);
@@ -507,6 +621,41 @@ int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int fl
   return (res >= 0 ? res : (int)errno_os_to_etcpal(errno));
 }
 
+int etcpal_sendmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_sent = 0;
+  for (; num_sent < num_msgs; ++num_sent)
+  {
+    struct msghdr           impl_msg  = {0};
+    struct sockaddr_storage impl_name = {0};
+    struct iovec            impl_buf  = {0};
+    construct_msghdr(&msgs[num_sent].hdr, &impl_name, &impl_buf, &impl_msg);
+    impl_msg.msg_flags = 0;
+
+    // An invalid destination means the socket is connected.
+    socklen_t name_size =
+        (socklen_t)sockaddr_etcpal_to_os(&msgs[num_sent].hdr.name, (etcpal_os_sockaddr_t*)&impl_name);
+    impl_msg.msg_name    = (name_size > 0 ? &impl_name : NULL);
+    impl_msg.msg_namelen = name_size;
+
+    ssize_t res = sendmsg(id, &impl_msg, 0);
+    if (res < 0)
+    {
+      if (num_sent > 0)
+        break;
+      return (int)errno_os_to_etcpal(errno);
+    }
+    msgs[num_sent].len = (size_t)res;
+  }
+
+  return (int)num_sent;
+}
+
 etcpal_error_t etcpal_setsockopt(etcpal_socket_t id,
                                  int             level,
                                  int             option_name,
@@ -596,12 +745,31 @@ int setsockopt_socket(etcpal_socket_t id, int option_name, const void* option_va
 }
 
 /* On Darwin, MCAST_JOIN_GROUP/MCAST_LEAVE_GROUP APIs do not seem to be supported. So we need to
- * translate interface indexes to addresses for IPv4 MCAST_JOIN_GROUP sockopts. */
+ * translate interface indexes to addresses for IPv4 MCAST_JOIN_GROUP sockopts. The address comes
+ * from the netint cache if the netint module is initialized; otherwise it is queried with an
+ * ioctl, which costs several system calls. */
 static int ip4_ifindex_to_addr(unsigned int ifindex, struct in_addr* addr)
 {
   if (!ETCPAL_ASSERT_VERIFY(addr))
     return -1;
 
+  EtcPalNetintInfo netints[ETCPAL_SOCKET_NETINT_LOOKUP_SIZE];
+  size_t           num_netints = ETCPAL_SOCKET_NETINT_LOOKUP_SIZE;
+  etcpal_error_t   lookup_res  = etcpal_netint_get_interfaces_for_index(ifindex, netints, &num_netints);
+  if (lookup_res == kEtcPalErrOk || lookup_res == kEtcPalErrBufSize)
+  {
+    if (num_netints > ETCPAL_SOCKET_NETINT_LOOKUP_SIZE)
+      num_netints = ETCPAL_SOCKET_NETINT_LOOKUP_SIZE;
+    for (size_t i = 0; i < num_netints; ++i)
+    {
+      if (ETCPAL_IP_IS_V4(&netints[i].addr))
+      {
+        addr->s_addr = htonl(ETCPAL_IP_V4_ADDRESS(&netints[i].addr));
+        return 0;
+      }
+    }
+  }
+
   struct ifreq req = {{0}};
   if (if_indextoname(ifindex, req.ifr_name) != NULL)
   {
@@ -623,6 +791,60 @@ static int ip4_ifindex_to_addr(unsigned int ifindex, struct in_addr* addr)
   return -1;
 }
 
+/* Groups are usually joined many at a time on a handful of interfaces, so the address of the
+ * interface is only looked up again when the interface index changes from one group to the next. */
+int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !groups || num_groups == 0)
+    return (int)kEtcPalErrInvalid;
+
+  int            netint_index    = -1;
+  bool           netint_addr_ok  = false;
+  struct in_addr netint_addr     = {0};
+  int            ip4_option_name = (option_name == ETCPAL_MCAST_JOIN_GROUP) ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP;
+
+  size_t num_done = 0;
+  for (; num_done < num_groups; ++num_done)
+  {
+    const EtcPalGroupReq* greq = &groups[num_done];
+
+    int res = -1;
+    if (ETCPAL_IP_IS_V4(&greq->group) && greq->ifindex >= 0)
+    {
+      if (!netint_addr_ok || greq->ifindex != netint_index)
+      {
+        netint_index   = greq->ifindex;
+        netint_addr_ok = (0 == ip4_ifindex_to_addr((unsigned int)greq->ifindex, &netint_addr));
+      }
+
+      if (netint_addr_ok)
+      {
+        struct ip_mreq val       = {{0}};
+        val.imr_multiaddr.s_addr = htonl(ETCPAL_IP_V4_ADDRESS(&greq->group));
+        val.imr_interface        = netint_addr;
+        res                      = setsockopt(id, IPPROTO_IP, ip4_option_name, &val, sizeof val);
+      }
+    }
+    else if (ETCPAL_IP_IS_V6(&greq->group))
+    {
+      res = setsockopt_ip6(id, option_name, greq, sizeof(EtcPalGroupReq));
+    }
+    else
+    {
+      errno = EINVAL;
+    }
+
+    if (res != 0)
+    {
+      if (num_done > 0)
+        break;
+      return (int)errno_os_to_etcpal(errno);
+    }
+  }
+
+  return (int)num_done;
+}
+
 int setsockopt_ip(etcpal_socket_t id, int option_name, const void* option_value, size_t option_len)
 {
   if (!ETCPAL_ASSERT_VERIFY(id != ETCPAL_SOCKET_INVALID) || !ETCPAL_ASSERT_VERIFY(option_value))
@@ -689,10 +911,14 @@ int setsockopt_ip(etcpal_socket_t id, int option_name, const void* option_value,
     case ETCPAL_IP_MULTICAST_IF:
       if (option_len == sizeof(unsigned int))
       {
+#ifdef IP_MULTICAST_IFINDEX
+        return setsockopt(id, IPPROTO_IP, IP_MULTICAST_IFINDEX, option_value, (socklen_t)option_len);
+#else
         struct in_addr val = {0};
         if (0 != ip4_ifindex_to_addr(*(unsigned int*)option_value, &val))
           return -1;
         return setsockopt(id, IPPROTO_IP, IP_MULTICAST_IF, &val, sizeof val);
+#endif
       }
       break;
     case ETCPAL_IP_MULTICAST_TTL:
@@ -844,18 +1070,12 @@ etcpal_error_t etcpal_getblocking(etcpal_socket_t id, bool* blocking)
 
 etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
 {
-  if (!context)
-    return kEtcPalErrInvalid;
-
-  context->kq_fd = kqueue();
-  if (context->kq_fd >= 0)
-  {
-    etcpal_rbtree_init(&context->sockets, poll_socket_compare, poll_socket_alloc, poll_socket_free);
-    context->valid = true;
-    return kEtcPalErrOk;
-  }
+  return init_poll_context(context, false);
+}
 
-  return errno_os_to_etcpal(errno);
+etcpal_error_t etcpal_poll_context_init_multithreaded(EtcPalPollContext* context)
+{
+  return init_poll_context(context, true);
 }
 
 void etcpal_poll_context_deinit(EtcPalPollContext* context)
@@ -863,7 +1083,14 @@ void etcpal_poll_context_deinit(EtcPalPollContext* context)
   if (context && context->valid)
   {
     etcpal_rbtree_clear(&context->sockets);
+    etcpal_rbtree_clear(&context->timers);
+    if (context->wakeup_fds[0] >= 0)
+    {
+      close(context->wakeup_fds[0]);
+      close(context->wakeup_fds[1]);
+    }
     close(context->kq_fd);
+    etcpal_mutex_destroy(&context->lock);
     context->valid = false;
   }
 }
@@ -878,25 +1105,39 @@ etcpal_error_t etcpal_poll_add_socket(EtcPalPollContext*   context,
     EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)malloc(sizeof(EtcPalPollSocket));
     if (sock_desc)
     {
-      sock_desc->sock           = socket;
-      sock_desc->events         = events;
-      etcpal_error_t insert_res = etcpal_rbtree_insert(&context->sockets, sock_desc);
-      if (insert_res == kEtcPalErrOk)
-      {
-        EtcPalOsEvents os_events  = {{{0}}};
-        int            num_events = events_etcpal_to_kqueue(socket, 0, events, user_data, &os_events);
+      sock_desc->sock      = socket;
+      sock_desc->events    = events;
+      sock_desc->user_data = user_data;
 
-        int res = kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL);
-        if (res == 0)
-          return kEtcPalErrOk;
+      etcpal_error_t res = kEtcPalErrSys;
+      if (etcpal_mutex_lock(&context->lock))
+      {
+        res = etcpal_rbtree_insert(&context->sockets, sock_desc);
+        if (res == kEtcPalErrOk)
+        {
+          EtcPalOsEvents os_events  = {{{0}}};
+          int            num_events = events_etcpal_to_kqueue(socket, 0, events, user_data,
+                                                              socket_kqueue_flags(context), &os_events);
+          if (kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL) != 0)
+          {
+            res = errno_os_to_etcpal(errno);
+            // Our node dealloc function also deallocates sock_desc, so no need to free it here.
+            etcpal_rbtree_remove(&context->sockets, sock_desc);
+          }
+        }
+        else
+        {
+          free(sock_desc);
+        }
 
-        // Our node dealloc function also deallocates sock_desc, so no need to free it here.
-        etcpal_rbtree_remove(&context->sockets, sock_desc);
-        return errno_os_to_etcpal(errno);
+        etcpal_mutex_unlock(&context->lock);
+      }
+      else
+      {
+        free(sock_desc);
       }
 
-      free(sock_desc);
-      return insert_res;
+      return res;
     }
 
     return kEtcPalErrNoMem;
@@ -912,41 +1153,87 @@ etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
 {
   if (context && context->valid && socket != ETCPAL_SOCKET_INVALID && (new_events & ETCPAL_POLL_VALID_INPUT_EVENT_MASK))
   {
-    EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
-    if (sock_desc)
+    etcpal_error_t res = kEtcPalErrSys;
+    if (etcpal_mutex_lock(&context->lock))
     {
-      EtcPalOsEvents os_events = {{{0}}};
-      int num_events = events_etcpal_to_kqueue(socket, sock_desc->events, new_events, new_user_data, &os_events);
-
-      int res = kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL);
-      if (res == 0)
+      EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
+      if (sock_desc)
       {
-        sock_desc->events = new_events;
-        return kEtcPalErrOk;
+        EtcPalOsEvents os_events  = {{{0}}};
+        int            num_events = events_etcpal_to_kqueue(socket, sock_desc->events, new_events, new_user_data,
+                                                            socket_kqueue_flags(context), &os_events);
+        if (kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL) == 0)
+        {
+          sock_desc->events    = new_events;
+          sock_desc->user_data = new_user_data;
+          res                  = kEtcPalErrOk;
+        }
+        else
+        {
+          res = errno_os_to_etcpal(errno);
+        }
+      }
+      else
+      {
+        res = kEtcPalErrNotFound;
       }
 
-      return errno_os_to_etcpal(errno);
+      etcpal_mutex_unlock(&context->lock);
     }
 
-    return kEtcPalErrNotFound;
+    return res;
   }
 
   return kEtcPalErrInvalid;
 }
 
+etcpal_error_t etcpal_poll_rearm_socket(EtcPalPollContext* context, etcpal_socket_t socket)
+{
+  if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrInvalid;
+
+  // Sockets are only disarmed after an event on a multithreaded context.
+  if (!context->multithreaded)
+    return kEtcPalErrOk;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
+    if (sock_desc)
+    {
+      EtcPalOsEvents os_events  = {{{0}}};
+      int            num_events = events_etcpal_to_kqueue(socket, 0, sock_desc->events, sock_desc->user_data,
+                                                          socket_kqueue_flags(context), &os_events);
+      res = (kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL) == 0 ? kEtcPalErrOk
+                                                                                       : errno_os_to_etcpal(errno));
+    }
+    else
+    {
+      res = kEtcPalErrNotFound;
+    }
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+
+  return res;
+}
+
 void etcpal_poll_remove_socket(EtcPalPollContext* context, etcpal_socket_t socket)
 {
-  if (context && context->valid)
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
   {
     EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &socket);
     if (sock_desc)
     {
       EtcPalOsEvents os_events  = {{{0}}};
-      int            num_events = events_etcpal_to_kqueue(socket, sock_desc->events, 0, NULL, &os_events);
+      int            num_events = events_etcpal_to_kqueue(socket, sock_desc->events, 0, NULL, 0, &os_events);
 
       kevent(context->kq_fd, os_events.events, num_events, NULL, 0, NULL);
       etcpal_rbtree_remove(&context->sockets, sock_desc);
     }
+
+    etcpal_mutex_unlock(&context->lock);
   }
 }
 
@@ -954,69 +1241,387 @@ etcpal_error_t etcpal_poll_wait(EtcPalPollContext* context, EtcPalPollEvent* eve
 {
   if (context && context->valid && event)
   {
-    if (etcpal_rbtree_size(&context->sockets) > 0)
+    if (!etcpal_mutex_lock(&context->lock))
+      return kEtcPalErrSys;
+    bool have_sources = (etcpal_rbtree_size(&context->sockets) > 0 || etcpal_rbtree_size(&context->timers) > 0 ||
+                         context->wakeup_fds[0] >= 0);
+    etcpal_mutex_unlock(&context->lock);
+
+    if (have_sources)
     {
-      struct timespec  os_timeout = {0};
-      struct timespec* os_timeout_ptr;
-      if (timeout_ms == ETCPAL_WAIT_FOREVER)
-      {
-        os_timeout_ptr = NULL;
-      }
-      else
-      {
-        os_timeout.tv_sec  = timeout_ms / 1000;
-        os_timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
-        os_timeout_ptr     = &os_timeout;
-      }
+      EtcPalTimer timeout_timer;
+      if (timeout_ms != ETCPAL_WAIT_FOREVER)
+        etcpal_timer_start(&timeout_timer, (uint32_t)timeout_ms);
 
-      struct kevent kevt     = {0};
-      int           wait_res = kevent(context->kq_fd, NULL, 0, &kevt, 1, os_timeout_ptr);
-      if (wait_res > 0)
+      // A timer, wakeup or socket which was removed or reset after kqueue reported it is not
+      // reported. If that leaves nothing to report, wait again for the rest of the timeout.
+      while (true)
       {
-        etcpal_socket_t   sock      = (etcpal_socket_t)kevt.ident;
-        EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &sock);
-        if (ETCPAL_ASSERT_VERIFY(sock_desc))
+        struct timespec  os_timeout = {0};
+        struct timespec* os_timeout_ptr;
+        if (timeout_ms == ETCPAL_WAIT_FOREVER)
         {
-          event->socket    = sock_desc->sock;
-          event->events    = events_kqueue_to_etcpal(&kevt, sock_desc);
-          event->err       = kEtcPalErrOk;
-          event->user_data = kevt.udata;
-
-          // Check for errors
-          int       error;
-          socklen_t error_size = sizeof error;
-          if (getsockopt(sock_desc->sock, SOL_SOCKET, SO_ERROR, &error, &error_size) == 0)
-          {
-            if (error != 0)
-            {
-              event->events |= ETCPAL_POLL_ERR;
-              event->err = errno_os_to_etcpal(error);
-            }
-          }
+          os_timeout_ptr = NULL;
+        }
+        else
+        {
+          uint32_t remaining = etcpal_timer_remaining(&timeout_timer);
+          os_timeout.tv_sec  = remaining / 1000;
+          os_timeout.tv_nsec = (remaining % 1000) * 1000000;
+          os_timeout_ptr     = &os_timeout;
+        }
 
-          return kEtcPalErrOk;
+        struct kevent kevt     = {0};
+        int           wait_res = kevent(context->kq_fd, NULL, 0, &kevt, 1, os_timeout_ptr);
+        if (wait_res > 0)
+        {
+          if (!etcpal_mutex_lock(&context->lock))
+            return kEtcPalErrSys;
+          bool got_event = fill_poll_event(context, &kevt, event);
+          etcpal_mutex_unlock(&context->lock);
+
+          if (got_event)
+            return kEtcPalErrOk;
         }
+        else if (wait_res == 0)
+        {
+          return kEtcPalErrTimedOut;
+        }
+        else
+        {
+          return errno_os_to_etcpal(errno);
+        }
+      }
+    }
 
-        return kEtcPalErrSys;
+    return kEtcPalErrNoSockets;
+  }
+
+  return kEtcPalErrInvalid;
+}
+
+int etcpal_poll_wait_many(EtcPalPollContext* context, EtcPalPollEvent* events, size_t max_events, int timeout_ms)
+{
+  if (!events || max_events == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // The kqueue()-based implementation currently reports one event per call.
+  etcpal_error_t res = etcpal_poll_wait(context, events, timeout_ms);
+  return (res == kEtcPalErrOk ? 1 : (int)res);
+}
+
+etcpal_error_t etcpal_poll_add_timer(EtcPalPollContext*   context,
+                                     uint32_t             timeout_ms,
+                                     uint32_t             interval_ms,
+                                     void*                user_data,
+                                     etcpal_poll_timer_t* timer)
+{
+  if (!context || !context->valid || !timer)
+    return kEtcPalErrInvalid;
+
+  EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)malloc(sizeof(EtcPalPollTimer));
+  if (!timer_desc)
+    return kEtcPalErrNoMem;
+
+  if (!etcpal_mutex_lock(&context->lock))
+  {
+    free(timer_desc);
+    return kEtcPalErrSys;
+  }
+
+  // kqueue timers are identified by an arbitrary ident, which does not share a namespace with file
+  // descriptors since the filter is different.
+  timer_desc->id        = context->next_timer_id;
+  timer_desc->user_data = user_data;
+
+  etcpal_error_t res = etcpal_rbtree_insert(&context->timers, timer_desc);
+  if (res == kEtcPalErrOk)
+  {
+    res = arm_poll_timer(context, timer_desc, timeout_ms, interval_ms);
+    if (res == kEtcPalErrOk)
+    {
+      context->next_timer_id = (context->next_timer_id == INT_MAX ? 0 : context->next_timer_id + 1);
+      *timer                 = timer_desc->id;
+    }
+    else
+    {
+      // Our node dealloc function also deallocates timer_desc, so no need to free it here.
+      etcpal_rbtree_remove(&context->timers, timer_desc);
+    }
+  }
+  else
+  {
+    free(timer_desc);
+  }
+
+  etcpal_mutex_unlock(&context->lock);
+  return res;
+}
+
+etcpal_error_t etcpal_poll_reset_timer(EtcPalPollContext*  context,
+                                       etcpal_poll_timer_t timer,
+                                       uint32_t            timeout_ms,
+                                       uint32_t            interval_ms)
+{
+  if (!context || !context->valid || timer == ETCPAL_POLL_TIMER_INVALID)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)etcpal_rbtree_find(&context->timers, &timer);
+    if (timer_desc)
+      res = arm_poll_timer(context, timer_desc, timeout_ms, interval_ms);
+    else
+      res = kEtcPalErrNotFound;
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+
+  return res;
+}
+
+void etcpal_poll_remove_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer)
+{
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
+  {
+    EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)etcpal_rbtree_find(&context->timers, &timer);
+    if (timer_desc)
+    {
+      // This fails harmlessly if a one-shot timer has already expired and been deleted by kqueue.
+      struct kevent kevt;
+      EV_SET(&kevt, (uintptr_t)timer, EVFILT_TIMER, EV_DELETE, 0, 0, NULL);
+      kevent(context->kq_fd, &kevt, 1, NULL, 0, NULL);
+      etcpal_rbtree_remove(&context->timers, timer_desc);
+    }
+
+    etcpal_mutex_unlock(&context->lock);
+  }
+}
+
+etcpal_error_t etcpal_poll_add_wakeup(EtcPalPollContext* context, void* user_data)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+
+  if (!etcpal_mutex_lock(&context->lock))
+    return kEtcPalErrSys;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  if (context->wakeup_fds[0] >= 0)
+  {
+    res = kEtcPalErrExists;
+  }
+  else
+  {
+    // macOS has no eventfd, so a self-pipe is used instead.
+    int wakeup_fds[2];
+    if (pipe(wakeup_fds) == 0)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        fcntl(wakeup_fds[i], F_SETFL, fcntl(wakeup_fds[i], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(wakeup_fds[i], F_SETFD, FD_CLOEXEC);
+      }
+
+      struct kevent kevt;
+      EV_SET(&kevt, wakeup_fds[0], EVFILT_READ, EV_ADD, 0, 0, NULL);
+      if (kevent(context->kq_fd, &kevt, 1, NULL, 0, NULL) == 0)
+      {
+        context->wakeup_fds[0]    = wakeup_fds[0];
+        context->wakeup_fds[1]    = wakeup_fds[1];
+        context->wakeup_user_data = user_data;
       }
-      else if (wait_res == 0)
+      else
       {
-        return kEtcPalErrTimedOut;
+        res = errno_os_to_etcpal(errno);
+        close(wakeup_fds[0]);
+        close(wakeup_fds[1]);
       }
+    }
+    else
+    {
+      res = errno_os_to_etcpal(errno);
+    }
+  }
 
-      return errno_os_to_etcpal(errno);
+  etcpal_mutex_unlock(&context->lock);
+  return res;
+}
+
+etcpal_error_t etcpal_poll_wakeup(EtcPalPollContext* context)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+  if (context->wakeup_fds[1] < 0)
+    return kEtcPalErrNotFound;
+
+  // EAGAIN means the pipe is full, in which case a wakeup is already pending.
+  uint8_t byte = 0;
+  if (write(context->wakeup_fds[1], &byte, 1) < 0 && errno != EAGAIN)
+    return errno_os_to_etcpal(errno);
+  return kEtcPalErrOk;
+}
+
+void etcpal_poll_remove_wakeup(EtcPalPollContext* context)
+{
+  if (context && context->valid && etcpal_mutex_lock(&context->lock))
+  {
+    if (context->wakeup_fds[0] >= 0)
+    {
+      // Closing the read end of the pipe also removes it from the kqueue.
+      close(context->wakeup_fds[0]);
+      close(context->wakeup_fds[1]);
+      context->wakeup_fds[0]    = -1;
+      context->wakeup_fds[1]    = -1;
+      context->wakeup_user_data = NULL;
     }
 
-    return kEtcPalErrNoSockets;
+    etcpal_mutex_unlock(&context->lock);
   }
+}
 
-  return kEtcPalErrInvalid;
+etcpal_error_t init_poll_context(EtcPalPollContext* context, bool multithreaded)
+{
+  if (!context)
+    return kEtcPalErrInvalid;
+
+  if (!etcpal_mutex_create(&context->lock))
+    return kEtcPalErrSys;
+
+  context->kq_fd = kqueue();
+  if (context->kq_fd >= 0)
+  {
+    etcpal_rbtree_init(&context->sockets, poll_socket_compare, poll_socket_alloc, poll_socket_free);
+    etcpal_rbtree_init(&context->timers, poll_timer_compare, poll_socket_alloc, poll_socket_free);
+    context->multithreaded    = multithreaded;
+    context->next_timer_id    = 0;
+    context->wakeup_fds[0]    = -1;
+    context->wakeup_fds[1]    = -1;
+    context->wakeup_user_data = NULL;
+    context->valid            = true;
+    return kEtcPalErrOk;
+  }
+
+  etcpal_error_t res = errno_os_to_etcpal(errno);
+  etcpal_mutex_destroy(&context->lock);
+  return res;
+}
+
+uint16_t socket_kqueue_flags(const EtcPalPollContext* context)
+{
+  // EV_DISPATCH disables a socket's filter once an event on it has been reported to one thread, so
+  // that no other thread receives it until etcpal_poll_rearm_socket(). EV_ENABLE makes re-adding
+  // the filter in etcpal_poll_rearm_socket() or etcpal_poll_modify_socket() enable it again.
+  return (context->multithreaded ? (EV_DISPATCH | EV_ENABLE) : 0);
+}
+
+// Translate one kevent into an EtcPalPollEvent. Returns false if there is nothing to report.
+// Must be called with the context lock held.
+bool fill_poll_event(EtcPalPollContext* context, const struct kevent* kevt, EtcPalPollEvent* event)
+{
+  if (kevt->filter == EVFILT_TIMER)
+    return fill_timer_event(context, kevt, event);
+  if (context->wakeup_fds[0] >= 0 && (int)kevt->ident == context->wakeup_fds[0])
+    return fill_wakeup_event(context, event);
+
+  etcpal_socket_t   sock      = (etcpal_socket_t)kevt->ident;
+  EtcPalPollSocket* sock_desc = (EtcPalPollSocket*)etcpal_rbtree_find(&context->sockets, &sock);
+  if (!sock_desc)
+    return false;
+
+  event->socket    = sock_desc->sock;
+  event->events    = events_kqueue_to_etcpal(kevt, sock_desc);
+  event->err       = kEtcPalErrOk;
+  event->user_data = kevt->udata;
+  event->timer     = ETCPAL_POLL_TIMER_INVALID;
+
+  // Check for errors
+  int       error;
+  socklen_t error_size = sizeof error;
+  if (getsockopt(sock_desc->sock, SOL_SOCKET, SO_ERROR, &error, &error_size) == 0)
+  {
+    if (error != 0)
+    {
+      event->events |= ETCPAL_POLL_ERR;
+      event->err = errno_os_to_etcpal(error);
+    }
+  }
+
+  return true;
+}
+
+
+etcpal_error_t arm_poll_timer(EtcPalPollContext* context,
+                              EtcPalPollTimer*   timer_desc,
+                              uint32_t           timeout_ms,
+                              uint32_t           interval_ms)
+{
+  // EVFILT_TIMER only supports one period, so a timer whose first timeout differs from its interval
+  // is added as a one-shot and re-added as a periodic timer when it first expires.
+  uintptr_t     ident = (uintptr_t)timer_desc->id;
+  struct kevent kevt;
+  if (interval_ms != 0 && interval_ms == timeout_ms)
+    EV_SET(&kevt, ident, EVFILT_TIMER, EV_ADD | EV_ENABLE, 0, (intptr_t)interval_ms, NULL);
+  else
+    EV_SET(&kevt, ident, EVFILT_TIMER, EV_ADD | EV_ENABLE | EV_ONESHOT, 0, (intptr_t)timeout_ms, NULL);
+
+  if (kevent(context->kq_fd, &kevt, 1, NULL, 0, NULL) != 0)
+    return errno_os_to_etcpal(errno);
+
+  timer_desc->interval_ms = interval_ms;
+  timer_desc->rearm       = (interval_ms != 0 && interval_ms != timeout_ms);
+  return kEtcPalErrOk;
+}
+
+bool fill_timer_event(EtcPalPollContext* context, const struct kevent* kevt, EtcPalPollEvent* event)
+{
+  etcpal_poll_timer_t timer      = (etcpal_poll_timer_t)kevt->ident;
+  EtcPalPollTimer*    timer_desc = (EtcPalPollTimer*)etcpal_rbtree_find(&context->timers, &timer);
+  if (!timer_desc)
+    return false;
+
+  if (timer_desc->rearm)
+  {
+    struct kevent periodic;
+    EV_SET(&periodic, kevt->ident, EVFILT_TIMER, EV_ADD | EV_ENABLE, 0, (intptr_t)timer_desc->interval_ms, NULL);
+    if (kevent(context->kq_fd, &periodic, 1, NULL, 0, NULL) == 0)
+      timer_desc->rearm = false;
+  }
+
+  event->socket    = ETCPAL_SOCKET_INVALID;
+  event->events    = ETCPAL_POLL_TIMER;
+  event->err       = kEtcPalErrOk;
+  event->user_data = timer_desc->user_data;
+  event->timer     = timer;
+  return true;
+}
+
+bool fill_wakeup_event(EtcPalPollContext* context, EtcPalPollEvent* event)
+{
+  // Drain the pipe, so that all wakeups which happened before now are reported as one event.
+  uint8_t buf[64];
+  ssize_t read_res   = 0;
+  bool    got_wakeup = false;
+  while ((read_res = read(context->wakeup_fds[0], buf, sizeof buf)) > 0)
+    got_wakeup = true;
+
+  if (!got_wakeup)
+    return false;
+
+  event->socket    = ETCPAL_SOCKET_INVALID;
+  event->events    = ETCPAL_POLL_WAKEUP;
+  event->err       = kEtcPalErrOk;
+  event->user_data = context->wakeup_user_data;
+  event->timer     = ETCPAL_POLL_TIMER_INVALID;
+  return true;
 }
 
 int events_etcpal_to_kqueue(etcpal_socket_t      socket,
                             etcpal_poll_events_t prev_events,
                             etcpal_poll_events_t new_events,
                             void*                user_data,
+                            uint16_t             add_flags,
                             EtcPalOsEvents*      kevents)
 {
   if (!ETCPAL_ASSERT_VERIFY(socket != ETCPAL_SOCKET_INVALID) || !ETCPAL_ASSERT_VERIFY(kevents))
@@ -1030,7 +1635,7 @@ int events_etcpal_to_kqueue(etcpal_socket_t      socket,
     if (new_events & ETCPAL_POLL_IN)
     {
       // Re-add the socket even if it was already added before - user data might be modified.
-      EV_SET(&kevents->events[num_events], socket, EVFILT_READ, EV_ADD, 0, 0, user_data);
+      EV_SET(&kevents->events[num_events], socket, EVFILT_READ, EV_ADD | add_flags, 0, 0, user_data);
       ++num_events;
     }
     else if (prev_events & ETCPAL_POLL_IN)
@@ -1046,7 +1651,7 @@ int events_etcpal_to_kqueue(etcpal_socket_t      socket,
     if (new_events & (ETCPAL_POLL_OUT | ETCPAL_POLL_CONNECT))
     {
       // Re-add the socket even if it was already added before - user data might be modified.
-      EV_SET(&kevents->events[num_events], socket, EVFILT_WRITE, EV_ADD, 0, 0, user_data);
+      EV_SET(&kevents->events[num_events], socket, EVFILT_WRITE, EV_ADD | add_flags, 0, 0, user_data);
       ++num_events;
     }
     else if (prev_events & (ETCPAL_POLL_OUT | ETCPAL_POLL_CONNECT))
@@ -1065,7 +1670,7 @@ int events_etcpal_to_kqueue(etcpal_socket_t      socket,
     if (new_events & ETCPAL_POLL_OOB)
     {
       // Re-add the socket even if it was already added before - user data might be modified.
-      EV_SET(&kevents->events[num_events], socket, EVFILT_EXCEPT, EV_ADD, NOTE_OOB, 0, user_data);
+      EV_SET(&kevents->events[num_events], socket, EVFILT_EXCEPT, EV_ADD | add_flags, NOTE_OOB, 0, user_data);
       ++num_events;
     }
     else if (prev_events & ETCPAL_POLL_OOB)
@@ -1127,6 +1732,19 @@ int poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const voi
   return (a->sock > b->sock) - (a->sock < b->sock);
 }
 
+int poll_timer_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b)
+{
+  ETCPAL_UNUSED_ARG(tree);
+
+  if (!ETCPAL_ASSERT_VERIFY(value_a) || !ETCPAL_ASSERT_VERIFY(value_b))
+    return 0;
+
+  const EtcPalPollTimer* a = (const EtcPalPollTimer*)value_a;
+  const EtcPalPollTimer* b = (const EtcPalPollTimer*)value_b;
+
+  return (a->id > b->id) - (a->id < b->id);
+}
+
 EtcPalRbNode* poll_socket_alloc(void)
 {
   return (EtcPalRbNode*)malloc(sizeof(EtcPalRbNode));
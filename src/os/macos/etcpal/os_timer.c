@@ -31,12 +31,13 @@ static const double kMsWrapPoint = UINT32_MAX + 1.0;
 
 double ticks_to_ms = 0;
 
+static mach_timebase_info_data_t timebase_info;
+
 etcpal_error_t etcpal_timer_init(void)
 {
-  mach_timebase_info_data_t timebase;
-  mach_timebase_info(&timebase);
+  mach_timebase_info(&timebase_info);
 
-  ticks_to_ms = (((double)timebase.numer) / (((double)timebase.denom) * ((double)1000000)));
+  ticks_to_ms = (((double)timebase_info.numer) / (((double)timebase_info.denom) * ((double)1000000)));
   return kEtcPalErrOk;
 }
 
@@ -51,4 +52,19 @@ uint32_t etcpal_getms(void)
   return ((uint32_t)fmod(ticks * ticks_to_ms, kMsWrapPoint));  // Placate UBSAN by using mod to wrap if needed
 }
 
+uint64_t etcpal_getns(void)
+{
+  uint64_t ticks = mach_absolute_time();
+
+  // Split the conversion to avoid overflowing the intermediate product.
+  return (ticks / timebase_info.denom) * timebase_info.numer +
+         (ticks % timebase_info.denom) * timebase_info.numer / timebase_info.denom;
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+  // mach_absolute_time() is already read from user space without a system call.
+  return etcpal_getns();
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
@@ -42,4 +42,16 @@ uint32_t etcpal_getms(void)
   return (ts.SECONDS * 1000 + ts.MILLISECONDS);
 }
 
+uint64_t etcpal_getns(void)
+{
+  TIME_STRUCT ts;
+  _time_get_elapsed(&ts);
+  return ((uint64_t)ts.SECONDS * 1000000000u + (uint64_t)ts.MILLISECONDS * 1000000u);
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+  return etcpal_getns();
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
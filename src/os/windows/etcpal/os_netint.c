@@ -166,6 +166,20 @@ bool os_netint_is_up(unsigned int index, const CachedNetintInfo* cache)
   return false;
 }
 
+etcpal_error_t os_netint_start_monitor(void)
+{
+  return kEtcPalErrNotImpl;
+}
+
+void os_netint_stop_monitor(void)
+{
+}
+
+void os_netint_update_routes(CachedNetintInfo* cache)
+{
+  ETCPAL_UNUSED_ARG(cache);
+}
+
 IP_ADAPTER_ADDRESSES* get_windows_adapters()
 {
   ULONG flags = GAA_FLAG_SKIP_ANYCAST | GAA_FLAG_SKIP_MULTICAST | GAA_FLAG_SKIP_DNS_SERVER;
@@ -19,6 +19,7 @@
 
 #include "etcpal/socket.h"
 
+#include <limits.h>
 #include <string.h>
 #include <stdlib.h>
 #include <WinSock2.h>
@@ -29,12 +30,17 @@
 #include "etcpal/common.h"
 #include "etcpal/private/common.h"
 #include "etcpal/private/socket.h"
+#include "etcpal/thread.h"
+#include "etcpal/timer.h"
 #include "os_error.h"
 
 /*************************** Private constants *******************************/
 
 #define POLL_CONTEXT_ARR_CHUNK_SIZE 10
 
+// How long etcpal_poll_wait() sleeps at a time when a context has only disarmed timers to wait on.
+#define POLL_IDLE_SLEEP_MS 1000
+
 /****************************** Private types ********************************/
 
 /* A struct to track sockets being polled by the etcpal_poll() API */
@@ -47,6 +53,19 @@ typedef struct EtcPalPollSocket
   void*                user_data;
 } EtcPalPollSocket;
 
+/* A struct to track timers being polled by the etcpal_poll() API. select() knows nothing about
+ * timers, so the time until the next expiration is used to bound the select() timeout. */
+typedef struct EtcPalPollTimer
+{
+  // 'id' must always remain as the first member in the struct to facilitate an EtcPalRbTree lookup
+  // shortcut
+  etcpal_poll_timer_t id;
+  bool                armed;
+  uint32_t            expiry_ms;  // The etcpal_getms() time at which the timer next expires.
+  uint32_t            interval_ms;
+  void*               user_data;
+} EtcPalPollTimer;
+
 /***************************** Private macros ********************************/
 
 #define ETCPAL_FD_ZERO(setptr)      \
@@ -146,6 +165,9 @@ static int setsockopt_ip6(etcpal_socket_t id, int option_name, const void* optio
 // Helpers for etcpal_getsockopt()
 static int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, size_t* option_len);
 
+// Helpers for etcpal_join_groups() and etcpal_leave_groups()
+static int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name);
+
 // Helper functions for the etcpal_poll API
 static void           set_in_fd_sets(EtcPalPollContext* context, const EtcPalPollSocket* sock);
 static void           clear_in_fd_sets(EtcPalPollContext* context, const EtcPalPollSocket* sock);
@@ -155,7 +177,15 @@ static etcpal_error_t handle_select_result(EtcPalPollContext*     context,
                                            const EtcPalPollFdSet* writefds,
                                            const EtcPalPollFdSet* exceptfds);
 
+static void           start_poll_timer(EtcPalPollTimer* timer, uint32_t timeout_ms, uint32_t interval_ms);
+static bool           get_expired_timer(EtcPalPollContext* context, EtcPalPollEvent* event);
+static int            get_next_timer_timeout(EtcPalPollContext* context);
+static etcpal_error_t create_wakeup_sockets(EtcPalPollContext* context);
+static void           close_wakeup_sockets(EtcPalPollContext* context);
+static void           handle_wakeup(EtcPalPollContext* context, EtcPalPollEvent* event);
+
 static int           poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b);
+static int           poll_timer_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b);
 static EtcPalRbNode* poll_socket_alloc(void);
 static void          poll_socket_free(EtcPalRbNode* node);
 
@@ -355,6 +385,39 @@ int getsockopt_socket(etcpal_socket_t id, int option_name, void* option_value, s
   return -1;
 }
 
+int etcpal_join_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_JOIN_GROUP);
+}
+
+int etcpal_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups)
+{
+  return join_leave_groups(id, groups, num_groups, ETCPAL_MCAST_LEAVE_GROUP);
+}
+
+int join_leave_groups(etcpal_socket_t id, const EtcPalGroupReq* groups, size_t num_groups, int option_name)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !groups || num_groups == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_done = 0;
+  for (; num_done < num_groups; ++num_done)
+  {
+    const EtcPalGroupReq* greq  = &groups[num_done];
+    int                   level = ETCPAL_IP_IS_V6(&greq->group) ? ETCPAL_IPPROTO_IPV6 : ETCPAL_IPPROTO_IP;
+
+    etcpal_error_t res = etcpal_setsockopt(id, level, option_name, greq, sizeof(EtcPalGroupReq));
+    if (res != kEtcPalErrOk)
+    {
+      if (num_done > 0)
+        break;
+      return (int)res;
+    }
+  }
+
+  return (int)num_done;
+}
+
 etcpal_error_t etcpal_listen(etcpal_socket_t id, int backlog)
 {
   if (id == ETCPAL_SOCKET_INVALID)
@@ -435,6 +498,20 @@ int etcpal_recvmsg(etcpal_socket_t id, EtcPalMsgHdr* msg, int flags)
   return (int)num_bytes_received;
 }
 
+int etcpal_recvmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // No batch receive on this platform; receive one datagram per call.
+  int res = etcpal_recvmsg(id, &msgs[0].hdr, flags);
+  if (res < 0)
+    return res;
+
+  msgs[0].len = (size_t)res;
+  return 1;
+}
+
 bool etcpal_cmsg_firsthdr(EtcPalMsgHdr* msgh, EtcPalCMsgHdr* firsthdr)
 {
   bool result = false;
@@ -531,6 +608,40 @@ int etcpal_send(etcpal_socket_t id, const void* message, size_t length, int flag
   return (res >= 0 ? res : (int)err_winsock_to_etcpal(WSAGetLastError()));
 }
 
+int etcpal_sendmsg(etcpal_socket_t       id,
+                   const EtcPalIoVec*    iov,
+                   size_t                iovcnt,
+                   int                   flags,
+                   const EtcPalSockAddr* dest_addr)
+{
+  ETCPAL_UNUSED_ARG(flags);
+
+  if ((id == ETCPAL_SOCKET_INVALID) || !iov || iovcnt == 0 || iovcnt > ETCPAL_SENDMSG_MAX_IOV)
+    return (int)kEtcPalErrInvalid;
+
+  WSABUF impl_bufs[ETCPAL_SENDMSG_MAX_IOV];
+  for (size_t i = 0; i < iovcnt; ++i)
+  {
+    impl_bufs[i].buf = (CHAR*)iov[i].base;
+    impl_bufs[i].len = (ULONG)iov[i].len;
+  }
+
+  struct sockaddr_storage ss      = {0};
+  int                     ss_size = 0;
+  if (dest_addr)
+  {
+    ss_size = (int)sockaddr_etcpal_to_os(dest_addr, (etcpal_os_sockaddr_t*)&ss);
+    if (ss_size == 0)
+      return (int)kEtcPalErrSys;
+  }
+
+  DWORD bytes_sent = 0;
+  int   res        = WSASendTo(id, impl_bufs, (DWORD)iovcnt, &bytes_sent, 0, (dest_addr ? (struct sockaddr*)&ss : NULL),
+                               ss_size, NULL, NULL);
+
+  return (res == 0 ? (int)bytes_sent : (int)err_winsock_to_etcpal(WSAGetLastError()));
+}
+
 int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int flags, const EtcPalSockAddr* dest_addr)
 {
   ETCPAL_UNUSED_ARG(flags);
@@ -548,6 +659,31 @@ int etcpal_sendto(etcpal_socket_t id, const void* message, size_t length, int fl
   return (res >= 0 ? res : (int)err_winsock_to_etcpal(WSAGetLastError()));
 }
 
+int etcpal_sendmmsg(etcpal_socket_t id, EtcPalMMsgHdr* msgs, size_t num_msgs, int flags)
+{
+  if ((id == ETCPAL_SOCKET_INVALID) || !msgs || num_msgs == 0)
+    return (int)kEtcPalErrInvalid;
+
+  size_t num_sent = 0;
+  for (; num_sent < num_msgs; ++num_sent)
+  {
+    const EtcPalMsgHdr* msg = &msgs[num_sent].hdr;
+
+    // An invalid destination means the socket is connected.
+    int res = ETCPAL_IP_IS_INVALID(&msg->name.ip) ? etcpal_send(id, msg->buf, msg->buflen, flags)
+                                                  : etcpal_sendto(id, msg->buf, msg->buflen, flags, &msg->name);
+    if (res < 0)
+    {
+      if (num_sent > 0)
+        break;
+      return res;
+    }
+    msgs[num_sent].len = (size_t)res;
+  }
+
+  return (int)num_sent;
+}
+
 etcpal_error_t etcpal_setsockopt(etcpal_socket_t id,
                                  int             level,
                                  int             option_name,
@@ -903,6 +1039,11 @@ etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
     return kEtcPalErrSys;
 
   etcpal_rbtree_init(&context->sockets, poll_socket_compare, poll_socket_alloc, poll_socket_free);
+  etcpal_rbtree_init(&context->timers, poll_timer_compare, poll_socket_alloc, poll_socket_free);
+  context->next_timer_id    = 0;
+  context->wakeup_recv_sock = ETCPAL_SOCKET_INVALID;
+  context->wakeup_send_sock = ETCPAL_SOCKET_INVALID;
+  context->wakeup_user_data = NULL;
   ETCPAL_FD_ZERO(&context->readfds);
   ETCPAL_FD_ZERO(&context->writefds);
   ETCPAL_FD_ZERO(&context->exceptfds);
@@ -910,12 +1051,21 @@ etcpal_error_t etcpal_poll_context_init(EtcPalPollContext* context)
   return kEtcPalErrOk;
 }
 
+etcpal_error_t etcpal_poll_context_init_multithreaded(EtcPalPollContext* context)
+{
+  // select() cannot hand an event on a socket to only one of several waiting threads.
+  ETCPAL_UNUSED_ARG(context);
+  return kEtcPalErrNotImpl;
+}
+
 void etcpal_poll_context_deinit(EtcPalPollContext* context)
 {
   if (!context || !context->valid)
     return;
 
   etcpal_rbtree_clear(&context->sockets);
+  etcpal_rbtree_clear(&context->timers);
+  close_wakeup_sockets(context);
   etcpal_mutex_destroy(&context->lock);
   context->valid = false;
 }
@@ -971,7 +1121,12 @@ etcpal_error_t etcpal_poll_add_socket(EtcPalPollContext*   context,
   etcpal_error_t res = kEtcPalErrSys;
   if (etcpal_mutex_lock(&context->lock))
   {
-    if (etcpal_rbtree_size(&context->sockets) >= ETCPAL_SOCKET_MAX_POLL_SIZE)
+    // The wakeup socket takes up one of the fd_set slots.
+    size_t max_sockets = ETCPAL_SOCKET_MAX_POLL_SIZE;
+    if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+      --max_sockets;
+
+    if (etcpal_rbtree_size(&context->sockets) >= max_sockets)
     {
       res = kEtcPalErrNoMem;
     }
@@ -1039,6 +1194,15 @@ etcpal_error_t etcpal_poll_modify_socket(EtcPalPollContext*   context,
   return res;
 }
 
+etcpal_error_t etcpal_poll_rearm_socket(EtcPalPollContext* context, etcpal_socket_t socket)
+{
+  if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrInvalid;
+
+  // Multithreaded contexts are not supported, so sockets are never disarmed.
+  return kEtcPalErrOk;
+}
+
 void etcpal_poll_remove_socket(EtcPalPollContext* context, etcpal_socket_t socket)
 {
   if (!context || !context->valid || socket == ETCPAL_SOCKET_INVALID)
@@ -1062,58 +1226,252 @@ etcpal_error_t etcpal_poll_wait(EtcPalPollContext* context, EtcPalPollEvent* eve
   if (!context || !context->valid || !event)
     return kEtcPalErrInvalid;
 
-  // Get the sets of sockets that we will select on.
-  EtcPalPollFdSet readfds = {0};
-  ETCPAL_FD_ZERO(&readfds);
-  EtcPalPollFdSet writefds = {0};
-  ETCPAL_FD_ZERO(&writefds);
-  EtcPalPollFdSet exceptfds = {0};
-  ETCPAL_FD_ZERO(&exceptfds);
+  EtcPalTimer timeout_timer;
+  if (timeout_ms != ETCPAL_WAIT_FOREVER)
+    etcpal_timer_start(&timeout_timer, (uint32_t)timeout_ms);
+
+  // select() knows nothing about timers, so its timeout is bounded by the next timer expiration. If
+  // that comes before the caller's timeout, go around again to report the timer.
+  for (bool first_pass = true;; first_pass = false)
+  {
+    // Get the sets of sockets that we will select on.
+    EtcPalPollFdSet readfds = {0};
+    ETCPAL_FD_ZERO(&readfds);
+    EtcPalPollFdSet writefds = {0};
+    ETCPAL_FD_ZERO(&writefds);
+    EtcPalPollFdSet exceptfds = {0};
+    ETCPAL_FD_ZERO(&exceptfds);
+    bool have_timers      = false;
+    int  timer_timeout_ms = ETCPAL_WAIT_FOREVER;
+    if (etcpal_mutex_lock(&context->lock))
+    {
+      if (get_expired_timer(context, event))
+      {
+        etcpal_mutex_unlock(&context->lock);
+        return kEtcPalErrOk;
+      }
+
+      have_timers      = (etcpal_rbtree_size(&context->timers) > 0);
+      timer_timeout_ms = get_next_timer_timeout(context);
+      if (etcpal_rbtree_size(&context->sockets) > 0)
+      {
+        readfds   = context->readfds;
+        writefds  = context->writefds;
+        exceptfds = context->exceptfds;
+      }
+      if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+      {
+        ETCPAL_FD_SET(context->wakeup_recv_sock, &readfds);
+      }
+      etcpal_mutex_unlock(&context->lock);
+    }
+
+    bool have_fds = (readfds.count || writefds.count || exceptfds.count);
+
+    // No valid sockets, timers or wakeups are currently added to the context.
+    if (!have_fds && !have_timers)
+      return kEtcPalErrNoSockets;
+
+    if (!first_pass && timeout_ms != ETCPAL_WAIT_FOREVER && etcpal_timer_is_expired(&timeout_timer))
+      return kEtcPalErrTimedOut;
+
+    int wait_ms = timer_timeout_ms;
+    if (timeout_ms != ETCPAL_WAIT_FOREVER)
+    {
+      int remaining_ms = (int)etcpal_timer_remaining(&timeout_timer);
+      if (wait_ms == ETCPAL_WAIT_FOREVER || remaining_ms < wait_ms)
+        wait_ms = remaining_ms;
+    }
+
+    if (!have_fds)
+    {
+      // Winsock's select() fails with empty sets, so a context with only timers sleeps instead.
+      etcpal_thread_sleep(wait_ms == ETCPAL_WAIT_FOREVER ? POLL_IDLE_SLEEP_MS : (unsigned int)wait_ms);
+      continue;
+    }
+
+    struct timeval os_timeout = {0};
+    if (wait_ms != ETCPAL_WAIT_FOREVER)
+    {
+      os_timeout.tv_sec  = wait_ms / 1000;
+      os_timeout.tv_usec = (wait_ms % 1000) * 1000;
+    }
+
+    int sel_res = select(0, readfds.count ? &readfds.set : NULL, writefds.count ? &writefds.set : NULL,
+                         exceptfds.count ? &exceptfds.set : NULL, wait_ms == ETCPAL_WAIT_FOREVER ? NULL : &os_timeout);
+
+    if (sel_res < 0)
+      return err_winsock_to_etcpal(WSAGetLastError());
+
+    if (sel_res > 0)
+    {
+      etcpal_error_t res = kEtcPalErrSys;
+      if (context->valid && etcpal_mutex_lock(&context->lock))
+      {
+        if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID &&
+            ETCPAL_FD_ISSET(context->wakeup_recv_sock, &readfds))
+        {
+          handle_wakeup(context, event);
+          res = kEtcPalErrOk;
+        }
+        else
+        {
+          res = handle_select_result(context, event, &readfds, &writefds, &exceptfds);
+        }
+        etcpal_mutex_unlock(&context->lock);
+      }
+
+      return res;
+    }
+  }
+}
+
+int etcpal_poll_wait_many(EtcPalPollContext* context, EtcPalPollEvent* events, size_t max_events, int timeout_ms)
+{
+  if (!events || max_events == 0)
+    return (int)kEtcPalErrInvalid;
+
+  // The select()-based implementation only reports one event per call.
+  etcpal_error_t res = etcpal_poll_wait(context, events, timeout_ms);
+  return (res == kEtcPalErrOk ? 1 : (int)res);
+}
+
+etcpal_error_t etcpal_poll_add_timer(EtcPalPollContext*   context,
+                                     uint32_t             timeout_ms,
+                                     uint32_t             interval_ms,
+                                     void*                user_data,
+                                     etcpal_poll_timer_t* timer)
+{
+  if (!context || !context->valid || !timer)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = kEtcPalErrSys;
   if (etcpal_mutex_lock(&context->lock))
   {
-    if (etcpal_rbtree_size(&context->sockets) > 0)
+    EtcPalPollTimer* new_timer = (EtcPalPollTimer*)malloc(sizeof(EtcPalPollTimer));
+    if (new_timer)
+    {
+      new_timer->id          = context->next_timer_id;
+      new_timer->user_data   = user_data;
+      context->next_timer_id = (context->next_timer_id == INT_MAX ? 0 : context->next_timer_id + 1);
+      start_poll_timer(new_timer, timeout_ms, interval_ms);
+
+      res = etcpal_rbtree_insert(&context->timers, new_timer);
+      if (res == kEtcPalErrOk)
+        *timer = new_timer->id;
+      else
+        free(new_timer);
+    }
+    else
     {
-      readfds   = context->readfds;
-      writefds  = context->writefds;
-      exceptfds = context->exceptfds;
+      res = kEtcPalErrNoMem;
     }
+
     etcpal_mutex_unlock(&context->lock);
   }
 
-  // No valid sockets are currently added to the context.
-  if (!readfds.count && !writefds.count && !exceptfds.count)
-    return kEtcPalErrNoSockets;
+  return res;
+}
 
-  struct timeval os_timeout = {0};
-  if (timeout_ms == 0)
+etcpal_error_t etcpal_poll_reset_timer(EtcPalPollContext*  context,
+                                       etcpal_poll_timer_t timer,
+                                       uint32_t            timeout_ms,
+                                       uint32_t            interval_ms)
+{
+  if (!context || !context->valid || timer == ETCPAL_POLL_TIMER_INVALID)
+    return kEtcPalErrInvalid;
+
+  etcpal_error_t res = kEtcPalErrSys;
+  if (etcpal_mutex_lock(&context->lock))
   {
-    os_timeout.tv_sec  = 0;
-    os_timeout.tv_usec = 0;
+    EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)etcpal_rbtree_find(&context->timers, &timer);
+    if (timer_desc)
+    {
+      start_poll_timer(timer_desc, timeout_ms, interval_ms);
+      res = kEtcPalErrOk;
+    }
+    else
+    {
+      res = kEtcPalErrNotFound;
+    }
+
+    etcpal_mutex_unlock(&context->lock);
   }
-  else if (timeout_ms != ETCPAL_WAIT_FOREVER)
+
+  return res;
+}
+
+void etcpal_poll_remove_timer(EtcPalPollContext* context, etcpal_poll_timer_t timer)
+{
+  if (!context || !context->valid || timer == ETCPAL_POLL_TIMER_INVALID)
+    return;
+
+  if (etcpal_mutex_lock(&context->lock))
   {
-    os_timeout.tv_sec  = timeout_ms / 1000;
-    os_timeout.tv_usec = (timeout_ms % 1000) * 1000;
+    etcpal_rbtree_remove(&context->timers, &timer);
+    etcpal_mutex_unlock(&context->lock);
   }
+}
 
-  int sel_res = select(0, readfds.count ? &readfds.set : NULL, writefds.count ? &writefds.set : NULL,
-                       exceptfds.count ? &exceptfds.set : NULL, timeout_ms == ETCPAL_WAIT_FOREVER ? NULL : &os_timeout);
-
-  if (sel_res < 0)
-    return err_winsock_to_etcpal(WSAGetLastError());
-  if (sel_res == 0)
-    return kEtcPalErrTimedOut;
+etcpal_error_t etcpal_poll_add_wakeup(EtcPalPollContext* context, void* user_data)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
 
   etcpal_error_t res = kEtcPalErrSys;
-  if (context->valid && etcpal_mutex_lock(&context->lock))
+  if (etcpal_mutex_lock(&context->lock))
   {
-    res = handle_select_result(context, event, &readfds, &writefds, &exceptfds);
+    if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+    {
+      res = kEtcPalErrExists;
+    }
+    else if (etcpal_rbtree_size(&context->sockets) >= ETCPAL_SOCKET_MAX_POLL_SIZE)
+    {
+      // The wakeup socket needs a slot in the read fd_set.
+      res = kEtcPalErrNoMem;
+    }
+    else
+    {
+      res = create_wakeup_sockets(context);
+      if (res == kEtcPalErrOk)
+        context->wakeup_user_data = user_data;
+    }
+
     etcpal_mutex_unlock(&context->lock);
   }
 
   return res;
 }
 
+etcpal_error_t etcpal_poll_wakeup(EtcPalPollContext* context)
+{
+  if (!context || !context->valid)
+    return kEtcPalErrInvalid;
+  if (context->wakeup_send_sock == ETCPAL_SOCKET_INVALID)
+    return kEtcPalErrNotFound;
+
+  // All datagrams queued before the waiting thread gets to them are drained at once, so they are
+  // reported as one event. kEtcPalErrWouldBlock means the socket buffer is full, in which case a
+  // wakeup is already pending.
+  const uint8_t wakeup_byte = 0;
+  int           send_res    = etcpal_send(context->wakeup_send_sock, &wakeup_byte, 1, 0);
+  if (send_res < 0 && send_res != (int)kEtcPalErrWouldBlock)
+    return (etcpal_error_t)send_res;
+  return kEtcPalErrOk;
+}
+
+void etcpal_poll_remove_wakeup(EtcPalPollContext* context)
+{
+  if (!context || !context->valid)
+    return;
+
+  if (etcpal_mutex_lock(&context->lock))
+  {
+    close_wakeup_sockets(context);
+    etcpal_mutex_unlock(&context->lock);
+  }
+}
+
 etcpal_error_t handle_select_result(EtcPalPollContext*     context,
                                     EtcPalPollEvent*       event,
                                     const EtcPalPollFdSet* readfds,
@@ -1149,6 +1507,7 @@ etcpal_error_t handle_select_result(EtcPalPollContext*     context,
       res              = kEtcPalErrOk;
       event->socket    = sock_desc->sock;
       event->user_data = sock_desc->user_data;
+      event->timer     = ETCPAL_POLL_TIMER_INVALID;
 
       /* Check for errors */
       int error      = 0;
@@ -1192,6 +1551,167 @@ etcpal_error_t handle_select_result(EtcPalPollContext*     context,
   return res;
 }
 
+void start_poll_timer(EtcPalPollTimer* timer, uint32_t timeout_ms, uint32_t interval_ms)
+{
+  if (!ETCPAL_ASSERT_VERIFY(timer))
+    return;
+
+  timer->armed       = true;
+  timer->expiry_ms   = etcpal_getms() + timeout_ms;
+  timer->interval_ms = interval_ms;
+}
+
+// Fill in an event for the first expired timer in the context, if there is one.
+bool get_expired_timer(EtcPalPollContext* context, EtcPalPollEvent* event)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context) || !ETCPAL_ASSERT_VERIFY(event))
+    return false;
+
+  uint32_t now = etcpal_getms();
+
+  EtcPalRbIter iter;
+  etcpal_rbiter_init(&iter);
+  for (EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)etcpal_rbiter_first(&iter, &context->timers); timer_desc;
+       timer_desc                  = (EtcPalPollTimer*)etcpal_rbiter_next(&iter))
+  {
+    if (timer_desc->armed && (int32_t)(now - timer_desc->expiry_ms) >= 0)
+    {
+      // A periodic timer which expired more than once since it was last reported is reported once.
+      if (timer_desc->interval_ms == 0)
+      {
+        timer_desc->armed = false;
+      }
+      else
+      {
+        do
+        {
+          timer_desc->expiry_ms += timer_desc->interval_ms;
+        } while ((int32_t)(now - timer_desc->expiry_ms) >= 0);
+      }
+
+      event->socket    = ETCPAL_SOCKET_INVALID;
+      event->events    = ETCPAL_POLL_TIMER;
+      event->err       = kEtcPalErrOk;
+      event->user_data = timer_desc->user_data;
+      event->timer     = timer_desc->id;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Get the time in milliseconds until the next timer in the context expires, or
+// ETCPAL_WAIT_FOREVER if no timers are armed.
+int get_next_timer_timeout(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return ETCPAL_WAIT_FOREVER;
+
+  uint32_t now = etcpal_getms();
+  int      res = ETCPAL_WAIT_FOREVER;
+
+  EtcPalRbIter iter;
+  etcpal_rbiter_init(&iter);
+  for (EtcPalPollTimer* timer_desc = (EtcPalPollTimer*)etcpal_rbiter_first(&iter, &context->timers); timer_desc;
+       timer_desc                  = (EtcPalPollTimer*)etcpal_rbiter_next(&iter))
+  {
+    if (timer_desc->armed)
+    {
+      int32_t remaining = (int32_t)(timer_desc->expiry_ms - now);
+      if (remaining < 0)
+        remaining = 0;
+      if (res == ETCPAL_WAIT_FOREVER || remaining < res)
+        res = (int)remaining;
+    }
+  }
+
+  return res;
+}
+
+// Create a pair of loopback UDP sockets. A datagram sent on the send socket makes the receive socket
+// readable, which wakes up select(). Each socket is connected to the other, so that the receive
+// socket ignores datagrams from anywhere else.
+etcpal_error_t create_wakeup_sockets(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return kEtcPalErrSys;
+
+  etcpal_socket_t recv_sock = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t send_sock = ETCPAL_SOCKET_INVALID;
+
+  EtcPalSockAddr recv_addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&recv_addr.ip, 0x7f000001u);
+  recv_addr.port = 0;
+  EtcPalSockAddr send_addr;
+
+  etcpal_error_t res = etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_sock);
+  if (res == kEtcPalErrOk)
+    res = etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock);
+  if (res == kEtcPalErrOk)
+    res = etcpal_bind(recv_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_getsockname(recv_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_connect(send_sock, &recv_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_getsockname(send_sock, &send_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_connect(recv_sock, &send_addr);
+  if (res == kEtcPalErrOk)
+    res = etcpal_setblocking(recv_sock, false);
+  if (res == kEtcPalErrOk)
+    res = etcpal_setblocking(send_sock, false);
+
+  if (res != kEtcPalErrOk)
+  {
+    if (recv_sock != ETCPAL_SOCKET_INVALID)
+      etcpal_close(recv_sock);
+    if (send_sock != ETCPAL_SOCKET_INVALID)
+      etcpal_close(send_sock);
+    return res;
+  }
+
+  context->wakeup_recv_sock = recv_sock;
+  context->wakeup_send_sock = send_sock;
+  return kEtcPalErrOk;
+}
+
+void close_wakeup_sockets(EtcPalPollContext* context)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context))
+    return;
+
+  if (context->wakeup_recv_sock != ETCPAL_SOCKET_INVALID)
+  {
+    etcpal_close(context->wakeup_recv_sock);
+    etcpal_close(context->wakeup_send_sock);
+    context->wakeup_recv_sock = ETCPAL_SOCKET_INVALID;
+    context->wakeup_send_sock = ETCPAL_SOCKET_INVALID;
+    context->wakeup_user_data = NULL;
+  }
+}
+
+// Drain all pending wakeup datagrams and fill in the wakeup event.
+void handle_wakeup(EtcPalPollContext* context, EtcPalPollEvent* event)
+{
+  if (!ETCPAL_ASSERT_VERIFY(context) || !ETCPAL_ASSERT_VERIFY(event))
+    return;
+
+  uint8_t buf[16];
+  int     recv_res = 0;
+  do
+  {
+    recv_res = etcpal_recv(context->wakeup_recv_sock, buf, sizeof buf, 0);
+  } while (recv_res > 0);
+
+  event->socket    = ETCPAL_SOCKET_INVALID;
+  event->events    = ETCPAL_POLL_WAKEUP;
+  event->err       = kEtcPalErrOk;
+  event->user_data = context->wakeup_user_data;
+  event->timer     = ETCPAL_POLL_TIMER_INVALID;
+}
+
 int poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b)
 {
   ETCPAL_UNUSED_ARG(tree);
@@ -1205,6 +1725,19 @@ int poll_socket_compare(const EtcPalRbTree* tree, const void* value_a, const voi
   return (a->sock > b->sock) - (a->sock < b->sock);
 }
 
+int poll_timer_compare(const EtcPalRbTree* tree, const void* value_a, const void* value_b)
+{
+  ETCPAL_UNUSED_ARG(tree);
+
+  if (!ETCPAL_ASSERT_VERIFY(value_a) || !ETCPAL_ASSERT_VERIFY(value_b))
+    return 0;
+
+  const EtcPalPollTimer* a = (const EtcPalPollTimer*)value_a;
+  const EtcPalPollTimer* b = (const EtcPalPollTimer*)value_b;
+
+  return (a->id > b->id) - (a->id < b->id);
+}
+
 EtcPalRbNode* poll_socket_alloc(void)
 {
   return (EtcPalRbNode*)malloc(sizeof(EtcPalRbNode));
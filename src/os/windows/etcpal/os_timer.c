@@ -27,8 +27,13 @@
 
 #if !defined(ETCPAL_BUILDING_MOCK_LIB)
 
+static LARGE_INTEGER perf_counter_freq;
+
 etcpal_error_t etcpal_timer_init(void)
 {
+  // Always succeeds on Windows XP and later.
+  QueryPerformanceFrequency(&perf_counter_freq);
+
   if (TIMERR_NOERROR == timeBeginPeriod(ETCPAL_WINDOWS_TIMER_RESOLUTION))
     return kEtcPalErrOk;
   return kEtcPalErrSys;
@@ -44,4 +49,22 @@ uint32_t etcpal_getms(void)
   return timeGetTime();
 }
 
+uint64_t etcpal_getns(void)
+{
+  LARGE_INTEGER count;
+  QueryPerformanceCounter(&count);
+
+  // Split the conversion to avoid overflowing the intermediate product.
+  uint64_t ticks = (uint64_t)count.QuadPart;
+  uint64_t freq  = (uint64_t)perf_counter_freq.QuadPart;
+  return (ticks / freq) * 1000000000u + (ticks % freq) * 1000000000u / freq;
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+  // The performance counter shares no time base with the cheaper tick count APIs, so there is no
+  // coarse variant of it to use.
+  return etcpal_getns();
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
@@ -66,6 +66,48 @@ bool etcpal_queue_timed_receive(etcpal_queue_t* id, void* data, int timeout_ms)
   return err == 0;
 }
 
+size_t etcpal_queue_send_many(etcpal_queue_t* id, const void* data, size_t num_items, int timeout_ms)
+{
+  if (!id || !data || num_items == 0)
+  {
+    return 0;
+  }
+
+  // Only the first item waits for space; the rest are sent only if space is immediately available.
+  const uint8_t* item     = (const uint8_t*)data;
+  size_t         num_sent = 0;
+  for (; num_sent < num_items; ++num_sent, item += id->queue.msg_size)
+  {
+    k_timeout_t timeout = (num_sent == 0 ? ms_to_zephyr_timeout(timeout_ms) : K_NO_WAIT);
+    if (k_msgq_put(&id->queue, item, timeout) != 0)
+    {
+      break;
+    }
+  }
+  return num_sent;
+}
+
+size_t etcpal_queue_receive_many(etcpal_queue_t* id, void* data, size_t max_items, int timeout_ms)
+{
+  if (!id || !data || max_items == 0)
+  {
+    return 0;
+  }
+
+  // Only the first item waits; the rest are received only if they are immediately available.
+  uint8_t* item         = (uint8_t*)data;
+  size_t   num_received = 0;
+  for (; num_received < max_items; ++num_received, item += id->queue.msg_size)
+  {
+    k_timeout_t timeout = (num_received == 0 ? ms_to_zephyr_timeout(timeout_ms) : K_NO_WAIT);
+    if (k_msgq_get(&id->queue, item, timeout) != 0)
+    {
+      break;
+    }
+  }
+  return num_received;
+}
+
 void etcpal_queue_destroy(etcpal_queue_t* id)
 {
   if (id)
@@ -42,4 +42,14 @@ uint32_t etcpal_getms(void)
   return k_uptime_get();
 }
 
+uint64_t etcpal_getns(void)
+{
+  return k_ticks_to_ns_floor64(k_uptime_ticks());
+}
+
+uint64_t etcpal_getns_coarse(void)
+{
+  return etcpal_getns();
+}
+
 #endif  // !defined(ETCPAL_BUILDING_MOCK_LIB)
@@ -23,6 +23,7 @@
 #include "etcpal/mutex.h"
 #include "etcpal/signal.h"
 #include "etcpal/thread.h"
+#include "etcpal/timer.h"
 #include "unity_fixture.h"
 
 #define NUM_ITERATIONS 3
@@ -173,9 +174,128 @@ TEST(event_group_integration, wait_does_not_return_on_unrequested_bits)
   etcpal_mutex_destroy(&num_events_received_lock);
 }
 
+#if ETCPAL_EVENT_GROUP_WAKES_MULTIPLE_THREADS
+
+#define NUM_WAITERS              8
+#define MAX_WAKEUP_LATENCY_NS    100000000ull  // 100 ms
+#define WAITER_STARTUP_PAD_MS    100
+#define WAKEUP_POLL_INTERVAL_MS  1
+#define WAKEUP_POLL_MAX_ATTEMPTS 1000
+
+typedef struct MultiWaiter
+{
+  etcpal_event_bits_t bits;
+  etcpal_event_bits_t result;
+  bool                woken;
+  uint64_t            woken_time_ns;
+} MultiWaiter;
+
+static MultiWaiter    multi_waiters[NUM_WAITERS];
+static etcpal_mutex_t multi_waiters_lock = ETCPAL_MUTEX_INIT;
+
+static void multi_waiter_thread(void* arg)
+{
+  MultiWaiter*        waiter = (MultiWaiter*)arg;
+  etcpal_event_bits_t result = etcpal_event_group_wait(&event, waiter->bits, ETCPAL_EVENT_GROUP_AUTO_CLEAR);
+  uint64_t            now    = etcpal_getns();
+
+  TEST_ASSERT_TRUE(etcpal_mutex_lock(&multi_waiters_lock));
+  waiter->result        = result;
+  waiter->woken         = true;
+  waiter->woken_time_ns = now;
+  etcpal_mutex_unlock(&multi_waiters_lock);
+}
+
+static bool multi_waiter_woken(size_t index)
+{
+  TEST_ASSERT_TRUE(etcpal_mutex_lock(&multi_waiters_lock));
+  bool woken = multi_waiters[index].woken;
+  etcpal_mutex_unlock(&multi_waiters_lock);
+  return woken;
+}
+
+static void start_multi_waiters(etcpal_thread_t* threads, bool same_bit)
+{
+  TEST_ASSERT_TRUE(etcpal_mutex_create(&multi_waiters_lock));
+
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  for (size_t i = 0; i < NUM_WAITERS; ++i)
+  {
+    multi_waiters[i].bits          = same_bit ? 0x1u : (etcpal_event_bits_t)(1u << i);
+    multi_waiters[i].result        = 0;
+    multi_waiters[i].woken         = false;
+    multi_waiters[i].woken_time_ns = 0;
+    TEST_ASSERT_EQUAL(etcpal_thread_create(&threads[i], &params, multi_waiter_thread, &multi_waiters[i]),
+                      kEtcPalErrOk);
+  }
+
+  // Give all of the waiters time to block on the event group.
+  etcpal_thread_sleep(WAITER_STARTUP_PAD_MS);
+}
+
+static void stop_multi_waiters(etcpal_thread_t* threads)
+{
+  for (size_t i = 0; i < NUM_WAITERS; ++i)
+    TEST_ASSERT_EQUAL(etcpal_thread_join(&threads[i]), kEtcPalErrOk);
+  etcpal_mutex_destroy(&multi_waiters_lock);
+}
+
+// Each bit that is set should wake exactly the thread waiting on it, and promptly.
+TEST(event_group_integration, set_bits_wakes_only_satisfied_waiters)
+{
+  etcpal_thread_t threads[NUM_WAITERS];
+  start_multi_waiters(threads, false);
+
+  for (size_t i = 0; i < NUM_WAITERS; ++i)
+  {
+    uint64_t set_time_ns = etcpal_getns();
+    etcpal_event_group_set_bits(&event, multi_waiters[i].bits);
+
+    int attempts = 0;
+    while (!multi_waiter_woken(i) && attempts++ < WAKEUP_POLL_MAX_ATTEMPTS)
+      etcpal_thread_sleep(WAKEUP_POLL_INTERVAL_MS);
+    TEST_ASSERT_TRUE(multi_waiter_woken(i));
+
+    for (size_t j = i + 1; j < NUM_WAITERS; ++j)
+      TEST_ASSERT_FALSE(multi_waiter_woken(j));
+
+    TEST_ASSERT_TRUE(etcpal_mutex_lock(&multi_waiters_lock));
+    TEST_ASSERT_EQUAL_UINT32(multi_waiters[i].bits, multi_waiters[i].result);
+    TEST_ASSERT_LESS_THAN_UINT64(MAX_WAKEUP_LATENCY_NS, multi_waiters[i].woken_time_ns - set_time_ns);
+    etcpal_mutex_unlock(&multi_waiters_lock);
+  }
+
+  stop_multi_waiters(threads);
+  TEST_ASSERT_EQUAL_UINT32(0u, etcpal_event_group_get_bits(&event));
+}
+
+// Setting a bit that many threads are waiting on should wake all of them, and auto-clear the bit
+// only after all of them have seen it.
+TEST(event_group_integration, set_bits_wakes_all_waiters_for_a_bit)
+{
+  etcpal_thread_t threads[NUM_WAITERS];
+  start_multi_waiters(threads, true);
+
+  etcpal_event_group_set_bits(&event, 0x1u);
+  stop_multi_waiters(threads);
+
+  for (size_t i = 0; i < NUM_WAITERS; ++i)
+  {
+    TEST_ASSERT_TRUE(multi_waiters[i].woken);
+    TEST_ASSERT_EQUAL_UINT32(0x1u, multi_waiters[i].result);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0u, etcpal_event_group_get_bits(&event));
+}
+
+#endif  // ETCPAL_EVENT_GROUP_WAKES_MULTIPLE_THREADS
+
 TEST_GROUP_RUNNER(event_group_integration)
 {
   RUN_TEST_CASE(event_group_integration, one_wait_one_signal_one_event);
   RUN_TEST_CASE(event_group_integration, one_wait_one_signal_multiple_events);
   RUN_TEST_CASE(event_group_integration, wait_does_not_return_on_unrequested_bits);
+#if ETCPAL_EVENT_GROUP_WAKES_MULTIPLE_THREADS
+  RUN_TEST_CASE(event_group_integration, set_bits_wakes_only_satisfied_waiters);
+  RUN_TEST_CASE(event_group_integration, set_bits_wakes_all_waiters_for_a_bit);
+#endif
 }
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/log.h"
+#include "unity_fixture.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "etcpal/common.h"
+#include "etcpal/thread.h"
+
+// Constants
+#define NUM_THREADS    8
+#define NUM_ITERATIONS 5000
+
+typedef struct LogThreadContext
+{
+  int             id;
+  int             num_logged;
+  int             num_received;
+  EtcPalLogParams params;
+} LogThreadContext;
+
+static LogThreadContext thread_contexts[NUM_THREADS];
+static volatile bool    error_detected;
+
+// Each thread logs with its own params and context. Every message should arrive at that thread's
+// context with its strings intact, no matter what other threads are logging at the same time.
+static void log_callback(void* context, const EtcPalLogStrings* strings)
+{
+  LogThreadContext* ctx = (LogThreadContext*)context;
+
+  char expected[ETCPAL_RAW_LOG_MSG_MAX_LEN];
+  snprintf(expected, ETCPAL_RAW_LOG_MSG_MAX_LEN, "Thread %d message %d", ctx->id, ctx->num_logged);
+
+  if (!strings->raw || strcmp(strings->raw, expected) != 0 || !strings->human_readable || !strings->syslog ||
+      strings->legacy_syslog)
+  {
+    error_detected = true;
+  }
+  else
+  {
+    size_t expected_len = strlen(expected);
+    size_t human_len    = strlen(strings->human_readable);
+    size_t syslog_len   = strlen(strings->syslog);
+    if (human_len < expected_len || strcmp(&strings->human_readable[human_len - expected_len], expected) != 0 ||
+        syslog_len < expected_len || strcmp(&strings->syslog[syslog_len - expected_len], expected) != 0)
+    {
+      error_detected = true;
+    }
+  }
+  ++ctx->num_received;
+}
+
+static void log_test_thread(void* arg)
+{
+  LogThreadContext* ctx = (LogThreadContext*)arg;
+  for (ctx->num_logged = 0; ctx->num_logged < NUM_ITERATIONS && !error_detected; ++ctx->num_logged)
+    etcpal_log(&ctx->params, ETCPAL_LOG_INFO, "Thread %d message %d", ctx->id, ctx->num_logged);
+}
+
+TEST_GROUP(log_integration);
+
+TEST_SETUP(log_integration)
+{
+  error_detected = false;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_init(ETCPAL_FEATURE_LOGGING));
+}
+
+TEST_TEAR_DOWN(log_integration)
+{
+  etcpal_deinit(ETCPAL_FEATURE_LOGGING);
+  // Allow some time for threads to be cleaned up on RTOS platforms
+  etcpal_thread_sleep(200);
+}
+
+TEST(log_integration, concurrent_logging_works)
+{
+  etcpal_thread_t threads[NUM_THREADS] = {ETCPAL_THREAD_INIT};
+
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    LogThreadContext* ctx = &thread_contexts[i];
+    memset(ctx, 0, sizeof(LogThreadContext));
+    ctx->id              = i;
+    ctx->params.action   = ETCPAL_LOG_CREATE_HUMAN_READABLE | ETCPAL_LOG_CREATE_SYSLOG;
+    ctx->params.log_fn   = log_callback;
+    ctx->params.log_mask = ETCPAL_LOG_UPTO(ETCPAL_LOG_DEBUG);
+    ctx->params.context  = ctx;
+    TEST_ASSERT_TRUE(etcpal_validate_log_params(&ctx->params));
+  }
+
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  for (int i = 0; i < NUM_THREADS; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&threads[i], &params, log_test_thread, &thread_contexts[i]));
+
+  for (size_t i = 0; i < NUM_THREADS; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&threads[i]));
+
+  TEST_ASSERT_FALSE(error_detected);
+  for (size_t i = 0; i < NUM_THREADS; ++i)
+    TEST_ASSERT_EQUAL_INT(NUM_ITERATIONS, thread_contexts[i].num_received);
+}
+
+TEST_GROUP_RUNNER(log_integration)
+{
+  RUN_TEST_CASE(log_integration, concurrent_logging_works);
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/mempool.h"
+#include "unity_fixture.h"
+
+#include <stdbool.h>
+#include "etcpal/common.h"
+#include "etcpal/thread.h"
+
+// Constants
+#define NUM_THREADS          8
+#define NUM_ITERATIONS       10000
+#define ALLOCS_PER_ITERATION 4
+#define POOL_SIZE            (NUM_THREADS * ALLOCS_PER_ITERATION)
+
+typedef struct TestElem
+{
+  volatile int owner;
+} TestElem;
+
+ETCPAL_MEMPOOL_DEFINE(locked_test, TestElem, POOL_SIZE);
+ETCPAL_MEMPOOL_DEFINE_LOCKFREE(lockfree_test, TestElem, POOL_SIZE);
+
+static EtcPalMempoolDesc* test_pool;
+static volatile bool      error_detected;
+
+// Each thread repeatedly allocates a few elements, marks them as owned, and verifies that no other
+// thread has touched them before freeing them. Two threads being handed the same element would show
+// up as a changed owner value.
+static void mempool_test_thread(void* arg)
+{
+  int       id = *(int*)arg;
+  TestElem* elems[ALLOCS_PER_ITERATION];
+
+  for (int i = 0; i < NUM_ITERATIONS && !error_detected; ++i)
+  {
+    for (size_t j = 0; j < ALLOCS_PER_ITERATION; ++j)
+    {
+      elems[j] = (TestElem*)etcpal_mempool_alloc_priv(test_pool);
+      if (!elems[j])
+      {
+        // The pool is sized so that every thread can always get its elements.
+        error_detected = true;
+        return;
+      }
+      elems[j]->owner = id;
+    }
+
+    for (size_t j = 0; j < ALLOCS_PER_ITERATION; ++j)
+    {
+      if (elems[j]->owner != id)
+        error_detected = true;
+      elems[j]->owner = -1;
+      etcpal_mempool_free_priv(test_pool, elems[j]);
+    }
+  }
+}
+
+static void run_mempool_thread_test(void)
+{
+  etcpal_thread_t threads[NUM_THREADS] = {ETCPAL_THREAD_INIT};
+  int             thread_ids[NUM_THREADS];
+
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  for (int i = 0; i < NUM_THREADS; ++i)
+  {
+    thread_ids[i] = i;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&threads[i], &params, mempool_test_thread, &thread_ids[i]));
+  }
+
+  for (size_t i = 0; i < NUM_THREADS; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&threads[i]));
+
+  TEST_ASSERT_FALSE(error_detected);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mempool_used_priv(test_pool));
+}
+
+TEST_GROUP(mempool_integration);
+
+TEST_SETUP(mempool_integration)
+{
+  error_detected = false;
+}
+
+TEST_TEAR_DOWN(mempool_integration)
+{
+  etcpal_mempool_deinit(locked_test);
+  etcpal_mempool_deinit(lockfree_test);
+
+  // Allow some time for threads to be cleaned up on RTOS platforms
+  etcpal_thread_sleep(200);
+}
+
+TEST(mempool_integration, locked_pool_thread_test)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(locked_test));
+  test_pool = &locked_test_pool_desc;
+  run_mempool_thread_test();
+}
+
+TEST(mempool_integration, lockfree_pool_thread_test)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(lockfree_test));
+  test_pool = &lockfree_test_pool_desc;
+  run_mempool_thread_test();
+}
+
+TEST_GROUP_RUNNER(mempool_integration)
+{
+  RUN_TEST_CASE(mempool_integration, locked_pool_thread_test);
+  RUN_TEST_CASE(mempool_integration, lockfree_pool_thread_test);
+}
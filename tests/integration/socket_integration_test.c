@@ -33,8 +33,10 @@
 
 #include <string.h>
 #include "etcpal/common.h"
+#include "etcpal/mutex.h"
 #include "etcpal/netint.h"
 #include "etcpal/thread.h"
+#include "etcpal/timer.h"
 
 #ifdef __MQX__
 #define MQX_PROVIDES_STDIO !MQX_SUPPRESS_STDIO_MACROS
@@ -61,6 +63,8 @@
 #endif
 
 #define NUM_TEST_PACKETS 1000
+// Linux limits each socket to 20 IPv4 group memberships by default (net.ipv4.igmp_max_memberships).
+#define NUM_BATCH_GROUPS 16
 
 etcpal_error_t      etcpal_init_result;
 static unsigned int v4_netint;
@@ -759,6 +763,45 @@ TEST(socket_integration_udp, multicast_udp_ipv4_sendto_recvmsg)
   multicast_udp_cleanup();
 }
 
+TEST(socket_integration_udp, multicast_udp_ipv4_join_groups)
+{
+  multicast_udp_ipv4_setup();
+
+  // Join a batch of groups, like a receiver subscribing to many sACN universes (239.255.0.1 and up).
+  static EtcPalGroupReq groups[NUM_BATCH_GROUPS];
+  for (size_t i = 0; i < NUM_BATCH_GROUPS; ++i)
+  {
+    groups[i].ifindex = (int)v4_netint;
+    ETCPAL_IP_SET_V4_ADDRESS(&groups[i].group, 0xefff0000u + (uint32_t)i + 1u);
+  }
+  TEST_ASSERT_EQUAL_INT(NUM_BATCH_GROUPS, etcpal_join_groups(recv_socks[0], groups, NUM_BATCH_GROUPS));
+
+  // Joining a group that is already joined fails on the first group.
+  TEST_ASSERT_LESS_THAN_INT(0, etcpal_join_groups(recv_socks[0], groups, NUM_BATCH_GROUPS));
+
+  // Traffic to the last group in the batch should be received.
+  int intval = 500;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_setsockopt(recv_socks[0], ETCPAL_SOL_SOCKET, ETCPAL_SO_RCVTIMEO, &intval, sizeof(int)));
+  EtcPalSockAddr group_addr;
+  group_addr.ip   = groups[NUM_BATCH_GROUPS - 1].group;
+  group_addr.port = MULTICAST_UDP_PORT_BASE;
+  TEST_ASSERT_EQUAL_INT((int)SOCKET_TEST_MESSAGE_LENGTH, etcpal_sendto(send_sock, kSocketTestMessage,
+                                                                       SOCKET_TEST_MESSAGE_LENGTH, 0, &group_addr));
+
+  EtcPalSockAddr from_addr;
+  uint8_t        buf[SOCKET_TEST_MESSAGE_LENGTH];
+  TEST_ASSERT_EQUAL_INT((int)SOCKET_TEST_MESSAGE_LENGTH,
+                        etcpal_recvfrom(recv_socks[0], buf, SOCKET_TEST_MESSAGE_LENGTH, 0, &from_addr));
+  TEST_ASSERT_EQUAL_MEMORY(kSocketTestMessage, buf, SOCKET_TEST_MESSAGE_LENGTH);
+
+  // Leave the groups, after which leaving again fails.
+  TEST_ASSERT_EQUAL_INT(NUM_BATCH_GROUPS, etcpal_leave_groups(recv_socks[0], groups, NUM_BATCH_GROUPS));
+  TEST_ASSERT_LESS_THAN_INT(0, etcpal_leave_groups(recv_socks[0], groups, NUM_BATCH_GROUPS));
+
+  multicast_udp_cleanup();
+}
+
 #if ETCPAL_TEST_IPV6
 TEST(socket_integration_udp, multicast_udp_ipv6_sendto_recvfrom)
 {
@@ -845,6 +888,207 @@ TEST(socket_integration_udp, bulk_poll)
   etcpal_poll_context_deinit(&context);
 }
 
+#if defined(__linux__) || defined(__APPLE__)
+// Multithreaded poll contexts are only available on platforms where the OS polling API can report
+// each event to only one waiting thread.
+
+#define MT_POLL_NUM_SOCKETS 8
+#define MT_POLL_PACKETS_PER_SOCKET 50
+#define MT_POLL_MAX_WORKERS 8
+
+typedef struct MtPollState
+{
+  EtcPalPollContext context;
+  etcpal_mutex_t    lock;
+  bool              busy[MT_POLL_NUM_SOCKETS];
+  bool              overlapped;
+  bool              done;
+  size_t            num_received;
+} MtPollState;
+
+static MtPollState mt_poll_state;
+
+static bool mt_poll_done(void)
+{
+  // Stop the worker if the lock is broken, rather than spinning forever.
+  bool done = true;
+  if (etcpal_mutex_lock(&mt_poll_state.lock))
+  {
+    done = mt_poll_state.done;
+    etcpal_mutex_unlock(&mt_poll_state.lock);
+  }
+  return done;
+}
+
+static void mt_poll_worker(void* arg)
+{
+  ETCPAL_UNUSED_ARG(arg);
+
+  while (!mt_poll_done())
+  {
+    EtcPalPollEvent event;
+    if (etcpal_poll_wait(&mt_poll_state.context, &event, 20) != kEtcPalErrOk || !(event.events & ETCPAL_POLL_IN))
+      continue;
+
+    size_t index = (size_t)(uintptr_t)event.user_data;
+
+    if (etcpal_mutex_lock(&mt_poll_state.lock))
+    {
+      if (mt_poll_state.busy[index])
+        mt_poll_state.overlapped = true;
+      mt_poll_state.busy[index] = true;
+      etcpal_mutex_unlock(&mt_poll_state.lock);
+    }
+
+    // Drain the socket completely before rearming it, as the socket is not reported again until then.
+    size_t  num_received = 0;
+    uint8_t recv_buf[SOCKET_TEST_MESSAGE_LENGTH];
+    while (etcpal_recvfrom(event.socket, recv_buf, SOCKET_TEST_MESSAGE_LENGTH, 0, NULL) > 0)
+      ++num_received;
+
+    if (etcpal_mutex_lock(&mt_poll_state.lock))
+    {
+      mt_poll_state.busy[index] = false;
+      mt_poll_state.num_received += num_received;
+      etcpal_mutex_unlock(&mt_poll_state.lock);
+    }
+
+    etcpal_poll_rearm_socket(&mt_poll_state.context, event.socket);
+  }
+}
+
+static void run_multithreaded_poll(size_t num_workers)
+{
+  char error_msg[50];
+  sprintf(error_msg, "Failed with %zu workers", num_workers);
+
+  memset(&mt_poll_state, 0, sizeof mt_poll_state);
+  TEST_ASSERT_TRUE(etcpal_mutex_create(&mt_poll_state.lock));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_context_init_multithreaded(&mt_poll_state.context));
+
+  uint16_t bind_ports[MT_POLL_NUM_SOCKETS];
+  for (size_t i = 0; i < MT_POLL_NUM_SOCKETS; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_socks[i]));
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_setblocking(recv_socks[i], false));
+
+    EtcPalSockAddr bind_addr;
+    ETCPAL_IP_SET_V4_ADDRESS(&bind_addr.ip, 0x7f000001);
+    bind_addr.port = 0;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_bind(recv_socks[i], &bind_addr));
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_getsockname(recv_socks[i], &bind_addr));
+    bind_ports[i] = bind_addr.port;
+
+    TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                      etcpal_poll_add_socket(&mt_poll_state.context, recv_socks[i], ETCPAL_POLL_IN, (void*)(uintptr_t)i));
+  }
+
+  etcpal_thread_t    workers[MT_POLL_MAX_WORKERS];
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  for (size_t i = 0; i < num_workers; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&workers[i], &params, mt_poll_worker, NULL));
+
+  ETCPAL_IP_SET_V4_ADDRESS(&send_addr.ip, 0x7f000001);
+  for (size_t i = 0; i < MT_POLL_PACKETS_PER_SOCKET; ++i)
+  {
+    for (size_t j = 0; j < MT_POLL_NUM_SOCKETS; ++j)
+    {
+      send_addr.port = bind_ports[j];
+      etcpal_sendto(send_sock, (const uint8_t*)kSocketTestMessage, SOCKET_TEST_MESSAGE_LENGTH, 0, &send_addr);
+    }
+  }
+
+  EtcPalTimer deadline;
+  etcpal_timer_start(&deadline, 5000);
+  size_t num_received = 0;
+  while (num_received < MT_POLL_NUM_SOCKETS * MT_POLL_PACKETS_PER_SOCKET && !etcpal_timer_is_expired(&deadline))
+  {
+    etcpal_thread_sleep(10);
+    TEST_ASSERT_TRUE(etcpal_mutex_lock(&mt_poll_state.lock));
+    num_received = mt_poll_state.num_received;
+    etcpal_mutex_unlock(&mt_poll_state.lock);
+  }
+
+  TEST_ASSERT_TRUE(etcpal_mutex_lock(&mt_poll_state.lock));
+  mt_poll_state.done = true;
+  etcpal_mutex_unlock(&mt_poll_state.lock);
+  for (size_t i = 0; i < num_workers; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&workers[i]));
+
+  for (size_t i = 0; i < MT_POLL_NUM_SOCKETS; ++i)
+  {
+    etcpal_poll_remove_socket(&mt_poll_state.context, recv_socks[i]);
+    etcpal_close(recv_socks[i]);
+    recv_socks[i] = ETCPAL_SOCKET_INVALID;
+  }
+  etcpal_poll_context_deinit(&mt_poll_state.context);
+  etcpal_mutex_destroy(&mt_poll_state.lock);
+
+  TEST_ASSERT_FALSE_MESSAGE(mt_poll_state.overlapped, error_msg);
+  TEST_ASSERT_EQUAL_MESSAGE(MT_POLL_NUM_SOCKETS * MT_POLL_PACKETS_PER_SOCKET, num_received, error_msg);
+}
+
+// Test that a pool of workers waiting on one multithreaded context receives all of the traffic on
+// its sockets, without any socket ever being handled by two workers at once.
+TEST(socket_integration_udp, multithreaded_poll)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock));
+
+  run_multithreaded_poll(1);
+  run_multithreaded_poll(2);
+  run_multithreaded_poll(4);
+  run_multithreaded_poll(8);
+}
+
+static void mt_poll_single_wait_thread(void* arg)
+{
+  EtcPalPollEvent* event = (EtcPalPollEvent*)arg;
+
+  // Wakeups are not expected, but skip over them in any case.
+  etcpal_error_t res = kEtcPalErrOk;
+  do
+  {
+    res = etcpal_poll_wait(&mt_poll_state.context, event, 1000);
+  } while (res == kEtcPalErrOk && (event->events & ETCPAL_POLL_WAKEUP));
+
+  if (res != kEtcPalErrOk)
+    event->err = res;
+}
+
+// Test that a socket added to a multithreaded context while a thread is blocked waiting on it is
+// reported to that thread.
+TEST(socket_integration_udp, multithreaded_poll_add_while_waiting)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_context_init_multithreaded(&mt_poll_state.context));
+  // Without a wakeup, the context would be empty and the wait would return immediately.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_add_wakeup(&mt_poll_state.context, NULL));
+
+  EtcPalPollEvent    event       = {ETCPAL_SOCKET_INVALID, 0, kEtcPalErrOk, NULL, ETCPAL_POLL_TIMER_INVALID};
+  etcpal_thread_t    wait_thread = ETCPAL_THREAD_INIT;
+  EtcPalThreadParams params      = ETCPAL_THREAD_PARAMS_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&wait_thread, &params, mt_poll_single_wait_thread, &event));
+  etcpal_thread_sleep(50);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_socks[0]));
+  EtcPalSockAddr bind_addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&bind_addr.ip, 0x7f000001);
+  bind_addr.port = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_bind(recv_socks[0], &bind_addr));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_getsockname(recv_socks[0], &bind_addr));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_add_socket(&mt_poll_state.context, recv_socks[0], ETCPAL_POLL_IN, NULL));
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock));
+  etcpal_sendto(send_sock, (const uint8_t*)kSocketTestMessage, SOCKET_TEST_MESSAGE_LENGTH, 0, &bind_addr);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&wait_thread));
+  etcpal_poll_context_deinit(&mt_poll_state.context);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, event.err);
+  TEST_ASSERT_EQUAL(recv_socks[0], event.socket);
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_IN, event.events);
+}
+#endif  // defined(__linux__) || defined(__APPLE__)
+
 TEST_GROUP_RUNNER(socket_integration_udp)
 {
   etcpal_init_result = etcpal_init(ETCPAL_FEATURE_SOCKETS | ETCPAL_FEATURE_NETINTS);
@@ -863,6 +1107,7 @@ TEST_GROUP_RUNNER(socket_integration_udp)
   {
     RUN_TEST_CASE(socket_integration_udp, multicast_udp_ipv4_sendto_recvfrom);
     RUN_TEST_CASE(socket_integration_udp, multicast_udp_ipv4_sendto_recvmsg);
+    RUN_TEST_CASE(socket_integration_udp, multicast_udp_ipv4_join_groups);
   }
 #if ETCPAL_TEST_IPV6
   RUN_TEST_CASE(socket_integration_udp, unicast_udp_ipv6_sendto_recvfrom);
@@ -875,6 +1120,10 @@ TEST_GROUP_RUNNER(socket_integration_udp)
 #endif
 
   RUN_TEST_CASE(socket_integration_udp, bulk_poll);
+#if defined(__linux__) || defined(__APPLE__)
+  RUN_TEST_CASE(socket_integration_udp, multithreaded_poll);
+  RUN_TEST_CASE(socket_integration_udp, multithreaded_poll_add_while_waiting);
+#endif
 
   if (etcpal_init_result == kEtcPalErrOk)
     etcpal_deinit(ETCPAL_FEATURE_SOCKETS | ETCPAL_FEATURE_NETINTS);
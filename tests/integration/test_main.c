@@ -24,6 +24,8 @@ void run_all_tests(void)
 #if !DISABLE_EVENT_GROUP_TESTS
   RUN_TEST_GROUP(event_group_integration);
 #endif
+  RUN_TEST_GROUP(log_integration);
+  RUN_TEST_GROUP(mempool_integration);
   RUN_TEST_GROUP(mutex_integration);
 #if !DISABLE_QUEUE_TESTS
   RUN_TEST_GROUP(etcpal_queue_integration);
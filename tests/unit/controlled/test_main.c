@@ -25,7 +25,9 @@ DEFINE_FFF_GLOBALS;
 void run_all_tests(void)
 {
   RUN_TEST_GROUP(timer_controlled);
+  RUN_TEST_GROUP(timer_wheel_controlled);
 #if !ETCPAL_NO_NETWORKING_SUPPORT
   RUN_TEST_GROUP(netint_controlled);
+  RUN_TEST_GROUP(route_index);
 #endif
 }
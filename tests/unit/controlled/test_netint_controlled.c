@@ -22,22 +22,74 @@
 #include "unity_fixture.h"
 #include "etc_fff_wrapper.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+// netint.c reallocates the cache array when the monitor adds addresses, using the real allocator,
+// so the fake OS layer must allocate with it too rather than with Unity's tracking allocator.
+#undef calloc
+#undef free
+
 #define NUM_TEST_NETINTS 1
 
 static EtcPalNetintInfo test_netints[NUM_TEST_NETINTS] = {{0}};
 
 etcpal_error_t test_enum_interfaces(CachedNetintInfo* cache)
 {
-  cache->netints     = test_netints;
+  cache->netints = (EtcPalNetintInfo*)calloc(NUM_TEST_NETINTS, sizeof(EtcPalNetintInfo));
+  if (!cache->netints)
+    return kEtcPalErrNoMem;
+
+  memcpy(cache->netints, test_netints, sizeof test_netints);
   cache->num_netints = NUM_TEST_NETINTS;
+  return kEtcPalErrOk;
+}
+
+void test_free_interfaces(CachedNetintInfo* cache)
+{
+  free(cache->netints);
+}
 
+static void apply_link_state(unsigned int index, bool is_up, bool notify)
+{
+  EtcPalNetintChange change;
+  memset(&change, 0, sizeof(change));
+  change.type  = (is_up ? kEtcPalNetintUp : kEtcPalNetintDown);
+  change.index = index;
+  netint_apply_change(&change, notify);
+}
+
+// Reports an initial link state snapshot like a real monitor does when it starts.
+etcpal_error_t test_start_monitor(void)
+{
+  apply_link_state(1, true, false);
+  apply_link_state(2, false, false);
   return kEtcPalErrOk;
 }
 
+void test_update_routes(CachedNetintInfo* cache)
+{
+  cache->def.v4_valid = true;
+  cache->def.v4_index = 1;
+}
+
 ETC_FAKE_VALUE_FUNC(etcpal_error_t, os_enumerate_interfaces, CachedNetintInfo*);
 ETC_FAKE_VOID_FUNC(os_free_interfaces, CachedNetintInfo*);
 ETC_FAKE_VALUE_FUNC(etcpal_error_t, os_resolve_route, const EtcPalIpAddr*, const CachedNetintInfo*, unsigned int*);
 ETC_FAKE_VALUE_FUNC(bool, os_netint_is_up, unsigned int, const CachedNetintInfo*);
+ETC_FAKE_VALUE_FUNC(etcpal_error_t, os_netint_start_monitor);
+ETC_FAKE_VOID_FUNC(os_netint_stop_monitor);
+ETC_FAKE_VOID_FUNC(os_netint_update_routes, CachedNetintInfo*);
+
+static EtcPalNetintChange last_change;
+static unsigned int       num_changes;
+
+static void record_change(void* context, const EtcPalNetintChange* change)
+{
+  TEST_ASSERT_EQUAL_PTR(&last_change, context);
+  last_change = *change;
+  ++num_changes;
+}
 
 TEST_GROUP(netint_controlled);
 
@@ -47,8 +99,17 @@ TEST_SETUP(netint_controlled)
   RESET_FAKE(os_free_interfaces);
   RESET_FAKE(os_resolve_route);
   RESET_FAKE(os_netint_is_up);
+  RESET_FAKE(os_netint_start_monitor);
+  RESET_FAKE(os_netint_stop_monitor);
+  RESET_FAKE(os_netint_update_routes);
+
+  test_netints[0].index = 1;
+  ETCPAL_IP_SET_V4_ADDRESS(&test_netints[0].addr, 0x0a000001);  // 10.0.0.1
 
   os_enumerate_interfaces_fake.custom_fake = test_enum_interfaces;
+  os_free_interfaces_fake.custom_fake      = test_free_interfaces;
+  memset(&last_change, 0, sizeof(last_change));
+  num_changes = 0;
 
   TEST_ASSERT_EQUAL(etcpal_netint_init(), kEtcPalErrOk);
 }
@@ -69,7 +130,127 @@ TEST(netint_controlled, netint_is_up_works)
   TEST_ASSERT_EQUAL_UINT(os_netint_is_up_fake.arg0_val, 2);
 }
 
+static void start_test_monitor(void)
+{
+  os_netint_start_monitor_fake.custom_fake = test_start_monitor;
+  os_netint_update_routes_fake.custom_fake = test_update_routes;
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_netint_start_monitor(record_change, &last_change));
+}
+
+TEST(netint_controlled, monitor_answers_is_up_from_cache)
+{
+  start_test_monitor();
+
+  // The initial snapshot should not be reported.
+  TEST_ASSERT_EQUAL_UINT(0u, num_changes);
+  TEST_ASSERT_TRUE(etcpal_netint_is_up(1));
+  TEST_ASSERT_FALSE(etcpal_netint_is_up(2));
+  TEST_ASSERT_FALSE(etcpal_netint_is_up(3));
+  TEST_ASSERT_EQUAL_UINT(0u, os_netint_is_up_fake.call_count);
+
+  apply_link_state(1, false, true);
+  TEST_ASSERT_FALSE(etcpal_netint_is_up(1));
+  TEST_ASSERT_EQUAL_UINT(1u, num_changes);
+  TEST_ASSERT_EQUAL(kEtcPalNetintDown, last_change.type);
+  TEST_ASSERT_EQUAL_UINT(1u, last_change.index);
+
+  // Repeated state is not a change.
+  apply_link_state(1, false, true);
+  TEST_ASSERT_EQUAL_UINT(1u, num_changes);
+
+  // A new interface appearing in the up state is.
+  apply_link_state(3, true, true);
+  TEST_ASSERT_TRUE(etcpal_netint_is_up(3));
+  TEST_ASSERT_EQUAL_UINT(2u, num_changes);
+  TEST_ASSERT_EQUAL(kEtcPalNetintUp, last_change.type);
+
+  // After the monitor stops, the OS is queried again.
+  etcpal_netint_stop_monitor();
+  TEST_ASSERT_EQUAL_UINT(1u, os_netint_stop_monitor_fake.call_count);
+  os_netint_is_up_fake.return_val = true;
+  TEST_ASSERT_TRUE(etcpal_netint_is_up(1));
+  TEST_ASSERT_EQUAL_UINT(1u, os_netint_is_up_fake.call_count);
+}
+
+TEST(netint_controlled, monitor_applies_address_changes)
+{
+  start_test_monitor();
+
+  EtcPalNetintChange change;
+  memset(&change, 0, sizeof(change));
+  change.type         = kEtcPalNetintAddrAdded;
+  change.index        = 1;
+  change.netint.index = 1;
+  ETCPAL_IP_SET_V4_ADDRESS(&change.netint.addr, 0x0a000002);  // 10.0.0.2
+  netint_apply_change(&change, true);
+
+  TEST_ASSERT_EQUAL_UINT(1u, num_changes);
+  TEST_ASSERT_EQUAL(kEtcPalNetintAddrAdded, last_change.type);
+
+  size_t           num_netints = 2;
+  EtcPalNetintInfo netints[2];
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_netint_get_interfaces(netints, &num_netints));
+  TEST_ASSERT_EQUAL_UINT(2u, num_netints);
+
+  EtcPalNetintInfo found;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_netint_get_interface_with_ip(&change.netint.addr, &found));
+  TEST_ASSERT_EQUAL_UINT(1u, found.index);
+
+  // Adding the same address again is not a change.
+  netint_apply_change(&change, true);
+  TEST_ASSERT_EQUAL_UINT(1u, num_changes);
+
+  change.type = kEtcPalNetintAddrRemoved;
+  netint_apply_change(&change, true);
+  TEST_ASSERT_EQUAL_UINT(2u, num_changes);
+  TEST_ASSERT_EQUAL(kEtcPalNetintAddrRemoved, last_change.type);
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_netint_get_interface_with_ip(&change.netint.addr, &found));
+
+  // Removing an address that isn't cached is not a change.
+  netint_apply_change(&change, true);
+  TEST_ASSERT_EQUAL_UINT(2u, num_changes);
+}
+
+TEST(netint_controlled, monitor_applies_route_changes)
+{
+  start_test_monitor();
+
+  unsigned int index = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_netint_get_default_interface(kEtcPalIpTypeV4, &index));
+
+  EtcPalNetintChange change;
+  memset(&change, 0, sizeof(change));
+  change.type = kEtcPalNetintRoutesChanged;
+  netint_apply_change(&change, true);
+
+  TEST_ASSERT_EQUAL_UINT(1u, os_netint_update_routes_fake.call_count);
+  TEST_ASSERT_EQUAL_UINT(1u, num_changes);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_netint_get_default_interface(kEtcPalIpTypeV4, &index));
+  TEST_ASSERT_EQUAL_UINT(1u, index);
+
+  EtcPalNetintInfo found;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_netint_get_interface_with_ip(&test_netints[0].addr, &found));
+  TEST_ASSERT_TRUE(found.is_default);
+}
+
+TEST(netint_controlled, monitor_start_errors_work)
+{
+  os_netint_start_monitor_fake.return_val = kEtcPalErrNotImpl;
+  TEST_ASSERT_EQUAL(kEtcPalErrNotImpl, etcpal_netint_start_monitor(NULL, NULL));
+  os_netint_is_up_fake.return_val = true;
+  TEST_ASSERT_TRUE(etcpal_netint_is_up(1));
+  TEST_ASSERT_EQUAL_UINT(1u, os_netint_is_up_fake.call_count);
+
+  start_test_monitor();
+  TEST_ASSERT_EQUAL(kEtcPalErrAlready, etcpal_netint_start_monitor(NULL, NULL));
+}
+
 TEST_GROUP_RUNNER(netint_controlled)
 {
   RUN_TEST_CASE(netint_controlled, netint_is_up_works);
+  RUN_TEST_CASE(netint_controlled, monitor_answers_is_up_from_cache);
+  RUN_TEST_CASE(netint_controlled, monitor_applies_address_changes);
+  RUN_TEST_CASE(netint_controlled, monitor_applies_route_changes);
+  RUN_TEST_CASE(netint_controlled, monitor_start_errors_work);
 }
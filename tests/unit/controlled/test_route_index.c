@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/private/route_index.h"
+#include "unity_fixture.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_SYNTHETIC_ROUTES  10000
+#define NUM_SYNTHETIC_LOOKUPS 2000
+
+typedef struct TestRoute
+{
+  EtcPalIpAddr prefix;
+  unsigned int prefix_len;
+  int          value;
+} TestRoute;
+
+static RouteIndex index_under_test;
+static TestRoute* routes;
+static uint32_t   rand_state;
+
+// A small deterministic PRNG so that failures are reproducible.
+static uint32_t next_rand(void)
+{
+  rand_state = rand_state * 1664525u + 1013904223u;
+  return rand_state >> 8;
+}
+
+static void addr_to_bytes(const EtcPalIpAddr* addr, uint8_t* bytes)
+{
+  if (ETCPAL_IP_IS_V4(addr))
+  {
+    uint32_t v4 = ETCPAL_IP_V4_ADDRESS(addr);
+    bytes[0]    = (uint8_t)(v4 >> 24);
+    bytes[1]    = (uint8_t)(v4 >> 16);
+    bytes[2]    = (uint8_t)(v4 >> 8);
+    bytes[3]    = (uint8_t)v4;
+  }
+  else
+  {
+    memcpy(bytes, ETCPAL_IP_V6_ADDRESS(addr), ETCPAL_IPV6_BYTES);
+  }
+}
+
+static bool prefix_matches(const TestRoute* route, const EtcPalIpAddr* addr)
+{
+  uint8_t route_bytes[ETCPAL_IPV6_BYTES];
+  uint8_t addr_bytes[ETCPAL_IPV6_BYTES];
+  addr_to_bytes(&route->prefix, route_bytes);
+  addr_to_bytes(addr, addr_bytes);
+
+  for (unsigned int bit = 0; bit < route->prefix_len; ++bit)
+  {
+    uint8_t mask = (uint8_t)(0x80u >> (bit % 8));
+    if ((route_bytes[bit / 8] & mask) != (addr_bytes[bit / 8] & mask))
+      return false;
+  }
+  return true;
+}
+
+// The reference implementation: the longest matching prefix wins, and among routes with the same
+// prefix, the one added first wins.
+static int linear_lookup(const TestRoute* table, size_t size, const EtcPalIpAddr* addr)
+{
+  const TestRoute* best = NULL;
+  for (const TestRoute* route = table; route < table + size; ++route)
+  {
+    if (prefix_matches(route, addr) && (!best || route->prefix_len > best->prefix_len))
+      best = route;
+  }
+  return (best ? best->value : -1);
+}
+
+// Generate an address that shares its first bytes with one of a few "sites", so that the synthetic
+// table has plenty of nested and overlapping prefixes.
+static void random_addr(etcpal_iptype_t type, EtcPalIpAddr* addr)
+{
+  static const uint8_t kSites[] = {10, 172, 192, 0x20};
+
+  uint8_t bytes[ETCPAL_IPV6_BYTES];
+  for (size_t i = 0; i < ETCPAL_IPV6_BYTES; ++i)
+    bytes[i] = (uint8_t)next_rand();
+  bytes[0] = kSites[next_rand() % (sizeof kSites)];
+  if (next_rand() % 2)
+    bytes[1] = (uint8_t)(bytes[1] % 4);
+
+  if (type == kEtcPalIpTypeV4)
+  {
+    ETCPAL_IP_SET_V4_ADDRESS(
+        addr, ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3]);
+  }
+  else
+  {
+    ETCPAL_IP_SET_V6_ADDRESS(addr, bytes);
+  }
+}
+
+static void build_synthetic_table(etcpal_iptype_t type)
+{
+  unsigned int max_len = (type == kEtcPalIpTypeV4 ? 32 : 128);
+  for (int i = 0; i < NUM_SYNTHETIC_ROUTES; ++i)
+  {
+    TestRoute* route = &routes[i];
+    random_addr(type, &route->prefix);
+    // Bias toward shorter prefixes so that many lookups resolve through several nested routes.
+    route->prefix_len = next_rand() % (max_len + 1);
+    if (next_rand() % 2)
+      route->prefix_len /= 2;
+    route->value = i;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                      route_index_insert(&index_under_test, &route->prefix, route->prefix_len, route->value));
+  }
+}
+
+static void check_synthetic_lookups(etcpal_iptype_t type)
+{
+  for (int i = 0; i < NUM_SYNTHETIC_LOOKUPS; ++i)
+  {
+    EtcPalIpAddr addr;
+    random_addr(type, &addr);
+    TEST_ASSERT_EQUAL_INT(linear_lookup(routes, NUM_SYNTHETIC_ROUTES, &addr),
+                          route_index_lookup(&index_under_test, &addr));
+
+    // Also look up the network address of an existing route, which must match at least that route.
+    const TestRoute* route = &routes[next_rand() % NUM_SYNTHETIC_ROUTES];
+    TEST_ASSERT_EQUAL_INT(linear_lookup(routes, NUM_SYNTHETIC_ROUTES, &route->prefix),
+                          route_index_lookup(&index_under_test, &route->prefix));
+  }
+}
+
+TEST_GROUP(route_index);
+
+TEST_SETUP(route_index)
+{
+  route_index_init(&index_under_test);
+  routes     = (TestRoute*)calloc(NUM_SYNTHETIC_ROUTES, sizeof(TestRoute));
+  rand_state = 0x5eed;
+  TEST_ASSERT_NOT_NULL(routes);
+}
+
+TEST_TEAR_DOWN(route_index)
+{
+  route_index_clear(&index_under_test);
+  free(routes);
+}
+
+TEST(route_index, empty_index_finds_nothing)
+{
+  EtcPalIpAddr addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0a650101);
+  TEST_ASSERT_EQUAL_INT(-1, route_index_lookup(&index_under_test, &addr));
+}
+
+TEST(route_index, longest_prefix_wins)
+{
+  EtcPalIpAddr prefix;
+  ETCPAL_IP_SET_V4_ADDRESS(&prefix, 0x0a000000);  // 10.0.0.0
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 8, 1));
+  ETCPAL_IP_SET_V4_ADDRESS(&prefix, 0x0a650000);  // 10.101.0.0
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 16, 2));
+  ETCPAL_IP_SET_V4_ADDRESS(&prefix, 0x0a651400);  // 10.101.20.0
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 24, 3));
+  ETCPAL_IP_SET_V4_ADDRESS(&prefix, 0x0a651401);  // 10.101.20.1
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 32, 4));
+
+  EtcPalIpAddr addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0a010203);  // 10.1.2.3
+  TEST_ASSERT_EQUAL_INT(1, route_index_lookup(&index_under_test, &addr));
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0a650203);  // 10.101.2.3
+  TEST_ASSERT_EQUAL_INT(2, route_index_lookup(&index_under_test, &addr));
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0a651403);  // 10.101.20.3
+  TEST_ASSERT_EQUAL_INT(3, route_index_lookup(&index_under_test, &addr));
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0a651401);  // 10.101.20.1
+  TEST_ASSERT_EQUAL_INT(4, route_index_lookup(&index_under_test, &addr));
+  ETCPAL_IP_SET_V4_ADDRESS(&addr, 0x0b651401);  // 11.101.20.1
+  TEST_ASSERT_EQUAL_INT(-1, route_index_lookup(&index_under_test, &addr));
+}
+
+TEST(route_index, first_route_for_network_wins)
+{
+  // Host bits beyond the prefix length should be ignored, so these routes are both for the same
+  // network.
+  // 2001:db8:1::, 2001:db8:1::1, 2001:db8:1:2::3 and 2001:db8:2::3
+  static const uint8_t kNetwork[ETCPAL_IPV6_BYTES] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01};
+  static const uint8_t kHost[ETCPAL_IPV6_BYTES]    = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+  static const uint8_t kInside[ETCPAL_IPV6_BYTES]  = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3};
+  static const uint8_t kOutside[ETCPAL_IPV6_BYTES] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3};
+
+  EtcPalIpAddr prefix;
+  ETCPAL_IP_SET_V6_ADDRESS(&prefix, kNetwork);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 48, 7));
+  ETCPAL_IP_SET_V6_ADDRESS(&prefix, kHost);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, route_index_insert(&index_under_test, &prefix, 48, 8));
+
+  EtcPalIpAddr addr;
+  ETCPAL_IP_SET_V6_ADDRESS(&addr, kInside);
+  TEST_ASSERT_EQUAL_INT(7, route_index_lookup(&index_under_test, &addr));
+  ETCPAL_IP_SET_V6_ADDRESS(&addr, kOutside);
+  TEST_ASSERT_EQUAL_INT(-1, route_index_lookup(&index_under_test, &addr));
+}
+
+TEST(route_index, invalid_prefix_is_rejected)
+{
+  EtcPalIpAddr prefix;
+  ETCPAL_IP_SET_V4_ADDRESS(&prefix, 0x0a000000);  // 10.0.0.0
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, route_index_insert(&index_under_test, &prefix, 33, 1));
+
+  ETCPAL_IP_SET_INVALID(&prefix);
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, route_index_insert(&index_under_test, &prefix, 0, 1));
+}
+
+TEST(route_index, matches_linear_scan_on_large_ipv4_table)
+{
+  build_synthetic_table(kEtcPalIpTypeV4);
+  check_synthetic_lookups(kEtcPalIpTypeV4);
+}
+
+TEST(route_index, matches_linear_scan_on_large_ipv6_table)
+{
+  build_synthetic_table(kEtcPalIpTypeV6);
+  check_synthetic_lookups(kEtcPalIpTypeV6);
+}
+
+TEST_GROUP_RUNNER(route_index)
+{
+  RUN_TEST_CASE(route_index, empty_index_finds_nothing);
+  RUN_TEST_CASE(route_index, longest_prefix_wins);
+  RUN_TEST_CASE(route_index, first_route_for_network_wins);
+  RUN_TEST_CASE(route_index, invalid_prefix_is_rejected);
+  RUN_TEST_CASE(route_index, matches_linear_scan_on_large_ipv4_table);
+  RUN_TEST_CASE(route_index, matches_linear_scan_on_large_ipv6_table);
+}
@@ -25,12 +25,16 @@
 extern "C" {
 
 ETC_FAKE_VALUE_FUNC(uint32_t, etcpal_getms);
+ETC_FAKE_VALUE_FUNC(uint64_t, etcpal_getns);
+ETC_FAKE_VALUE_FUNC(uint64_t, etcpal_getns_coarse);
 
 TEST_GROUP(timer_controlled);
 
 TEST_SETUP(timer_controlled)
 {
   RESET_FAKE(etcpal_getms);
+  RESET_FAKE(etcpal_getns);
+  RESET_FAKE(etcpal_getns_coarse);
 }
 
 TEST_TEAR_DOWN(timer_controlled)
@@ -93,11 +97,75 @@ TEST(timer_controlled, time_point_now_works)
   TEST_ASSERT_EQUAL_UINT32(tp.value(), 0xffffffffu);
 }
 
+TEST(timer_controlled, getus_works)
+{
+  etcpal_getns_fake.return_val = 0x123456789abcdef0ull;
+  TEST_ASSERT_EQUAL_UINT64(0x123456789abcdef0ull / 1000u, etcpal_getus());
+
+  etcpal_getns_fake.return_val = 999;
+  TEST_ASSERT_EQUAL_UINT64(0u, etcpal_getus());
+}
+
+TEST(timer_controlled, high_res_time_point_works)
+{
+  etcpal_getns_fake.return_val        = 5000000000ull;
+  etcpal_getns_coarse_fake.return_val = 4999000000ull;
+
+  auto tp = etcpal::HighResTimePoint::Now();
+  TEST_ASSERT_EQUAL_UINT64(5000000000ull, tp.value());
+  auto coarse = etcpal::HighResTimePoint::NowCoarse();
+  TEST_ASSERT_EQUAL_UINT64(4999000000ull, coarse.value());
+
+  TEST_ASSERT_TRUE(coarse < tp);
+  TEST_ASSERT_TRUE(tp >= coarse);
+  TEST_ASSERT_TRUE((tp - coarse) == std::chrono::milliseconds(1));
+  TEST_ASSERT_TRUE((coarse - tp) == std::chrono::milliseconds(-1));
+
+  tp += std::chrono::microseconds(250);
+  TEST_ASSERT_EQUAL_UINT64(5000250000ull, tp.value());
+  tp -= std::chrono::nanoseconds(250000);
+  TEST_ASSERT_TRUE(tp == etcpal::HighResTimePoint(5000000000ull));
+}
+
+TEST(timer_controlled, high_res_timer_works)
+{
+  etcpal_getns_fake.return_val = 1000;
+
+  // 44 Hz frame period
+  etcpal::HighResTimer timer(std::chrono::microseconds(22727));
+  TEST_ASSERT_EQUAL_UINT64(1000u, timer.GetStartTime().value());
+  TEST_ASSERT_TRUE(timer.GetInterval() == std::chrono::nanoseconds(22727000));
+  TEST_ASSERT_FALSE(timer.IsExpired());
+
+  etcpal_getns_fake.return_val = 1000 + 22726999;
+  TEST_ASSERT_TRUE(timer.GetElapsed() == std::chrono::nanoseconds(22726999));
+  TEST_ASSERT_TRUE(timer.GetRemaining() == std::chrono::nanoseconds(1));
+  TEST_ASSERT_FALSE(timer.IsExpired());
+
+  etcpal_getns_fake.return_val = 1000 + 22727001;
+  TEST_ASSERT_TRUE(timer.GetRemaining() == std::chrono::nanoseconds(0));
+  TEST_ASSERT_TRUE(timer.IsExpired());
+
+  timer.Reset();
+  TEST_ASSERT_FALSE(timer.IsExpired());
+  TEST_ASSERT_TRUE(timer.GetElapsed() == std::chrono::nanoseconds(0));
+
+  // Zero and negative intervals are always expired.
+  timer.Start(std::chrono::nanoseconds(0));
+  TEST_ASSERT_TRUE(timer.IsExpired());
+  timer.Start(std::chrono::milliseconds(-5));
+  TEST_ASSERT_TRUE(timer.IsExpired());
+  TEST_ASSERT_TRUE(etcpal::HighResTimer().IsExpired());
+}
+
 TEST_GROUP_RUNNER(timer_controlled)
 {
   RUN_TEST_CASE(timer_controlled, timer_wraparound_works_as_expected);
   RUN_TEST_CASE(timer_controlled, elapsed_since_wraparound_works_as_expected);
   RUN_TEST_CASE(timer_controlled, remaining_works_as_expected);
   RUN_TEST_CASE(timer_controlled, time_point_now_works);
+  RUN_TEST_CASE(timer_controlled, getus_works);
+  RUN_TEST_CASE(timer_controlled, high_res_time_point_works);
+  RUN_TEST_CASE(timer_controlled, high_res_timer_works);
 }
 }
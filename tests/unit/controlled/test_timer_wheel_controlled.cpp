@@ -0,0 +1,345 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/timer_wheel.h"
+#include "etcpal/cpp/timer_wheel.h"
+#include "unity_fixture.h"
+#include "etc_fff_wrapper.h"
+
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+
+DECLARE_FAKE_VALUE_FUNC(uint32_t, etcpal_getms);
+
+struct TestTimer
+{
+  EtcPalTimerWheelEntry entry;
+  uint32_t              expiry;
+  uint32_t              fired_at;
+  unsigned int          times_fired;
+};
+
+static EtcPalTimerWheel       wheel;
+static std::vector<TestTimer> timers;
+static std::vector<size_t>    fire_order;
+
+static void record_expiry(EtcPalTimerWheelEntry* entry, void* context)
+{
+  (void)entry;
+  auto timer = static_cast<TestTimer*>(context);
+  timer->fired_at = etcpal_getms();
+  ++timer->times_fired;
+  fire_order.push_back(static_cast<size_t>(timer - timers.data()));
+}
+
+static void schedule_test_timer(size_t index, uint32_t interval)
+{
+  TestTimer& timer = timers[index];
+  etcpal_timer_wheel_entry_init(&timer.entry, record_expiry, &timer);
+  timer.expiry      = etcpal_getms() + interval;
+  timer.times_fired = 0;
+  etcpal_timer_wheel_schedule(&wheel, &timer.entry, interval);
+}
+
+TEST_GROUP(timer_wheel_controlled);
+
+TEST_SETUP(timer_wheel_controlled)
+{
+  RESET_FAKE(etcpal_getms);
+  etcpal_getms_fake.return_val = 1000;
+  etcpal_timer_wheel_init(&wheel);
+  timers.clear();
+  fire_order.clear();
+}
+
+TEST_TEAR_DOWN(timer_wheel_controlled)
+{
+  etcpal_timer_wheel_clear(&wheel);
+}
+
+TEST(timer_wheel_controlled, timers_expire_at_exact_time)
+{
+  // Intervals on either side of each level boundary
+  const uint32_t intervals[] = {1u, 2u, 63u, 64u, 65u, 4095u, 4096u, 4097u, 262143u, 262144u, 300000u, 16777217u};
+  const size_t   num_timers  = sizeof(intervals) / sizeof(intervals[0]);
+
+  timers.resize(num_timers);
+  for (size_t i = 0; i < num_timers; ++i)
+    schedule_test_timer(i, intervals[i]);
+  TEST_ASSERT_EQUAL_UINT(num_timers, etcpal_timer_wheel_size(&wheel));
+
+  for (size_t i = 0; i < num_timers; ++i)
+  {
+    etcpal_getms_fake.return_val = timers[i].expiry - 1;
+    TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_process(&wheel));
+    TEST_ASSERT_TRUE(etcpal_timer_wheel_is_scheduled(&timers[i].entry));
+
+    etcpal_getms_fake.return_val = timers[i].expiry;
+    TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+    TEST_ASSERT_EQUAL_UINT(1u, timers[i].times_fired);
+    TEST_ASSERT_FALSE(etcpal_timer_wheel_is_scheduled(&timers[i].entry));
+    TEST_ASSERT_EQUAL_UINT(num_timers - i - 1, etcpal_timer_wheel_size(&wheel));
+  }
+}
+
+TEST(timer_wheel_controlled, timers_expire_in_order)
+{
+  const size_t num_timers = 2000;
+
+  timers.resize(num_timers);
+  for (size_t i = 0; i < num_timers; ++i)
+    schedule_test_timer(i, static_cast<uint32_t>(rand() % 100000));
+
+  etcpal_getms_fake.return_val += 100000;
+  TEST_ASSERT_EQUAL_UINT(num_timers, etcpal_timer_wheel_process(&wheel));
+  TEST_ASSERT_EQUAL_UINT(num_timers, fire_order.size());
+  for (size_t i = 1; i < num_timers; ++i)
+  {
+    TEST_ASSERT_TRUE(static_cast<int32_t>(timers[fire_order[i]].expiry - timers[fire_order[i - 1]].expiry) >= 0);
+  }
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_size(&wheel));
+  TEST_ASSERT_EQUAL_INT(ETCPAL_WAIT_FOREVER, etcpal_timer_wheel_next_timeout(&wheel));
+}
+
+TEST(timer_wheel_controlled, zero_interval_expires_on_next_process)
+{
+  timers.resize(1);
+  schedule_test_timer(0, 0);
+  TEST_ASSERT_EQUAL_INT(0, etcpal_timer_wheel_next_timeout(&wheel));
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+  TEST_ASSERT_EQUAL_UINT(1u, timers[0].times_fired);
+}
+
+TEST(timer_wheel_controlled, cancel_and_reschedule_work)
+{
+  timers.resize(3);
+  schedule_test_timer(0, 100);
+  schedule_test_timer(1, 5000);
+  schedule_test_timer(2, 200);
+
+  etcpal_timer_wheel_cancel(&wheel, &timers[0].entry);
+  TEST_ASSERT_FALSE(etcpal_timer_wheel_is_scheduled(&timers[0].entry));
+  TEST_ASSERT_EQUAL_UINT(2u, etcpal_timer_wheel_size(&wheel));
+
+  // Cancelling twice is harmless.
+  etcpal_timer_wheel_cancel(&wheel, &timers[0].entry);
+  TEST_ASSERT_EQUAL_UINT(2u, etcpal_timer_wheel_size(&wheel));
+
+  // Rescheduling replaces the previous expiry time.
+  timers[1].expiry = etcpal_getms() + 50;
+  etcpal_timer_wheel_schedule(&wheel, &timers[1].entry, 50);
+  TEST_ASSERT_EQUAL_UINT(2u, etcpal_timer_wheel_size(&wheel));
+
+  etcpal_getms_fake.return_val += 10000;
+  TEST_ASSERT_EQUAL_UINT(2u, etcpal_timer_wheel_process(&wheel));
+  TEST_ASSERT_EQUAL_UINT(0u, timers[0].times_fired);
+  TEST_ASSERT_EQUAL_UINT(1u, timers[1].times_fired);
+  TEST_ASSERT_EQUAL_UINT(1u, timers[2].times_fired);
+  TEST_ASSERT_EQUAL_UINT(2u, fire_order.size());
+  TEST_ASSERT_EQUAL_UINT(1u, fire_order[0]);
+  TEST_ASSERT_EQUAL_UINT(2u, fire_order[1]);
+}
+
+static unsigned int periodic_count;
+
+static void periodic_expiry(EtcPalTimerWheelEntry* entry, void* context)
+{
+  (void)context;
+  ++periodic_count;
+  etcpal_timer_wheel_schedule(&wheel, entry, 10);
+}
+
+static void cancel_other_expiry(EtcPalTimerWheelEntry* entry, void* context)
+{
+  (void)entry;
+  etcpal_timer_wheel_cancel(&wheel, static_cast<EtcPalTimerWheelEntry*>(context));
+}
+
+TEST(timer_wheel_controlled, callbacks_can_reschedule_and_cancel)
+{
+  EtcPalTimerWheelEntry periodic;
+  etcpal_timer_wheel_entry_init(&periodic, periodic_expiry, nullptr);
+  etcpal_timer_wheel_schedule(&wheel, &periodic, 10);
+  periodic_count = 0;
+
+  // Step one ms at a time: the timer should fire every 10 ms.
+  for (int i = 0; i < 100; ++i)
+  {
+    ++etcpal_getms_fake.return_val;
+    etcpal_timer_wheel_process(&wheel);
+  }
+  TEST_ASSERT_EQUAL_UINT(10u, periodic_count);
+  TEST_ASSERT_TRUE(etcpal_timer_wheel_is_scheduled(&periodic));
+
+  // A timer which expires at the same time as another can cancel it from its callback.
+  timers.resize(1);
+  EtcPalTimerWheelEntry canceller;
+  etcpal_timer_wheel_entry_init(&canceller, cancel_other_expiry, &timers[0].entry);
+  etcpal_timer_wheel_schedule(&wheel, &canceller, 5);
+  schedule_test_timer(0, 5);
+  etcpal_timer_wheel_cancel(&wheel, &periodic);
+
+  etcpal_getms_fake.return_val += 5;
+  etcpal_timer_wheel_process(&wheel);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_size(&wheel));
+
+  // Which one runs first is unspecified; exactly one of them fires.
+  TEST_ASSERT_FALSE(etcpal_timer_wheel_is_scheduled(&timers[0].entry));
+  TEST_ASSERT_FALSE(etcpal_timer_wheel_is_scheduled(&canceller));
+}
+
+TEST(timer_wheel_controlled, next_timeout_works)
+{
+  TEST_ASSERT_EQUAL_INT(ETCPAL_WAIT_FOREVER, etcpal_timer_wheel_next_timeout(&wheel));
+
+  timers.resize(2);
+  schedule_test_timer(0, 30);
+  TEST_ASSERT_EQUAL_INT(30, etcpal_timer_wheel_next_timeout(&wheel));
+
+  // Time passing without processing is accounted for.
+  etcpal_getms_fake.return_val += 10;
+  TEST_ASSERT_EQUAL_INT(20, etcpal_timer_wheel_next_timeout(&wheel));
+  etcpal_getms_fake.return_val += 30;
+  TEST_ASSERT_EQUAL_INT(0, etcpal_timer_wheel_next_timeout(&wheel));
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+
+  // Longer timeouts are never overestimated, and waiting repeatedly converges on the exact expiry.
+  schedule_test_timer(1, 100000);
+  int waits = 0;
+  while (timers[1].times_fired == 0)
+  {
+    int timeout = etcpal_timer_wheel_next_timeout(&wheel);
+    TEST_ASSERT_TRUE(timeout > 0);
+    etcpal_getms_fake.return_val += static_cast<uint32_t>(timeout);
+    TEST_ASSERT_TRUE(static_cast<int32_t>(timers[1].expiry - etcpal_getms_fake.return_val) >= 0);
+    etcpal_timer_wheel_process(&wheel);
+    TEST_ASSERT_TRUE(++waits < 10);
+  }
+  TEST_ASSERT_EQUAL_UINT32(timers[1].expiry, timers[1].fired_at);
+}
+
+TEST(timer_wheel_controlled, wraparound_works)
+{
+  etcpal_getms_fake.return_val = 0xffffff00u;
+  etcpal_timer_wheel_init(&wheel);
+
+  timers.resize(3);
+  schedule_test_timer(0, 0x80);
+  schedule_test_timer(1, 0x100);
+  schedule_test_timer(2, 0x10000);
+
+  etcpal_getms_fake.return_val = 0xffffffffu;
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+  etcpal_getms_fake.return_val = 0;
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+  TEST_ASSERT_EQUAL_UINT32(0u, timers[1].fired_at);
+  etcpal_getms_fake.return_val = 0xfeff;
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_process(&wheel));
+  etcpal_getms_fake.return_val = 0xff00;
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+}
+
+TEST(timer_wheel_controlled, max_interval_works)
+{
+  timers.resize(1);
+  schedule_test_timer(0, 0xffffffffu);
+  timers[0].expiry = etcpal_getms() + ETCPAL_TIMER_WHEEL_MAX_INTERVAL;
+
+  etcpal_getms_fake.return_val = timers[0].expiry - 1;
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_process(&wheel));
+  TEST_ASSERT_EQUAL_INT(1, etcpal_timer_wheel_next_timeout(&wheel));
+  etcpal_getms_fake.return_val = timers[0].expiry;
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_timer_wheel_process(&wheel));
+}
+
+// Schedule 100,000 timers and process the wheel at irregular intervals, checking that each timer
+// fires on the first call to process after its expiry time.
+TEST(timer_wheel_controlled, many_timers_work)
+{
+  const size_t num_timers = 100000;
+
+  timers.resize(num_timers);
+  for (size_t i = 0; i < num_timers; ++i)
+    schedule_test_timer(i, static_cast<uint32_t>(rand() % 600000));
+  TEST_ASSERT_EQUAL_UINT(num_timers, etcpal_timer_wheel_size(&wheel));
+
+  size_t total_fired = 0;
+  while (total_fired < num_timers)
+  {
+    etcpal_getms_fake.return_val += static_cast<uint32_t>(rand() % 200);
+    total_fired += etcpal_timer_wheel_process(&wheel);
+  }
+  TEST_ASSERT_EQUAL_UINT(num_timers, total_fired);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_timer_wheel_size(&wheel));
+
+  for (const TestTimer& timer : timers)
+  {
+    TEST_ASSERT_EQUAL_UINT(1u, timer.times_fired);
+    TEST_ASSERT_TRUE(static_cast<int32_t>(timer.fired_at - timer.expiry) >= 0);
+    TEST_ASSERT_TRUE(static_cast<int32_t>(timer.fired_at - timer.expiry) < 200);
+  }
+}
+
+TEST(timer_wheel_controlled, cpp_wrapper_works)
+{
+  etcpal::TimerWheel cpp_wheel;
+
+  int                       count = 0;
+  etcpal::TimerWheel::Timer timer([&]() { ++count; });
+  {
+    etcpal::TimerWheel::Timer scoped_timer([&]() { count += 100; });
+    cpp_wheel.Schedule(scoped_timer, 10);
+    TEST_ASSERT_TRUE(scoped_timer.IsScheduled());
+    TEST_ASSERT_EQUAL_UINT(1u, cpp_wheel.size());
+  }
+  // Destroying the timer cancels it.
+  TEST_ASSERT_EQUAL_UINT(0u, cpp_wheel.size());
+
+  cpp_wheel.Schedule(timer, 20);
+  TEST_ASSERT_EQUAL_INT(20, cpp_wheel.NextTimeout());
+  etcpal_getms_fake.return_val += 20;
+  TEST_ASSERT_EQUAL_UINT(1u, cpp_wheel.Process());
+  TEST_ASSERT_EQUAL_INT(1, count);
+  TEST_ASSERT_FALSE(timer.IsScheduled());
+
+  timer.SetHandler([&]() { count = -1; });
+  cpp_wheel.Schedule(timer, 5);
+  cpp_wheel.Cancel(timer);
+  cpp_wheel.Schedule(timer, 5);
+  etcpal_getms_fake.return_val += 5;
+  cpp_wheel.Process();
+  TEST_ASSERT_EQUAL_INT(-1, count);
+}
+
+TEST_GROUP_RUNNER(timer_wheel_controlled)
+{
+  RUN_TEST_CASE(timer_wheel_controlled, timers_expire_at_exact_time);
+  RUN_TEST_CASE(timer_wheel_controlled, timers_expire_in_order);
+  RUN_TEST_CASE(timer_wheel_controlled, zero_interval_expires_on_next_process);
+  RUN_TEST_CASE(timer_wheel_controlled, cancel_and_reschedule_work);
+  RUN_TEST_CASE(timer_wheel_controlled, callbacks_can_reschedule_and_cancel);
+  RUN_TEST_CASE(timer_wheel_controlled, next_timeout_works);
+  RUN_TEST_CASE(timer_wheel_controlled, wraparound_works);
+  RUN_TEST_CASE(timer_wheel_controlled, max_interval_works);
+  RUN_TEST_CASE(timer_wheel_controlled, many_timers_work);
+  RUN_TEST_CASE(timer_wheel_controlled, cpp_wrapper_works);
+}
+}
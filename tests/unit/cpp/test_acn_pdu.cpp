@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/acn_pdu.h"
+#include "unity_fixture.h"
+
+#include <array>
+#include <vector>
+
+namespace
+{
+constexpr AcnPduConstraints kTestConstraints{4, 2};
+
+// Append a PDU with the given inheritance to a block.
+void AddPdu(std::vector<uint8_t>& block, bool vector, bool header, size_t data_len)
+{
+  const size_t start = block.size();
+  uint8_t      flags = 0;
+  if (vector)
+    ACN_PDU_SET_V_FLAG(flags);
+  if (header)
+    ACN_PDU_SET_H_FLAG(flags);
+  if (data_len)
+    ACN_PDU_SET_D_FLAG(flags);
+  block.push_back(flags);
+  block.push_back(0);
+
+  if (vector)
+    block.insert(block.end(), kTestConstraints.vector_size, static_cast<uint8_t>(start));
+  if (header)
+    block.insert(block.end(), kTestConstraints.header_size, 0xaa);
+  block.insert(block.end(), data_len, 0x55);
+  ACN_PDU_PACK_NORMAL_LEN(&block[start], block.size() - start);
+}
+
+std::vector<uint8_t> MakeTestBlock(size_t num_pdus)
+{
+  std::vector<uint8_t> block;
+  AddPdu(block, true, true, 10);
+  for (size_t i = 1; i < num_pdus; ++i)
+    AddPdu(block, (i % 2) == 0, (i % 3) == 0, (i % 4) == 0 ? 0 : (i % 17));
+  return block;
+}
+}  // namespace
+
+extern "C" {
+TEST_GROUP(etcpal_cpp_acn_pdu);
+
+TEST_SETUP(etcpal_cpp_acn_pdu)
+{
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_acn_pdu)
+{
+}
+
+TEST(etcpal_cpp_acn_pdu, range_matches_parse_pdu)
+{
+  const auto block = MakeTestBlock(100);
+
+  AcnPdu c_pdu      = ACN_PDU_INIT;
+  size_t num_parsed = 0;
+  for (const AcnPdu& pdu : etcpal::acn::PduRange(block.data(), block.size(), kTestConstraints))
+  {
+    TEST_ASSERT_TRUE(acn_parse_pdu(block.data(), block.size(), &kTestConstraints, &c_pdu));
+    TEST_ASSERT_EQUAL_PTR(c_pdu.pvector, pdu.pvector);
+    TEST_ASSERT_EQUAL_PTR(c_pdu.pheader, pdu.pheader);
+    TEST_ASSERT_EQUAL_PTR(c_pdu.pdata, pdu.pdata);
+    TEST_ASSERT_EQUAL_UINT(c_pdu.data_len, pdu.data_len);
+    TEST_ASSERT_EQUAL_PTR(c_pdu.pnextpdu, pdu.pnextpdu);
+    ++num_parsed;
+  }
+  TEST_ASSERT_EQUAL_UINT(100u, num_parsed);
+  TEST_ASSERT_FALSE(acn_parse_pdu(block.data(), block.size(), &kTestConstraints, &c_pdu));
+}
+
+TEST(etcpal_cpp_acn_pdu, range_stops_at_malformed_pdu)
+{
+  auto block = MakeTestBlock(3);
+  // Truncate the last PDU.
+  block.pop_back();
+
+  etcpal::acn::PduRange range(block.data(), block.size(), kTestConstraints);
+  TEST_ASSERT_EQUAL(2, std::distance(range.begin(), range.end()));
+
+  // A first PDU which inherits anything is malformed.
+  std::vector<uint8_t> bad_block;
+  AddPdu(bad_block, false, true, 10);
+  etcpal::acn::PduRange bad_range(bad_block.data(), bad_block.size(), kTestConstraints);
+  TEST_ASSERT_TRUE(bad_range.begin() == bad_range.end());
+}
+
+TEST(etcpal_cpp_acn_pdu, empty_range_works)
+{
+  etcpal::acn::PduRange range(nullptr, 0, kTestConstraints);
+  TEST_ASSERT_TRUE(range.begin() == range.end());
+}
+
+TEST_GROUP_RUNNER(etcpal_cpp_acn_pdu)
+{
+  RUN_TEST_CASE(etcpal_cpp_acn_pdu, range_matches_parse_pdu);
+  RUN_TEST_CASE(etcpal_cpp_acn_pdu, range_stops_at_malformed_pdu);
+  RUN_TEST_CASE(etcpal_cpp_acn_pdu, empty_range_works);
+}
+}
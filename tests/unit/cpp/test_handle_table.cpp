@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/handle_table.h"
+#include "etcpal/cpp/opaque_id.h"
+#include "unity_fixture.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct TestHandleType
+{
+};
+using TestHandle = etcpal::OpaqueId<TestHandleType, int, -1>;
+
+// Counts live instances, to check that the table constructs and destroys resources correctly.
+class TestResource
+{
+public:
+  TestResource(int number, std::string name) : number_(number), name_(std::move(name)) { ++num_live_; }
+  TestResource(const TestResource& other) : number_(other.number_), name_(other.name_) { ++num_live_; }
+  ~TestResource() { --num_live_; }
+
+  int                number() const { return number_; }
+  const std::string& name() const { return name_; }
+
+  static int num_live_;
+
+private:
+  int         number_;
+  std::string name_;
+};
+
+int TestResource::num_live_ = 0;
+
+#if ETCPAL_BUILDING_WITH_EXCEPTIONS
+// A resource whose constructor throws on request, after the table has allocated a handle for it.
+class ThrowingResource
+{
+public:
+  explicit ThrowingResource(bool fail)
+  {
+    if (fail)
+      throw std::runtime_error("construction failed");
+    ++TestResource::num_live_;
+  }
+  ThrowingResource(const ThrowingResource& other) = delete;
+  ThrowingResource& operator=(const ThrowingResource& other) = delete;
+  ~ThrowingResource() { --TestResource::num_live_; }
+};
+#endif
+
+extern "C" {
+TEST_GROUP(etcpal_cpp_handle_table);
+
+TEST_SETUP(etcpal_cpp_handle_table)
+{
+  TestResource::num_live_ = 0;
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_handle_table)
+{
+}
+
+TEST(etcpal_cpp_handle_table, insert_find_and_erase_work)
+{
+  etcpal::HandleTable<TestHandle, TestResource> table;
+  TEST_ASSERT_TRUE(table.empty());
+
+  std::vector<TestHandle> handles;
+  for (int i = 0; i < 100; ++i)
+  {
+    auto handle = table.Emplace(i, "resource " + std::to_string(i));
+    TEST_ASSERT_TRUE(handle);
+    handles.push_back(*handle);
+  }
+  TEST_ASSERT_EQUAL_UINT(100u, table.size());
+  TEST_ASSERT_EQUAL_INT(100, TestResource::num_live_);
+
+  // Resources are not moved when the table grows.
+  const TestResource* first = table.Find(handles[0]);
+  TEST_ASSERT_NOT_NULL(first);
+  TEST_ASSERT_TRUE(table.Insert(TestResource(100, "resource 100")));
+  TEST_ASSERT_EQUAL_PTR(first, table.Find(handles[0]));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const TestResource* resource = table.Find(handles[i]);
+    TEST_ASSERT_NOT_NULL(resource);
+    TEST_ASSERT_EQUAL_INT(i, resource->number());
+    TEST_ASSERT_EQUAL_STRING(("resource " + std::to_string(i)).c_str(), resource->name().c_str());
+  }
+
+  TEST_ASSERT_TRUE(table.Erase(handles[10]));
+  TEST_ASSERT_FALSE(table.Erase(handles[10]));
+  TEST_ASSERT_FALSE(table.Contains(handles[10]));
+  TEST_ASSERT_NULL(table.Find(handles[10]));
+  TEST_ASSERT_EQUAL_INT(100, TestResource::num_live_);
+
+  // The slot of the erased resource is reused with a new handle.
+  auto reused = table.Emplace(-1, "reused");
+  TEST_ASSERT_TRUE(reused);
+  TEST_ASSERT_TRUE(*reused != handles[10]);
+  TEST_ASSERT_NULL(table.Find(handles[10]));
+  TEST_ASSERT_EQUAL_INT(-1, table.Find(*reused)->number());
+
+  TEST_ASSERT_NULL(table.Find(TestHandle::Invalid()));
+  TEST_ASSERT_FALSE(table.Erase(TestHandle::Invalid()));
+
+  table.Clear();
+  TEST_ASSERT_TRUE(table.empty());
+  TEST_ASSERT_EQUAL_INT(0, TestResource::num_live_);
+  TEST_ASSERT_FALSE(table.Contains(handles[0]));
+}
+
+TEST(etcpal_cpp_handle_table, max_size_is_enforced)
+{
+  etcpal::HandleTable<TestHandle, std::unique_ptr<int>> table(4);
+  for (int i = 0; i < 4; ++i)
+    TEST_ASSERT_TRUE(table.Emplace(std::unique_ptr<int>(new int(i))));
+
+  auto result = table.Emplace(std::unique_ptr<int>(new int(4)));
+  TEST_ASSERT_FALSE(result);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, result.error_code());
+}
+
+TEST(etcpal_cpp_handle_table, invalid_max_size_fails_cleanly)
+{
+  etcpal::HandleTable<TestHandle, TestResource> table(0);
+  TEST_ASSERT_TRUE(table.empty());
+
+  auto result = table.Emplace(1, "one");
+  TEST_ASSERT_FALSE(result);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, result.error_code());
+  TEST_ASSERT_TRUE(table.empty());
+  TEST_ASSERT_EQUAL(0, TestResource::num_live_);
+
+  etcpal::HandleTable<TestHandle, TestResource> too_big_table(ETCPAL_HANDLE_TABLE_MAX_SIZE + 1);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, too_big_table.Emplace(1, "one").error_code());
+}
+
+TEST(etcpal_cpp_handle_table, for_each_visits_each_resource)
+{
+  {
+    etcpal::HandleTable<TestHandle, TestResource> table;
+    for (int i = 0; i < 20; ++i)
+      (void)table.Emplace(i, "");
+
+    int sum   = 0;
+    int count = 0;
+    table.ForEach([&](TestHandle handle, TestResource& resource) {
+      TEST_ASSERT_EQUAL_PTR(&resource, table.Find(handle));
+      sum += resource.number();
+      ++count;
+    });
+    TEST_ASSERT_EQUAL_INT(20, count);
+    TEST_ASSERT_EQUAL_INT(190, sum);
+  }
+
+  // The destructor destroys the remaining resources.
+  TEST_ASSERT_EQUAL_INT(0, TestResource::num_live_);
+}
+
+#if ETCPAL_BUILDING_WITH_EXCEPTIONS
+TEST(etcpal_cpp_handle_table, throwing_constructor_frees_handle)
+{
+  {
+    etcpal::HandleTable<TestHandle, ThrowingResource> table;
+    TEST_ASSERT_TRUE(table.Emplace(false));
+    TEST_ASSERT_TRUE(table.Emplace(false));
+
+    bool threw = false;
+    try
+    {
+      (void)table.Emplace(true);
+    }
+    catch (const std::runtime_error&)
+    {
+      threw = true;
+    }
+    TEST_ASSERT_TRUE(threw);
+
+    // The handle allocated for the failed resource was freed, so it is not visited or destroyed.
+    TEST_ASSERT_EQUAL_UINT(2u, table.size());
+    int count = 0;
+    table.ForEach([&](TestHandle, ThrowingResource&) { ++count; });
+    TEST_ASSERT_EQUAL_INT(2, count);
+
+    // The table is still usable afterwards.
+    TEST_ASSERT_TRUE(table.Emplace(false));
+    TEST_ASSERT_EQUAL_INT(3, TestResource::num_live_);
+  }
+
+  TEST_ASSERT_EQUAL_INT(0, TestResource::num_live_);
+}
+#endif
+
+TEST_GROUP_RUNNER(etcpal_cpp_handle_table)
+{
+  RUN_TEST_CASE(etcpal_cpp_handle_table, insert_find_and_erase_work);
+  RUN_TEST_CASE(etcpal_cpp_handle_table, max_size_is_enforced);
+  RUN_TEST_CASE(etcpal_cpp_handle_table, invalid_max_size_fails_cleanly);
+  RUN_TEST_CASE(etcpal_cpp_handle_table, for_each_visits_each_resource);
+#if ETCPAL_BUILDING_WITH_EXCEPTIONS
+  RUN_TEST_CASE(etcpal_cpp_handle_table, throwing_constructor_frees_handle);
+#endif
+}
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/hashmap.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include "etcpal/cpp/uuid.h"
+#include "unity_fixture.h"
+
+extern "C" {
+
+TEST_GROUP(etcpal_cpp_hashmap);
+
+TEST_SETUP(etcpal_cpp_hashmap)
+{
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_hashmap)
+{
+}
+
+struct Point
+{
+  int32_t x;
+  int32_t y;
+};
+
+TEST(etcpal_cpp_hashmap, dynamic_map_works)
+{
+  etcpal::FlatHashMap<uint32_t, Point> map;
+  TEST_ASSERT_TRUE(map.empty());
+
+  for (uint32_t i = 0; i < 1000; ++i)
+    TEST_ASSERT_TRUE(map.Insert(i, Point{static_cast<int32_t>(i), -static_cast<int32_t>(i)}).IsOk());
+  TEST_ASSERT_EQUAL_UINT(1000u, map.size());
+  TEST_ASSERT_EQUAL(kEtcPalErrExists, map.Insert(5, Point{0, 0}).code());
+
+  const auto& const_map = map;
+  for (uint32_t i = 0; i < 1000; ++i)
+  {
+    const Point* point = const_map.Find(i);
+    TEST_ASSERT_NOT_NULL(point);
+    TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(i), point->x);
+  }
+  TEST_ASSERT_FALSE(map.Contains(1000));
+
+  TEST_ASSERT_TRUE(map.InsertOrAssign(5, Point{50, 50}).IsOk());
+  TEST_ASSERT_EQUAL_INT32(50, map.Find(5)->x);
+  TEST_ASSERT_EQUAL_UINT(1000u, map.size());
+
+  TEST_ASSERT_TRUE(map.Erase(5));
+  TEST_ASSERT_FALSE(map.Erase(5));
+  TEST_ASSERT_FALSE(map.Contains(5));
+
+  size_t count = 0;
+  map.ForEach([&](const uint32_t& key, Point& point) {
+    TEST_ASSERT_EQUAL_INT32(-static_cast<int32_t>(key), point.y);
+    ++count;
+  });
+  TEST_ASSERT_EQUAL_UINT(999u, count);
+
+  map.Clear();
+  TEST_ASSERT_TRUE(map.empty());
+}
+
+TEST(etcpal_cpp_hashmap, static_map_works)
+{
+  using Map = etcpal::FlatHashMap<int, int>;
+
+  alignas(8) static uint8_t storage[Map::StorageSize(16)];
+  Map                       map(storage, 16);
+  TEST_ASSERT_EQUAL_UINT(16u, map.capacity());
+
+  for (int i = 0; i < 16; ++i)
+    TEST_ASSERT_TRUE(map.Insert(i, i * i).IsOk());
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, map.Insert(16, 0).code());
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, map.InsertOrAssign(16, 0).code());
+  TEST_ASSERT_TRUE(map.InsertOrAssign(4, 0).IsOk());
+  TEST_ASSERT_EQUAL_INT(0, *map.Find(4));
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, map.Reserve(17).code());
+}
+
+TEST(etcpal_cpp_hashmap, uuid_keys_work)
+{
+  etcpal::FlatHashMap<EtcPalUuid, int> map;
+
+  const std::array<uint8_t, 6>          mac = {0x00, 0xc0, 0x16, 0x01, 0x02, 0x03};
+  std::unordered_map<etcpal::Uuid, int> reference;
+  for (int i = 0; i < 200; ++i)
+  {
+    auto uuid = etcpal::Uuid::Device("hashmap test", mac, static_cast<uint32_t>(i));
+    TEST_ASSERT_TRUE(map.Insert(uuid.get(), i).IsOk());
+    reference[uuid] = i;
+  }
+
+  for (const auto& entry : reference)
+  {
+    const int* value = map.Find(entry.first.get());
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT(entry.second, *value);
+  }
+  TEST_ASSERT_FALSE(map.Contains(kEtcPalNullUuid));
+}
+
+TEST_GROUP_RUNNER(etcpal_cpp_hashmap)
+{
+  RUN_TEST_CASE(etcpal_cpp_hashmap, dynamic_map_works);
+  RUN_TEST_CASE(etcpal_cpp_hashmap, static_map_works);
+  RUN_TEST_CASE(etcpal_cpp_hashmap, uuid_keys_work);
+}
+}
@@ -18,6 +18,7 @@
  ******************************************************************************/
 
 #include "etcpal/cpp/inet.h"
+#include "etcpal/cpp/hashmap.h"
 #include "unity_fixture.h"
 
 #include <algorithm>
@@ -755,6 +756,37 @@ TEST(etcpal_cpp_inet, invalid_ips_hash_to_same_value)
   TEST_ASSERT_EQUAL(1u, ips.size());
 }
 
+TEST(etcpal_cpp_inet, c_types_work_as_flat_hash_map_keys)
+{
+  // The std::hash specializations for the C types ignore the IPv6 scope ID, like operator==.
+  EtcPalIpAddr scoped_1 = etcpal::IpAddr::FromString("fe80::1").get();
+  EtcPalIpAddr scoped_2 = scoped_1;
+  scoped_1.addr.v6.scope_id = 1;
+  scoped_2.addr.v6.scope_id = 2;
+  TEST_ASSERT_TRUE(scoped_1 == scoped_2);
+  TEST_ASSERT_EQUAL(std::hash<EtcPalIpAddr>()(scoped_1), std::hash<EtcPalIpAddr>()(scoped_2));
+
+  etcpal::FlatHashMap<EtcPalSockAddr, int> map;
+  EtcPalSockAddr                           sock_addr;
+  sock_addr.ip = etcpal::IpAddr::FromString("10.101.0.1").get();
+  for (int i = 0; i < 100; ++i)
+  {
+    sock_addr.port = static_cast<uint16_t>(5568 + i);
+    TEST_ASSERT_TRUE(map.Insert(sock_addr, i).IsOk());
+  }
+
+  sock_addr.ip = etcpal::IpAddr::FromString("10.101.0.1").get();
+  for (int i = 0; i < 100; ++i)
+  {
+    sock_addr.port   = static_cast<uint16_t>(5568 + i);
+    const int* value = map.Find(sock_addr);
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT(i, *value);
+  }
+  sock_addr.ip = etcpal::IpAddr::FromString("10.101.0.2").get();
+  TEST_ASSERT_FALSE(map.Contains(sock_addr));
+}
+
 TEST_GROUP_RUNNER(etcpal_cpp_inet)
 {
   RUN_TEST_CASE(etcpal_cpp_inet, c_ipaddr_equality_operators_work);
@@ -795,5 +827,6 @@ TEST_GROUP_RUNNER(etcpal_cpp_inet)
   RUN_TEST_CASE(etcpal_cpp_inet, adding_sockaddrs_to_unordered_set_works);
   RUN_TEST_CASE(etcpal_cpp_inet, adding_macaddrs_to_unordered_set_works);
   RUN_TEST_CASE(etcpal_cpp_inet, invalid_ips_hash_to_same_value);
+  RUN_TEST_CASE(etcpal_cpp_inet, c_types_work_as_flat_hash_map_keys);
 }
 }
@@ -20,6 +20,11 @@
 #include "etcpal/cpp/log.h"
 #include "unity_fixture.h"
 
+#include <array>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <functional>
 #include <string>
 #include <vector>
@@ -93,11 +98,38 @@ TEST(etcpal_cpp_log_timestamp, value_constructor_works)
   TEST_ASSERT_EQUAL_INT(timestamp.get().utc_offset, -60);
 }
 
+// LogTimestamp::Now() should agree with the C library's idea of the current local time.
+TEST(etcpal_cpp_log_timestamp, now_works)
+{
+  std::time_t before = std::time(nullptr);
+  auto        first  = etcpal::LogTimestamp::Now();
+  auto        second = etcpal::LogTimestamp::Now();
+  std::time_t after  = std::time(nullptr);
+
+  TEST_ASSERT_TRUE(first.IsValid());
+  TEST_ASSERT_TRUE(second.IsValid());
+  TEST_ASSERT_EQUAL_INT(first.get().utc_offset, second.get().utc_offset);
+
+  // Compare against the local time unless a second boundary was crossed while getting the time.
+  if (before == after)
+  {
+    std::tm local_tm = *std::localtime(&before);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_year + 1900), second.get().year);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_mon + 1), second.get().month);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_mday), second.get().day);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_hour), second.get().hour);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_min), second.get().minute);
+    TEST_ASSERT_EQUAL_UINT(static_cast<unsigned int>(local_tm.tm_sec), second.get().second);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT(first.get().msec, second.get().msec);
+  }
+}
+
 TEST_GROUP_RUNNER(etcpal_cpp_log_timestamp)
 {
   RUN_TEST_CASE(etcpal_cpp_log_timestamp, default_constructor_works);
   RUN_TEST_CASE(etcpal_cpp_log_timestamp, invalid_works);
   RUN_TEST_CASE(etcpal_cpp_log_timestamp, value_constructor_works);
+  RUN_TEST_CASE(etcpal_cpp_log_timestamp, now_works);
 }
 
 TEST_GROUP(etcpal_cpp_log);
@@ -337,6 +369,153 @@ TEST(etcpal_cpp_log, queued_dispatch_works)
   TEST_ASSERT_EQUAL_STRING(log_strs[2].c_str(), "1970-01-01 00:00:00.000Z [DBUG] Test Message 3");
 }
 
+// Log a message which stalls the dispatch thread in the log handler, then log num_messages more
+// while it is stalled. Returns the raw strings of all messages dispatched.
+static std::vector<std::string> LogWhileDispatchStalled(int num_messages)
+{
+  std::vector<std::string> log_strs;
+  etcpal::Signal           dispatch_stalled;
+  etcpal::Signal           release_dispatch;
+  test_log_handler.OnLogEvent([&](const EtcPalLogStrings& strings) {
+    log_strs.emplace_back(strings.raw);
+    if (log_strs.size() == 1)
+    {
+      dispatch_stalled.Notify();
+      release_dispatch.Wait();
+    }
+  });
+
+  logger.Debug("Stall");
+  dispatch_stalled.Wait();
+  for (int i = 1; i <= num_messages; ++i)
+    logger.Debug("%d", i);
+  release_dispatch.Notify();
+
+  logger.Shutdown();
+  return log_strs;
+}
+
+TEST(etcpal_cpp_log, queued_drop_newest_works)
+{
+  TEST_ASSERT_TRUE(logger.SetDispatchPolicy(etcpal::LogDispatchPolicy::kQueued)
+                       .SetOverflowPolicy(etcpal::LogOverflowPolicy::kDropNewest)
+                       .SetLogQueueCapacity(4)
+                       .Startup(test_log_handler));
+  TEST_ASSERT_EQUAL_UINT(4u, logger.log_queue_capacity());
+
+  auto log_strs = LogWhileDispatchStalled(6);
+
+  // The last two messages should have been dropped.
+  const std::vector<std::string> expected = {"Stall", "1", "2", "3", "4"};
+  TEST_ASSERT_TRUE(log_strs == expected);
+  TEST_ASSERT_EQUAL_UINT(2u, logger.dropped_message_count());
+}
+
+TEST(etcpal_cpp_log, queued_drop_oldest_works)
+{
+  TEST_ASSERT_TRUE(logger.SetDispatchPolicy(etcpal::LogDispatchPolicy::kQueued)
+                       .SetOverflowPolicy(etcpal::LogOverflowPolicy::kDropOldest)
+                       .SetLogQueueCapacity(4)
+                       .Startup(test_log_handler));
+
+  auto log_strs = LogWhileDispatchStalled(6);
+
+  // The first two messages logged while stalled should have been dropped.
+  const std::vector<std::string> expected = {"Stall", "3", "4", "5", "6"};
+  TEST_ASSERT_TRUE(log_strs == expected);
+  TEST_ASSERT_EQUAL_UINT(2u, logger.dropped_message_count());
+}
+
+TEST(etcpal_cpp_log, queued_block_works)
+{
+  // Capacity is rounded up to the next power of 2
+  TEST_ASSERT_TRUE(logger.SetDispatchPolicy(etcpal::LogDispatchPolicy::kQueued)
+                       .SetOverflowPolicy(etcpal::LogOverflowPolicy::kBlock)
+                       .SetLogQueueCapacity(3)
+                       .Startup(test_log_handler));
+  TEST_ASSERT_EQUAL_UINT(4u, logger.log_queue_capacity());
+
+  std::vector<std::string> log_strs;
+  test_log_handler.OnLogEvent([&log_strs](const EtcPalLogStrings& strings) { log_strs.emplace_back(strings.raw); });
+
+  // Logging far more messages than the queue can hold should block rather than drop any.
+  constexpr int kNumMessages = 100;
+  for (int i = 0; i < kNumMessages; ++i)
+    logger.Debug("%d", i);
+  logger.Shutdown();
+
+  TEST_ASSERT_EQUAL_UINT(0u, logger.dropped_message_count());
+  TEST_ASSERT_EQUAL_UINT(static_cast<size_t>(kNumMessages), log_strs.size());
+  for (int i = 0; i < kNumMessages; ++i)
+    TEST_ASSERT_EQUAL_STRING(std::to_string(i).c_str(), log_strs[i].c_str());
+}
+
+static std::string FormatExpected(const char* format, ...)
+{
+  std::array<char, ETCPAL_RAW_LOG_MSG_MAX_LEN> buf;
+  std::va_list                                 args;
+  va_start(args, format);
+  vsnprintf(buf.data(), buf.size(), format, args);
+  va_end(args);
+  return buf.data();
+}
+
+static bool CanCaptureArgs(const char* format, ...)
+{
+  std::array<char, ETCPAL_RAW_LOG_MSG_MAX_LEN> record;
+  std::va_list                                 args;
+  va_start(args, format);
+  bool res = etcpal::detail::CaptureLogArgs(format, args, record.data(), record.size());
+  va_end(args);
+  return res;
+}
+
+TEST(etcpal_cpp_log, queued_deferred_formatting_works)
+{
+  // Make sure the messages below take the deferred path.
+  TEST_ASSERT_TRUE(CanCaptureArgs("%d %s %.*f %p %%", 1, "str", 2, 1.0, nullptr));
+  TEST_ASSERT_FALSE(CanCaptureArgs("%s", static_cast<const char*>(nullptr)));
+  TEST_ASSERT_FALSE(CanCaptureArgs("%ls", L"wide"));
+  TEST_ASSERT_FALSE(CanCaptureArgs("%s", std::string(ETCPAL_RAW_LOG_MSG_MAX_LEN, 'x').c_str()));
+
+  TEST_ASSERT_TRUE(logger.SetDispatchPolicy(etcpal::LogDispatchPolicy::kQueued)
+                       .SetFormatPolicy(etcpal::LogFormatPolicy::kDeferred)
+                       .Startup(test_log_handler));
+  TEST_ASSERT_EQUAL(etcpal::LogFormatPolicy::kDeferred, logger.format_policy());
+
+  std::vector<std::string> log_strs;
+  test_log_handler.OnLogEvent([&log_strs](const EtcPalLogStrings& strings) { log_strs.emplace_back(strings.raw); });
+
+  // The string arguments must be captured by value.
+  std::string temp_str = "temporary";
+  std::string long_str(ETCPAL_RAW_LOG_MSG_MAX_LEN + 100, 'x');
+
+  std::vector<std::string> expected;
+  expected.push_back(FormatExpected("%d %i %u %x %X %o %c", -5, 42, 7u, 255, 255, 8, 'z'));
+  logger.Info("%d %i %u %x %X %o %c", -5, 42, 7u, 255, 255, 8, 'z');
+  expected.push_back(FormatExpected("%ld %lld %zu %jd %td %hhd %hu", -1L, 1LL << 40, sizeof(int), INTMAX_MAX,
+                                    static_cast<ptrdiff_t>(-3), 300, 70000));
+  logger.Info("%ld %lld %zu %jd %td %hhd %hu", -1L, 1LL << 40, sizeof(int), INTMAX_MAX, static_cast<ptrdiff_t>(-3),
+              300, 70000);
+  expected.push_back(FormatExpected("%5.2f|%-12e|%g|%Lf|%a", 3.14159, 1e10, 0.5, 2.5L, 1.0));
+  logger.Info("%5.2f|%-12e|%g|%Lf|%a", 3.14159, 1e10, 0.5, 2.5L, 1.0);
+  expected.push_back(FormatExpected("%s and %.3s and %10s", temp_str.c_str(), "abcdef", "pad"));
+  logger.Info("%s and %.3s and %10s", temp_str.c_str(), "abcdef", "pad");
+  temp_str = "overwritten";
+  expected.push_back(FormatExpected("%*d|%-*.*s|%%|%p", 6, 42, 8, 2, "xyz", static_cast<void*>(&temp_str)));
+  logger.Info("%*d|%-*.*s|%%|%p", 6, 42, 8, 2, "xyz", static_cast<void*>(&temp_str));
+
+  // Too large to capture - should fall back to immediate formatting.
+  expected.push_back(FormatExpected("%s", long_str.c_str()));
+  logger.Info("%s", long_str.c_str());
+
+  logger.Shutdown();
+
+  TEST_ASSERT_EQUAL_UINT(expected.size(), log_strs.size());
+  for (size_t i = 0; i < expected.size() && i < log_strs.size(); ++i)
+    TEST_ASSERT_EQUAL_STRING(expected[i].c_str(), log_strs[i].c_str());
+}
+
 TEST_GROUP_RUNNER(etcpal_cpp_log)
 {
   RUN_TEST_CASE(etcpal_cpp_log, startup_works);
@@ -346,5 +525,9 @@ TEST_GROUP_RUNNER(etcpal_cpp_log)
   RUN_TEST_CASE(etcpal_cpp_log, timestamps_work);
   RUN_TEST_CASE(etcpal_cpp_log, syslog_params_work);
   RUN_TEST_CASE(etcpal_cpp_log, queued_dispatch_works);
+  RUN_TEST_CASE(etcpal_cpp_log, queued_drop_newest_works);
+  RUN_TEST_CASE(etcpal_cpp_log, queued_drop_oldest_works);
+  RUN_TEST_CASE(etcpal_cpp_log, queued_block_works);
+  RUN_TEST_CASE(etcpal_cpp_log, queued_deferred_formatting_works);
 }
 }
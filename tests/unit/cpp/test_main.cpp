@@ -21,8 +21,11 @@
 
 extern "C" void run_all_tests(void)  // NOLINT
 {
+  RUN_TEST_GROUP(etcpal_cpp_acn_pdu);
   RUN_TEST_GROUP(etcpal_cpp_error);
+  RUN_TEST_GROUP(etcpal_cpp_handle_table);
   RUN_TEST_GROUP(etcpal_cpp_hash);
+  RUN_TEST_GROUP(etcpal_cpp_hashmap);
   RUN_TEST_GROUP(etcpal_cpp_uuid);
   RUN_TEST_GROUP(etcpal_cpp_opaque_id);
 #if !ETCPAL_NO_OS_SUPPORT
@@ -38,7 +41,9 @@ extern "C" void run_all_tests(void)  // NOLINT
   RUN_TEST_GROUP(etcpal_cpp_rwlock);
   RUN_TEST_GROUP(etcpal_cpp_sem);
   RUN_TEST_GROUP(etcpal_cpp_signal);
+  RUN_TEST_GROUP(etcpal_cpp_spsc_queue);
   RUN_TEST_GROUP(etcpal_cpp_thread);
+  RUN_TEST_GROUP(etcpal_cpp_threadpool);
   RUN_TEST_GROUP(etcpal_cpp_timer);
 
 #if !DISABLE_QUEUE_TESTS
@@ -52,5 +57,6 @@ extern "C" void run_all_tests(void)  // NOLINT
 #endif
 #if !ETCPAL_NO_NETWORKING_SUPPORT
   RUN_TEST_GROUP(etcpal_cpp_inet);
+  RUN_TEST_GROUP(etcpal_cpp_socket);
 #endif
 }
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/socket.h"
+#include "unity_fixture.h"
+
+#include <array>
+
+extern "C" {
+TEST_GROUP(etcpal_cpp_socket);
+
+TEST_SETUP(etcpal_cpp_socket)
+{
+  etcpal_init(ETCPAL_FEATURE_SOCKETS);
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_socket)
+{
+  etcpal_deinit(ETCPAL_FEATURE_SOCKETS);
+}
+
+TEST(etcpal_cpp_socket, poll_context_works)
+{
+  etcpal::PollContext context;
+
+  // No sockets added yet
+  auto no_sockets_event = context.Wait(100);
+  TEST_ASSERT_FALSE(no_sockets_event.has_value());
+  TEST_ASSERT_EQUAL(kEtcPalErrNoSockets, no_sockets_event.error_code());
+
+  etcpal_socket_t sock_1 = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t sock_2 = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &sock_1));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &sock_2));
+
+  // UDP sockets poll as ready for output right away.
+  TEST_ASSERT_TRUE(context.AddSocket(sock_1, ETCPAL_POLL_OUT, &sock_1).IsOk());
+  auto event = context.Wait(100);
+  TEST_ASSERT_TRUE(event.has_value());
+  TEST_ASSERT_EQUAL(sock_1, event->socket);
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_OUT, event->events);
+  TEST_ASSERT_EQUAL_PTR(&sock_1, event->user_data);
+
+  TEST_ASSERT_TRUE(context.AddSocket(sock_2, ETCPAL_POLL_OUT, &sock_2).IsOk());
+  std::array<EtcPalPollEvent, 4> events{};
+  auto                           num_events = context.WaitMany(events, 100);
+  TEST_ASSERT_TRUE(num_events.has_value());
+  TEST_ASSERT_GREATER_OR_EQUAL(1u, *num_events);
+  TEST_ASSERT_LESS_OR_EQUAL(2u, *num_events);
+  for (size_t i = 0; i < *num_events; ++i)
+    TEST_ASSERT_TRUE(events[i].socket == sock_1 || events[i].socket == sock_2);
+
+  // Switching both sockets to input polling should lead to a timeout
+  TEST_ASSERT_TRUE(context.ModifySocket(sock_1, ETCPAL_POLL_IN).IsOk());
+  TEST_ASSERT_TRUE(context.ModifySocket(sock_2, ETCPAL_POLL_IN).IsOk());
+  auto timed_out = context.WaitMany(events, 100);
+  TEST_ASSERT_FALSE(timed_out.has_value());
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, timed_out.error_code());
+
+  context.RemoveSocket(sock_1);
+  context.RemoveSocket(sock_2);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoSockets, context.Wait(100).error_code());
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_close(sock_1));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_close(sock_2));
+}
+
+TEST(etcpal_cpp_socket, poll_context_timer_and_wakeup_work)
+{
+  etcpal::PollContext context;
+
+  int  timer_data = 0;
+  auto timer      = context.AddTimer(10, 0, &timer_data);
+  TEST_ASSERT_TRUE(timer.has_value());
+
+  auto event = context.Wait(1000);
+  TEST_ASSERT_TRUE(event.has_value());
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_TIMER, event->events);
+  TEST_ASSERT_EQUAL(*timer, event->timer);
+  TEST_ASSERT_EQUAL_PTR(&timer_data, event->user_data);
+  context.RemoveTimer(*timer);
+
+  int wakeup_data = 0;
+  TEST_ASSERT_TRUE(context.AddWakeup(&wakeup_data).IsOk());
+  TEST_ASSERT_TRUE(context.Wakeup().IsOk());
+  auto wakeup_event = context.Wait(1000);
+  TEST_ASSERT_TRUE(wakeup_event.has_value());
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_WAKEUP, wakeup_event->events);
+  TEST_ASSERT_EQUAL_PTR(&wakeup_data, wakeup_event->user_data);
+  context.RemoveWakeup();
+
+  TEST_ASSERT_EQUAL(kEtcPalErrNoSockets, context.Wait(100).error_code());
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+TEST(etcpal_cpp_socket, multithreaded_poll_context_disarms_sockets)
+{
+  etcpal::PollContext context(true);
+
+  etcpal_socket_t sock = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &sock));
+  TEST_ASSERT_TRUE(context.AddSocket(sock, ETCPAL_POLL_OUT).IsOk());
+
+  // The socket stays ready for output, but is only reported again once it has been rearmed.
+  auto event = context.Wait(100);
+  TEST_ASSERT_TRUE(event.has_value());
+  TEST_ASSERT_EQUAL(sock, event->socket);
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, context.Wait(100).error_code());
+
+  TEST_ASSERT_TRUE(context.RearmSocket(sock).IsOk());
+  auto rearmed_event = context.Wait(100);
+  TEST_ASSERT_TRUE(rearmed_event.has_value());
+  TEST_ASSERT_EQUAL(sock, rearmed_event->socket);
+
+  context.RemoveSocket(sock);
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, context.RearmSocket(sock).code());
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_close(sock));
+}
+#endif
+
+TEST_GROUP_RUNNER(etcpal_cpp_socket)
+{
+  RUN_TEST_CASE(etcpal_cpp_socket, poll_context_works);
+  RUN_TEST_CASE(etcpal_cpp_socket, poll_context_timer_and_wakeup_work);
+#if defined(__linux__) || defined(__APPLE__)
+  RUN_TEST_CASE(etcpal_cpp_socket, multithreaded_poll_context_disarms_sockets);
+#endif
+}
+}
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/spsc_queue.h"
+
+#include <array>
+#include <cstdint>
+#include "etcpal/cpp/thread.h"
+#include "unity_fixture.h"
+
+extern "C" {
+
+TEST_GROUP(etcpal_cpp_spsc_queue);
+
+TEST_SETUP(etcpal_cpp_spsc_queue)
+{
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_spsc_queue)
+{
+}
+
+TEST(etcpal_cpp_spsc_queue, spsc_try_push_and_pop_work)
+{
+  etcpal::SpscQueue<uint32_t, 4> q;
+  TEST_ASSERT_EQUAL_UINT(4u, q.Capacity());
+  TEST_ASSERT_TRUE(q.IsEmpty());
+
+  uint32_t item = 0;
+  TEST_ASSERT_FALSE(q.TryPop(item));
+  TEST_ASSERT_FALSE(q.Pop(item, 0));
+
+  for (uint32_t i = 0; i < 4; ++i)
+    TEST_ASSERT_TRUE(q.TryPush(i));
+  TEST_ASSERT_FALSE(q.TryPush(4));
+  TEST_ASSERT_EQUAL_UINT(4u, q.Size());
+
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    TEST_ASSERT_TRUE(q.Pop(item, 0));
+    TEST_ASSERT_EQUAL_UINT32(i, item);
+  }
+  TEST_ASSERT_TRUE(q.IsEmpty());
+}
+
+TEST(etcpal_cpp_spsc_queue, mpsc_try_push_and_pop_work)
+{
+  etcpal::MpscQueue<uint32_t, 4> q;
+  TEST_ASSERT_EQUAL_UINT(4u, q.Capacity());
+  TEST_ASSERT_TRUE(q.IsEmpty());
+
+  uint32_t item = 0;
+  TEST_ASSERT_FALSE(q.TryPop(item));
+
+  for (uint32_t i = 0; i < 4; ++i)
+    TEST_ASSERT_TRUE(q.TryPush(i));
+  TEST_ASSERT_FALSE(q.TryPush(4));
+  TEST_ASSERT_EQUAL_UINT(4u, q.Size());
+
+  for (uint32_t i = 0; i < 4; ++i)
+  {
+    TEST_ASSERT_TRUE(q.TryPop(item));
+    TEST_ASSERT_EQUAL_UINT32(i, item);
+  }
+  TEST_ASSERT_TRUE(q.IsEmpty());
+}
+
+TEST(etcpal_cpp_spsc_queue, spsc_blocking_pop_receives_all_items_in_order)
+{
+  static constexpr uint32_t kNumItems = 100000;
+
+  etcpal::SpscQueue<uint32_t, 64> q;
+  etcpal::Thread                  producer;
+  TEST_ASSERT_TRUE(producer.Start([&q]() {
+    for (uint32_t i = 0; i < kNumItems; ++i)
+    {
+      while (!q.TryPush(i))
+        ;
+    }
+  }));
+
+  uint32_t item = 0;
+  for (uint32_t i = 0; i < kNumItems; ++i)
+  {
+    TEST_ASSERT_TRUE(q.Pop(item));
+    TEST_ASSERT_EQUAL_UINT32(i, item);
+  }
+  TEST_ASSERT_TRUE(producer.Join());
+}
+
+TEST(etcpal_cpp_spsc_queue, mpsc_blocking_pop_receives_all_items)
+{
+  static constexpr uint32_t kNumProducers     = 4;
+  static constexpr uint32_t kItemsPerProducer = 25000;
+
+  etcpal::MpscQueue<uint32_t, 64>           q;
+  std::array<etcpal::Thread, kNumProducers> producers;
+  for (uint32_t p = 0; p < kNumProducers; ++p)
+  {
+    TEST_ASSERT_TRUE(producers[p].Start([&q, p]() {
+      for (uint32_t i = 0; i < kItemsPerProducer; ++i)
+      {
+        // Encode the producer in the high bits so that per-producer ordering can be checked.
+        while (!q.TryPush((p << 24) | i))
+          ;
+      }
+    }));
+  }
+
+  std::array<uint32_t, kNumProducers> next_expected{};
+  uint32_t                            item = 0;
+  for (uint32_t i = 0; i < kNumProducers * kItemsPerProducer; ++i)
+  {
+    TEST_ASSERT_TRUE(q.Pop(item));
+    uint32_t producer = item >> 24;
+    TEST_ASSERT_LESS_THAN_UINT32(kNumProducers, producer);
+    TEST_ASSERT_EQUAL_UINT32(next_expected[producer]++, item & 0xffffffu);
+  }
+
+  for (auto& producer : producers)
+    TEST_ASSERT_TRUE(producer.Join());
+  TEST_ASSERT_TRUE(q.IsEmpty());
+}
+
+TEST_GROUP_RUNNER(etcpal_cpp_spsc_queue)
+{
+  RUN_TEST_CASE(etcpal_cpp_spsc_queue, spsc_try_push_and_pop_work);
+  RUN_TEST_CASE(etcpal_cpp_spsc_queue, mpsc_try_push_and_pop_work);
+  RUN_TEST_CASE(etcpal_cpp_spsc_queue, spsc_blocking_pop_receives_all_items_in_order);
+  RUN_TEST_CASE(etcpal_cpp_spsc_queue, mpsc_blocking_pop_receives_all_items);
+}
+}
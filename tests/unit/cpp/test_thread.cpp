@@ -254,6 +254,36 @@ TEST(etcpal_cpp_thread, get_os_handle_works)
   TEST_ASSERT_EQUAL(os_handle, reported_handle);
 }
 
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+TEST(etcpal_cpp_thread, sched_param_setters_work)
+{
+  etcpal::Thread thrd;
+  TEST_ASSERT_EQUAL_INT(SCHED_OTHER, thrd.sched_policy());
+  TEST_ASSERT_TRUE(thrd.cpu_affinity() == 0);
+
+  int policy = -1;
+  thrd.SetSchedPolicy(SCHED_RR).SetPriority(1).SetCpuAffinity(~0ull);
+  TEST_ASSERT_EQUAL_INT(SCHED_RR, thrd.sched_policy());
+  TEST_ASSERT_TRUE(thrd.cpu_affinity() == ~0ull);
+  TEST_ASSERT_NULL(thrd.platform_data());
+
+  TEST_ASSERT_TRUE(thrd.Start([&]() {
+                         struct sched_param sched_param;
+                         pthread_getschedparam(pthread_self(), &policy, &sched_param);
+                       })
+                       .IsOk());
+  TEST_ASSERT_TRUE(thrd.Join().IsOk());
+
+  // Without the privileges for real-time scheduling, the thread falls back to default scheduling.
+  TEST_ASSERT_TRUE(policy == SCHED_RR || policy == SCHED_OTHER);
+
+  // The scheduling parameters move along with the thread.
+  etcpal::Thread moved = std::move(thrd);
+  TEST_ASSERT_EQUAL_INT(SCHED_RR, moved.sched_policy());
+  TEST_ASSERT_EQUAL_INT(SCHED_OTHER, thrd.sched_policy());  // NOLINT(bugprone-use-after-move)
+}
+#endif
+
 TEST_GROUP_RUNNER(etcpal_cpp_thread)
 {
   RUN_TEST_CASE(etcpal_cpp_thread, default_constructor_works);
@@ -272,6 +302,9 @@ TEST_GROUP_RUNNER(etcpal_cpp_thread)
   RUN_TEST_CASE(etcpal_cpp_thread, sleep_ms_works);
   RUN_TEST_CASE(etcpal_cpp_thread, sleep_chrono_works);
   RUN_TEST_CASE(etcpal_cpp_thread, get_os_handle_works);
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  RUN_TEST_CASE(etcpal_cpp_thread, sched_param_setters_work);
+#endif
 }
 
 }  // extern "C"
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/cpp/threadpool.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "unity_fixture.h"
+
+extern "C" {
+
+TEST_GROUP(etcpal_cpp_threadpool);
+
+TEST_SETUP(etcpal_cpp_threadpool)
+{
+}
+
+TEST_TEAR_DOWN(etcpal_cpp_threadpool)
+{
+}
+
+TEST(etcpal_cpp_threadpool, default_constructor_works)
+{
+  etcpal::ThreadPool pool;
+  TEST_ASSERT_FALSE(pool.IsRunning());
+  TEST_ASSERT_EQUAL_UINT(0u, pool.num_threads());
+  TEST_ASSERT_EQUAL(kEtcPalErrNotInit, pool.Submit([]() {}).code());
+
+  // ParallelFor still works, on the calling thread.
+  std::vector<int> values(100, 0);
+  pool.ParallelFor(values.size(), [&](size_t i) { values[i] = static_cast<int>(i); });
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(i), values[i]);
+
+  TEST_ASSERT_TRUE(pool.Startup(2).IsOk());
+  TEST_ASSERT_TRUE(pool.IsRunning());
+  TEST_ASSERT_EQUAL_UINT(2u, pool.num_threads());
+  TEST_ASSERT_EQUAL(kEtcPalErrAlready, pool.Startup(2).code());
+  pool.Shutdown();
+  TEST_ASSERT_FALSE(pool.IsRunning());
+}
+
+TEST(etcpal_cpp_threadpool, submit_works)
+{
+  etcpal::ThreadPool pool(4, 32);
+  std::atomic<int>   count{0};
+
+  // A small trivially-copyable lambda, stored inline
+  for (int i = 0; i < 1000; ++i)
+    TEST_ASSERT_TRUE(pool.Submit([&count]() { ++count; }).IsOk());
+
+  // A lambda with a non-trivial capture, stored on the heap
+  auto shared = std::make_shared<int>(5);
+  for (int i = 0; i < 1000; ++i)
+    TEST_ASSERT_TRUE(pool.Submit([&count, shared]() { count += *shared; }).IsOk());
+
+  pool.WaitIdle();
+  TEST_ASSERT_EQUAL_INT(6000, count.load());
+  TEST_ASSERT_EQUAL_INT(1, shared.use_count());
+}
+
+TEST(etcpal_cpp_threadpool, tasks_can_submit_tasks)
+{
+  etcpal::ThreadPool pool(3);
+  std::atomic<int>   count{0};
+
+  for (int i = 0; i < 100; ++i)
+  {
+    pool.Submit([&]() {
+      for (int j = 0; j < 10; ++j)
+        pool.Submit([&count]() { ++count; });
+    });
+  }
+  pool.WaitIdle();
+  TEST_ASSERT_EQUAL_INT(1000, count.load());
+}
+
+TEST(etcpal_cpp_threadpool, parallel_for_works)
+{
+  etcpal::ThreadPool pool(4);
+
+  std::vector<uint64_t> values(100000, 0);
+  pool.ParallelFor(values.size(), [&](size_t i) { values[i] = i * i; });
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_ASSERT_TRUE(values[i] == i * i);
+
+  std::atomic<uint64_t> sum{0};
+  pool.ParallelForChunks(
+      values.size(),
+      [&](size_t begin, size_t end) {
+        uint64_t partial = 0;
+        for (size_t i = begin; i < end; ++i)
+          partial += i;
+        sum += partial;
+      },
+      1000);
+  TEST_ASSERT_TRUE(sum.load() == (uint64_t)(values.size() - 1) * values.size() / 2);
+
+  // Nested inside a task
+  std::vector<int> nested(10000, 0);
+  pool.Submit([&]() { pool.ParallelFor(nested.size(), [&](size_t i) { nested[i] = 1; }); });
+  pool.WaitIdle();
+  for (int value : nested)
+    TEST_ASSERT_EQUAL_INT(1, value);
+}
+
+TEST_GROUP_RUNNER(etcpal_cpp_threadpool)
+{
+  RUN_TEST_CASE(etcpal_cpp_threadpool, default_constructor_works);
+  RUN_TEST_CASE(etcpal_cpp_threadpool, submit_works);
+  RUN_TEST_CASE(etcpal_cpp_threadpool, tasks_can_submit_tasks);
+  RUN_TEST_CASE(etcpal_cpp_threadpool, parallel_for_works);
+}
+}
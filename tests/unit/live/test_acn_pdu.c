@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/acn_pdu.h"
+#include "unity_fixture.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define TEST_VECTOR_SIZE 4
+#define TEST_HEADER_SIZE 2
+#define TEST_MAX_PDUS    200
+
+static const AcnPduConstraints kTestConstraints = {TEST_VECTOR_SIZE, TEST_HEADER_SIZE};
+
+static uint8_t test_block[TEST_MAX_PDUS * 32];
+static AcnPdu  iterative_pdus[TEST_MAX_PDUS];
+static AcnPdu  batch_pdus[TEST_MAX_PDUS];
+
+// Pack one PDU with the given inheritance onto the end of a block. Returns the new block length.
+static size_t pack_test_pdu(uint8_t* block, size_t block_len, bool vector, bool header, size_t data_len, bool ext_len)
+{
+  uint8_t* cur_ptr = &block[block_len];
+  uint8_t* pdu     = cur_ptr;
+
+  *cur_ptr = 0;
+  if (vector)
+    ACN_PDU_SET_V_FLAG(*cur_ptr);
+  if (header)
+    ACN_PDU_SET_H_FLAG(*cur_ptr);
+  if (data_len)
+    ACN_PDU_SET_D_FLAG(*cur_ptr);
+  if (ext_len)
+    ACN_PDU_SET_L_FLAG(*cur_ptr);
+  cur_ptr += (ext_len ? 3 : 2);
+
+  if (vector)
+  {
+    memset(cur_ptr, (int)(block_len & 0xff), TEST_VECTOR_SIZE);
+    cur_ptr += TEST_VECTOR_SIZE;
+  }
+  if (header)
+  {
+    memset(cur_ptr, 0xaa, TEST_HEADER_SIZE);
+    cur_ptr += TEST_HEADER_SIZE;
+  }
+  memset(cur_ptr, 0x55, data_len);
+  cur_ptr += data_len;
+
+  size_t pdu_len = (size_t)(cur_ptr - pdu);
+  if (ext_len)
+    ACN_PDU_PACK_EXT_LEN(pdu, pdu_len);
+  else
+    ACN_PDU_PACK_NORMAL_LEN(pdu, pdu_len);
+  return block_len + pdu_len;
+}
+
+// Build a block that mixes every kind of inheritance and both length field sizes, like an RPT
+// broker fan-out buffer with many small PDUs.
+static size_t build_test_block(size_t num_pdus)
+{
+  size_t block_len = pack_test_pdu(test_block, 0, true, true, 10, false);
+  for (size_t i = 1; i < num_pdus; ++i)
+  {
+    block_len =
+        pack_test_pdu(test_block, block_len, (i % 2) == 0, (i % 3) == 0, (i % 4) == 0 ? 0 : (i % 17), (i % 5) == 0);
+  }
+  return block_len;
+}
+
+static size_t parse_iteratively(const uint8_t* buf, size_t buflen)
+{
+  AcnPdu pdu        = ACN_PDU_INIT;
+  size_t num_parsed = 0;
+  while (num_parsed < TEST_MAX_PDUS && acn_parse_pdu(buf, buflen, &kTestConstraints, &pdu))
+    iterative_pdus[num_parsed++] = pdu;
+  return num_parsed;
+}
+
+static void assert_pdus_equal(const AcnPdu* expected, const AcnPdu* actual, size_t num_pdus)
+{
+  for (size_t i = 0; i < num_pdus; ++i)
+  {
+    TEST_ASSERT_EQUAL_PTR(expected[i].pvector, actual[i].pvector);
+    TEST_ASSERT_EQUAL_PTR(expected[i].pheader, actual[i].pheader);
+    TEST_ASSERT_EQUAL_PTR(expected[i].pdata, actual[i].pdata);
+    TEST_ASSERT_EQUAL_UINT(expected[i].data_len, actual[i].data_len);
+    TEST_ASSERT_EQUAL_PTR(expected[i].pnextpdu, actual[i].pnextpdu);
+  }
+}
+
+TEST_GROUP(etcpal_acn_pdu);
+
+TEST_SETUP(etcpal_acn_pdu)
+{
+  memset(test_block, 0, sizeof test_block);
+  memset(iterative_pdus, 0, sizeof iterative_pdus);
+  memset(batch_pdus, 0, sizeof batch_pdus);
+}
+
+TEST_TEAR_DOWN(etcpal_acn_pdu)
+{
+}
+
+TEST(etcpal_acn_pdu, parse_block_matches_parse_pdu)
+{
+  size_t block_len = build_test_block(TEST_MAX_PDUS);
+  TEST_ASSERT_EQUAL_UINT(TEST_MAX_PDUS, parse_iteratively(test_block, block_len));
+
+  AcnPdu last_pdu = ACN_PDU_INIT;
+  TEST_ASSERT_EQUAL_UINT(TEST_MAX_PDUS, acn_parse_pdu_block(test_block, block_len, &kTestConstraints, &last_pdu,
+                                                            batch_pdus, TEST_MAX_PDUS));
+  assert_pdus_equal(iterative_pdus, batch_pdus, TEST_MAX_PDUS);
+  TEST_ASSERT_EQUAL_PTR(&test_block[block_len], last_pdu.pnextpdu);
+
+  // last_pdu is optional.
+  size_t res = acn_parse_pdu_block(test_block, block_len, &kTestConstraints, NULL, batch_pdus, TEST_MAX_PDUS);
+  TEST_ASSERT_EQUAL_UINT(TEST_MAX_PDUS, res);
+}
+
+TEST(etcpal_acn_pdu, parse_block_resumes_from_last_pdu)
+{
+  size_t block_len = build_test_block(TEST_MAX_PDUS);
+  TEST_ASSERT_EQUAL_UINT(TEST_MAX_PDUS, parse_iteratively(test_block, block_len));
+
+  // Parse in odd-sized chunks; inheritance must carry across calls.
+  AcnPdu last_pdu   = ACN_PDU_INIT;
+  size_t num_parsed = 0;
+  while (num_parsed < TEST_MAX_PDUS)
+  {
+    size_t res =
+        acn_parse_pdu_block(test_block, block_len, &kTestConstraints, &last_pdu, &batch_pdus[num_parsed], 7);
+    TEST_ASSERT_GREATER_THAN_UINT(0u, res);
+    num_parsed += res;
+  }
+  TEST_ASSERT_EQUAL_UINT(TEST_MAX_PDUS, num_parsed);
+  assert_pdus_equal(iterative_pdus, batch_pdus, TEST_MAX_PDUS);
+
+  // Nothing left in the block.
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(test_block, block_len, &kTestConstraints, &last_pdu, batch_pdus, 7));
+}
+
+TEST(etcpal_acn_pdu, parse_block_stops_at_malformed_pdu)
+{
+  size_t block_len = pack_test_pdu(test_block, 0, true, true, 10, false);
+  block_len        = pack_test_pdu(test_block, block_len, false, false, 5, false);
+  size_t bad_pdu   = block_len;
+  block_len        = pack_test_pdu(test_block, block_len, true, false, 3, false);
+
+  // Claim the third PDU runs past the end of the block.
+  ACN_PDU_PACK_NORMAL_LEN(&test_block[bad_pdu], block_len - bad_pdu + 1);
+
+  AcnPdu last_pdu = ACN_PDU_INIT;
+  TEST_ASSERT_EQUAL_UINT(2u, acn_parse_pdu_block(test_block, block_len, &kTestConstraints, &last_pdu, batch_pdus,
+                                                 TEST_MAX_PDUS));
+  TEST_ASSERT_EQUAL_PTR(&test_block[bad_pdu], last_pdu.pnextpdu);
+
+  // A first PDU which inherits anything is malformed.
+  block_len = pack_test_pdu(test_block, 0, false, true, 10, false);
+  size_t res = acn_parse_pdu_block(test_block, block_len, &kTestConstraints, NULL, batch_pdus, TEST_MAX_PDUS);
+  TEST_ASSERT_EQUAL_UINT(0u, res);
+}
+
+TEST(etcpal_acn_pdu, parse_block_invalid_calls_fail)
+{
+  size_t block_len = build_test_block(4);
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(NULL, block_len, &kTestConstraints, NULL, batch_pdus, 4));
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(test_block, 0, &kTestConstraints, NULL, batch_pdus, 4));
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(test_block, block_len, NULL, NULL, batch_pdus, 4));
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(test_block, block_len, &kTestConstraints, NULL, NULL, 4));
+  TEST_ASSERT_EQUAL_UINT(0u, acn_parse_pdu_block(test_block, block_len, &kTestConstraints, NULL, batch_pdus, 0));
+}
+
+TEST_GROUP_RUNNER(etcpal_acn_pdu)
+{
+  RUN_TEST_CASE(etcpal_acn_pdu, parse_block_matches_parse_pdu);
+  RUN_TEST_CASE(etcpal_acn_pdu, parse_block_resumes_from_last_pdu);
+  RUN_TEST_CASE(etcpal_acn_pdu, parse_block_stops_at_malformed_pdu);
+  RUN_TEST_CASE(etcpal_acn_pdu, parse_block_invalid_calls_fail);
+}
@@ -20,11 +20,16 @@
 #include "etcpal/handle_manager.h"
 
 #include <limits.h>
+#include <stdlib.h>
 
 #include "etcpal/common.h"
 #include "unity_fixture.h"
 #include "etc_fff_wrapper.h"
 
+#define STATIC_TABLE_SIZE      20
+#define DYNAMIC_TABLE_MAX_SIZE 1000
+#define CHURN_TABLE_SIZE       64
+
 static int num_in_use_checks = 0;
 
 /* Handle value in use functions. */
@@ -146,9 +151,126 @@ TEST(etcpal_handle_manager, handles_run_out)
   }
 }
 
+TEST(etcpal_handle_manager, handle_table_init_rejects_invalid_args)
+{
+  EtcPalHandleTable table;
+  EtcPalHandleSlot  slots[4];
+
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_handle_table_init(NULL, 10));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_handle_table_init(&table, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_handle_table_init(&table, ETCPAL_HANDLE_TABLE_MAX_SIZE + 1));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_handle_table_init_static(&table, NULL, 4));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_handle_table_init_static(&table, slots, 0));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_alloc(NULL, NULL));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(NULL, 0));
+}
+
+TEST(etcpal_handle_manager, handle_table_static_storage_works)
+{
+  EtcPalHandleTable table;
+  EtcPalHandleSlot  slots[STATIC_TABLE_SIZE];
+  int               handles[STATIC_TABLE_SIZE];
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_handle_table_init_static(&table, slots, STATIC_TABLE_SIZE));
+
+  // Fill the table; each handle should map to a distinct slot index.
+  bool index_used[STATIC_TABLE_SIZE] = {false};
+  for (int i = 0; i < STATIC_TABLE_SIZE; ++i)
+  {
+    size_t index = STATIC_TABLE_SIZE;
+    handles[i]   = etcpal_handle_table_alloc(&table, &index);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, handles[i]);
+    TEST_ASSERT_LESS_THAN(STATIC_TABLE_SIZE, index);
+    TEST_ASSERT_FALSE(index_used[index]);
+    index_used[index] = true;
+    TEST_ASSERT_EQUAL((int)index, etcpal_handle_table_lookup(&table, handles[i]));
+    TEST_ASSERT_EQUAL(handles[i], etcpal_handle_table_handle_at(&table, index));
+  }
+  TEST_ASSERT_EQUAL_UINT(STATIC_TABLE_SIZE, etcpal_handle_table_size(&table));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_alloc(&table, NULL));
+
+  // A freed handle becomes stale, and the new handle for its slot is different.
+  int freed_index = etcpal_handle_table_lookup(&table, handles[5]);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_handle_table_free(&table, handles[5]));
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_handle_table_free(&table, handles[5]));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, handles[5]));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_handle_at(&table, (size_t)freed_index));
+
+  size_t new_index  = 0;
+  int    new_handle = etcpal_handle_table_alloc(&table, &new_index);
+  TEST_ASSERT_EQUAL(freed_index, (int)new_index);
+  TEST_ASSERT_NOT_EQUAL(handles[5], new_handle);
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, handles[5]));
+  TEST_ASSERT_EQUAL(freed_index, etcpal_handle_table_lookup(&table, new_handle));
+
+  // Clearing makes all handles stale.
+  etcpal_handle_table_clear(&table);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_handle_table_size(&table));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, new_handle));
+  for (int i = 0; i < STATIC_TABLE_SIZE; ++i)
+    TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, handles[i]));
+  TEST_ASSERT_GREATER_OR_EQUAL(0, etcpal_handle_table_alloc(&table, NULL));
+
+  etcpal_handle_table_deinit(&table);
+}
+
+TEST(etcpal_handle_manager, handle_table_grows_to_max_size)
+{
+  static int handles[DYNAMIC_TABLE_MAX_SIZE];
+
+  EtcPalHandleTable table;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_handle_table_init(&table, DYNAMIC_TABLE_MAX_SIZE));
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_handle_table_capacity(&table));
+
+  for (int i = 0; i < DYNAMIC_TABLE_MAX_SIZE; ++i)
+  {
+    handles[i] = etcpal_handle_table_alloc(&table, NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, handles[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT(DYNAMIC_TABLE_MAX_SIZE, etcpal_handle_table_capacity(&table));
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_alloc(&table, NULL));
+
+  // Handles allocated before the table grew must still be valid.
+  for (int i = 0; i < DYNAMIC_TABLE_MAX_SIZE; ++i)
+    TEST_ASSERT_GREATER_OR_EQUAL(0, etcpal_handle_table_lookup(&table, handles[i]));
+
+  etcpal_handle_table_deinit(&table);
+  TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, handles[0]));
+}
+
+TEST(etcpal_handle_manager, handle_table_detects_stale_handles_under_churn)
+{
+  EtcPalHandleTable table;
+  EtcPalHandleSlot  slots[CHURN_TABLE_SIZE];
+  int               live[CHURN_TABLE_SIZE];
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_handle_table_init_static(&table, slots, CHURN_TABLE_SIZE));
+
+  for (int i = 0; i < CHURN_TABLE_SIZE; ++i)
+    live[i] = etcpal_handle_table_alloc(&table, NULL);
+
+  // Repeatedly replace random handles. A replaced handle must stay stale as long as its slot has
+  // not been reused often enough for the generation count to wrap.
+  for (int round = 0; round < 10000; ++round)
+  {
+    int victim = rand() % CHURN_TABLE_SIZE;
+    int stale  = live[victim];
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_handle_table_free(&table, stale));
+    live[victim] = etcpal_handle_table_alloc(&table, NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, live[victim]);
+    TEST_ASSERT_NOT_EQUAL(stale, live[victim]);
+    TEST_ASSERT_EQUAL(-1, etcpal_handle_table_lookup(&table, stale));
+  }
+  TEST_ASSERT_EQUAL_UINT(CHURN_TABLE_SIZE, etcpal_handle_table_size(&table));
+  for (int i = 0; i < CHURN_TABLE_SIZE; ++i)
+    TEST_ASSERT_GREATER_OR_EQUAL(0, etcpal_handle_table_lookup(&table, live[i]));
+}
+
 TEST_GROUP_RUNNER(etcpal_handle_manager)
 {
   RUN_TEST_CASE(etcpal_handle_manager, handles_generate_with_max);
   RUN_TEST_CASE(etcpal_handle_manager, handles_generate_without_max);
   RUN_TEST_CASE(etcpal_handle_manager, handles_run_out);
+  RUN_TEST_CASE(etcpal_handle_manager, handle_table_init_rejects_invalid_args);
+  RUN_TEST_CASE(etcpal_handle_manager, handle_table_static_storage_works);
+  RUN_TEST_CASE(etcpal_handle_manager, handle_table_grows_to_max_size);
+  RUN_TEST_CASE(etcpal_handle_manager, handle_table_detects_stale_handles_under_churn);
 }
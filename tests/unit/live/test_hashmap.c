@@ -0,0 +1,265 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/hashmap.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "etcpal/uuid.h"
+#include "unity_fixture.h"
+
+#define NUM_DYNAMIC_KEYS 10000
+#define STATIC_CAPACITY  32
+
+static EtcPalHashMap map;
+static ETCPAL_HASHMAP_DEFINE_STORAGE(static_storage, STATIC_CAPACITY, int, int);
+
+// Sends every key to one of a few home slots, to exercise long probe runs and wrap-around.
+static uint32_t colliding_hash(const void* key)
+{
+  return (uint32_t)(*(const int*)key % 3);
+}
+
+// A hash with no high bits set, which the hash map must still spread across its slots.
+static uint32_t identity_hash(const void* key)
+{
+  return (uint32_t)(*(const int*)key);
+}
+
+TEST_GROUP(etcpal_hashmap);
+
+TEST_SETUP(etcpal_hashmap)
+{
+  memset(&map, 0, sizeof map);
+}
+
+TEST_TEAR_DOWN(etcpal_hashmap)
+{
+  etcpal_hashmap_deinit(&map);
+}
+
+TEST(etcpal_hashmap, init_rejects_invalid_args)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_hashmap_init(NULL, sizeof(int), sizeof(int), NULL, NULL));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_hashmap_init(&map, 0, sizeof(int), NULL, NULL));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid,
+                    etcpal_hashmap_init_static(&map, sizeof(int), sizeof(int), NULL, NULL, NULL, STATIC_CAPACITY));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid,
+                    etcpal_hashmap_init_static(&map, sizeof(int), sizeof(int), NULL, NULL, static_storage, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_hashmap_init_static(&map, sizeof(int), sizeof(int), NULL, NULL,
+                                                                  (uint8_t*)static_storage + 1, STATIC_CAPACITY));
+}
+
+TEST(etcpal_hashmap, dynamic_map_works)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_init(&map, sizeof(int), sizeof(int), identity_hash, NULL));
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_hashmap_capacity(&map));
+
+  for (int i = 0; i < NUM_DYNAMIC_KEYS; ++i)
+  {
+    int value = i * 2;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &i, &value));
+  }
+  TEST_ASSERT_EQUAL_UINT(NUM_DYNAMIC_KEYS, etcpal_hashmap_size(&map));
+  TEST_ASSERT_TRUE(etcpal_hashmap_capacity(&map) * 3 >= NUM_DYNAMIC_KEYS * 4);
+
+  int key   = 5;
+  int value = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrExists, etcpal_hashmap_insert(&map, &key, &value));
+
+  for (int i = 0; i < NUM_DYNAMIC_KEYS; ++i)
+  {
+    int* found = (int*)etcpal_hashmap_find(&map, &i);
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_INT(i * 2, *found);
+  }
+  key = NUM_DYNAMIC_KEYS;
+  TEST_ASSERT_NULL(etcpal_hashmap_find(&map, &key));
+
+  // Remove the even keys
+  for (int i = 0; i < NUM_DYNAMIC_KEYS; i += 2)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_remove(&map, &i));
+  key = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_hashmap_remove(&map, &key));
+  TEST_ASSERT_EQUAL_UINT(NUM_DYNAMIC_KEYS / 2, etcpal_hashmap_size(&map));
+
+  for (int i = 0; i < NUM_DYNAMIC_KEYS; ++i)
+  {
+    int* found = (int*)etcpal_hashmap_find(&map, &i);
+    if (i % 2 == 0)
+    {
+      TEST_ASSERT_NULL(found);
+    }
+    else
+    {
+      TEST_ASSERT_NOT_NULL(found);
+      TEST_ASSERT_EQUAL_INT(i * 2, *found);
+    }
+  }
+
+  etcpal_hashmap_clear(&map);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_hashmap_size(&map));
+  key = 1;
+  TEST_ASSERT_NULL(etcpal_hashmap_find(&map, &key));
+}
+
+TEST(etcpal_hashmap, static_map_works)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_init_static(&map, sizeof(int), sizeof(int), NULL, NULL,
+                                                             static_storage, STATIC_CAPACITY));
+  TEST_ASSERT_EQUAL_UINT(STATIC_CAPACITY, etcpal_hashmap_capacity(&map));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_reserve(&map, STATIC_CAPACITY));
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, etcpal_hashmap_reserve(&map, STATIC_CAPACITY + 1));
+
+  // A static map can be filled completely.
+  for (int i = 0; i < STATIC_CAPACITY; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &i, &i));
+  int key = STATIC_CAPACITY;
+  TEST_ASSERT_EQUAL(kEtcPalErrNoMem, etcpal_hashmap_insert(&map, &key, &key));
+  TEST_ASSERT_NULL(etcpal_hashmap_find(&map, &key));
+  TEST_ASSERT_EQUAL_UINT(STATIC_CAPACITY, etcpal_hashmap_capacity(&map));
+
+  for (int i = 0; i < STATIC_CAPACITY; ++i)
+  {
+    int* found = (int*)etcpal_hashmap_find(&map, &i);
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_INT(i, *found);
+  }
+
+  key = 3;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_remove(&map, &key));
+  key = STATIC_CAPACITY;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &key, &key));
+  TEST_ASSERT_NOT_NULL(etcpal_hashmap_find(&map, &key));
+}
+
+TEST(etcpal_hashmap, removal_keeps_colliding_keys_reachable)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_init_static(&map, sizeof(int), sizeof(int), colliding_hash, NULL,
+                                                             static_storage, STATIC_CAPACITY));
+
+  bool present[STATIC_CAPACITY];
+  for (int i = 0; i < STATIC_CAPACITY; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &i, &i));
+    present[i] = true;
+  }
+
+  // Remove and re-add keys in a pseudo-random order, checking every key after each change.
+  // srand() is taken care of at the entry point.
+  for (int round = 0; round < 200; ++round)
+  {
+    int key = rand() % STATIC_CAPACITY;
+    if (present[key])
+      TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_remove(&map, &key));
+    else
+      TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &key, &key));
+    present[key] = !present[key];
+
+    for (int i = 0; i < STATIC_CAPACITY; ++i)
+    {
+      int* found = (int*)etcpal_hashmap_find(&map, &i);
+      if (present[i])
+      {
+        TEST_ASSERT_NOT_NULL(found);
+        TEST_ASSERT_EQUAL_INT(i, *found);
+      }
+      else
+      {
+        TEST_ASSERT_NULL(found);
+      }
+    }
+  }
+}
+
+TEST(etcpal_hashmap, iteration_visits_each_entry)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_init(&map, sizeof(int), sizeof(int), NULL, NULL));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_reserve(&map, 100));
+  size_t capacity = etcpal_hashmap_capacity(&map);
+
+  for (int i = 0; i < 100; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &i, &i));
+  TEST_ASSERT_EQUAL_UINT(capacity, etcpal_hashmap_capacity(&map));
+
+  int               visits[100] = {0};
+  EtcPalHashMapIter iter;
+  etcpal_hashmap_iter_init(&iter, &map);
+  const void* key   = NULL;
+  void*       value = NULL;
+  while (etcpal_hashmap_iter_next(&iter, &key, &value))
+  {
+    int k = *(const int*)key;
+    TEST_ASSERT_EQUAL_INT(k, *(int*)value);
+    ++visits[k];
+    *(int*)value = -k;
+  }
+
+  for (int i = 0; i < 100; ++i)
+  {
+    TEST_ASSERT_EQUAL_INT(1, visits[i]);
+    TEST_ASSERT_EQUAL_INT(-i, *(int*)etcpal_hashmap_find(&map, &i));
+  }
+}
+
+TEST(etcpal_hashmap, uuid_keys_work)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_hashmap_init(&map, sizeof(EtcPalUuid), 0, etcpal_uuid_hash_key, etcpal_uuid_key_equal));
+
+  EtcPalUuid uuids[50];
+  for (uint32_t i = 0; i < 50; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_generate_device_uuid("hashmap test", (const uint8_t*)"\0\1\2\3\4\5", i,
+                                                                &uuids[i]));
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &uuids[i], NULL));
+  }
+  TEST_ASSERT_EQUAL_UINT(50u, etcpal_hashmap_size(&map));
+
+  for (size_t i = 0; i < 50; ++i)
+  {
+    EtcPalUuid copy = uuids[i];
+    TEST_ASSERT_NOT_NULL(etcpal_hashmap_find(&map, &copy));
+    TEST_ASSERT_EQUAL(kEtcPalErrExists, etcpal_hashmap_insert(&map, &copy, NULL));
+  }
+  TEST_ASSERT_NULL(etcpal_hashmap_find(&map, &kEtcPalNullUuid));
+}
+
+TEST(etcpal_hashmap, hash_bytes_works)
+{
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6, 7};
+
+  // Every length, including the partial block, contributes to the hash.
+  for (size_t len = 1; len <= sizeof data; ++len)
+  {
+    TEST_ASSERT_EQUAL_UINT32(etcpal_hash_bytes(data, len), etcpal_hash_bytes(data, len));
+    TEST_ASSERT_NOT_EQUAL(etcpal_hash_bytes(data, len - 1), etcpal_hash_bytes(data, len));
+  }
+}
+
+TEST_GROUP_RUNNER(etcpal_hashmap)
+{
+  RUN_TEST_CASE(etcpal_hashmap, init_rejects_invalid_args);
+  RUN_TEST_CASE(etcpal_hashmap, dynamic_map_works);
+  RUN_TEST_CASE(etcpal_hashmap, static_map_works);
+  RUN_TEST_CASE(etcpal_hashmap, removal_keeps_colliding_keys_reachable);
+  RUN_TEST_CASE(etcpal_hashmap, iteration_visits_each_entry);
+  RUN_TEST_CASE(etcpal_hashmap, uuid_keys_work);
+  RUN_TEST_CASE(etcpal_hashmap, hash_bytes_works);
+}
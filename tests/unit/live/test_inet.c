@@ -18,6 +18,7 @@
  ******************************************************************************/
 
 #include "etcpal/inet.h"
+#include "etcpal/hashmap.h"
 #include "unity_fixture.h"
 
 #include <limits.h>
@@ -524,6 +525,58 @@ TEST(etcpal_inet, string_to_mac_conversion_works)
   }
 }
 
+TEST(etcpal_inet, ip_hash_key_functions_work)
+{
+  const uint8_t v6_data[ETCPAL_IPV6_BYTES] = {0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+
+  // Hashes must only depend on the parts of the address which etcpal_ip_cmp() compares.
+  EtcPalIpAddr v4_a;
+  EtcPalIpAddr v4_b;
+  memset(&v4_a, 0x00, sizeof v4_a);
+  memset(&v4_b, 0xff, sizeof v4_b);
+  ETCPAL_IP_SET_V4_ADDRESS(&v4_a, 0x0a650101);
+  ETCPAL_IP_SET_V4_ADDRESS(&v4_b, 0x0a650101);
+  TEST_ASSERT_TRUE(etcpal_ip_key_equal(&v4_a, &v4_b));
+  TEST_ASSERT_EQUAL_UINT32(etcpal_ip_hash_key(&v4_a), etcpal_ip_hash_key(&v4_b));
+
+  EtcPalIpAddr v6_a;
+  EtcPalIpAddr v6_b;
+  ETCPAL_IP_SET_V6_ADDRESS_WITH_SCOPE_ID(&v6_a, v6_data, 1u);
+  ETCPAL_IP_SET_V6_ADDRESS_WITH_SCOPE_ID(&v6_b, v6_data, 2u);
+  TEST_ASSERT_TRUE(etcpal_ip_key_equal(&v6_a, &v6_b));
+  TEST_ASSERT_EQUAL_UINT32(etcpal_ip_hash_key(&v6_a), etcpal_ip_hash_key(&v6_b));
+  TEST_ASSERT_FALSE(etcpal_ip_key_equal(&v4_a, &v6_a));
+
+  EtcPalSockAddr sock_a;
+  EtcPalSockAddr sock_b;
+  sock_a.ip   = v4_a;
+  sock_a.port = 5568;
+  sock_b.ip   = v4_b;
+  sock_b.port = 5568;
+  TEST_ASSERT_TRUE(etcpal_sockaddr_key_equal(&sock_a, &sock_b));
+  TEST_ASSERT_EQUAL_UINT32(etcpal_sockaddr_hash_key(&sock_a), etcpal_sockaddr_hash_key(&sock_b));
+  sock_b.port = 5569;
+  TEST_ASSERT_FALSE(etcpal_sockaddr_key_equal(&sock_a, &sock_b));
+
+  // Use them as hash map keys
+  EtcPalHashMap map;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_init(&map, sizeof(EtcPalSockAddr), sizeof(int),
+                                                      etcpal_sockaddr_hash_key, etcpal_sockaddr_key_equal));
+  for (int i = 0; i < 100; ++i)
+  {
+    sock_a.port = (uint16_t)i;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_hashmap_insert(&map, &sock_a, &i));
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    sock_b.port = (uint16_t)i;
+    int* found  = (int*)etcpal_hashmap_find(&map, &sock_b);
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_INT(i, *found);
+  }
+  etcpal_hashmap_deinit(&map);
+}
+
 TEST_GROUP_RUNNER(etcpal_inet)
 {
   RUN_TEST_CASE(etcpal_inet, invalid_calls_fail);
@@ -544,4 +597,5 @@ TEST_GROUP_RUNNER(etcpal_inet)
   RUN_TEST_CASE(etcpal_inet, mac_compare_works);
   RUN_TEST_CASE(etcpal_inet, mac_to_string_conversion_works);
   RUN_TEST_CASE(etcpal_inet, string_to_mac_conversion_works);
+  RUN_TEST_CASE(etcpal_inet, ip_hash_key_functions_work);
 }
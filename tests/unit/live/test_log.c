@@ -287,6 +287,40 @@ TEST(etcpal_log, action_all_is_honored)
   TEST_ASSERT_EQUAL_STRING(last_log_strings_received.legacy_syslog, LOG_ACTION_TEST_LEGACY_SYSLOG_STR);
   TEST_ASSERT_EQUAL_STRING(last_log_strings_received.human_readable, LOG_ACTION_TEST_HUMAN_STR);
   TEST_ASSERT_EQUAL_STRING(last_log_strings_received.raw, LOG_ACTION_TEST_RAW_STR);
+  TEST_ASSERT_EQUAL_UINT(strlen(LOG_ACTION_TEST_RAW_STR), last_log_strings_received.raw_len);
+}
+
+// A message which is too long is truncated to the same body in every format.
+TEST(etcpal_log, action_all_truncates_long_message_once)
+{
+  static char long_arg[ETCPAL_RAW_LOG_MSG_MAX_LEN * 2];
+  memset(long_arg, 'a', sizeof(long_arg) - 1);
+  long_arg[sizeof(long_arg) - 1] = '\0';
+
+  log_action_test_params.action =
+      ETCPAL_LOG_CREATE_SYSLOG | ETCPAL_LOG_CREATE_LEGACY_SYSLOG | ETCPAL_LOG_CREATE_HUMAN_READABLE;
+  etcpal_log(&log_action_test_params, ETCPAL_LOG_EMERG, "%d %s", 42, long_arg);
+
+  TEST_ASSERT_EQUAL_UINT(log_callback_fake.call_count, 1);
+  TEST_ASSERT_TRUE(last_log_strings_received.syslog);
+  TEST_ASSERT_TRUE(last_log_strings_received.legacy_syslog);
+  TEST_ASSERT_TRUE(last_log_strings_received.human_readable);
+  TEST_ASSERT_TRUE(last_log_strings_received.raw);
+
+  const char* raw = last_log_strings_received.raw;
+  TEST_ASSERT_EQUAL_UINT(ETCPAL_RAW_LOG_MSG_MAX_LEN, last_log_strings_received.raw_len);
+  TEST_ASSERT_EQUAL_UINT(ETCPAL_RAW_LOG_MSG_MAX_LEN, strlen(raw));
+  TEST_ASSERT_EQUAL_STRING_LEN("42 aaaa", raw, 7);
+
+  // Each string must end with exactly the raw message.
+  const char* strs[] = {last_log_strings_received.syslog, last_log_strings_received.legacy_syslog,
+                        last_log_strings_received.human_readable};
+  for (size_t i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i)
+  {
+    size_t len = strlen(strs[i]);
+    TEST_ASSERT_GREATER_THAN_UINT(ETCPAL_RAW_LOG_MSG_MAX_LEN, len);
+    TEST_ASSERT_EQUAL_STRING(raw, &strs[i][len - ETCPAL_RAW_LOG_MSG_MAX_LEN]);
+  }
 }
 
 TEST(etcpal_log, context_pointer_is_passed_unmodified)
@@ -648,6 +682,55 @@ TEST(etcpal_log, human_time_header_is_well_formed)
   TEST_ASSERT_TRUE(strstr(human_buf, "1970-01-01 00:00:00.000-02:00"));
 }
 
+// Timestamps are reused between messages logged in the same second; make sure they are still
+// updated correctly.
+TEST(etcpal_log, time_header_is_updated_between_messages)
+{
+  EtcPalLogParams lparams = ETCPAL_LOG_PARAMS_INIT;
+  lparams.action          = ETCPAL_LOG_CREATE_HUMAN_READABLE | ETCPAL_LOG_CREATE_SYSLOG | ETCPAL_LOG_CREATE_LEGACY_SYSLOG;
+  lparams.log_fn          = log_callback;
+  lparams.log_mask        = ETCPAL_LOG_UPTO(ETCPAL_LOG_DEBUG);
+  lparams.time_fn         = time_callback;
+  TEST_ASSERT_TRUE(etcpal_validate_log_params(&lparams));
+
+  cur_time.msec = 7;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.human_readable, "1970-01-01 00:00:00.007Z [CRIT]"));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.syslog, " 1970-01-01T00:00:00.007Z "));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.legacy_syslog, "Jan  1 00:00:00 "));
+
+  // Same second, different milliseconds
+  cur_time.msec = 985;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.human_readable, "1970-01-01 00:00:00.985Z [CRIT]"));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.syslog, " 1970-01-01T00:00:00.985Z "));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.legacy_syslog, "Jan  1 00:00:00 "));
+
+  // Same time, different UTC offset
+  cur_time.utc_offset = -300;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.human_readable, "1970-01-01 00:00:00.985-05:00 [CRIT]"));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.syslog, " 1970-01-01T00:00:00.985-05:00 "));
+
+  // Different second
+  cur_time.second = 1;
+  cur_time.msec   = 0;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.human_readable, "1970-01-01 00:00:01.000-05:00 [CRIT]"));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.syslog, " 1970-01-01T00:00:01.000-05:00 "));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.legacy_syslog, "Jan  1 00:00:01 "));
+
+  // No timestamp, then back to the same second
+  lparams.time_fn = NULL;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_EQUAL_STRING(last_log_strings_received.human_readable, "[CRIT] Test Message");
+  lparams.time_fn = time_callback;
+  cur_time.msec   = 42;
+  etcpal_log(&lparams, ETCPAL_LOG_CRIT, "Test Message");
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.human_readable, "1970-01-01 00:00:01.042-05:00 [CRIT]"));
+  TEST_ASSERT_TRUE(strstr(last_log_strings_received.syslog, " 1970-01-01T00:00:01.042-05:00 "));
+}
+
 TEST(etcpal_log, syslog_time_header_is_well_formed)
 {
   EtcPalSyslogParams syslog_params = ETCPAL_SYSLOG_PARAMS_INIT;
@@ -1039,6 +1122,7 @@ TEST_GROUP_RUNNER(etcpal_log)
   RUN_TEST_CASE(etcpal_log, action_syslog_only_is_honored);
   RUN_TEST_CASE(etcpal_log, action_legacy_syslog_only_is_honored);
   RUN_TEST_CASE(etcpal_log, action_all_is_honored);
+  RUN_TEST_CASE(etcpal_log, action_all_truncates_long_message_once);
   RUN_TEST_CASE(etcpal_log, context_pointer_is_passed_unmodified);
   RUN_TEST_CASE(etcpal_log, priority_is_passed_unmodified);
   RUN_TEST_CASE(etcpal_log, syslog_header_with_all_parts);
@@ -1055,6 +1139,7 @@ TEST_GROUP_RUNNER(etcpal_log)
   RUN_TEST_CASE(etcpal_log, syslog_prival_is_correct);
   RUN_TEST_CASE(etcpal_log, log_mask_is_honored);
   RUN_TEST_CASE(etcpal_log, human_time_header_is_well_formed);
+  RUN_TEST_CASE(etcpal_log, time_header_is_updated_between_messages);
   RUN_TEST_CASE(etcpal_log, syslog_time_header_is_well_formed);
   RUN_TEST_CASE(etcpal_log, legacy_syslog_time_header_is_well_formed);
   RUN_TEST_CASE(etcpal_log, formatting_int_values_works);
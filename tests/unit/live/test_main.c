@@ -24,12 +24,15 @@ DEFINE_FFF_GLOBALS;
 
 void run_all_tests(void)
 {
+  RUN_TEST_GROUP(etcpal_acn_pdu);
   RUN_TEST_GROUP(etcpal_common);
   RUN_TEST_GROUP(etcpal_handle_manager);
+  RUN_TEST_GROUP(etcpal_hashmap);
   RUN_TEST_GROUP(etcpal_log);
   RUN_TEST_GROUP(etcpal_mempool);
   RUN_TEST_GROUP(etcpal_pack);
   RUN_TEST_GROUP(etcpal_rbtree);
+  RUN_TEST_GROUP(etcpal_spsc_queue);
   RUN_TEST_GROUP(etcpal_uuid);
 #if !ETCPAL_NO_OS_SUPPORT
 #if !DISABLE_EVENT_GROUP_TESTS
@@ -43,6 +46,7 @@ void run_all_tests(void)
   RUN_TEST_GROUP(etcpal_sem);
   RUN_TEST_GROUP(etcpal_signal);
   RUN_TEST_GROUP(etcpal_thread);
+  RUN_TEST_GROUP(etcpal_threadpool);
   RUN_TEST_GROUP(etcpal_timer);
 #if !DISABLE_QUEUE_TESTS
   RUN_TEST_GROUP(etcpal_queue);
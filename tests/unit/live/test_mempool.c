@@ -35,6 +35,8 @@ typedef struct TestElem
 
 ETCPAL_MEMPOOL_DEFINE(alloc_test, TestElem, ALLOC_TEST_MEMP_SIZE);
 ETCPAL_MEMPOOL_DEFINE_ARRAY(alloc_array_test, TestElem, ALLOC_TEST_MEMP_ARR_SIZE, ALLOC_TEST_MEMP_SIZE);
+ETCPAL_MEMPOOL_DEFINE_LOCKFREE(lockfree_test, TestElem, ALLOC_TEST_MEMP_SIZE);
+ETCPAL_MEMPOOL_DEFINE_ARRAY_LOCKFREE(lockfree_array_test, TestElem, ALLOC_TEST_MEMP_ARR_SIZE, ALLOC_TEST_MEMP_SIZE);
 
 TestElem* test_arr[ALLOC_TEST_MEMP_SIZE];
 size_t    index_arr[ALLOC_TEST_MEMP_SIZE];
@@ -65,6 +67,10 @@ TEST_SETUP(etcpal_mempool)
 
 TEST_TEAR_DOWN(etcpal_mempool)
 {
+  etcpal_mempool_deinit(alloc_test);
+  etcpal_mempool_deinit(alloc_array_test);
+  etcpal_mempool_deinit(lockfree_test);
+  etcpal_mempool_deinit(lockfree_array_test);
 }
 
 TEST(etcpal_mempool, alloc_and_free_works)
@@ -99,6 +105,20 @@ TEST(etcpal_mempool, alloc_and_free_works)
   }
 }
 
+TEST(etcpal_mempool, reinit_after_deinit_works)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(alloc_test));
+  TEST_ASSERT_NOT_NULL(etcpal_mempool_alloc(alloc_test));
+  etcpal_mempool_deinit(alloc_test);
+
+  // Deinitializing twice is harmless, and the pool comes back empty after it is initialized again.
+  etcpal_mempool_deinit(alloc_test);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(alloc_test));
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mempool_used(alloc_test));
+  TEST_ASSERT_NOT_NULL(etcpal_mempool_alloc(alloc_test));
+  TEST_ASSERT_EQUAL_UINT(1u, etcpal_mempool_used(alloc_test));
+}
+
 TEST(etcpal_mempool, alloc_and_free_array_works)
 {
   // Initialize the pool.
@@ -149,8 +169,99 @@ TEST(etcpal_mempool, alloc_and_free_array_works)
   }
 }
 
+TEST(etcpal_mempool, lockfree_alloc_and_free_works)
+{
+  // Initialize the pool.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(lockfree_test));
+  TEST_ASSERT_EQUAL_UINT(ALLOC_TEST_MEMP_SIZE, etcpal_mempool_size(lockfree_test));
+
+  // Allocate the entire pool. Each element should be unique.
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    TestElem* elem = (TestElem*)etcpal_mempool_alloc(lockfree_test);
+    TEST_ASSERT(elem);
+    if (elem)
+      elem->val1 = (int)i;
+    test_arr[i] = elem;
+  }
+  TEST_ASSERT_EQUAL_UINT(ALLOC_TEST_MEMP_SIZE, etcpal_mempool_used(lockfree_test));
+  TEST_ASSERT_NULL(etcpal_mempool_alloc(lockfree_test));
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+    TEST_ASSERT_EQUAL_INT((int)i, test_arr[i]->val1);
+
+  // Free the elements back in random order.
+  create_shuffled_index_array(index_arr, ALLOC_TEST_MEMP_SIZE);
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    etcpal_mempool_free(lockfree_test, test_arr[index_arr[i]]);
+  }
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mempool_used(lockfree_test));
+
+  // Make sure we can allocate the entire pool again.
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    test_arr[i] = (TestElem*)etcpal_mempool_alloc(lockfree_test);
+    TEST_ASSERT(test_arr[i]);
+  }
+  TEST_ASSERT_NULL(etcpal_mempool_alloc(lockfree_test));
+
+  // Reinitializing the pool should make the entire pool available again.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(lockfree_test));
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mempool_used(lockfree_test));
+  TEST_ASSERT_NOT_NULL(etcpal_mempool_alloc(lockfree_test));
+}
+
+TEST(etcpal_mempool, lockfree_alloc_and_free_array_works)
+{
+  // Initialize the pool.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_mempool_init(lockfree_array_test));
+  TEST_ASSERT_EQUAL_UINT(ALLOC_TEST_MEMP_SIZE, etcpal_mempool_size(lockfree_array_test));
+
+  // Allocate the entire pool.
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    TestElem* elem_arr = (TestElem*)etcpal_mempool_alloc(lockfree_array_test);
+    TEST_ASSERT(elem_arr);
+    if (elem_arr)
+    {
+      for (size_t j = 0; j < ALLOC_TEST_MEMP_ARR_SIZE; ++j)
+      {
+        elem_arr[j].val1 = 1;
+        elem_arr[j].val2 = 2;
+      }
+    }
+
+    test_arr[i] = elem_arr;
+  }
+  TEST_ASSERT_EQUAL_UINT(ALLOC_TEST_MEMP_SIZE, etcpal_mempool_used(lockfree_array_test));
+
+  // Free the elements back in random order.
+  create_shuffled_index_array(index_arr, ALLOC_TEST_MEMP_SIZE);
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    etcpal_mempool_free(lockfree_array_test, test_arr[index_arr[i]]);
+  }
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mempool_used(lockfree_array_test));
+
+  // Make sure we can allocate the entire pool again and the sentinel values are still there.
+  for (size_t i = 0; i < ALLOC_TEST_MEMP_SIZE; ++i)
+  {
+    test_arr[i] = (TestElem*)etcpal_mempool_alloc(lockfree_array_test);
+    TEST_ASSERT(test_arr[i]);
+
+    for (size_t j = 0; j < ALLOC_TEST_MEMP_ARR_SIZE; ++j)
+    {
+      TEST_ASSERT_EQUAL(test_arr[i][j].val1, 1);
+      TEST_ASSERT_EQUAL(test_arr[i][j].val2, 2);
+    }
+  }
+}
+
 TEST_GROUP_RUNNER(etcpal_mempool)
 {
   RUN_TEST_CASE(etcpal_mempool, alloc_and_free_works);
+  RUN_TEST_CASE(etcpal_mempool, reinit_after_deinit_works);
   RUN_TEST_CASE(etcpal_mempool, alloc_and_free_array_works);
+  RUN_TEST_CASE(etcpal_mempool, lockfree_alloc_and_free_works);
+  RUN_TEST_CASE(etcpal_mempool, lockfree_alloc_and_free_array_works);
 }
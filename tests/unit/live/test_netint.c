@@ -20,6 +20,7 @@
 #include "etcpal/netint.h"
 #include "unity_fixture.h"
 
+#include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
 
@@ -93,6 +94,7 @@ TEST(etcpal_netint_no_init, api_does_not_work_before_initialization)
   EtcPalIpAddr dest;
   etcpal_string_to_ip(kEtcPalIpTypeV4, "8.8.8.8", &dest);
   TEST_ASSERT_EQUAL(kEtcPalErrNotInit, etcpal_netint_get_interface_for_dest(&dest, &index));
+  TEST_ASSERT_EQUAL(kEtcPalErrNotInit, etcpal_netint_get_interfaces_for_dests(&dest, &index, 1));
 }
 
 // The main test group. This initializes the module before each test and deinits it after.
@@ -291,6 +293,77 @@ TEST(etcpal_netint, get_interface_for_dest_works_ipv4)
   }
 }
 
+TEST(etcpal_netint, get_interfaces_for_dests_matches_single_lookups)
+{
+  // Resolve every interface address plus a couple of arbitrary destinations in one batch, and make
+  // sure each result matches the one given by etcpal_netint_get_interface_for_dest().
+  size_t        num_dests = num_netints + 2;
+  EtcPalIpAddr* dests     = (EtcPalIpAddr*)calloc(num_dests, sizeof(EtcPalIpAddr));
+  unsigned int* indexes   = (unsigned int*)calloc(num_dests, sizeof(unsigned int));
+  TEST_ASSERT_NOT_NULL(dests);
+  TEST_ASSERT_NOT_NULL(indexes);
+
+  for (size_t i = 0; i < num_netints; ++i)
+    dests[i] = netints[i].addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&dests[num_netints], 0xc8dc0302);  // 200.220.3.2
+  etcpal_string_to_ip(kEtcPalIpTypeV6, "2001:db8::1234", &dests[num_netints + 1]);
+
+  etcpal_error_t batch_res  = etcpal_netint_get_interfaces_for_dests(dests, indexes, num_dests);
+  bool           all_routed = true;
+  for (size_t i = 0; i < num_dests; ++i)
+  {
+    unsigned int   single_index = 0;
+    etcpal_error_t single_res   = etcpal_netint_get_interface_for_dest(&dests[i], &single_index);
+    if (single_res == kEtcPalErrOk)
+    {
+      TEST_ASSERT_EQUAL_UINT(single_index, indexes[i]);
+    }
+    else
+    {
+      TEST_ASSERT_EQUAL(kEtcPalErrNotFound, single_res);
+      TEST_ASSERT_EQUAL_UINT(0u, indexes[i]);
+      all_routed = false;
+    }
+  }
+  TEST_ASSERT_EQUAL(all_routed ? kEtcPalErrOk : kEtcPalErrNotFound, batch_res);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_netint_get_interfaces_for_dests(NULL, indexes, num_dests));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_netint_get_interfaces_for_dests(dests, NULL, num_dests));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_netint_get_interfaces_for_dests(dests, indexes, 0));
+
+  free(dests);
+  free(indexes);
+}
+
+TEST(etcpal_netint, monitor_agrees_with_os)
+{
+  // Record the state reported by the OS before starting the monitor.
+  bool* was_up = (bool*)calloc(num_netints, sizeof(bool));
+  TEST_ASSERT_NOT_NULL(was_up);
+  for (size_t i = 0; i < num_netints; ++i)
+    was_up[i] = etcpal_netint_is_up(netints[i].index);
+
+  etcpal_error_t res = etcpal_netint_start_monitor(NULL, NULL);
+  if (res == kEtcPalErrNotImpl)
+  {
+    free(was_up);
+    TEST_IGNORE_MESSAGE("Interface monitoring is not supported on this platform.");
+  }
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, res);
+  TEST_ASSERT_EQUAL(kEtcPalErrAlready, etcpal_netint_start_monitor(NULL, NULL));
+
+  // The monitor's view of the interfaces should match what we saw without it.
+  for (size_t i = 0; i < num_netints; ++i)
+    TEST_ASSERT_EQUAL(was_up[i], etcpal_netint_is_up(netints[i].index));
+
+  size_t num_monitored_netints = 0;
+  etcpal_netint_get_interfaces(NULL, &num_monitored_netints);
+  TEST_ASSERT_EQUAL_UINT(num_netints, num_monitored_netints);
+
+  etcpal_netint_stop_monitor();
+  free(was_up);
+}
+
 TEST_GROUP_RUNNER(etcpal_netint)
 {
   RUN_TEST_CASE(etcpal_netint_no_init, api_does_not_work_before_initialization);
@@ -300,4 +373,6 @@ TEST_GROUP_RUNNER(etcpal_netint)
   RUN_TEST_CASE(etcpal_netint, get_netint_with_ip_works);
   RUN_TEST_CASE(etcpal_netint, default_netint_is_consistent);
   RUN_TEST_CASE(etcpal_netint, get_interface_for_dest_works_ipv4);
+  RUN_TEST_CASE(etcpal_netint, get_interfaces_for_dests_matches_single_lookups);
+  RUN_TEST_CASE(etcpal_netint, monitor_agrees_with_os);
 }
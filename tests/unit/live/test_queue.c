@@ -129,10 +129,77 @@ TEST(etcpal_queue, can_detect_empty)
   etcpal_queue_destroy(&queue);
 }
 
+TEST(etcpal_queue, wraps_around_correctly)
+{
+  etcpal_queue_t queue = ETCPAL_QUEUE_INIT;
+
+  // Use a size that is not a power of 2, and cycle through enough items to wrap several times.
+  TEST_ASSERT_TRUE(etcpal_queue_create(&queue, 5, sizeof(uint32_t)));
+  for (uint32_t i = 0; i < 20; ++i)
+  {
+    TEST_ASSERT_TRUE(etcpal_queue_timed_send(&queue, &i, 0));
+    uint32_t extra = i + 1000;
+    TEST_ASSERT_TRUE(etcpal_queue_timed_send(&queue, &extra, 0));
+
+    uint32_t received_data = 0;
+    TEST_ASSERT_TRUE(etcpal_queue_timed_receive(&queue, &received_data, 0));
+    TEST_ASSERT_EQUAL_UINT32(i, received_data);
+    TEST_ASSERT_TRUE(etcpal_queue_timed_receive(&queue, &received_data, 0));
+    TEST_ASSERT_EQUAL_UINT32(i + 1000, received_data);
+  }
+  TEST_ASSERT_TRUE(etcpal_queue_is_empty(&queue));
+
+  etcpal_queue_destroy(&queue);
+}
+
+#if !DISABLE_QUEUE_BATCH_TESTS
+TEST(etcpal_queue, can_send_and_receive_many)
+{
+  etcpal_queue_t queue = ETCPAL_QUEUE_INIT;
+
+  TEST_ASSERT_TRUE(etcpal_queue_create(&queue, 6, sizeof(uint32_t)));
+
+  // Offset the head so that batches wrap around the end of the buffer.
+  uint32_t data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  TEST_ASSERT_EQUAL_UINT(3u, etcpal_queue_send_many(&queue, data, 3, 0));
+  uint32_t received_data[10] = {0};
+  TEST_ASSERT_EQUAL_UINT(3u, etcpal_queue_receive_many(&queue, received_data, 10, 0));
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(data, received_data, 3);
+
+  // Only as many items as will fit should be sent.
+  TEST_ASSERT_EQUAL_UINT(6u, etcpal_queue_send_many(&queue, data, 10, 0));
+  TEST_ASSERT_TRUE(etcpal_queue_is_full(&queue));
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_queue_send_many(&queue, &data[6], 4, 0));
+
+  // Receive in two batches, preserving order.
+  TEST_ASSERT_EQUAL_UINT(4u, etcpal_queue_receive_many(&queue, received_data, 4, 0));
+  TEST_ASSERT_EQUAL_UINT(2u, etcpal_queue_receive_many(&queue, &received_data[4], 10, 0));
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(data, received_data, 6);
+  TEST_ASSERT_TRUE(etcpal_queue_is_empty(&queue));
+
+#if ETCPAL_QUEUE_HAS_TIMED_FUNCTIONS
+  EtcPalTimer timer;
+  etcpal_timer_start(&timer, 100);
+
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_queue_receive_many(&queue, received_data, 10, 10));
+
+  // An unfortunately necessary heuristic - we assert that at least half the specified time has
+  // gone by, to account for OS slop.
+  TEST_ASSERT_GREATER_THAN_UINT32(5, etcpal_timer_elapsed(&timer));
+#endif
+
+  etcpal_queue_destroy(&queue);
+}
+#endif
+
 TEST_GROUP_RUNNER(etcpal_queue)
 {
   RUN_TEST_CASE(etcpal_queue, can_send_and_receive);
   RUN_TEST_CASE(etcpal_queue, will_timeout_on_send);
   RUN_TEST_CASE(etcpal_queue, will_timeout_on_receive);
   RUN_TEST_CASE(etcpal_queue, can_detect_empty);
+  RUN_TEST_CASE(etcpal_queue, wraps_around_correctly);
+#if !DISABLE_QUEUE_BATCH_TESTS
+  RUN_TEST_CASE(etcpal_queue, can_send_and_receive_many);
+#endif
 }
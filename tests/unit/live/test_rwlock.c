@@ -20,9 +20,102 @@
 #include "etcpal/rwlock.h"
 
 #include "etcpal/common.h"
+#include "etcpal/signal.h"
+#include "etcpal/thread.h"
 #include "etcpal/timer.h"
 #include "unity_fixture.h"
 
+#if ETCPAL_RWLOCK_HAS_TIMED_LOCK
+#define JITTER_TEST_TIMEOUT_MS  20
+#define JITTER_TEST_ITERATIONS  10
+#define JITTER_TEST_MAX_LATE_MS 100
+
+// Some platforms detect a thread contending with its own lock and fail immediately, so contention
+// for the timed lock tests is provided by a separate thread.
+typedef struct LockHolder
+{
+  etcpal_rwlock_t* rwlock;
+  bool             write;
+  bool             got_lock;
+  etcpal_signal_t  locked;
+  etcpal_signal_t  release;
+  etcpal_thread_t  thread;
+} LockHolder;
+
+static void hold_lock(void* arg)
+{
+  LockHolder* holder = (LockHolder*)arg;
+  if (holder->write)
+    holder->got_lock = etcpal_rwlock_writelock(holder->rwlock);
+  else
+    holder->got_lock = etcpal_rwlock_readlock(holder->rwlock);
+
+  // Signal even on failure, so that start_holding_lock() can report it instead of hanging.
+  etcpal_signal_post(&holder->locked);
+  etcpal_signal_wait(&holder->release);
+
+  if (holder->got_lock)
+  {
+    if (holder->write)
+      etcpal_rwlock_writeunlock(holder->rwlock);
+    else
+      etcpal_rwlock_readunlock(holder->rwlock);
+  }
+}
+
+static void start_holding_lock(LockHolder* holder, etcpal_rwlock_t* rwlock, bool write)
+{
+  holder->rwlock   = rwlock;
+  holder->write    = write;
+  holder->got_lock = false;
+  TEST_ASSERT_TRUE(etcpal_signal_create(&holder->locked));
+  TEST_ASSERT_TRUE(etcpal_signal_create(&holder->release));
+
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&holder->thread, &params, hold_lock, holder));
+  TEST_ASSERT_TRUE(etcpal_signal_wait(&holder->locked));
+  TEST_ASSERT_TRUE(holder->got_lock);
+}
+
+static void stop_holding_lock(LockHolder* holder)
+{
+  etcpal_signal_post(&holder->release);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&holder->thread));
+  etcpal_signal_destroy(&holder->release);
+  etcpal_signal_destroy(&holder->locked);
+}
+
+typedef bool (*TimedLockFn)(etcpal_rwlock_t* id, int timeout_ms);
+
+// Time out repeatedly on a contended lock and return the latest wakeup past the deadline.
+static uint32_t measure_max_late_ms(etcpal_rwlock_t* rwlock, TimedLockFn timed_lock)
+{
+  uint32_t max_late_ms = 0;
+  for (int i = 0; i < JITTER_TEST_ITERATIONS; ++i)
+  {
+    uint32_t start = etcpal_getms();
+    TEST_ASSERT_FALSE(timed_lock(rwlock, JITTER_TEST_TIMEOUT_MS));
+    uint32_t elapsed = etcpal_getms() - start;
+
+    // Allow 1ms of slack for the granularity of etcpal_getms().
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(JITTER_TEST_TIMEOUT_MS - 1, elapsed);
+    if (elapsed > JITTER_TEST_TIMEOUT_MS && elapsed - JITTER_TEST_TIMEOUT_MS > max_late_ms)
+      max_late_ms = elapsed - JITTER_TEST_TIMEOUT_MS;
+  }
+  return max_late_ms;
+}
+
+static bool timed_readlock(etcpal_rwlock_t* id, int timeout_ms)
+{
+  return etcpal_rwlock_timed_readlock(id, timeout_ms);
+}
+
+static bool timed_writelock(etcpal_rwlock_t* id, int timeout_ms)
+{
+  return etcpal_rwlock_timed_writelock(id, timeout_ms);
+}
+#endif
+
 #define NUM_TEST_LOCKS 32
 
 TEST_GROUP(etcpal_rwlock);
@@ -77,11 +170,12 @@ TEST(etcpal_rwlock, timed_lock_works)
   etcpal_rwlock_t rwlock = ETCPAL_RWLOCK_INIT;
   TEST_ASSERT_TRUE(etcpal_rwlock_create(&rwlock));
 
-#if ETCPAL_MUTEX_HAS_TIMED_LOCK
+#if ETCPAL_RWLOCK_HAS_TIMED_LOCK
   EtcPalTimer timer;
+  LockHolder  holder;
 
   // Test timed_writelock()
-  TEST_ASSERT_TRUE(etcpal_rwlock_readlock(&rwlock));
+  start_holding_lock(&holder, &rwlock, false);
   etcpal_timer_start(&timer, 100);
   TEST_ASSERT_FALSE(etcpal_rwlock_timed_writelock(&rwlock, 10));
 
@@ -89,16 +183,22 @@ TEST(etcpal_rwlock, timed_lock_works)
   // gone by, to account for OS slop.
   TEST_ASSERT_GREATER_THAN_UINT32(5, etcpal_timer_elapsed(&timer));
 
-  etcpal_rwlock_readunlock(&rwlock);
+  stop_holding_lock(&holder);
 
   // Test timed_readlock()
 
-  TEST_ASSERT_TRUE(etcpal_rwlock_writelock(&rwlock));
+  start_holding_lock(&holder, &rwlock, true);
   etcpal_timer_start(&timer, 100);
   TEST_ASSERT_FALSE(etcpal_rwlock_timed_readlock(&rwlock, 10));
 
   TEST_ASSERT_GREATER_THAN_UINT32(5, etcpal_timer_elapsed(&timer));
 
+  stop_holding_lock(&holder);
+
+  // Once the lock is released, the timed functions should succeed.
+  TEST_ASSERT_TRUE(etcpal_rwlock_timed_readlock(&rwlock, 10));
+  etcpal_rwlock_readunlock(&rwlock);
+  TEST_ASSERT_TRUE(etcpal_rwlock_timed_writelock(&rwlock, 10));
   etcpal_rwlock_writeunlock(&rwlock);
 #else
   // On this platform, timed_lock() should behave the same as try_lock() if timeout_ms is 0, and
@@ -120,11 +220,34 @@ TEST(etcpal_rwlock, timed_lock_works)
   etcpal_rwlock_destroy(&rwlock);
 }
 
+#if ETCPAL_RWLOCK_HAS_TIMED_LOCK
+TEST(etcpal_rwlock, timed_lock_jitter_is_bounded)
+{
+  etcpal_rwlock_t rwlock = ETCPAL_RWLOCK_INIT;
+  TEST_ASSERT_TRUE(etcpal_rwlock_create(&rwlock));
+
+  LockHolder holder;
+
+  start_holding_lock(&holder, &rwlock, false);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(JITTER_TEST_MAX_LATE_MS, measure_max_late_ms(&rwlock, timed_writelock));
+  stop_holding_lock(&holder);
+
+  start_holding_lock(&holder, &rwlock, true);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(JITTER_TEST_MAX_LATE_MS, measure_max_late_ms(&rwlock, timed_readlock));
+  stop_holding_lock(&holder);
+
+  etcpal_rwlock_destroy(&rwlock);
+}
+#endif  // ETCPAL_RWLOCK_HAS_TIMED_LOCK
+
 TEST_GROUP_RUNNER(etcpal_rwlock)
 {
   etcpal_init(ETCPAL_FEATURE_TIMERS);
   RUN_TEST_CASE(etcpal_rwlock, create_and_destroy_works);
   RUN_TEST_CASE(etcpal_rwlock, read_and_write_interaction);
   RUN_TEST_CASE(etcpal_rwlock, timed_lock_works);
+#if ETCPAL_RWLOCK_HAS_TIMED_LOCK
+  RUN_TEST_CASE(etcpal_rwlock, timed_lock_jitter_is_bounded);
+#endif
   etcpal_deinit(ETCPAL_FEATURE_TIMERS);
 }
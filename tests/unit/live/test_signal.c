@@ -20,9 +20,22 @@
 #include "etcpal/signal.h"
 
 #include "etcpal/common.h"
+#include "etcpal/thread.h"
 #include "etcpal/timer.h"
 #include "unity_fixture.h"
 
+#if ETCPAL_SIGNAL_HAS_TIMED_WAIT
+#define JITTER_TEST_TIMEOUT_MS  20
+#define JITTER_TEST_ITERATIONS  10
+#define JITTER_TEST_MAX_LATE_MS 100
+
+static void post_after_delay(void* arg)
+{
+  etcpal_thread_sleep(JITTER_TEST_TIMEOUT_MS);
+  etcpal_signal_post((etcpal_signal_t*)arg);
+}
+#endif
+
 TEST_GROUP(etcpal_signal);
 
 TEST_SETUP(etcpal_signal)
@@ -85,11 +98,63 @@ TEST(etcpal_signal, timed_wait_works)
   etcpal_signal_destroy(&signal);
 }
 
+#if ETCPAL_SIGNAL_HAS_TIMED_WAIT
+// Repeatedly time out and make sure each wakeup happens neither early nor excessively late.
+TEST(etcpal_signal, timed_wait_jitter_is_bounded)
+{
+  etcpal_signal_t signal = ETCPAL_SIGNAL_INIT;
+  TEST_ASSERT_TRUE(etcpal_signal_create(&signal));
+
+  uint32_t max_late_ms = 0;
+  for (int i = 0; i < JITTER_TEST_ITERATIONS; ++i)
+  {
+    uint32_t start = etcpal_getms();
+    TEST_ASSERT_FALSE(etcpal_signal_timed_wait(&signal, JITTER_TEST_TIMEOUT_MS));
+    uint32_t elapsed = etcpal_getms() - start;
+
+    // Allow 1ms of slack for the granularity of etcpal_getms().
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(JITTER_TEST_TIMEOUT_MS - 1, elapsed);
+    if (elapsed > JITTER_TEST_TIMEOUT_MS && elapsed - JITTER_TEST_TIMEOUT_MS > max_late_ms)
+      max_late_ms = elapsed - JITTER_TEST_TIMEOUT_MS;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(JITTER_TEST_MAX_LATE_MS, max_late_ms);
+
+  etcpal_signal_destroy(&signal);
+}
+
+// A post from another thread should end a timed wait early.
+TEST(etcpal_signal, timed_wait_wakes_on_post)
+{
+  etcpal_signal_t signal = ETCPAL_SIGNAL_INIT;
+  TEST_ASSERT_TRUE(etcpal_signal_create(&signal));
+
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  etcpal_thread_t    thread;
+
+  uint32_t start = etcpal_getms();
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&thread, &params, post_after_delay, &signal));
+  TEST_ASSERT_TRUE(etcpal_signal_timed_wait(&signal, 5000));
+  uint32_t elapsed = etcpal_getms() - start;
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(JITTER_TEST_TIMEOUT_MS + JITTER_TEST_MAX_LATE_MS, elapsed);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&thread));
+
+  // The wakeup should have consumed the post.
+  TEST_ASSERT_FALSE(etcpal_signal_try_wait(&signal));
+
+  etcpal_signal_destroy(&signal);
+}
+#endif  // ETCPAL_SIGNAL_HAS_TIMED_WAIT
+
 TEST_GROUP_RUNNER(etcpal_signal)
 {
   etcpal_init(ETCPAL_FEATURE_TIMERS);
   RUN_TEST_CASE(etcpal_signal, create_and_destroy_works);
   RUN_TEST_CASE(etcpal_signal, try_wait_works);
   RUN_TEST_CASE(etcpal_signal, timed_wait_works);
+#if ETCPAL_SIGNAL_HAS_TIMED_WAIT
+  RUN_TEST_CASE(etcpal_signal, timed_wait_jitter_is_bounded);
+  RUN_TEST_CASE(etcpal_signal, timed_wait_wakes_on_post);
+#endif
   etcpal_deinit(ETCPAL_FEATURE_TIMERS);
 }
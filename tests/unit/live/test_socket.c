@@ -37,8 +37,12 @@
 #include "etcpal/socket.h"
 #include "unity_fixture.h"
 
+#include "etcpal/acn_rlp.h"
 #include "etcpal/netint.h"
+#include "etcpal/thread.h"
+#include "etcpal/timer.h"
 #include <stddef.h>
+#include <string.h>
 
 // For getaddrinfo
 #if 0
@@ -391,6 +395,81 @@ TEST(etcpal_socket, poll_for_writability_on_udp_sockets_works)
   etcpal_poll_context_deinit(&context);
 }
 
+#define POLL_WAIT_MANY_TEST_PORT_BASE 9100
+#define POLL_WAIT_MANY_NUM_SOCKETS    4
+
+// Test that etcpal_poll_wait_many() reports all ready sockets, each at most once.
+TEST(etcpal_socket, poll_wait_many_works)
+{
+  etcpal_socket_t send_sock = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t rcvsocks[POLL_WAIT_MANY_NUM_SOCKETS];
+
+  EtcPalPollContext context = ETCPAL_POLL_CONTEXT_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_context_init(&context));
+
+  EtcPalPollEvent events[POLL_WAIT_MANY_NUM_SOCKETS * 2];
+  TEST_ASSERT_EQUAL((int)kEtcPalErrNoSockets, etcpal_poll_wait_many(&context, events, 1, 100));
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock));
+
+  EtcPalSockAddr bind_addr;
+  etcpal_ip_set_wildcard(kEtcPalIpTypeV4, &bind_addr.ip);
+  for (size_t i = 0; i < POLL_WAIT_MANY_NUM_SOCKETS; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &rcvsocks[i]));
+    bind_addr.port = (uint16_t)(POLL_WAIT_MANY_TEST_PORT_BASE + i);
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_bind(rcvsocks[i], &bind_addr));
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_add_socket(&context, rcvsocks[i], ETCPAL_POLL_IN, &rcvsocks[i]));
+  }
+
+  // Invalid calls
+  TEST_ASSERT_EQUAL((int)kEtcPalErrInvalid, etcpal_poll_wait_many(NULL, events, 1, 100));
+  TEST_ASSERT_EQUAL((int)kEtcPalErrInvalid, etcpal_poll_wait_many(&context, NULL, 1, 100));
+  TEST_ASSERT_EQUAL((int)kEtcPalErrInvalid, etcpal_poll_wait_many(&context, events, 0, 100));
+
+  TEST_ASSERT_EQUAL((int)kEtcPalErrTimedOut, etcpal_poll_wait_many(&context, events, 1, 100));
+
+  EtcPalSockAddr send_addr;
+  ETCPAL_IP_SET_V4_ADDRESS(&send_addr.ip, 0x7f000001);
+  for (size_t i = 0; i < POLL_WAIT_MANY_NUM_SOCKETS; ++i)
+  {
+    send_addr.port = (uint16_t)(POLL_WAIT_MANY_TEST_PORT_BASE + i);
+    etcpal_sendto(send_sock, (const uint8_t*)"test message", sizeof("test message"), 0, &send_addr);
+  }
+
+  // Drain the events; platforms that can only report one event per call will take multiple calls.
+  bool socket_seen[POLL_WAIT_MANY_NUM_SOCKETS] = {false};
+  int  total_events                            = 0;
+  while (total_events < POLL_WAIT_MANY_NUM_SOCKETS)
+  {
+    int res = etcpal_poll_wait_many(&context, events, POLL_WAIT_MANY_NUM_SOCKETS * 2, 1000);
+    TEST_ASSERT_GREATER_THAN(0, res);
+    TEST_ASSERT_LESS_OR_EQUAL(POLL_WAIT_MANY_NUM_SOCKETS - total_events, res);
+
+    for (int i = 0; i < res; ++i)
+    {
+      size_t sock_index = (size_t)((etcpal_socket_t*)events[i].user_data - rcvsocks);
+      TEST_ASSERT_LESS_THAN(POLL_WAIT_MANY_NUM_SOCKETS, sock_index);
+      TEST_ASSERT_EQUAL(rcvsocks[sock_index], events[i].socket);
+      TEST_ASSERT_EQUAL(ETCPAL_POLL_IN, events[i].events);
+      TEST_ASSERT_EQUAL(kEtcPalErrOk, events[i].err);
+      TEST_ASSERT_FALSE(socket_seen[sock_index]);
+      socket_seen[sock_index] = true;
+
+      uint8_t recv_buf[sizeof("test message")];
+      TEST_ASSERT_GREATER_THAN(0, etcpal_recvfrom(events[i].socket, recv_buf, sizeof(recv_buf), 0, NULL));
+    }
+    total_events += res;
+  }
+
+  TEST_ASSERT_EQUAL((int)kEtcPalErrTimedOut, etcpal_poll_wait_many(&context, events, 1, 100));
+
+  for (size_t i = 0; i < POLL_WAIT_MANY_NUM_SOCKETS; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_close(rcvsocks[i]));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_close(send_sock));
+  etcpal_poll_context_deinit(&context);
+}
+
 // The lwIP select function requires the max socket fd + 1 as the first parameter. This test ensures an edge case is
 // correctly handled where the max fd is removed.
 TEST(etcpal_socket, poll_still_works_when_max_fd_removed)
@@ -629,6 +708,287 @@ TEST(etcpal_socket, recvmsg_trunc_peek_works)
   etcpal_close(recv_sock);
 }
 
+#define MMSG_TEST_PORT    (RECVMSG_TEST_PORT_BASE + 1)
+#define SENDMSG_TEST_PORT (RECVMSG_TEST_PORT_BASE + 2)
+#define MMSG_TEST_NUM_MSGS 8
+
+TEST(etcpal_socket, sendmmsg_and_recvmmsg_work)
+{
+#ifdef __MQX__
+  TEST_IGNORE_MESSAGE("etcpal_recvmmsg() not implemented on this platform.");
+#endif
+
+  etcpal_socket_t recv_sock = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t send_sock = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_sock));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock));
+
+  int intval = 1;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_setsockopt(recv_sock, ETCPAL_IPPROTO_IP, ETCPAL_IP_PKTINFO, &intval, sizeof(int)));
+  intval = 100;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_setsockopt(recv_sock, ETCPAL_SOL_SOCKET, ETCPAL_SO_RCVTIMEO, &intval, sizeof(int)));
+
+  EtcPalSockAddr bind_addr;
+  etcpal_ip_set_wildcard(kEtcPalIpTypeV4, &bind_addr.ip);
+  bind_addr.port = MMSG_TEST_PORT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_bind(recv_sock, &bind_addr));
+
+  // Send a batch of datagrams of different lengths.
+  uint8_t       send_bufs[MMSG_TEST_NUM_MSGS][MMSG_TEST_NUM_MSGS + 1];
+  EtcPalMMsgHdr send_msgs[MMSG_TEST_NUM_MSGS];
+  memset(send_msgs, 0, sizeof send_msgs);
+  for (size_t i = 0; i < MMSG_TEST_NUM_MSGS; ++i)
+  {
+    memset(send_bufs[i], (int)i, sizeof send_bufs[i]);
+    ETCPAL_IP_SET_V4_ADDRESS(&send_msgs[i].hdr.name.ip, 0x7f000001);
+    send_msgs[i].hdr.name.port = MMSG_TEST_PORT;
+    send_msgs[i].hdr.buf       = send_bufs[i];
+    send_msgs[i].hdr.buflen    = i + 1;
+  }
+  TEST_ASSERT_EQUAL(MMSG_TEST_NUM_MSGS, etcpal_sendmmsg(send_sock, send_msgs, MMSG_TEST_NUM_MSGS, 0));
+  for (size_t i = 0; i < MMSG_TEST_NUM_MSGS; ++i)
+    TEST_ASSERT_EQUAL_UINT(i + 1, send_msgs[i].len);
+
+  // Receive them back. Platforms without a batch receive return them one at a time.
+  uint8_t       recv_bufs[MMSG_TEST_NUM_MSGS][MMSG_TEST_NUM_MSGS + 1];
+  uint8_t       controls[MMSG_TEST_NUM_MSGS][ETCPAL_MAX_CONTROL_SIZE_PKTINFO];
+  EtcPalMMsgHdr recv_msgs[MMSG_TEST_NUM_MSGS];
+  memset(recv_msgs, 0, sizeof recv_msgs);
+  for (size_t i = 0; i < MMSG_TEST_NUM_MSGS; ++i)
+  {
+    recv_msgs[i].hdr.buf        = recv_bufs[i];
+    recv_msgs[i].hdr.buflen     = sizeof recv_bufs[i];
+    recv_msgs[i].hdr.control    = controls[i];
+    recv_msgs[i].hdr.controllen = sizeof controls[i];
+  }
+
+  size_t num_received = 0;
+  while (num_received < MMSG_TEST_NUM_MSGS)
+  {
+    int res = etcpal_recvmmsg(recv_sock, &recv_msgs[num_received], MMSG_TEST_NUM_MSGS - num_received, 0);
+    TEST_ASSERT_GREATER_THAN(0, res);
+    num_received += (size_t)res;
+  }
+
+  for (size_t i = 0; i < MMSG_TEST_NUM_MSGS; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT(i + 1, recv_msgs[i].len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(send_bufs[i], recv_bufs[i], i + 1);
+    TEST_ASSERT_EQUAL_UINT32(0x7f000001, ETCPAL_IP_V4_ADDRESS(&recv_msgs[i].hdr.name.ip));
+
+    EtcPalCMsgHdr cmsg    = {0};
+    EtcPalPktInfo pktinfo;
+    memset(&pktinfo, 0, sizeof pktinfo);
+    TEST_ASSERT_TRUE(etcpal_cmsg_firsthdr(&recv_msgs[i].hdr, &cmsg));
+    TEST_ASSERT_TRUE(etcpal_cmsg_to_pktinfo(&cmsg, &pktinfo));
+    TEST_ASSERT_EQUAL_UINT32(0x7f000001, ETCPAL_IP_V4_ADDRESS(&pktinfo.addr));
+  }
+
+  // Verify nothing remains on the input queue.
+  int result = etcpal_recvmmsg(recv_sock, recv_msgs, MMSG_TEST_NUM_MSGS, 0);
+  TEST_ASSERT((result == kEtcPalErrTimedOut) || (result == kEtcPalErrWouldBlock));
+
+  etcpal_close(send_sock);
+  etcpal_close(recv_sock);
+}
+
+TEST(etcpal_socket, sendmsg_sends_rlp_block_in_place)
+{
+#ifdef __MQX__
+  TEST_IGNORE_MESSAGE("Gathered sends not implemented on this platform.");
+#endif
+
+  etcpal_socket_t recv_sock = ETCPAL_SOCKET_INVALID;
+  etcpal_socket_t send_sock = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &recv_sock));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &send_sock));
+
+  int intval = 100;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_setsockopt(recv_sock, ETCPAL_SOL_SOCKET, ETCPAL_SO_RCVTIMEO, &intval, sizeof(int)));
+
+  EtcPalSockAddr addr;
+  etcpal_ip_set_wildcard(kEtcPalIpTypeV4, &addr.ip);
+  addr.port = SENDMSG_TEST_PORT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_bind(recv_sock, &addr));
+
+  // The second PDU inherits the first one's data, and the third has a different vector. The third
+  // PDU's data is large enough to need the extended length field.
+  static uint8_t data_1[100];
+  static uint8_t data_2[5000];
+  memset(data_1, 0x11, sizeof data_1);
+  memset(data_2, 0x22, sizeof data_2);
+
+  AcnRootLayerPdu pdus[3];
+  memset(pdus, 0, sizeof pdus);
+  for (size_t i = 0; i < 3; ++i)
+    memset(pdus[i].sender_cid.data, 0xcd, ETCPAL_UUID_BYTES);
+  pdus[0].vector   = ACN_VECTOR_ROOT_E131_DATA;
+  pdus[0].pdata    = data_1;
+  pdus[0].data_len = sizeof data_1;
+  pdus[1]          = pdus[0];
+  pdus[2].vector   = ACN_VECTOR_ROOT_E131_EXTENDED;
+  pdus[2].pdata    = data_2;
+  pdus[2].data_len = sizeof data_2;
+
+  static uint8_t expected[ACN_UDP_PREAMBLE_SIZE + 2 * sizeof data_1 + sizeof data_2 + 3 * ACN_RLP_HEADER_SIZE_EXT_LEN];
+  size_t expected_len = acn_pack_udp_preamble(expected, sizeof expected);
+  expected_len += acn_pack_root_layer_block(&expected[expected_len], sizeof expected - expected_len, pdus, 3);
+
+  uint8_t     preamble[ACN_UDP_PREAMBLE_SIZE];
+  uint8_t     headers[ACN_RLP_IOV_HEADER_BUF_SIZE(3)];
+  EtcPalIoVec iov[1 + ACN_RLP_IOV_MAX_COUNT(3)];
+  iov[0].base = preamble;
+  iov[0].len  = acn_pack_udp_preamble(preamble, sizeof preamble);
+
+  size_t num_iov = acn_pack_root_layer_block_iov(headers, sizeof headers, pdus, 3, &iov[1], ACN_RLP_IOV_MAX_COUNT(3));
+  TEST_ASSERT_EQUAL_UINT(4u, num_iov);
+  TEST_ASSERT_EQUAL_PTR(data_1, iov[2].base);
+  TEST_ASSERT_EQUAL_PTR(data_2, iov[4].base);
+  TEST_ASSERT_EQUAL_UINT(0u, acn_pack_root_layer_block_iov(headers, sizeof headers, pdus, 3, &iov[1], 3));
+
+  ETCPAL_IP_SET_V4_ADDRESS(&addr.ip, 0x7f000001);
+  TEST_ASSERT_EQUAL((int)expected_len, etcpal_sendmsg(send_sock, iov, num_iov + 1, 0, &addr));
+
+  static uint8_t recv_buf[sizeof expected];
+  TEST_ASSERT_EQUAL((int)expected_len, etcpal_recvfrom(recv_sock, recv_buf, sizeof recv_buf, 0, NULL));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, recv_buf, expected_len);
+
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmsg(send_sock, iov, 0, 0, &addr));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmsg(send_sock, NULL, 1, 0, &addr));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmsg(send_sock, iov, ETCPAL_SENDMSG_MAX_IOV + 1, 0, &addr));
+
+  etcpal_close(send_sock);
+  etcpal_close(recv_sock);
+}
+
+TEST(etcpal_socket, mmsg_invalid_calls_fail)
+{
+  EtcPalMMsgHdr msg;
+  memset(&msg, 0, sizeof msg);
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_recvmmsg(ETCPAL_SOCKET_INVALID, &msg, 1, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmmsg(ETCPAL_SOCKET_INVALID, &msg, 1, 0));
+
+  etcpal_socket_t sock = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &sock));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_recvmmsg(sock, NULL, 1, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_recvmmsg(sock, &msg, 0, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmmsg(sock, NULL, 1, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_sendmmsg(sock, &msg, 0, 0));
+  etcpal_close(sock);
+}
+
+TEST(etcpal_socket, join_groups_invalid_calls_fail)
+{
+  EtcPalGroupReq greq;
+  greq.ifindex = 0;
+  ETCPAL_IP_SET_V4_ADDRESS(&greq.group, 0xefff0001);
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_join_groups(ETCPAL_SOCKET_INVALID, &greq, 1));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_leave_groups(ETCPAL_SOCKET_INVALID, &greq, 1));
+
+  etcpal_socket_t sock = ETCPAL_SOCKET_INVALID;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_socket(ETCPAL_AF_INET, ETCPAL_SOCK_DGRAM, &sock));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_join_groups(sock, NULL, 1));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_join_groups(sock, &greq, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_leave_groups(sock, NULL, 1));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_leave_groups(sock, &greq, 0));
+
+  // A group with an invalid address fails without joining anything.
+  EtcPalGroupReq invalid_greq;
+  memset(&invalid_greq, 0, sizeof invalid_greq);
+  TEST_ASSERT_LESS_THAN_INT(0, etcpal_join_groups(sock, &invalid_greq, 1));
+  etcpal_close(sock);
+}
+
+// Test that timers added to a poll context are reported as events, without any sockets added.
+TEST(etcpal_socket, poll_timer_works)
+{
+  EtcPalPollContext context = ETCPAL_POLL_CONTEXT_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_context_init(&context));
+
+  int                 user_data = 0;
+  etcpal_poll_timer_t timer     = ETCPAL_POLL_TIMER_INVALID;
+  TEST_ASSERT_NOT_EQUAL(kEtcPalErrOk, etcpal_poll_add_timer(NULL, 10, 0, &user_data, &timer));
+  TEST_ASSERT_NOT_EQUAL(kEtcPalErrOk, etcpal_poll_add_timer(&context, 10, 0, &user_data, NULL));
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_poll_reset_timer(&context, 0, 10, 0));
+
+  // One-shot timer: reported once, then nothing more until it is reset.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_add_timer(&context, 20, 0, &user_data, &timer));
+  TEST_ASSERT_NOT_EQUAL(ETCPAL_POLL_TIMER_INVALID, timer);
+
+  EtcPalPollEvent event;
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_poll_wait(&context, &event, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_wait(&context, &event, 1000));
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_TIMER, event.events);
+  TEST_ASSERT_EQUAL(ETCPAL_SOCKET_INVALID, event.socket);
+  TEST_ASSERT_EQUAL(timer, event.timer);
+  TEST_ASSERT_EQUAL_PTR(&user_data, event.user_data);
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_poll_wait(&context, &event, 50));
+
+  // Periodic timer: reported on every interval.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_reset_timer(&context, timer, 5, 10));
+  for (int i = 0; i < 3; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_wait(&context, &event, 1000));
+    TEST_ASSERT_EQUAL(ETCPAL_POLL_TIMER, event.events);
+    TEST_ASSERT_EQUAL(timer, event.timer);
+  }
+
+  // A pending expiration is discarded when the timer is reset.
+  etcpal_thread_sleep(20);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_reset_timer(&context, timer, 1000, 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_poll_wait(&context, &event, 50));
+
+  etcpal_poll_remove_timer(&context, timer);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoSockets, etcpal_poll_wait(&context, &event, 100));
+
+  etcpal_poll_context_deinit(&context);
+}
+
+static void wakeup_after_delay(void* arg)
+{
+  etcpal_thread_sleep(50);
+  etcpal_poll_wakeup((EtcPalPollContext*)arg);
+}
+
+// Test that etcpal_poll_wakeup() wakes a waiting thread, and that multiple wakeups coalesce.
+TEST(etcpal_socket, poll_wakeup_works)
+{
+  EtcPalPollContext context = ETCPAL_POLL_CONTEXT_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_context_init(&context));
+
+  int user_data = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrNotFound, etcpal_poll_wakeup(&context));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_add_wakeup(&context, &user_data));
+  TEST_ASSERT_EQUAL(kEtcPalErrExists, etcpal_poll_add_wakeup(&context, &user_data));
+
+  EtcPalPollEvent event;
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_poll_wait(&context, &event, 10));
+
+  for (int i = 0; i < 3; ++i)
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_wakeup(&context));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_wait(&context, &event, 1000));
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_WAKEUP, event.events);
+  TEST_ASSERT_EQUAL(ETCPAL_SOCKET_INVALID, event.socket);
+  TEST_ASSERT_EQUAL_PTR(&user_data, event.user_data);
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_poll_wait(&context, &event, 10));
+
+  // A wakeup from another thread ends a wait which would otherwise block forever.
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  etcpal_thread_t    thread;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&thread, &params, wakeup_after_delay, &context));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_poll_wait(&context, &event, ETCPAL_WAIT_FOREVER));
+  TEST_ASSERT_EQUAL(ETCPAL_POLL_WAKEUP, event.events);
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&thread));
+
+  etcpal_poll_remove_wakeup(&context);
+  TEST_ASSERT_EQUAL(kEtcPalErrNoSockets, etcpal_poll_wait(&context, &event, 10));
+
+  etcpal_poll_context_deinit(&context);
+}
+
 #if TEST_SOCKET_FULL_OS_AVAILABLE
 TEST(etcpal_socket, so_sndbuf_works)
 {
@@ -683,12 +1043,19 @@ TEST_GROUP_RUNNER(etcpal_socket)
   RUN_TEST_CASE(etcpal_socket, poll_modify_socket_works);
   RUN_TEST_CASE(etcpal_socket, poll_for_readability_on_udp_sockets_works);
   RUN_TEST_CASE(etcpal_socket, poll_for_writability_on_udp_sockets_works);
+  RUN_TEST_CASE(etcpal_socket, poll_wait_many_works);
   RUN_TEST_CASE(etcpal_socket, getaddrinfo_works_as_expected);
   RUN_TEST_CASE(etcpal_socket, recvmsg_works);
   RUN_TEST_CASE(etcpal_socket, recvmsg_trunc_flag_works);
   RUN_TEST_CASE(etcpal_socket, recvmsg_ctrunc_flag_works);
   RUN_TEST_CASE(etcpal_socket, recvmsg_peek_flag_works);
   RUN_TEST_CASE(etcpal_socket, recvmsg_trunc_peek_works);
+  RUN_TEST_CASE(etcpal_socket, sendmmsg_and_recvmmsg_work);
+  RUN_TEST_CASE(etcpal_socket, mmsg_invalid_calls_fail);
+  RUN_TEST_CASE(etcpal_socket, join_groups_invalid_calls_fail);
+  RUN_TEST_CASE(etcpal_socket, sendmsg_sends_rlp_block_in_place);
+  RUN_TEST_CASE(etcpal_socket, poll_timer_works);
+  RUN_TEST_CASE(etcpal_socket, poll_wakeup_works);
 #if TEST_SOCKET_FULL_OS_AVAILABLE
   RUN_TEST_CASE(etcpal_socket, so_sndbuf_works);
   RUN_TEST_CASE(etcpal_socket, so_sndtimeo_works);
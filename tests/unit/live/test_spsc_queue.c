@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/spsc_queue.h"
+#include "unity_fixture.h"
+
+#include <stdint.h>
+
+#define TEST_QUEUE_SIZE 8
+
+static uint32_t        item_buf[TEST_QUEUE_SIZE];
+static size_t          sequence_buf[TEST_QUEUE_SIZE];
+static EtcPalSpscQueue spsc_queue;
+static EtcPalMpscQueue mpsc_queue;
+
+TEST_GROUP(etcpal_spsc_queue);
+
+TEST_SETUP(etcpal_spsc_queue)
+{
+}
+
+TEST_TEAR_DOWN(etcpal_spsc_queue)
+{
+}
+
+TEST(etcpal_spsc_queue, init_rejects_invalid_args)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_spsc_queue_init(NULL, item_buf, sizeof(uint32_t), TEST_QUEUE_SIZE));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_spsc_queue_init(&spsc_queue, NULL, sizeof(uint32_t), TEST_QUEUE_SIZE));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_spsc_queue_init(&spsc_queue, item_buf, 0, TEST_QUEUE_SIZE));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_spsc_queue_init(&spsc_queue, item_buf, sizeof(uint32_t), 0));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_spsc_queue_init(&spsc_queue, item_buf, sizeof(uint32_t), 6));
+
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid,
+                    etcpal_mpsc_queue_init(&mpsc_queue, item_buf, NULL, sizeof(uint32_t), TEST_QUEUE_SIZE));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_mpsc_queue_init(&mpsc_queue, item_buf, sequence_buf, sizeof(uint32_t), 6));
+}
+
+TEST(etcpal_spsc_queue, spsc_push_and_pop_work)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_spsc_queue_init(&spsc_queue, item_buf, sizeof(uint32_t), TEST_QUEUE_SIZE));
+
+  uint32_t item = 0;
+  TEST_ASSERT_FALSE(etcpal_spsc_queue_try_pop(&spsc_queue, &item));
+
+  // Fill and drain the queue a few times to exercise wraparound.
+  uint32_t next_push = 0;
+  uint32_t next_pop  = 0;
+  for (int round = 0; round < 3; ++round)
+  {
+    while (etcpal_spsc_queue_try_push(&spsc_queue, &next_push))
+      ++next_push;
+    TEST_ASSERT_EQUAL_UINT(TEST_QUEUE_SIZE, etcpal_spsc_queue_size(&spsc_queue));
+
+    // Pop part of the queue so that the next fill starts mid-buffer.
+    for (int i = 0; i < 5; ++i)
+    {
+      TEST_ASSERT_TRUE(etcpal_spsc_queue_try_pop(&spsc_queue, &item));
+      TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+    }
+  }
+
+  while (etcpal_spsc_queue_try_pop(&spsc_queue, &item))
+    TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+  TEST_ASSERT_EQUAL_UINT32(next_push, next_pop);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_spsc_queue_size(&spsc_queue));
+}
+
+TEST(etcpal_spsc_queue, mpsc_push_and_pop_work)
+{
+  TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                    etcpal_mpsc_queue_init(&mpsc_queue, item_buf, sequence_buf, sizeof(uint32_t), TEST_QUEUE_SIZE));
+
+  uint32_t item = 0;
+  TEST_ASSERT_FALSE(etcpal_mpsc_queue_try_pop(&mpsc_queue, &item));
+
+  // Fill and drain the queue a few times to exercise wraparound.
+  uint32_t next_push = 0;
+  uint32_t next_pop  = 0;
+  for (int round = 0; round < 3; ++round)
+  {
+    while (etcpal_mpsc_queue_try_push(&mpsc_queue, &next_push))
+      ++next_push;
+    TEST_ASSERT_EQUAL_UINT(TEST_QUEUE_SIZE, etcpal_mpsc_queue_size(&mpsc_queue));
+
+    for (int i = 0; i < 5; ++i)
+    {
+      TEST_ASSERT_TRUE(etcpal_mpsc_queue_try_pop(&mpsc_queue, &item));
+      TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+    }
+  }
+
+  while (etcpal_mpsc_queue_try_pop(&mpsc_queue, &item))
+    TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+  TEST_ASSERT_EQUAL_UINT32(next_push, next_pop);
+  TEST_ASSERT_EQUAL_UINT(0u, etcpal_mpsc_queue_size(&mpsc_queue));
+}
+
+TEST_GROUP_RUNNER(etcpal_spsc_queue)
+{
+  RUN_TEST_CASE(etcpal_spsc_queue, init_rejects_invalid_args);
+  RUN_TEST_CASE(etcpal_spsc_queue, spsc_push_and_pop_work);
+  RUN_TEST_CASE(etcpal_spsc_queue, mpsc_push_and_pop_work);
+}
@@ -17,6 +17,11 @@
  * https://github.com/ETCLabs/EtcPal
  ******************************************************************************/
 
+// For pthread_getaffinity_np() and the CPU_* macros on Linux
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "etcpal/thread.h"
 
 #include <stdbool.h>
@@ -180,6 +185,81 @@ TEST(etcpal_thread, get_os_handle_works)
   TEST_ASSERT_TRUE(thread_handle == reported_handle);
 }
 
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+
+static int       sched_thread_policy;
+static int       sched_thread_priority;
+static cpu_set_t sched_thread_cpus;
+
+void save_sched_params(void* param)
+{
+  ETCPAL_UNUSED_ARG(param);
+
+  struct sched_param sched_param;
+  pthread_getschedparam(pthread_self(), &sched_thread_policy, &sched_param);
+  sched_thread_priority = sched_param.sched_priority;
+  pthread_getaffinity_np(pthread_self(), sizeof sched_thread_cpus, &sched_thread_cpus);
+}
+
+static void run_sched_params_thread(unsigned int priority, const EtcPalThreadParamsLinux* platform_params)
+{
+  EtcPalThreadParams params = ETCPAL_THREAD_PARAMS_INIT;
+  params.priority           = priority;
+  params.platform_data      = (void*)platform_params;
+
+  sched_thread_policy   = -1;
+  sched_thread_priority = -1;
+  CPU_ZERO(&sched_thread_cpus);
+
+  etcpal_thread_t thread = ETCPAL_THREAD_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_create(&thread, &params, save_sched_params, NULL));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_thread_join(&thread));
+}
+
+TEST(etcpal_thread, sched_params_are_applied)
+{
+  cpu_set_t available_cpus;
+  TEST_ASSERT_EQUAL_INT(0, pthread_getaffinity_np(pthread_self(), sizeof available_cpus, &available_cpus));
+  int cpu = 0;
+  while (cpu < 64 && !CPU_ISSET(cpu, &available_cpus))
+    ++cpu;
+  TEST_ASSERT_LESS_THAN_INT(64, cpu);
+
+  EtcPalThreadParamsLinux platform_params = ETCPAL_THREAD_LINUX_PARAMS_INIT;
+  platform_params.sched_policy            = SCHED_FIFO;
+  platform_params.cpu_affinity            = 1ull << cpu;
+
+  // A priority of 0 is below the SCHED_FIFO range and should be clamped to its minimum.
+  run_sched_params_thread(0, &platform_params);
+
+  // Without the privileges for real-time scheduling, the thread falls back to default scheduling.
+  if (sched_thread_policy == SCHED_FIFO)
+    TEST_ASSERT_EQUAL_INT(sched_get_priority_min(SCHED_FIFO), sched_thread_priority);
+  else
+    TEST_ASSERT_EQUAL_INT(SCHED_OTHER, sched_thread_policy);
+
+  // The affinity does not require privileges and should always be honored.
+  TEST_ASSERT_EQUAL_INT(1, CPU_COUNT(&sched_thread_cpus));
+  TEST_ASSERT_TRUE(CPU_ISSET(cpu, &sched_thread_cpus));
+}
+
+TEST(etcpal_thread, unavailable_affinity_falls_back)
+{
+  cpu_set_t available_cpus;
+  TEST_ASSERT_EQUAL_INT(0, pthread_getaffinity_np(pthread_self(), sizeof available_cpus, &available_cpus));
+  if (CPU_ISSET(63, &available_cpus))
+    TEST_IGNORE_MESSAGE("All CPUs in the affinity mask range are available.");
+
+  EtcPalThreadParamsLinux platform_params = ETCPAL_THREAD_LINUX_PARAMS_INIT;
+  platform_params.cpu_affinity            = 1ull << 63;
+
+  run_sched_params_thread(ETCPAL_THREAD_DEFAULT_PRIORITY, &platform_params);
+  TEST_ASSERT_EQUAL_INT(SCHED_OTHER, sched_thread_policy);
+  TEST_ASSERT_TRUE(CPU_EQUAL(&available_cpus, &sched_thread_cpus));
+}
+
+#endif  // ETCPAL_THREAD_HAS_SCHED_PARAMS
+
 TEST_GROUP_RUNNER(etcpal_thread)
 {
   RUN_TEST_CASE(etcpal_thread, create_and_destroy_functions_work);
@@ -188,4 +268,8 @@ TEST_GROUP_RUNNER(etcpal_thread)
 #endif
   RUN_TEST_CASE(etcpal_thread, threads_are_time_sliced);
   RUN_TEST_CASE(etcpal_thread, get_os_handle_works);
+#if ETCPAL_THREAD_HAS_SCHED_PARAMS
+  RUN_TEST_CASE(etcpal_thread, sched_params_are_applied);
+  RUN_TEST_CASE(etcpal_thread, unavailable_affinity_falls_back);
+#endif
 }
@@ -0,0 +1,284 @@
+/******************************************************************************
+ * Copyright 2022 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************
+ * This file is a part of EtcPal. For more information, go to:
+ * https://github.com/ETCLabs/EtcPal
+ ******************************************************************************/
+
+#include "etcpal/threadpool.h"
+#include "unity_fixture.h"
+
+#include <string.h>
+#include "etcpal/sem.h"
+
+#define NUM_TEST_TASKS      2000
+#define PARALLEL_FOR_COUNT  100000
+#define MAX_SCALING_THREADS 8
+
+static EtcPalThreadPool pool;
+static unsigned int     task_run_count[NUM_TEST_TASKS];
+static unsigned int     index_run_count[PARALLEL_FOR_COUNT];
+
+static void count_task(void* context)
+{
+  ++(*(unsigned int*)context);
+}
+
+// Records the context it was called with, and that it ran.
+static void* received_context;
+static bool  null_context_task_ran;
+
+static void record_context_task(void* context)
+{
+  received_context      = context;
+  null_context_task_ran = true;
+}
+
+typedef struct CopiedTaskData
+{
+  unsigned int index;
+  unsigned int value;
+} CopiedTaskData;
+
+static void copied_data_task(void* context)
+{
+  const CopiedTaskData* data = (const CopiedTaskData*)context;
+  task_run_count[data->index] += data->value;
+}
+
+// The context is an optional pointer to an offset to add to each index.
+static void count_indices(void* context, size_t begin, size_t end)
+{
+  size_t offset = context ? *(size_t*)context : 0;
+  for (size_t i = begin; i < end; ++i)
+    ++index_run_count[offset + i];
+}
+
+typedef struct BlockingTaskData
+{
+  etcpal_sem_t started;
+  etcpal_sem_t release;
+} BlockingTaskData;
+
+static void blocking_task(void* context)
+{
+  BlockingTaskData* data = (BlockingTaskData*)context;
+  (void)etcpal_sem_post(&data->started);
+  (void)etcpal_sem_wait(&data->release);
+}
+
+// Runs a parallel_for over its own tenth of the range from within a task, to make sure nested use
+// makes progress.
+static void nested_parallel_for_task(void* context)
+{
+  size_t offset = *(size_t*)context;
+  etcpal_threadpool_parallel_for(&pool, PARALLEL_FOR_COUNT / 10, 100, count_indices, &offset);
+}
+
+TEST_GROUP(etcpal_threadpool);
+
+TEST_SETUP(etcpal_threadpool)
+{
+  memset(task_run_count, 0, sizeof task_run_count);
+  memset(index_run_count, 0, sizeof index_run_count);
+}
+
+TEST_TEAR_DOWN(etcpal_threadpool)
+{
+}
+
+TEST(etcpal_threadpool, create_rejects_invalid_config)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_threadpool_create(NULL, &config));
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_threadpool_create(&pool, NULL));
+
+  config.num_threads = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_threadpool_create(&pool, &config));
+
+  config.num_threads      = 2;
+  config.max_queued_tasks = 0;
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_threadpool_create(&pool, &config));
+}
+
+TEST(etcpal_threadpool, submitted_tasks_run_once)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  config.max_queued_tasks       = 64;  // Smaller than the number of tasks, so submitting blocks
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+  TEST_ASSERT_EQUAL_UINT(ETCPAL_THREADPOOL_DEFAULT_NUM_THREADS, etcpal_threadpool_num_threads(&pool));
+
+  for (size_t i = 0; i < NUM_TEST_TASKS; ++i)
+  {
+    TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                      etcpal_threadpool_submit(&pool, count_task, &task_run_count[i], ETCPAL_WAIT_FOREVER));
+  }
+  etcpal_threadpool_wait_idle(&pool);
+
+  for (size_t i = 0; i < NUM_TEST_TASKS; ++i)
+    TEST_ASSERT_EQUAL_UINT(1u, task_run_count[i]);
+
+  etcpal_threadpool_destroy(&pool);
+}
+
+TEST(etcpal_threadpool, submit_copy_works)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+  // The data is copied, so it can go out of scope right after submitting.
+  for (unsigned int i = 0; i < NUM_TEST_TASKS; ++i)
+  {
+    CopiedTaskData data = {i, i + 1};
+    TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                      etcpal_threadpool_submit_copy(&pool, copied_data_task, &data, sizeof data, ETCPAL_WAIT_FOREVER));
+  }
+
+  unsigned char too_big[ETCPAL_THREADPOOL_TASK_DATA_SIZE + 1];
+  memset(too_big, 0, sizeof too_big);
+  TEST_ASSERT_EQUAL(kEtcPalErrInvalid, etcpal_threadpool_submit_copy(&pool, copied_data_task, too_big, sizeof too_big,
+                                                                      ETCPAL_WAIT_FOREVER));
+
+  // Destroying the pool finishes the submitted tasks first.
+  etcpal_threadpool_destroy(&pool);
+  for (unsigned int i = 0; i < NUM_TEST_TASKS; ++i)
+    TEST_ASSERT_EQUAL_UINT(i + 1, task_run_count[i]);
+}
+
+TEST(etcpal_threadpool, submit_passes_null_context)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+  // A NULL context is passed through as NULL, not as a pointer to copied data.
+  received_context      = &received_context;
+  null_context_task_ran = false;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_submit(&pool, record_context_task, NULL, ETCPAL_WAIT_FOREVER));
+  etcpal_threadpool_wait_idle(&pool);
+  TEST_ASSERT_TRUE(null_context_task_ran);
+  TEST_ASSERT_NULL(received_context);
+
+  etcpal_threadpool_destroy(&pool);
+}
+
+TEST(etcpal_threadpool, submission_is_bounded)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  config.num_threads            = 1;
+  config.max_queued_tasks       = 2;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+  BlockingTaskData blocker;
+  TEST_ASSERT_TRUE(etcpal_sem_create(&blocker.started, 0, 1));
+  TEST_ASSERT_TRUE(etcpal_sem_create(&blocker.release, 0, 1));
+
+  // Occupy the only worker, so that the queue fills up.
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_submit(&pool, blocking_task, &blocker, ETCPAL_WAIT_FOREVER));
+  TEST_ASSERT_TRUE(etcpal_sem_wait(&blocker.started));
+
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_submit(&pool, count_task, &task_run_count[0], ETCPAL_NO_WAIT));
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_submit(&pool, count_task, &task_run_count[0], ETCPAL_NO_WAIT));
+  TEST_ASSERT_EQUAL(kEtcPalErrWouldBlock,
+                    etcpal_threadpool_submit(&pool, count_task, &task_run_count[1], ETCPAL_NO_WAIT));
+  TEST_ASSERT_EQUAL(kEtcPalErrTimedOut, etcpal_threadpool_submit(&pool, count_task, &task_run_count[1], 10));
+
+  TEST_ASSERT_TRUE(etcpal_sem_post(&blocker.release));
+  etcpal_threadpool_wait_idle(&pool);
+  TEST_ASSERT_EQUAL_UINT(2u, task_run_count[0]);
+  TEST_ASSERT_EQUAL_UINT(0u, task_run_count[1]);
+
+  etcpal_threadpool_destroy(&pool);
+  etcpal_sem_destroy(&blocker.release);
+  etcpal_sem_destroy(&blocker.started);
+}
+
+TEST(etcpal_threadpool, parallel_for_covers_range)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+  etcpal_threadpool_parallel_for(&pool, PARALLEL_FOR_COUNT, 0, count_indices, NULL);
+  for (size_t i = 0; i < PARALLEL_FOR_COUNT; ++i)
+    TEST_ASSERT_EQUAL_UINT(1u, index_run_count[i]);
+
+  // Uneven chunking
+  etcpal_threadpool_parallel_for(&pool, PARALLEL_FOR_COUNT - 1, 7, count_indices, NULL);
+  for (size_t i = 0; i < PARALLEL_FOR_COUNT - 1; ++i)
+    TEST_ASSERT_EQUAL_UINT(2u, index_run_count[i]);
+  TEST_ASSERT_EQUAL_UINT(1u, index_run_count[PARALLEL_FOR_COUNT - 1]);
+
+  etcpal_threadpool_destroy(&pool);
+
+  // Without a pool, the whole range runs on the calling thread.
+  etcpal_threadpool_parallel_for(NULL, PARALLEL_FOR_COUNT, 0, count_indices, NULL);
+  TEST_ASSERT_EQUAL_UINT(3u, index_run_count[0]);
+}
+
+TEST(etcpal_threadpool, nested_parallel_for_works)
+{
+  EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+  config.num_threads            = 2;
+  config.max_queued_tasks       = 16;
+  TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+  // Every worker runs a task which waits on its own parallel_for, with a small queue.
+  size_t offsets[10];
+  for (size_t i = 0; i < 10; ++i)
+  {
+    offsets[i] = i * (PARALLEL_FOR_COUNT / 10);
+    TEST_ASSERT_EQUAL(kEtcPalErrOk,
+                      etcpal_threadpool_submit(&pool, nested_parallel_for_task, &offsets[i], ETCPAL_WAIT_FOREVER));
+  }
+  etcpal_threadpool_wait_idle(&pool);
+  etcpal_threadpool_destroy(&pool);
+
+  for (size_t i = 0; i < PARALLEL_FOR_COUNT; ++i)
+    TEST_ASSERT_EQUAL_UINT(1u, index_run_count[i]);
+}
+
+// There is no benchmark harness; this exercises the same workload at each pool size from 1 thread
+// up, which is where scaling problems (lost tasks, stalls) would show up.
+TEST(etcpal_threadpool, works_at_each_pool_size)
+{
+  for (unsigned int num_threads = 1; num_threads <= MAX_SCALING_THREADS; ++num_threads)
+  {
+    EtcPalThreadPoolConfig config = ETCPAL_THREADPOOL_CONFIG_INIT;
+    config.num_threads            = num_threads;
+    TEST_ASSERT_EQUAL(kEtcPalErrOk, etcpal_threadpool_create(&pool, &config));
+
+    etcpal_threadpool_parallel_for(&pool, PARALLEL_FOR_COUNT, 64, count_indices, NULL);
+    for (size_t i = 0; i < NUM_TEST_TASKS; ++i)
+      etcpal_threadpool_submit(&pool, count_task, &task_run_count[i], ETCPAL_WAIT_FOREVER);
+
+    etcpal_threadpool_destroy(&pool);
+  }
+
+  for (size_t i = 0; i < PARALLEL_FOR_COUNT; ++i)
+    TEST_ASSERT_EQUAL_UINT(MAX_SCALING_THREADS, index_run_count[i]);
+  for (size_t i = 0; i < NUM_TEST_TASKS; ++i)
+    TEST_ASSERT_EQUAL_UINT(MAX_SCALING_THREADS, task_run_count[i]);
+}
+
+TEST_GROUP_RUNNER(etcpal_threadpool)
+{
+  RUN_TEST_CASE(etcpal_threadpool, create_rejects_invalid_config);
+  RUN_TEST_CASE(etcpal_threadpool, submitted_tasks_run_once);
+  RUN_TEST_CASE(etcpal_threadpool, submit_copy_works);
+  RUN_TEST_CASE(etcpal_threadpool, submit_passes_null_context);
+  RUN_TEST_CASE(etcpal_threadpool, submission_is_bounded);
+  RUN_TEST_CASE(etcpal_threadpool, parallel_for_covers_range);
+  RUN_TEST_CASE(etcpal_threadpool, nested_parallel_for_works);
+  RUN_TEST_CASE(etcpal_threadpool, works_at_each_pool_size);
+}
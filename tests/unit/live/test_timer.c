@@ -47,6 +47,32 @@ TEST(etcpal_timer, getms_gets_increasing_values)
   TEST_ASSERT_GREATER_OR_EQUAL_INT32(0, (int32_t)t2 - (int32_t)t1);
 }
 
+TEST(etcpal_timer, getns_gets_increasing_values)
+{
+  uint64_t t1 = etcpal_getns();
+  etcpal_thread_sleep(10);
+  uint64_t t2 = etcpal_getns();
+
+  TEST_ASSERT_TRUE(t1 != 0u);
+  TEST_ASSERT_TRUE(t2 - t1 >= 9000000u);
+
+  uint64_t us = etcpal_getus();
+  TEST_ASSERT_TRUE(us >= t2 / 1000u);
+  TEST_ASSERT_TRUE(us <= etcpal_getns() / 1000u);
+}
+
+TEST(etcpal_timer, getns_coarse_tracks_getns)
+{
+  uint64_t coarse_1 = etcpal_getns_coarse();
+  uint64_t fine     = etcpal_getns();
+  etcpal_thread_sleep(50);
+  uint64_t coarse_2 = etcpal_getns_coarse();
+
+  // The coarse clock shares a time base with the fine one, lagging it by at most its resolution.
+  TEST_ASSERT_TRUE(coarse_1 <= fine);
+  TEST_ASSERT_TRUE(coarse_2 > fine);
+}
+
 TEST(etcpal_timer, elapsed_since_works)
 {
   uint32_t start_point = etcpal_getms();
@@ -86,6 +112,8 @@ TEST(etcpal_timer, timers_report_expired_properly)
 TEST_GROUP_RUNNER(etcpal_timer)
 {
   RUN_TEST_CASE(etcpal_timer, getms_gets_increasing_values);
+  RUN_TEST_CASE(etcpal_timer, getns_gets_increasing_values);
+  RUN_TEST_CASE(etcpal_timer, getns_coarse_tracks_getns);
   RUN_TEST_CASE(etcpal_timer, elapsed_since_works);
   RUN_TEST_CASE(etcpal_timer, timers_report_expired_properly);
 }